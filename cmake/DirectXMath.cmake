@@ -0,0 +1,43 @@
+# DirectXMath 헤더를 directxmath 타깃으로 만듭니다.
+# Windows SDK 에는 DirectXMath 가 들어 있으므로 따로 찾지 않습니다. 그 밖에서는
+# 설치된 헤더를 찾고, 없으면 받아 옵니다. 받을 수 없는 환경에서는
+# DIRECTXMATH_INCLUDE_DIR 과 SAL_INCLUDE_DIR 을 직접 지정합니다.
+add_library(directxmath INTERFACE)
+if(WIN32)
+  return()
+endif()
+
+find_path(DIRECTXMATH_INCLUDE_DIR DirectXMath.h
+          PATH_SUFFIXES directxmath DirectXMath)
+if(NOT DIRECTXMATH_INCLUDE_DIR)
+  include(FetchContent)
+  FetchContent_Declare(directxmath_source
+    GIT_REPOSITORY https://github.com/microsoft/DirectXMath.git
+    GIT_TAG may2024
+    GIT_SHALLOW TRUE)
+  FetchContent_GetProperties(directxmath_source)
+  if(NOT directxmath_source_POPULATED)
+    FetchContent_Populate(directxmath_source)
+  endif()
+  set(DIRECTXMATH_INCLUDE_DIR ${directxmath_source_SOURCE_DIR}/Inc)
+endif()
+
+# DirectXMath 는 MSVC 의 SAL 주석을 쓰므로 sal.h 가 필요합니다
+find_path(SAL_INCLUDE_DIR sal.h PATH_SUFFIXES directxmath DirectXMath)
+if(NOT SAL_INCLUDE_DIR)
+  set(SAL_INCLUDE_DIR ${CMAKE_BINARY_DIR}/_deps/sal)
+  if(NOT EXISTS ${SAL_INCLUDE_DIR}/sal.h)
+    file(DOWNLOAD
+      https://raw.githubusercontent.com/dotnet/runtime/v8.0.1/src/coreclr/pal/inc/rt/sal.h
+      ${SAL_INCLUDE_DIR}/sal.h
+      STATUS sal_status TLS_VERIFY ON)
+    list(GET sal_status 0 sal_status_code)
+    if(NOT sal_status_code EQUAL 0)
+      file(REMOVE ${SAL_INCLUDE_DIR}/sal.h)
+      message(FATAL_ERROR "sal.h download failed; set SAL_INCLUDE_DIR")
+    endif()
+  endif()
+endif()
+
+target_include_directories(directxmath SYSTEM INTERFACE
+  ${DIRECTXMATH_INCLUDE_DIR} ${SAL_INCLUDE_DIR})
@@ -0,0 +1,54 @@
+#include "pch.h"
+#include "framework/benchmark_class.h"
+#include "framework/command_line.h"
+#include "framework/engine_benchmarks.h"
+
+namespace {
+void RegisterEngineBenchmarks(BenchmarkClass& benchmark) {
+  RegisterCameraBenchmarks(benchmark);
+  RegisterShaderConstantsBenchmarks(benchmark);
+  RegisterModelBenchmarks(benchmark);
+  RegisterTransformBenchmarks(benchmark);
+  RegisterBvhBenchmarks(benchmark);
+  RegisterMeshFileBenchmarks(benchmark);
+  RegisterMeshImporterBenchmarks(benchmark);
+  RegisterMeshOptimizerBenchmarks(benchmark);
+  RegisterMeshSimplifierBenchmarks(benchmark);
+  RegisterLodSelectorBenchmarks(benchmark);
+  RegisterShaderCacheBenchmarks(benchmark);
+  RegisterJobSystemBenchmarks(benchmark);
+  RegisterRenderQueueBenchmarks(benchmark);
+  RegisterStateFilterBenchmarks(benchmark);
+  RegisterCommandListBenchmarks(benchmark);
+  RegisterFrameArenaBenchmarks(benchmark);
+  RegisterPoolAllocatorBenchmarks(benchmark);
+}
+}  // namespace
+
+// 수학 연산과 프레임당 핫 패스의 마이크로벤치마크를 실행하는 콘솔
+// 프로그램입니다. 결과는 표준 출력과 --benchmark-out 의 JSON 으로 나갑니다
+int main(int argc, char** argv) {
+  BenchmarkClass::Options options{};
+  if (BenchmarkClass::ParseOptions(command_line::GetArguments(argc, argv),
+                                   options) == false) {
+    BenchmarkClass::PrintUsage();
+    return 2;
+  }
+
+  BenchmarkClass* benchmark = new BenchmarkClass{};
+  if (benchmark == nullptr) return 1;
+
+  int32_t exit_code = 0;
+  if (benchmark->Initialize(options)) {
+    RegisterEngineBenchmarks(*benchmark);
+    if (benchmark->Run() == false) exit_code = 1;
+  } else {
+    exit_code = 1;
+  }
+
+  benchmark->Shutdown();
+  delete benchmark;
+  benchmark = nullptr;
+
+  return exit_code;
+}
@@ -3,22 +3,24 @@
 
 #include <exception>
 #include <format>
+#include <string>
 
 namespace com {
 // Helper class for COM exceptions
 class com_exception : public std::exception {
  public:
-  com_exception(HRESULT hr) : result(hr) {}
+  // 메시지는 여기서 만들어 두어야 what() 이 돌려준 포인터가 예외가 사는
+  // 동안 유효합니다. 작업 스레드에서 잡아 메인 스레드에서 보여 줍니다
+  com_exception(HRESULT hr)
+      : result(hr),
+        message(std::format("Failure with HRESULT of {:08X}",
+                            static_cast<unsigned int>(hr))) {}
 
-  const char* what() const noexcept override {
-    std::string s_str = std::format("Failure with HRESULT of {:08X}",
-                                    static_cast<unsigned int>(result));
-
-    return s_str.length() > 0 ? s_str.c_str() : "Unknown exception";
-  }
+  const char* what() const noexcept override { return message.c_str(); }
 
  private:
   HRESULT result;
+  std::string message;
 };
 
 // Helper utility converts D3D API failures into exceptions.
@@ -0,0 +1,93 @@
+#include "pch.h"
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+// 여러 스레드가 동시에 할당하므로 순서가 필요 없는 원자 변수로 셉니다
+std::atomic<uint64_t> allocation_count{0};
+std::atomic<uint64_t> allocated_bytes{0};
+std::atomic<uint64_t> free_count{0};
+
+void CountAllocation(const size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void CountFree(const void* pointer) {
+  if (pointer) free_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* Allocate(size_t size) {
+  if (size == 0) size = 1;
+  void* pointer = std::malloc(size);
+  if (pointer == nullptr) throw std::bad_alloc{};
+
+  CountAllocation(size);
+  return pointer;
+}
+
+void* AllocateAligned(size_t size, const size_t alignment) {
+  if (size == 0) size = 1;
+#if defined(_WIN32)
+  void* pointer = _aligned_malloc(size, alignment);
+#else
+  // aligned_alloc 은 크기가 정렬의 배수여야 합니다
+  void* pointer =
+      std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+  if (pointer == nullptr) throw std::bad_alloc{};
+
+  CountAllocation(size);
+  return pointer;
+}
+
+void FreeAligned(void* pointer) {
+  CountFree(pointer);
+#if defined(_WIN32)
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+}  // namespace
+
+namespace allocation_counter {
+uint64_t GetAllocationCount() {
+  return allocation_count.load(std::memory_order_relaxed);
+}
+
+uint64_t GetAllocatedBytes() {
+  return allocated_bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t GetFreeCount() { return free_count.load(std::memory_order_relaxed); }
+}  // namespace allocation_counter
+
+// 배열과 nothrow 형태는 표준 라이브러리가 아래 함수로 넘기므로 따로 바꾸지
+// 않습니다
+void* operator new(size_t size) { return Allocate(size); }
+
+void operator delete(void* pointer) noexcept {
+  CountFree(pointer);
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  CountFree(pointer);
+  std::free(pointer);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return AllocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  FreeAligned(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+  FreeAligned(pointer);
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+
+// 전역 operator new/delete 를 바꿔 프로세스 전체의 힙 할당을 셉니다.
+// 프레임 루프가 정상 상태에서 힙을 쓰지 않는지 확인할 때 씁니다. 값은 모든
+// 스레드의 합이며, 두 시점의 값을 빼서 그 사이의 할당을 구합니다.
+namespace allocation_counter {
+// 지금까지 성공한 할당 횟수입니다
+uint64_t GetAllocationCount();
+// 지금까지 할당을 요청한 바이트 수의 합입니다
+uint64_t GetAllocatedBytes();
+// 지금까지 해제한 횟수입니다. nullptr 해제는 세지 않습니다
+uint64_t GetFreeCount();
+}  // namespace allocation_counter
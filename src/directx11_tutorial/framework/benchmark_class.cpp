@@ -0,0 +1,165 @@
+#include "pch.h"
+#include "benchmark_class.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+#include "command_line.h"
+
+bool BenchmarkClass::ParseOptions(const std::vector<std::string>& arguments,
+                                  Options& options) {
+  for (size_t i = 0; i < arguments.size(); i++) {
+    const std::string& name = arguments[i];
+    if (name == "--help") return false;
+
+    // 모든 옵션은 값을 하나 받습니다
+    if (i + 1 == arguments.size()) {
+      std::fprintf(stderr, "error: %s needs a value\n", name.c_str());
+      return false;
+    }
+
+    const std::string& value = arguments[++i];
+    bool parsed = true;
+    if (name == "--filter") {
+      options.filter_ = value;
+    } else if (name == "--benchmark-out") {
+      options.output_path_ = command_line::ToPath(value);
+    } else if (name == "--min-seconds") {
+      parsed = command_line::ToNumber(value, options.min_seconds_);
+    } else if (name == "--repetitions") {
+      parsed = command_line::ToNumber(value, options.repetitions_);
+    } else {
+      std::fprintf(stderr, "error: unknown option %s\n", name.c_str());
+      return false;
+    }
+
+    if (parsed == false) {
+      std::fprintf(stderr, "error: invalid value for %s: %s\n", name.c_str(),
+                   value.c_str());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void BenchmarkClass::PrintUsage() {
+  std::fputs(
+      "usage: directx11_tutorial_benchmark [options]\n"
+      "  --filter TEXT          run benchmarks whose name contains TEXT\n"
+      "  --benchmark-out PATH   JSON results (benchmark.json)\n"
+      "  --min-seconds S        minimum time per measurement (0.2)\n"
+      "  --repetitions N        measurements per benchmark, median (5)\n",
+      stderr);
+}
+
+bool BenchmarkClass::Initialize(const Options& options) {
+  options_ = options;
+  if (options_.repetitions_ == 0) options_.repetitions_ = 1;
+
+  return true;
+}
+
+void BenchmarkClass::Shutdown() {
+  cases_.clear();
+  results_.clear();
+}
+
+void BenchmarkClass::Add(const std::string& name, const uint64_t items_per_op,
+                         BodyType body) {
+  AddFixture(name, items_per_op, [body] { return body; });
+}
+
+void BenchmarkClass::AddFixture(const std::string& name,
+                                const uint64_t items_per_op,
+                                FixtureType fixture) {
+  cases_.push_back({name, items_per_op, std::move(fixture)});
+}
+
+bool BenchmarkClass::Run() {
+  std::printf("%-48s %12s %14s %16s\n", "benchmark", "iterations", "ns/op",
+              "items/s");
+
+  for (const CaseType& benchmark : cases_) {
+    if (options_.filter_.empty() == false &&
+        benchmark.name_.find(options_.filter_) == std::string::npos)
+      continue;
+
+    const ResultType result = Measure(benchmark);
+    results_.push_back(result);
+
+    std::printf("%-48s %12llu %14.2f %16.4g\n", result.name_.c_str(),
+                static_cast<unsigned long long>(result.iterations_),
+                result.ns_per_op_, result.items_per_second_);
+    std::fflush(stdout);
+  }
+
+  return WriteJson();
+}
+
+BenchmarkClass::ResultType BenchmarkClass::Measure(const CaseType& benchmark) {
+  using Clock = std::chrono::steady_clock;
+
+  const BodyType body = benchmark.fixture_();
+
+  auto run = [&body](uint64_t iterations) {
+    const Clock::time_point start = Clock::now();
+    body(iterations);
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  };
+
+  // 한 번의 측정이 min_seconds_ 이상 걸리도록 반복 횟수를 늘려갑니다
+  uint64_t iterations = 1;
+  while (true) {
+    const double seconds = run(iterations);
+    if (seconds >= options_.min_seconds_ || iterations >= (1ull << 40)) break;
+
+    const double scale =
+        seconds > 0.0 ? options_.min_seconds_ * 1.2 / seconds : 10.0;
+    iterations = static_cast<uint64_t>(
+        static_cast<double>(iterations) * (std::min)(scale, 10.0)) + 1;
+  }
+
+  // 여러 번 반복 측정하여 중앙값을 사용합니다
+  std::vector<double> samples;
+  for (uint32_t i = 0; i < options_.repetitions_; i++)
+    samples.push_back(run(iterations) * 1e9 / static_cast<double>(iterations));
+  std::sort(samples.begin(), samples.end());
+
+  ResultType result{};
+  result.name_ = benchmark.name_;
+  result.iterations_ = iterations;
+  result.ns_per_op_ = samples[samples.size() / 2];
+  result.items_per_second_ =
+      result.ns_per_op_ > 0.0
+          ? static_cast<double>(benchmark.items_per_op_) * 1e9 /
+                result.ns_per_op_
+          : 0.0;
+
+  return result;
+}
+
+bool BenchmarkClass::WriteJson() {
+  // 커밋 간 비교를 위해 결과를 JSON 으로 저장합니다
+  std::ofstream file(options_.output_path_);
+  if (!file) return false;
+
+  file << "{\"benchmarks\":[\n";
+  for (size_t i = 0; i < results_.size(); i++) {
+    const ResultType& result = results_[i];
+    char line[512]{};
+    std::snprintf(line, sizeof(line),
+                  "{\"name\":\"%s\",\"iterations\":%llu,\"ns_per_op\":%.3f,"
+                  "\"items_per_second\":%.3f}%s\n",
+                  result.name_.c_str(),
+                  static_cast<unsigned long long>(result.iterations_),
+                  result.ns_per_op_, result.items_per_second_,
+                  i + 1 < results_.size() ? "," : "");
+    file << line;
+  }
+  file << "]}\n";
+
+  return file.good();
+}
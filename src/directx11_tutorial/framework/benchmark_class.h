@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+// 수학 연산과 프레임당 핫 패스를 측정하는 마이크로벤치마크 실행기입니다.
+// 벤치마크는 서브시스템마다 옆에 있는 *_benchmark.cpp 에서 등록합니다
+class BenchmarkClass {
+ public:
+  struct Options {
+    std::string filter_{};
+    std::filesystem::path output_path_{"benchmark.json"};
+    double min_seconds_ = 0.2;
+    uint32_t repetitions_ = 5;
+  };
+
+  struct ResultType {
+    std::string name_;
+    uint64_t iterations_ = 0;
+    double ns_per_op_ = 0.0;
+    double items_per_second_ = 0.0;
+  };
+
+  // body 는 주어진 반복 횟수만큼 측정 대상을 실행해야 합니다
+  using BodyType = std::function<void(uint64_t iterations)>;
+  // 측정 전에 한 번 데이터를 준비하고 body 를 돌려주는 함수입니다.
+  // 준비 시간은 측정에 포함되지 않고, 데이터는 측정이 끝나면 해제됩니다
+  using FixtureType = std::function<BodyType()>;
+
+  // arguments 로 options 를 채웁니다. --help 이거나, 모르는 인자가 있거나
+  // 값이 잘못되었으면 false 를 반환합니다
+  static bool ParseOptions(const std::vector<std::string>& arguments,
+                           Options& options);
+  static void PrintUsage();
+
+  // 최적화로 측정 대상이 제거되지 않도록 값을 사용한 것으로 표시합니다
+  template <typename T>
+  static void DoNotOptimize(const T& value) {
+    sink_ = &value;
+  }
+
+  bool Initialize(const Options& options);
+  void Shutdown();
+
+  void Add(const std::string& name, const uint64_t items_per_op,
+           BodyType body);
+  void AddFixture(const std::string& name, const uint64_t items_per_op,
+                  FixtureType fixture);
+  // 필터에 맞는 벤치마크를 실행합니다. 결과 JSON 을 쓰지 못하면 false 를
+  // 반환합니다
+  bool Run();
+
+ private:
+  struct CaseType {
+    std::string name_;
+    uint64_t items_per_op_;
+    FixtureType fixture_;
+  };
+
+  ResultType Measure(const CaseType& benchmark);
+  bool WriteJson();
+
+  static inline const void* volatile sink_ = nullptr;
+
+  Options options_{};
+  std::vector<CaseType> cases_;
+  std::vector<ResultType> results_;
+};
@@ -0,0 +1,71 @@
+#include "pch.h"
+#include "command_line.h"
+
+#include <charconv>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <shellapi.h>
+#endif
+
+namespace {
+template <typename T>
+bool ParseNumber(const std::string& argument, T& value) {
+  const char* const first = argument.data();
+  const char* const last = first + argument.size();
+
+  T result{};
+  const std::from_chars_result parsed = std::from_chars(first, last, result);
+  if (parsed.ec != std::errc{} || parsed.ptr != last) return false;
+
+  value = result;
+  return true;
+}
+}  // namespace
+
+namespace command_line {
+std::vector<std::string> GetArguments(const int argc, char** argv) {
+  std::vector<std::string> arguments;
+
+#if defined(_WIN32)
+  (void)argc;
+  (void)argv;
+
+  int count = 0;
+  wchar_t** wide = ::CommandLineToArgvW(::GetCommandLineW(), &count);
+  if (wide == nullptr) return arguments;
+
+  for (int i = 1; i < count; i++) {
+    const int size = ::WideCharToMultiByte(CP_UTF8, 0, wide[i], -1, nullptr,
+                                           0, nullptr, nullptr);
+    std::string argument(size > 0 ? size - 1 : 0, '\0');
+    if (size > 1)
+      ::WideCharToMultiByte(CP_UTF8, 0, wide[i], -1, argument.data(), size,
+                            nullptr, nullptr);
+    arguments.push_back(std::move(argument));
+  }
+  ::LocalFree(wide);
+#else
+  for (int i = 1; i < argc; i++) arguments.emplace_back(argv[i]);
+#endif
+
+  return arguments;
+}
+
+std::filesystem::path ToPath(const std::string& argument) {
+  return std::filesystem::path(
+      std::u8string(argument.begin(), argument.end()));
+}
+
+bool ToNumber(const std::string& argument, uint32_t& value) {
+  return ParseNumber(argument, value);
+}
+
+bool ToNumber(const std::string& argument, int32_t& value) {
+  return ParseNumber(argument, value);
+}
+
+bool ToNumber(const std::string& argument, double& value) {
+  return ParseNumber(argument, value);
+}
+}  // namespace command_line
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// 명령줄 인자를 플랫폼과 관계없이 UTF-8 문자열로 다룹니다
+namespace command_line {
+// 프로그램 이름을 뺀 인자들입니다. Windows 에서는 argv 대신 유니코드
+// 명령줄을 CommandLineToArgvW 로 나누므로, 따옴표로 감싼 공백 있는 경로와
+// 코드 페이지 밖의 문자도 그대로 남습니다. wWinMain 에서는 argc 를 0 으로
+// 넘깁니다
+std::vector<std::string> GetArguments(const int argc, char** argv);
+
+// UTF-8 인자를 경로로 바꿉니다
+std::filesystem::path ToPath(const std::string& argument);
+
+// 인자 전체가 숫자일 때만 value 에 쓰고 true 를 반환합니다
+bool ToNumber(const std::string& argument, uint32_t& value);
+bool ToNumber(const std::string& argument, int32_t& value);
+bool ToNumber(const std::string& argument, double& value);
+}  // namespace command_line
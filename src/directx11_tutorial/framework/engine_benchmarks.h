@@ -0,0 +1,24 @@
+#pragma once
+
+class BenchmarkClass;
+
+// 서브시스템마다 옆에 있는 *_benchmark.cpp 가 자신의 벤치마크를 등록합니다
+void RegisterJobSystemBenchmarks(BenchmarkClass& benchmark);
+void RegisterFrameArenaBenchmarks(BenchmarkClass& benchmark);
+void RegisterPoolAllocatorBenchmarks(BenchmarkClass& benchmark);
+
+void RegisterCameraBenchmarks(BenchmarkClass& benchmark);
+void RegisterShaderConstantsBenchmarks(BenchmarkClass& benchmark);
+void RegisterModelBenchmarks(BenchmarkClass& benchmark);
+void RegisterTransformBenchmarks(BenchmarkClass& benchmark);
+void RegisterBvhBenchmarks(BenchmarkClass& benchmark);
+void RegisterMeshFileBenchmarks(BenchmarkClass& benchmark);
+void RegisterMeshImporterBenchmarks(BenchmarkClass& benchmark);
+void RegisterMeshOptimizerBenchmarks(BenchmarkClass& benchmark);
+void RegisterMeshSimplifierBenchmarks(BenchmarkClass& benchmark);
+void RegisterLodSelectorBenchmarks(BenchmarkClass& benchmark);
+void RegisterShaderCacheBenchmarks(BenchmarkClass& benchmark);
+void RegisterRenderQueueBenchmarks(BenchmarkClass& benchmark);
+void RegisterStateFilterBenchmarks(BenchmarkClass& benchmark);
+void RegisterCommandListBenchmarks(BenchmarkClass& benchmark);
+
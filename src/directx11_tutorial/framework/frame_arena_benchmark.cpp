@@ -0,0 +1,46 @@
+#include "pch.h"
+#include "engine_benchmarks.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark_class.h"
+#include "frame_arena_class.h"
+
+void RegisterFrameArenaBenchmarks(BenchmarkClass& benchmark) {
+  // 한 프레임에 64 바이트짜리 임시 데이터 1000 개를 받고 버리기. 프레임
+  // 할당기와 힙 할당을 비교합니다
+  for (const bool arena : {false, true}) {
+    const uint32_t allocation_count = 1000;
+    const std::string name = "FrameArenaClass::Allocate/" +
+                             std::to_string(allocation_count) +
+                             (arena ? "/arena" : "/heap");
+
+    benchmark.AddFixture(name, allocation_count, [arena, allocation_count] {
+      struct DataType {
+        FrameArenaClass frame_arena_;
+        std::vector<void*> blocks_;
+        ~DataType() { frame_arena_.Shutdown(); }
+      };
+      auto data = std::make_shared<DataType>();
+      data->frame_arena_.Initialize(allocation_count * 64, 2);
+      data->blocks_.resize(allocation_count);
+
+      return BenchmarkClass::BodyType([data, arena](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+          if (arena) {
+            data->frame_arena_.BeginFrame();
+            for (void*& block : data->blocks_)
+              block = data->frame_arena_.Allocate(64);
+            BenchmarkClass::DoNotOptimize(data->blocks_);
+          } else {
+            for (void*& block : data->blocks_) block = ::operator new(64);
+            BenchmarkClass::DoNotOptimize(data->blocks_);
+            for (void* block : data->blocks_) ::operator delete(block);
+          }
+        }
+      });
+    });
+  }
+}
@@ -0,0 +1,107 @@
+#include "pch.h"
+#include "frame_arena_class.h"
+
+#include <algorithm>
+#include <new>
+
+bool FrameArenaClass::Initialize(const size_t capacity,
+                                 const uint32_t frame_count) {
+  if (frame_count == 0 || frame_count > MAX_FRAMES) return false;
+
+  frame_count_ = frame_count;
+  for (uint32_t frame = 0; frame < frame_count_; frame++) {
+    RegionType& region = regions_[frame];
+    region.memory_ = static_cast<uint8_t*>(::operator new(
+        capacity, std::align_val_t{alignof(std::max_align_t)}));
+    region.capacity_ = capacity;
+  }
+
+  frame_ = 0;
+  offset_.store(0, std::memory_order_relaxed);
+  return true;
+}
+
+void FrameArenaClass::Shutdown() {
+  for (RegionType& region : regions_) {
+    ReleaseOverflow(region);
+    if (region.memory_) {
+      ::operator delete(region.memory_,
+                        std::align_val_t{alignof(std::max_align_t)});
+      region.memory_ = nullptr;
+    }
+    region.capacity_ = 0;
+  }
+  frame_count_ = 0;
+}
+
+void FrameArenaClass::BeginFrame() {
+  peak_bytes_ = (std::max)(peak_bytes_, GetUsedBytes());
+
+  frame_ = (frame_ + 1) % frame_count_;
+  RegionType& region = regions_[frame_];
+
+  // 지난번 이 영역이 넘쳤으면 넘친 만큼 키워 다음부터는 힙을 쓰지 않습니다
+  if (region.overflow_bytes_ > 0) {
+    const size_t capacity = region.capacity_ + region.overflow_bytes_;
+    ReleaseOverflow(region);
+    ::operator delete(region.memory_,
+                      std::align_val_t{alignof(std::max_align_t)});
+    region.memory_ = static_cast<uint8_t*>(::operator new(
+        capacity, std::align_val_t{alignof(std::max_align_t)}));
+    region.capacity_ = capacity;
+  }
+
+  offset_.store(0, std::memory_order_relaxed);
+}
+
+void* FrameArenaClass::Allocate(const size_t size, const size_t alignment) {
+  RegionType& region = regions_[frame_];
+
+  // 정렬한 시작 위치를 compare-exchange 로 잡으므로 잠금이 없습니다.
+  // 영역은 max_align_t 로만 정렬되어 있으므로 오프셋이 아니라 주소를
+  // 정렬합니다
+  const uintptr_t base = reinterpret_cast<uintptr_t>(region.memory_);
+  size_t offset = offset_.load(std::memory_order_relaxed);
+  while (true) {
+    const size_t begin =
+        ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+    if (begin + size > region.capacity_)
+      return AllocateOverflow(size, alignment);
+
+    if (offset_.compare_exchange_weak(offset, begin + size,
+                                      std::memory_order_relaxed))
+      return region.memory_ + begin;
+  }
+}
+
+size_t FrameArenaClass::GetUsedBytes() {
+  return offset_.load(std::memory_order_relaxed) +
+         regions_[frame_].overflow_bytes_;
+}
+
+size_t FrameArenaClass::GetPeakBytes() {
+  return (std::max)(peak_bytes_, GetUsedBytes());
+}
+
+uint64_t FrameArenaClass::GetOverflowCount() { return overflow_count_; }
+
+void* FrameArenaClass::AllocateOverflow(const size_t size,
+                                        const size_t alignment) {
+  const OverflowBlockType block{
+      ::operator new(size, std::align_val_t{alignment}), alignment};
+
+  std::lock_guard<std::mutex> lock(overflow_mutex_);
+  RegionType& region = regions_[frame_];
+  region.overflow_blocks_.push_back(block);
+  // 영역에 옮겨 담을 때 정렬로 생길 빈칸까지 셉니다
+  region.overflow_bytes_ += size + alignment;
+  overflow_count_++;
+  return block.memory_;
+}
+
+void FrameArenaClass::ReleaseOverflow(RegionType& region) {
+  for (const OverflowBlockType& block : region.overflow_blocks_)
+    ::operator delete(block.memory_, std::align_val_t{block.alignment_});
+  region.overflow_blocks_.clear();
+  region.overflow_bytes_ = 0;
+}
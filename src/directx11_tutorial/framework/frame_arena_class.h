@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+// 한 프레임 동안만 쓰는 임시 데이터를 위한 선형(bump) 할당기입니다.
+// 프레임마다 영역을 하나씩 돌려 쓰며, BeginFrame 에서 다음 영역을 통째로
+// 비웁니다. 영역이 frame_count 개이므로 할당한 메모리는 그 뒤 frame_count - 1
+// 프레임 동안 유효합니다. 그래서 GPU 가 이전 프레임의 데이터를 아직 읽는
+// 동안에도 덮어쓰지 않습니다.
+// Allocate 는 여러 스레드에서 동시에 불러도 됩니다. 영역이 모자라면 힙에서
+// 받아 두었다가 그 영역을 비울 때 해제하고, 다음에 그 영역을 쓸 때는
+// 넘친 만큼 영역을 키웁니다.
+class FrameArenaClass {
+ public:
+  static const uint32_t MAX_FRAMES = 3;
+
+  // 영역 하나의 바이트 수와 돌려 쓸 영역 수(1 ~ MAX_FRAMES)입니다
+  bool Initialize(const size_t capacity, const uint32_t frame_count);
+  void Shutdown();
+
+  // 다음 영역으로 넘어가 비웁니다. 프레임 시작에서 한 번 부릅니다
+  void BeginFrame();
+
+  // alignment 는 2 의 거듭제곱이어야 합니다
+  void* Allocate(const size_t size, const size_t alignment = 16);
+  // 소멸자를 부르지 않으므로 소멸자가 하는 일이 없는 타입만 받습니다.
+  // 생성자도 부르지 않습니다
+  template <typename T>
+  T* Allocate(const size_t count);
+
+  // 이번 프레임에 쓴 바이트 수와 지금까지 한 프레임에 쓴 최대 바이트 수,
+  // 영역이 모자라 힙으로 넘어간 횟수입니다
+  size_t GetUsedBytes();
+  size_t GetPeakBytes();
+  uint64_t GetOverflowCount();
+
+ private:
+  // 영역이 모자라 힙에서 받은 블록입니다. 받은 정렬로 해제해야 합니다
+  struct OverflowBlockType {
+    void* memory_;
+    size_t alignment_;
+  };
+
+  struct RegionType {
+    uint8_t* memory_ = nullptr;
+    size_t capacity_ = 0;
+    // 넘친 블록과 그 바이트 수의 합입니다
+    std::vector<OverflowBlockType> overflow_blocks_;
+    size_t overflow_bytes_ = 0;
+  };
+
+  void* AllocateOverflow(const size_t size, const size_t alignment);
+  void ReleaseOverflow(RegionType& region);
+
+  RegionType regions_[MAX_FRAMES];
+  uint32_t frame_count_ = 0;
+  uint32_t frame_ = 0;
+  std::atomic<size_t> offset_{0};
+  std::mutex overflow_mutex_;
+  size_t peak_bytes_ = 0;
+  uint64_t overflow_count_ = 0;
+};
+
+template <typename T>
+T* FrameArenaClass::Allocate(const size_t count) {
+  static_assert(std::is_trivially_destructible_v<T>,
+                "FrameArenaClass does not run destructors");
+  return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+}
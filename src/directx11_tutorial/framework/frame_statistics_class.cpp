@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "frame_statistics_class.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+const double MIN_BUCKET_MS = 0.001;
+}  // namespace
+
+void FrameStatisticsClass::Reset() {
+  buckets_.fill(0);
+  frame_count_ = 0;
+  total_ms_ = 0.0;
+  min_ms_ = 0.0;
+  max_ms_ = 0.0;
+}
+
+void FrameStatisticsClass::AddFrame(const double milliseconds) {
+  // NaN 과 음수는 가장 아래 구간에 셉니다
+  const double octaves = milliseconds > MIN_BUCKET_MS
+                             ? std::log2(milliseconds / MIN_BUCKET_MS)
+                             : 0.0;
+  const double bucket =
+      (std::min)(octaves * BUCKETS_PER_OCTAVE, double{BUCKET_COUNT - 1});
+  buckets_[static_cast<uint32_t>(bucket)]++;
+
+  if (frame_count_ == 0) min_ms_ = max_ms_ = milliseconds;
+  min_ms_ = (std::min)(min_ms_, milliseconds);
+  max_ms_ = (std::max)(max_ms_, milliseconds);
+  total_ms_ += milliseconds;
+  frame_count_++;
+}
+
+double FrameStatisticsClass::Percentile(const double percent) const {
+  const uint64_t rank = (std::max)(
+      static_cast<uint64_t>(
+          std::ceil(percent / 100.0 * static_cast<double>(frame_count_))),
+      uint64_t{1});
+
+  uint64_t count = 0;
+  for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+    count += buckets_[i];
+    if (count < rank) continue;
+
+    // 구간의 위쪽 경계를 쓰되 실제로 잰 범위를 벗어나지 않게 합니다
+    const double upper = MIN_BUCKET_MS * std::exp2(static_cast<double>(i + 1) /
+                                                   BUCKETS_PER_OCTAVE);
+    return (std::clamp)(upper, min_ms_, max_ms_);
+  }
+  return max_ms_;
+}
+
+FrameStatisticsClass::SummaryType FrameStatisticsClass::Summarize() const {
+  SummaryType summary{};
+  if (frame_count_ == 0) return summary;
+
+  summary.frame_count_ = frame_count_;
+  summary.total_seconds_ = total_ms_ / 1000.0;
+  summary.min_ms_ = min_ms_;
+  summary.avg_ms_ = total_ms_ / static_cast<double>(frame_count_);
+  summary.p50_ms_ = Percentile(50.0);
+  summary.p95_ms_ = Percentile(95.0);
+  summary.p99_ms_ = Percentile(99.0);
+  summary.max_ms_ = max_ms_;
+  summary.frames_per_second_ =
+      total_ms_ > 0.0
+          ? static_cast<double>(frame_count_) * 1000.0 / total_ms_
+          : 0.0;
+
+  return summary;
+}
+
+std::string FrameStatisticsClass::Format() const {
+  const SummaryType summary = Summarize();
+
+  char text[256]{};
+  std::snprintf(text, sizeof(text),
+                "frames: %llu, elapsed: %.3f s, throughput: %.1f fps\n"
+                "frame time (ms): min %.3f avg %.3f p50 %.3f p95 %.3f "
+                "p99 %.3f max %.3f\n",
+                static_cast<unsigned long long>(summary.frame_count_),
+                summary.total_seconds_, summary.frames_per_second_,
+                summary.min_ms_, summary.avg_ms_, summary.p50_ms_,
+                summary.p95_ms_, summary.p99_ms_, summary.max_ms_);
+  return text;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+
+// 프레임 시간을 모아 최소/평균/백분위 통계와 처리량을 계산합니다.
+// 프레임 시간은 로그 간격 구간의 히스토그램에 세므로 오래 실행해도 메모리를
+// 더 쓰지 않습니다. 최소/평균/최대는 정확하고, 백분위는 구간 폭(약 1.1%)
+// 안의 근삿값입니다.
+class FrameStatisticsClass {
+ public:
+  struct SummaryType {
+    uint64_t frame_count_ = 0;
+    double total_seconds_ = 0.0;
+    double min_ms_ = 0.0;
+    double avg_ms_ = 0.0;
+    double p50_ms_ = 0.0;
+    double p95_ms_ = 0.0;
+    double p99_ms_ = 0.0;
+    double max_ms_ = 0.0;
+    double frames_per_second_ = 0.0;
+  };
+
+  void Reset();
+  void AddFrame(const double milliseconds);
+
+  SummaryType Summarize() const;
+  std::string Format() const;
+
+ private:
+  // 1 us 부터 두 배마다 64 개 구간을 두어 약 16.7 s 까지 셉니다. 범위를
+  // 벗어난 값은 양 끝 구간에 셉니다
+  static const uint32_t BUCKETS_PER_OCTAVE = 64;
+  static const uint32_t BUCKET_COUNT = BUCKETS_PER_OCTAVE * 24;
+
+  // nearest-rank 방식의 백분위 값입니다
+  double Percentile(const double percent) const;
+
+  std::array<uint64_t, BUCKET_COUNT> buckets_{};
+  uint64_t frame_count_ = 0;
+  double total_ms_ = 0.0;
+  double min_ms_ = 0.0;
+  double max_ms_ = 0.0;
+};
@@ -0,0 +1,166 @@
+#include "pch.h"
+#include "headless_class.h"
+
+#include <chrono>
+#include <cstdio>
+
+#include "allocation_counter.h"
+#include "command_line.h"
+#include "frame_statistics_class.h"
+#include "profiler.h"
+#include "graphic/graphics_class.h"
+
+bool HeadlessClass::ParseOptions(const std::vector<std::string>& arguments,
+                                 Options& options) {
+  for (size_t i = 0; i < arguments.size(); i++) {
+    const std::string& name = arguments[i];
+
+    // 플래그가 아닌 인자는 다음 값을 하나 더 읽습니다
+    if (name == "--help") return false;
+    if (name == "--require-zero-alloc") {
+      options.require_zero_allocations_ = true;
+      continue;
+    }
+    if (i + 1 == arguments.size()) {
+      std::fprintf(stderr, "error: %s needs a value\n", name.c_str());
+      return false;
+    }
+
+    const std::string& value = arguments[++i];
+    bool parsed = true;
+    if (name == "--frames") {
+      parsed = command_line::ToNumber(value, options.frame_count_);
+    } else if (name == "--seconds") {
+      parsed = command_line::ToNumber(value, options.seconds_);
+    } else if (name == "--width") {
+      parsed = command_line::ToNumber(value, options.width_);
+    } else if (name == "--height") {
+      parsed = command_line::ToNumber(value, options.height_);
+    } else if (name == "--warmup") {
+      parsed = command_line::ToNumber(value, options.warmup_frames_);
+    } else if (name == "--screenshot") {
+      options.screenshot_path_ = command_line::ToPath(value);
+    } else if (name == "--trace") {
+      options.trace_path_ = command_line::ToPath(value);
+    } else if (name == "--model") {
+      options.model_path_ = command_line::ToPath(value);
+    } else {
+      std::fprintf(stderr, "error: unknown option %s\n", name.c_str());
+      return false;
+    }
+
+    if (parsed == false) {
+      std::fprintf(stderr, "error: invalid value for %s: %s\n", name.c_str(),
+                   value.c_str());
+      return false;
+    }
+  }
+
+  // 아무 제한도 없으면 1000 프레임을 실행합니다
+  if (options.frame_count_ == 0 && options.seconds_ <= 0.0)
+    options.frame_count_ = 1000;
+
+  return true;
+}
+
+void HeadlessClass::PrintUsage() {
+  std::fputs(
+      "usage: directx11_tutorial_headless [options]\n"
+      "  --frames N             frames to measure (default 1000)\n"
+      "  --seconds S            seconds to measure\n"
+      "  --warmup N             frames to skip before measuring (10)\n"
+      "  --width W --height H   render size (800x600)\n"
+      "  --model PATH           .mesh, .obj or .ply model\n"
+      "  --screenshot PATH      save the last frame as PPM\n"
+      "  --trace PATH           write a Chrome trace (profiler builds)\n"
+      "  --require-zero-alloc   fail if the frame loop allocates\n",
+      stderr);
+}
+
+bool HeadlessClass::Initialize(const Options& options) {
+  options_ = options;
+
+  graphics_ = new GraphicsClass{};
+  if (graphics_ == nullptr) return false;
+
+  return graphics_->InitializeSoftware(options.width_, options.height_,
+                                       options.model_path_);
+}
+
+void HeadlessClass::Shutdown() {
+  if (graphics_) {
+    graphics_->Shutdown();
+    delete graphics_;
+    graphics_ = nullptr;
+  }
+}
+
+bool HeadlessClass::Run() {
+  using Clock = std::chrono::steady_clock;
+
+  PROFILE_THREAD_NAME("Main");
+
+  // 캐시와 스레드가 안정될 때까지 측정하지 않고 몇 프레임 돌립니다
+  for (uint32_t i = 0; i < options_.warmup_frames_; i++)
+    if (graphics_->Frame() == false) return false;
+
+  // 히스토그램은 크기가 고정이므로 측정 중에 할당하지 않습니다
+  FrameStatisticsClass statistics{};
+
+  // 측정 프레임 동안의 힙 할당만 셉니다
+  const uint64_t allocation_start = allocation_counter::GetAllocationCount();
+  const uint64_t bytes_start = allocation_counter::GetAllocatedBytes();
+
+  const Clock::time_point start = Clock::now();
+  uint32_t frame = 0;
+  bool rendered = true;
+
+  while (true) {
+    if (options_.frame_count_ > 0 && frame >= options_.frame_count_) break;
+
+    const Clock::time_point frame_start = Clock::now();
+    if (options_.seconds_ > 0.0 &&
+        std::chrono::duration<double>(frame_start - start).count() >=
+            options_.seconds_)
+      break;
+
+    if (graphics_->Frame() == false) {
+      rendered = false;
+      break;
+    }
+
+    statistics.AddFrame(
+        std::chrono::duration<double, std::milli>(Clock::now() - frame_start)
+            .count());
+    frame++;
+  }
+
+  const uint64_t allocation_count =
+      allocation_counter::GetAllocationCount() - allocation_start;
+  const uint64_t allocated_bytes =
+      allocation_counter::GetAllocatedBytes() - bytes_start;
+
+  // 프레임 시간 통계와 힙 할당 수를 표준 출력으로 보고합니다
+  std::fputs(statistics.Format().c_str(), stdout);
+  std::printf("heap allocations: %llu (%llu bytes) over %u frames\n",
+              static_cast<unsigned long long>(allocation_count),
+              static_cast<unsigned long long>(allocated_bytes), frame);
+  std::fflush(stdout);
+
+  if (options_.screenshot_path_.empty() == false)
+    graphics_->SaveScreenshot(options_.screenshot_path_);
+
+  // 프로파일러가 켜진 빌드라면 기록된 구간을 Chrome 트레이스로 저장합니다
+  if (options_.trace_path_.empty() == false)
+    profiler::WriteChromeTrace(options_.trace_path_);
+
+  if (rendered == false) {
+    std::fputs("error: a frame failed to render\n", stderr);
+    return false;
+  }
+  if (options_.require_zero_allocations_ && allocation_count > 0) {
+    std::fputs("error: the frame loop allocated from the heap\n", stderr);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+class GraphicsClass;
+
+// 윈도우 없이 소프트웨어 렌더러로 프레임 루프만 돌리고 프레임 시간과 힙
+// 할당 통계를 표준 출력으로 보고합니다. GPU 가 없는 환경에서도 실행됩니다
+class HeadlessClass {
+ public:
+  struct Options {
+    int32_t width_ = 800;
+    int32_t height_ = 600;
+    uint32_t frame_count_ = 0;   // 0 이면 프레임 수 제한이 없습니다
+    double seconds_ = 0.0;       // 0 이면 시간 제한이 없습니다
+    uint32_t warmup_frames_ = 10;
+    std::filesystem::path screenshot_path_{};
+    std::filesystem::path trace_path_{};
+    std::filesystem::path model_path_{};  // .mesh, .obj, .ply
+    // 측정 프레임 동안 힙 할당이 한 번이라도 있으면 실패로 끝냅니다
+    bool require_zero_allocations_ = false;
+  };
+
+  // arguments 로 options 를 채웁니다. --help 이거나, 모르는 인자가 있거나
+  // 값이 빠졌거나 숫자가 아니면 false 를 반환합니다. 잘못된 인자는 stderr
+  // 에 알립니다
+  static bool ParseOptions(const std::vector<std::string>& arguments,
+                           Options& options);
+  static void PrintUsage();
+
+  bool Initialize(const Options& options);
+  void Shutdown();
+  // 프레임을 그리지 못했거나 --require-zero-alloc 검사에 실패하면 false 를
+  // 반환합니다
+  bool Run();
+
+ private:
+  Options options_{};
+  GraphicsClass* graphics_ = nullptr;
+};
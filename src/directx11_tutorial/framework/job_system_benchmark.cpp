@@ -0,0 +1,60 @@
+#include "pch.h"
+#include "engine_benchmarks.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark_class.h"
+#include "job_system_class.h"
+
+void RegisterJobSystemBenchmarks(BenchmarkClass& benchmark) {
+  // 작은 작업 100 만 개를 묶음으로 나눠 모든 코어에서 실행하기
+  benchmark.AddFixture("JobSystemClass::ParallelFor/1M", 1000000, [] {
+    struct DataType {
+      JobSystemClass job_system_;
+      std::vector<float> values_;
+      ~DataType() { job_system_.Shutdown(); }
+    };
+    auto data = std::make_shared<DataType>();
+    data->job_system_.Initialize();
+    data->values_.assign(1000000, 1.0f);
+
+    return BenchmarkClass::BodyType([data](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; i++) {
+        data->job_system_.ParallelFor(
+            static_cast<uint32_t>(data->values_.size()),
+            [&](uint32_t index) { data->values_[index] *= 1.0001f; });
+        BenchmarkClass::DoNotOptimize(data->values_);
+      }
+    });
+  });
+
+  // 작업 안에서 다시 ParallelFor 를 3 단계로 중첩해 훔치기와 기다리는 동안
+  // 다른 작업을 실행하는 경로에 부하를 주기
+  const std::string nested_name = "JobSystemClass::ParallelFor/nested/64x64x16";
+  benchmark.AddFixture(nested_name, 64 * 64 * 16, [] {
+    struct DataType {
+      JobSystemClass job_system_;
+      ~DataType() { job_system_.Shutdown(); }
+    };
+    auto data = std::make_shared<DataType>();
+    data->job_system_.Initialize();
+
+    return BenchmarkClass::BodyType([data](uint64_t iterations) {
+      JobSystemClass& job_system = data->job_system_;
+      for (uint64_t i = 0; i < iterations; i++) {
+        std::atomic<uint64_t> sum{0};
+        job_system.ParallelFor(64, [&](uint32_t x) {
+          job_system.ParallelFor(64, [&](uint32_t y) {
+            job_system.ParallelFor(16, [&](uint32_t z) {
+              sum.fetch_add(x ^ y ^ z, std::memory_order_relaxed);
+            });
+          });
+        });
+        BenchmarkClass::DoNotOptimize(sum.load());
+      }
+    });
+  });
+}
@@ -0,0 +1,266 @@
+#include "pch.h"
+#include "job_system_class.h"
+
+#include <algorithm>
+
+#include "profiler.h"
+
+namespace {
+// 현재 스레드가 속한 작업 시스템과 deque 번호입니다
+thread_local JobSystemClass* current_system = nullptr;
+thread_local uint32_t current_worker = 0;
+}  // namespace
+
+bool JobSystemClass::DequeType::Push(JobType* job) {
+  const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  const int64_t top = top_.load(std::memory_order_acquire);
+  if (bottom - top >= static_cast<int64_t>(DEQUE_CAPACITY)) return false;
+
+  jobs_[bottom & (DEQUE_CAPACITY - 1)].store(job, std::memory_order_relaxed);
+  bottom_.store(bottom + 1, std::memory_order_release);
+  return true;
+}
+
+JobSystemClass::JobType* JobSystemClass::DequeType::Pop() {
+  // bottom 을 먼저 줄여 Steal 과 마지막 하나를 두고 경쟁하게 합니다. 논문의
+  // seq_cst fence 대신 seq_cst 연산을 써서 ThreadSanitizer 로도 검사됩니다
+  const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  bottom_.store(bottom, std::memory_order_seq_cst);
+  int64_t top = top_.load(std::memory_order_seq_cst);
+
+  // 비어 있으면 bottom 을 되돌립니다
+  if (top > bottom) {
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  JobType* job =
+      jobs_[bottom & (DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+  if (top == bottom) {
+    // 마지막 하나는 Steal 과 경쟁하므로 top 을 CAS 로 가져옵니다
+    if (top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed) == false)
+      job = nullptr;
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return job;
+}
+
+JobSystemClass::JobType* JobSystemClass::DequeType::Steal() {
+  int64_t top = top_.load(std::memory_order_seq_cst);
+  const int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+  if (top >= bottom) return nullptr;
+
+  JobType* job =
+      jobs_[top & (DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+  // 다른 스레드가 먼저 가져갔으면 실패합니다. 호출한 쪽이 다른 deque 를
+  // 찾아봅니다
+  if (top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                   std::memory_order_relaxed) == false)
+    return nullptr;
+  return job;
+}
+
+bool JobSystemClass::Initialize(uint32_t thread_count) {
+  // 개수를 지정하지 않으면 호출 스레드를 제외한 나머지 코어 수만큼 만듭니다
+  if (thread_count == 0) {
+    const uint32_t hardware = std::thread::hardware_concurrency();
+    thread_count = hardware > 1 ? hardware - 1 : 0;
+  }
+
+  stop_ = false;
+  deques_.reserve(thread_count + 1);
+  for (uint32_t i = 0; i < thread_count + 1; i++)
+    deques_.push_back(std::make_unique<DequeType>());
+
+  workers_.reserve(thread_count);
+  for (uint32_t i = 0; i < thread_count; i++)
+    workers_.emplace_back(&JobSystemClass::WorkerLoop, this, i + 1);
+
+  return true;
+}
+
+void JobSystemClass::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+
+  for (std::thread& worker : workers_)
+    if (worker.joinable()) worker.join();
+
+  workers_.clear();
+  deques_.clear();
+}
+
+uint32_t JobSystemClass::GetThreadCount() {
+  return static_cast<uint32_t>(workers_.size()) + 1;
+}
+
+void JobSystemClass::Run(JobType* jobs, const uint32_t count,
+                         CounterType* counter) {
+  if (count == 0) return;
+
+  // 작업이 끝나기 전에 카운터와 대기 수를 먼저 올립니다
+  for (uint32_t i = 0; i < count; i++) jobs[i].counter_ = counter;
+  counter->value_.fetch_add(count, std::memory_order_relaxed);
+  pending_.fetch_add(count, std::memory_order_seq_cst);
+
+  const uint32_t index = GetWorkerIndex();
+  uint32_t overflow = 0;
+  {
+    std::unique_lock<std::mutex> lock(external_mutex_, std::defer_lock);
+    if (index == 0) lock.lock();
+
+    for (uint32_t i = 0; i < count; i++) {
+      if (deques_[index]->Push(&jobs[i]) == false) {
+        // deque 가 가득 차면 넣지 못한 작업은 이 스레드에서 실행합니다
+        overflow = count - i;
+        break;
+      }
+    }
+  }
+
+  if (overflow > 0) {
+    pending_.fetch_sub(overflow, std::memory_order_relaxed);
+    for (uint32_t i = count - overflow; i < count; i++) Execute(&jobs[i]);
+  }
+
+  // 잠든 작업 스레드가 있으면 깨웁니다. pending_ 을 올린 뒤 sleeping_ 을
+  // 읽으므로, 잠들려는 스레드는 둘 중 하나에서 반드시 새 작업을 봅니다
+  if (count > overflow && sleeping_.load(std::memory_order_seq_cst) > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (count - overflow > 1)
+      wake_.notify_all();
+    else
+      wake_.notify_one();
+  }
+}
+
+void JobSystemClass::Wait(CounterType* counter) {
+  const uint32_t index = GetWorkerIndex();
+  uint32_t victim = index;
+
+  // 기다리는 동안 다른 작업을 실행합니다. 기다리는 작업이 다른 스레드에서
+  // 실행 중이면 양보하며 돌아봅니다
+  while (counter->value_.load(std::memory_order_acquire) != 0) {
+    JobType* job = TakeJob(index, victim);
+    if (job)
+      Execute(job);
+    else
+      std::this_thread::yield();
+  }
+}
+
+void JobSystemClass::ParallelFor(const uint32_t count,
+                                 void (*function)(const void* data,
+                                                  uint32_t index),
+                                 const void* data) {
+  if (count == 0) return;
+
+  // 작업이 하나뿐이거나 작업 스레드가 없으면 그냥 호출 스레드에서 실행합니다
+  const uint32_t thread_count = GetThreadCount();
+  if (count == 1 || thread_count == 1) {
+    for (uint32_t i = 0; i < count; i++) function(data, i);
+    return;
+  }
+
+  struct BatchType {
+    void (*function_)(const void* data, uint32_t index);
+    const void* data_;
+    uint32_t count_;
+    uint32_t batch_count_;
+  };
+  const BatchType batch{
+      function, data, count,
+      (std::min)({count, thread_count * BATCHES_PER_THREAD, MAX_BATCHES})};
+
+  // 인덱스를 고르게 나눈 묶음마다 작업 하나를 만듭니다
+  JobType jobs[MAX_BATCHES];
+  for (uint32_t i = 0; i < batch.batch_count_; i++) {
+    jobs[i].function_ = [](void* data, uint32_t index) {
+      const BatchType& batch = *static_cast<const BatchType*>(data);
+      const uint32_t begin = static_cast<uint32_t>(
+          uint64_t{index} * batch.count_ / batch.batch_count_);
+      const uint32_t end = static_cast<uint32_t>(
+          uint64_t{index + 1} * batch.count_ / batch.batch_count_);
+      for (uint32_t i = begin; i < end; i++) batch.function_(batch.data_, i);
+    };
+    jobs[i].data_ = const_cast<BatchType*>(&batch);
+    jobs[i].index_ = i;
+  }
+
+  // 첫 묶음은 다른 스레드가 훔쳐 가는 동안 호출 스레드가 바로 실행합니다
+  CounterType counter{};
+  Run(jobs + 1, batch.batch_count_ - 1, &counter);
+  jobs[0].function_(jobs[0].data_, jobs[0].index_);
+  Wait(&counter);
+}
+
+void JobSystemClass::WorkerLoop(const uint32_t index) {
+  PROFILE_THREAD_NAME("Job worker");
+  current_system = this;
+  current_worker = index;
+
+  uint32_t victim = index;
+  uint32_t idle = 0;
+  while (true) {
+    JobType* job = TakeJob(index, victim);
+    if (job) {
+      Execute(job);
+      idle = 0;
+      continue;
+    }
+
+    // 잠시 돌면서 찾아보고, 그래도 없으면 새 작업이 들어올 때까지 잡니다
+    if (++idle < SPIN_COUNT) {
+      std::this_thread::yield();
+      continue;
+    }
+    idle = 0;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleeping_.fetch_add(1, std::memory_order_seq_cst);
+    wake_.wait(lock, [this] {
+      return stop_ || pending_.load(std::memory_order_seq_cst) > 0;
+    });
+    sleeping_.fetch_sub(1, std::memory_order_relaxed);
+    if (stop_) return;
+  }
+}
+
+uint32_t JobSystemClass::GetWorkerIndex() {
+  return current_system == this ? current_worker : 0;
+}
+
+JobSystemClass::JobType* JobSystemClass::TakeJob(const uint32_t index,
+                                                 uint32_t& victim) {
+  // 자기 deque 에서 가장 최근에 넣은 작업부터 꺼냅니다
+  JobType* job = nullptr;
+  if (index == 0) {
+    std::lock_guard<std::mutex> lock(external_mutex_);
+    job = deques_[0]->Pop();
+  } else {
+    job = deques_[index]->Pop();
+  }
+
+  // 없으면 마지막으로 훔쳤던 deque 부터 돌아가며 가장 오래된 작업을
+  // 훔칩니다
+  const uint32_t deque_count = static_cast<uint32_t>(deques_.size());
+  for (uint32_t i = 0; i < deque_count && job == nullptr; i++) {
+    if (victim != index) job = deques_[victim]->Steal();
+    if (job == nullptr) victim = (victim + 1) % deque_count;
+  }
+
+  if (job) pending_.fetch_sub(1, std::memory_order_relaxed);
+  return job;
+}
+
+void JobSystemClass::Execute(JobType* job) {
+  // 카운터를 내리는 순간 기다리던 스레드가 job 을 해제할 수 있으므로
+  // 먼저 읽어 둡니다
+  CounterType* counter = job->counter_;
+  job->function_(job->data_, job->index_);
+  counter->value_.fetch_sub(1, std::memory_order_acq_rel);
+}
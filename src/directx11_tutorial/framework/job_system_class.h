@@ -0,0 +1,111 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 작업 스레드마다 Chase-Lev deque 를 두는 work-stealing 작업 시스템입니다.
+// 작업을 넣은 스레드는 자기 deque 의 아래(LIFO)에서 꺼내고, 할 일이 없는
+// 스레드는 다른 deque 의 위(FIFO)에서 훔쳐 갑니다. 작업의 완료는 카운터로
+// 기다리며, 기다리는 스레드도 다른 작업을 실행하므로 작업 안에서 다시
+// 작업을 넣고 기다려도(중첩 ParallelFor) 교착되지 않습니다.
+// 작업 시스템에 속하지 않은 스레드도 Run, Wait, ParallelFor 를 부를 수
+// 있습니다. 이 스레드들은 mutex 로 보호되는 공용 deque 하나를 함께 씁니다.
+class JobSystemClass {
+ public:
+  // 스레드마다의 deque 크기입니다. 가득 차면 작업을 바로 실행합니다
+  static const uint32_t DEQUE_CAPACITY = 4096;
+  // ParallelFor 가 스레드당 만드는 작업 수와 한 번에 만드는 최대 작업
+  // 수입니다
+  static const uint32_t BATCHES_PER_THREAD = 4;
+  static const uint32_t MAX_BATCHES = 256;
+  // 잠들기 전에 훔칠 작업을 찾아보는 횟수입니다
+  static const uint32_t SPIN_COUNT = 256;
+
+  // 남은 작업 수입니다. 0 이 되면 카운터에 묶인 작업이 모두 끝난 것입니다
+  struct CounterType {
+    std::atomic<uint32_t> value_{0};
+  };
+
+  // function_(data_, index_) 를 실행하는 작업 하나입니다. 작업 시스템은
+  // 작업을 복사하지 않으므로 Wait 이 끝날 때까지 유효해야 합니다
+  struct JobType {
+    void (*function_)(void* data, uint32_t index) = nullptr;
+    void* data_ = nullptr;
+    uint32_t index_ = 0;
+    CounterType* counter_ = nullptr;
+  };
+
+  // thread_count 는 호출 스레드를 제외한 작업 스레드 수입니다. 0 이면 코어
+  // 수보다 하나 적게 만듭니다
+  bool Initialize(uint32_t thread_count = 0);
+  void Shutdown();
+
+  // 작업 스레드와 호출 스레드를 합한 수를 반환합니다
+  uint32_t GetThreadCount();
+
+  // jobs 를 대기열에 넣고 counter 를 jobs 수만큼 올립니다
+  void Run(JobType* jobs, const uint32_t count, CounterType* counter);
+  // counter 가 0 이 될 때까지 대기열의 작업을 실행하며 기다립니다
+  void Wait(CounterType* counter);
+
+  // [0, count) 범위의 각 인덱스에 대해 task 를 병렬로 실행하고, 모든 작업이
+  // 끝날 때까지 기다립니다. 인덱스는 연속된 묶음으로 나눠 작업이 됩니다.
+  // 호출 스레드도 작업에 참여합니다.
+  // task 는 std::function 으로 감싸지 않고 주소로 넘기므로, 람다를 넘겨도
+  // 힙 할당이 없습니다
+  template <typename Task>
+  void ParallelFor(const uint32_t count, const Task& task);
+  // function(data, index) 를 부르는 형태입니다
+  void ParallelFor(const uint32_t count,
+                   void (*function)(const void* data, uint32_t index),
+                   const void* data);
+
+ private:
+  // Lê, Pop, Cohen, Zappa Nardelli 의 "Correct and Efficient Work-Stealing
+  // for Weak Memory Models" 를 따른 고정 크기 Chase-Lev deque 입니다.
+  // Push, Pop 은 소유 스레드만, Steal 은 어느 스레드나 부를 수 있습니다
+  class DequeType {
+   public:
+    bool Push(JobType* job);
+    JobType* Pop();
+    JobType* Steal();
+
+   private:
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<JobType*> jobs_[DEQUE_CAPACITY]{};
+  };
+
+  void WorkerLoop(const uint32_t index);
+  // 현재 스레드의 deque 번호입니다. 작업 스레드가 아니면 공용 deque 인 0
+  uint32_t GetWorkerIndex();
+  JobType* TakeJob(const uint32_t index, uint32_t& victim);
+  void Execute(JobType* job);
+
+  // 0 번은 작업 스레드가 아닌 스레드들의 공용 deque 입니다
+  std::vector<std::unique_ptr<DequeType>> deques_;
+  std::mutex external_mutex_;
+  std::vector<std::thread> workers_;
+
+  // 대기열에 남은 작업 수와 잠든 작업 스레드 수입니다
+  std::atomic<uint32_t> pending_{0};
+  std::atomic<uint32_t> sleeping_{0};
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+};
+
+template <typename Task>
+void JobSystemClass::ParallelFor(const uint32_t count, const Task& task) {
+  ParallelFor(
+      count,
+      [](const void* data, uint32_t index) {
+        (*static_cast<const Task*>(data))(index);
+      },
+      &task);
+}
@@ -0,0 +1,89 @@
+#include "pch.h"
+#include "mapped_file_class.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFileClass::~MappedFileClass() { Close(); }
+
+bool MappedFileClass::Open(const std::filesystem::path& path) {
+  Close();
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) return false;
+  file_ = file;
+
+  LARGE_INTEGER size{};
+  if (GetFileSizeEx(file, &size) == FALSE || size.QuadPart == 0) {
+    Close();
+    return false;
+  }
+  size_ = static_cast<uint64_t>(size.QuadPart);
+
+  mapping_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping_ == nullptr) {
+    Close();
+    return false;
+  }
+
+  data_ = static_cast<const uint8_t*>(
+      MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+#else
+  const int file = open(path.c_str(), O_RDONLY);
+  if (file < 0) return false;
+
+  struct stat status {};
+  if (fstat(file, &status) != 0 || status.st_size == 0) {
+    close(file);
+    return false;
+  }
+  size_ = static_cast<uint64_t>(status.st_size);
+
+  // 매핑은 파일 디스크립터를 닫아도 유지됩니다
+  void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);
+  if (data != MAP_FAILED) {
+    madvise(data, size_, MADV_WILLNEED);
+    data_ = static_cast<const uint8_t*>(data);
+  }
+#endif
+
+  if (data_ == nullptr) {
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+void MappedFileClass::Close() {
+#if defined(_WIN32)
+  if (data_) UnmapViewOfFile(data_);
+
+  if (mapping_) {
+    CloseHandle(mapping_);
+    mapping_ = nullptr;
+  }
+
+  if (file_) {
+    CloseHandle(file_);
+    file_ = nullptr;
+  }
+#else
+  if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+
+  data_ = nullptr;
+  size_ = 0;
+}
+
+const uint8_t* MappedFileClass::GetData() { return data_; }
+
+uint64_t MappedFileClass::GetSize() { return size_; }
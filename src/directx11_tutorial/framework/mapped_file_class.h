@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+
+// 파일 전체를 읽기 전용으로 메모리에 매핑합니다. 페이지는 처음 접근할 때
+// 읽혀 들어옵니다. Windows 와 POSIX 에서 같은 인터페이스로 동작합니다.
+class MappedFileClass {
+ public:
+  MappedFileClass() = default;
+  MappedFileClass(const MappedFileClass&) = delete;
+  MappedFileClass& operator=(const MappedFileClass&) = delete;
+  ~MappedFileClass();
+
+  bool Open(const std::filesystem::path& path);
+  void Close();
+
+  const uint8_t* GetData();
+  uint64_t GetSize();
+
+ private:
+  const uint8_t* data_ = nullptr;
+  uint64_t size_ = 0;
+#if defined(_WIN32)
+  void* file_ = nullptr;
+  void* mapping_ = nullptr;
+#endif
+};
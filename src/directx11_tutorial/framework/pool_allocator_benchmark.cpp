@@ -0,0 +1,52 @@
+#include "pch.h"
+#include "engine_benchmarks.h"
+
+#include <DirectXMath.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark_class.h"
+#include "pool_allocator_class.h"
+
+void RegisterPoolAllocatorBenchmarks(BenchmarkClass& benchmark) {
+  // 작은 객체 1000 개를 만들고 없애기. 고정 크기 풀과 new/delete 를
+  // 비교합니다
+  for (const bool pooled : {false, true}) {
+    const uint32_t object_count = 1000;
+    const std::string name = "PoolAllocatorClass/" +
+                             std::to_string(object_count) +
+                             (pooled ? "/pool" : "/new");
+
+    benchmark.AddFixture(name, object_count, [pooled, object_count] {
+      struct ObjectType {
+        DirectX::XMFLOAT4X4 world_;
+        uint32_t id_;
+      };
+      struct DataType {
+        PoolAllocatorClass<ObjectType> pool_;
+        std::vector<ObjectType*> objects_;
+      };
+      auto data = std::make_shared<DataType>();
+      data->pool_.Initialize(object_count);
+      data->objects_.resize(object_count);
+
+      return BenchmarkClass::BodyType([data, pooled](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+          uint32_t id = 0;
+          for (ObjectType*& object : data->objects_)
+            object = pooled ? data->pool_.Create(ObjectType{{}, id++})
+                            : new ObjectType{{}, id++};
+          BenchmarkClass::DoNotOptimize(data->objects_);
+          for (ObjectType* object : data->objects_) {
+            if (pooled)
+              data->pool_.Destroy(object);
+            else
+              delete object;
+          }
+        }
+      });
+    });
+  }
+}
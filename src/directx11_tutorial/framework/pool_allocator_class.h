@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// 같은 타입의 작은 객체를 고정 크기 슬롯에서 만들고 없애는 풀입니다.
+// 슬롯은 BLOCK_SIZE 개씩 묶음으로 받아 두고, 비운 슬롯은 자유 목록으로
+// 다시 씁니다. 묶음은 Shutdown 까지 해제하지 않으므로 객체의 주소는 바뀌지
+// 않고, 미리 받아 둔 만큼은 Create/Destroy 가 힙을 쓰지 않습니다.
+// 스레드 안전하지 않습니다.
+template <typename T, uint32_t BLOCK_SIZE = 64>
+class PoolAllocatorClass {
+ public:
+  PoolAllocatorClass() = default;
+  PoolAllocatorClass(const PoolAllocatorClass&) = delete;
+  PoolAllocatorClass& operator=(const PoolAllocatorClass&) = delete;
+  ~PoolAllocatorClass() { Shutdown(); }
+
+  // 슬롯을 적어도 reserve_count 개 받아 둡니다
+  bool Initialize(const uint32_t reserve_count);
+  // 아직 살아 있는 객체가 없어야 합니다
+  void Shutdown();
+
+  template <typename... Args>
+  T* Create(Args&&... args);
+  void Destroy(T* object);
+
+  uint32_t GetLiveCount() { return live_count_; }
+  uint32_t GetCapacity() {
+    return static_cast<uint32_t>(blocks_.size()) * BLOCK_SIZE;
+  }
+
+ private:
+  // 빈 슬롯은 다음 빈 슬롯을 가리킵니다
+  union SlotType {
+    SlotType* next_;
+    alignas(T) unsigned char storage_[sizeof(T)];
+  };
+
+  void AddBlock();
+
+  std::vector<std::unique_ptr<SlotType[]>> blocks_;
+  SlotType* free_list_ = nullptr;
+  uint32_t live_count_ = 0;
+};
+
+template <typename T, uint32_t BLOCK_SIZE>
+bool PoolAllocatorClass<T, BLOCK_SIZE>::Initialize(
+    const uint32_t reserve_count) {
+  while (GetCapacity() < reserve_count) AddBlock();
+  return true;
+}
+
+template <typename T, uint32_t BLOCK_SIZE>
+void PoolAllocatorClass<T, BLOCK_SIZE>::Shutdown() {
+  blocks_.clear();
+  free_list_ = nullptr;
+  live_count_ = 0;
+}
+
+template <typename T, uint32_t BLOCK_SIZE>
+template <typename... Args>
+T* PoolAllocatorClass<T, BLOCK_SIZE>::Create(Args&&... args) {
+  if (free_list_ == nullptr) AddBlock();
+
+  SlotType* slot = free_list_;
+  free_list_ = slot->next_;
+  live_count_++;
+  return new (slot->storage_) T(std::forward<Args>(args)...);
+}
+
+template <typename T, uint32_t BLOCK_SIZE>
+void PoolAllocatorClass<T, BLOCK_SIZE>::Destroy(T* object) {
+  if (object == nullptr) return;
+
+  object->~T();
+  SlotType* slot = reinterpret_cast<SlotType*>(object);
+  slot->next_ = free_list_;
+  free_list_ = slot;
+  live_count_--;
+}
+
+template <typename T, uint32_t BLOCK_SIZE>
+void PoolAllocatorClass<T, BLOCK_SIZE>::AddBlock() {
+  blocks_.push_back(std::make_unique<SlotType[]>(BLOCK_SIZE));
+  SlotType* block = blocks_.back().get();
+  // 앞 슬롯부터 꺼내 쓰도록 뒤에서부터 목록에 넣습니다
+  for (uint32_t i = BLOCK_SIZE; i > 0; i--) {
+    block[i - 1].next_ = free_list_;
+    free_list_ = &block[i - 1];
+  }
+}
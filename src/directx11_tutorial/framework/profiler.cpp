@@ -0,0 +1,149 @@
+#include "pch.h"
+#include "profiler.h"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace profiler {
+namespace {
+// 스레드마다 하나씩 있는 단일 생산자 링 버퍼입니다. 기록하는 쪽은 잠금 없이
+// 쓰고, 덤프하는 쪽은 head_ 를 다시 읽어 덮어쓰인 구간을 버립니다.
+class ThreadBuffer {
+ public:
+  static const uint32_t CAPACITY = 1 << 16;
+
+  struct EventType {
+    std::atomic<const char*> name_{nullptr};
+    std::atomic<int64_t> begin_{0};
+    std::atomic<int64_t> end_{0};
+  };
+
+  explicit ThreadBuffer(uint32_t thread_id) : thread_id_(thread_id) {}
+
+  void Push(const char* name, int64_t begin, int64_t end) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    EventType& event = events_[head & (CAPACITY - 1)];
+    // 덤프하는 쪽이 이 칸의 새 값을 읽었다면 head_ 가 이미 이 칸을 덮어쓰는
+    // 값(head)임도 보도록, 칸을 쓰기 전에 release 펜스를 둡니다 (seqlock)
+    std::atomic_thread_fence(std::memory_order_release);
+    event.name_.store(name, std::memory_order_relaxed);
+    event.begin_.store(begin, std::memory_order_relaxed);
+    event.end_.store(end, std::memory_order_relaxed);
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  uint32_t thread_id_;
+  std::atomic<const char*> thread_name_{nullptr};
+  std::atomic<uint64_t> head_{0};
+  EventType events_[CAPACITY];
+};
+
+std::mutex registry_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> registry;
+thread_local ThreadBuffer* thread_buffer = nullptr;
+
+ThreadBuffer* GetThreadBuffer() {
+  // 스레드의 첫 기록에서만 잠금을 잡고 버퍼를 등록합니다
+  if (thread_buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    registry.push_back(std::make_unique<ThreadBuffer>(
+        static_cast<uint32_t>(registry.size() + 1)));
+    thread_buffer = registry.back().get();
+  }
+
+  return thread_buffer;
+}
+
+ThreadBuffer* GetGpuBuffer() {
+  // GPU 구간은 기록하는 스레드와 상관없이 이름 붙인 트랙 하나에 모읍니다
+  static ThreadBuffer* gpu_buffer = [] {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    registry.push_back(std::make_unique<ThreadBuffer>(
+        static_cast<uint32_t>(registry.size() + 1)));
+    registry.back()->thread_name_.store("GPU", std::memory_order_relaxed);
+    return registry.back().get();
+  }();
+
+  return gpu_buffer;
+}
+
+void WriteEscaped(std::ofstream& file, const char* text) {
+  for (; *text; text++) {
+    if (*text == '"' || *text == '\\') file << '\\';
+    file << *text;
+  }
+}
+}  // namespace
+
+void Record(const char* name, int64_t begin, int64_t end) {
+  GetThreadBuffer()->Push(name, begin, end);
+}
+
+void RecordGpu(const char* name, int64_t begin, int64_t end) {
+  GetGpuBuffer()->Push(name, begin, end);
+}
+
+void SetThreadName(const char* name) {
+  GetThreadBuffer()->thread_name_.store(name, std::memory_order_relaxed);
+}
+
+bool WriteChromeTrace(const std::filesystem::path& path) {
+  std::ofstream file(path);
+  if (!file) return false;
+
+  std::lock_guard<std::mutex> lock(registry_mutex);
+
+  file << std::fixed << std::setprecision(3);
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  bool first = true;
+
+  for (const std::unique_ptr<ThreadBuffer>& buffer : registry) {
+    const char* thread_name =
+        buffer->thread_name_.load(std::memory_order_relaxed);
+    if (thread_name) {
+      file << (first ? "" : ",\n")
+           << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+           << buffer->thread_id_ << ",\"args\":{\"name\":\"";
+      WriteEscaped(file, thread_name);
+      file << "\"}}";
+      first = false;
+    }
+
+    // 링 버퍼에 남아 있는 가장 최근 구간들만 씁니다
+    const uint64_t head = buffer->head_.load(std::memory_order_acquire);
+    const uint64_t tail =
+        head > ThreadBuffer::CAPACITY ? head - ThreadBuffer::CAPACITY : 0;
+
+    for (uint64_t i = tail; i < head; i++) {
+      const ThreadBuffer::EventType& event =
+          buffer->events_[i & (ThreadBuffer::CAPACITY - 1)];
+      const char* name = event.name_.load(std::memory_order_relaxed);
+      const int64_t begin = event.begin_.load(std::memory_order_relaxed);
+      const int64_t end = event.end_.load(std::memory_order_relaxed);
+
+      // 읽는 동안 기록하는 스레드가 이 칸을 덮어썼거나 덮어쓰는 중이면
+      // 버립니다. 칸 i 는 head_ 가 i + CAPACITY 일 때부터 다시 쓰입니다
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (buffer->head_.load(std::memory_order_relaxed) >=
+          i + ThreadBuffer::CAPACITY)
+        continue;
+      if (name == nullptr) continue;
+
+      file << (first ? "" : ",\n") << "{\"name\":\"";
+      WriteEscaped(file, name);
+      file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id_
+           << ",\"ts\":" << static_cast<double>(begin) / 1000.0
+           << ",\"dur\":" << static_cast<double>(end - begin) / 1000.0 << "}";
+      first = false;
+    }
+  }
+
+  file << "\n]}\n";
+  return file.good();
+}
+}  // namespace profiler
@@ -0,0 +1,61 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+// Debug 빌드 또는 ENABLE_PROFILER 를 정의한 빌드에서만 프로파일 구간을
+// 기록합니다. 그 외 빌드에서는 PROFILE_* 매크로가 아무 코드도 만들지 않습니다.
+#if defined(_DEBUG) || defined(ENABLE_PROFILER)
+#define PROFILER_ENABLED 1
+#else
+#define PROFILER_ENABLED 0
+#endif
+
+namespace profiler {
+// 나노초 단위의 단조 증가 시각을 반환합니다
+inline int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// 현재 스레드의 링 버퍼에 구간 하나를 기록합니다. name 은 프로그램이 끝날
+// 때까지 유효한 문자열(리터럴)이어야 합니다
+void Record(const char* name, int64_t begin, int64_t end);
+
+// GPU 트랙에 구간 하나를 기록합니다. 시각은 Now() 기준으로 바꾼 값이어야
+// 하고, 한 스레드에서만 부릅니다
+void RecordGpu(const char* name, int64_t begin, int64_t end);
+
+// 현재 스레드의 트레이스 표시 이름을 지정합니다
+void SetThreadName(const char* name);
+
+// 기록된 모든 스레드의 구간을 chrome://tracing / Perfetto 용 JSON 으로 씁니다
+bool WriteChromeTrace(const std::filesystem::path& path);
+
+class ScopedZone {
+ public:
+  explicit ScopedZone(const char* name) : name_(name), begin_(Now()) {}
+  ~ScopedZone() { Record(name_, begin_, Now()); }
+
+  ScopedZone(const ScopedZone&) = delete;
+  ScopedZone& operator=(const ScopedZone&) = delete;
+
+ private:
+  const char* name_;
+  int64_t begin_;
+};
+}  // namespace profiler
+
+#if PROFILER_ENABLED
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) \
+  ::profiler::ScopedZone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_THREAD_NAME(name) ::profiler::SetThreadName(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
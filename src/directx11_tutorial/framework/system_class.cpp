@@ -2,6 +2,7 @@
 #include "system_class.h"
 
 #include "input_class.h"
+#include "profiler.h"
 #include "graphic/graphics_class.h"
 
 bool SystemClass::Initialize() {
@@ -37,6 +38,8 @@ void SystemClass::Shutdown() {
 void SystemClass::Run() {
   MSG msg{};
 
+  PROFILE_THREAD_NAME("Main");
+
   while (true) {
     if (::PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
       if (msg.message == WM_QUIT) break;
@@ -70,6 +73,17 @@ LRESULT CALLBACK SystemClass::MessageHandler(HWND hwnd, UINT umsg,
 bool SystemClass::Frame() {
   if (input_->IsKeyDown(VK_ESCAPE)) return false;
 
+  // 표시 방식을 바꿉니다
+  if (input_->IsKeyDown(VK_F1))
+    graphics_->SetPresentMode(PresenterClass::ModeType::VSYNC,
+                              FRAME_RATE_LIMIT);
+  else if (input_->IsKeyDown(VK_F2))
+    graphics_->SetPresentMode(PresenterClass::ModeType::UNCAPPED,
+                              FRAME_RATE_LIMIT);
+  else if (input_->IsKeyDown(VK_F3))
+    graphics_->SetPresentMode(PresenterClass::ModeType::CAPPED,
+                              FRAME_RATE_LIMIT);
+
   return graphics_->Frame();
 }
 
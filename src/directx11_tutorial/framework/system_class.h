@@ -18,9 +18,9 @@ class SystemClass {
   void InitialzieWindows(int32_t& width, int32_t& height);
   void ShutdownWindows();
 
-  LPCWSTR app_name_;
-  HINSTANCE hinstance_;
-  HWND hwnd_;
+  LPCWSTR app_name_ = nullptr;
+  HINSTANCE hinstance_ = nullptr;
+  HWND hwnd_ = nullptr;
 
   InputClass* input_ = nullptr;
   GraphicsClass* graphics_ = nullptr;
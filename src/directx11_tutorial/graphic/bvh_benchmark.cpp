@@ -0,0 +1,98 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <DirectXMath.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "framework/benchmark_class.h"
+#include "graphic/bvh_class.h"
+#include "graphic/frustum_class.h"
+
+void RegisterBvhBenchmarks(BenchmarkClass& benchmark) {
+  // 무작위로 흩어진 물체를 BVH 와 선형 검사로 절두체 컬링하기
+  for (const uint32_t count : {100000u, 1000000u}) {
+    struct DataType {
+      std::vector<BvhClass::BoundsType> bounds_;
+      BvhClass bvh_;
+      FrustumClass frustum_;
+      std::vector<uint32_t> visible_;
+      ~DataType() { bvh_.Shutdown(); }
+    };
+    auto make_data = [count] {
+      auto data = std::make_shared<DataType>();
+
+      std::mt19937 random(1234);
+      std::uniform_real_distribution<float> distribution(-500.0f, 500.0f);
+      data->bounds_.resize(count);
+      for (BvhClass::BoundsType& bounds : data->bounds_) {
+        const DirectX::XMFLOAT3 center{distribution(random),
+                                       distribution(random),
+                                       distribution(random)};
+        bounds.min_ = {center.x - 1.0f, center.y - 1.0f, center.z - 1.0f};
+        bounds.max_ = {center.x + 1.0f, center.y + 1.0f, center.z + 1.0f};
+      }
+      data->bvh_.Build(data->bounds_.data(), count);
+
+      const DirectX::XMMATRIX view = DirectX::XMMatrixLookAtLH(
+          DirectX::XMVectorSet(0.0f, 0.0f, -600.0f, 1.0f),
+          DirectX::XMVectorZero(),
+          DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+      const DirectX::XMMATRIX projection = DirectX::XMMatrixPerspectiveFovLH(
+          DirectX::XM_PI / 4.0f, 4.0f / 3.0f, 0.1f, 1000.0f);
+      data->frustum_.ConstructFrustum(view * projection);
+      return data;
+    };
+
+    const std::string suffix = "/" + std::to_string(count);
+
+    benchmark.AddFixture("BvhClass::Cull" + suffix, count, [make_data] {
+      auto data = make_data();
+      return BenchmarkClass::BodyType([data](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+          data->bvh_.Cull(data->frustum_, data->visible_);
+          BenchmarkClass::DoNotOptimize(data->visible_);
+        }
+      });
+    });
+
+    benchmark.AddFixture(
+        "FrustumClass::CheckBox/linear" + suffix, count, [make_data, count] {
+          auto data = make_data();
+          return BenchmarkClass::BodyType([data, count](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; i++) {
+              data->visible_.clear();
+              for (uint32_t n = 0; n < count; n++) {
+                const BvhClass::BoundsType& bounds = data->bounds_[n];
+                if (data->frustum_.CheckBox(bounds.min_, bounds.max_))
+                  data->visible_.push_back(n);
+              }
+              BenchmarkClass::DoNotOptimize(data->visible_);
+            }
+          });
+        });
+
+    // 매 반복마다 1% 의 물체를 움직이고 바뀐 경로만 다시 맞추기
+    benchmark.AddFixture(
+        "BvhClass::Refit" + suffix + "/dirty1%", count / 100,
+        [make_data, count] {
+          auto data = make_data();
+          return BenchmarkClass::BodyType([data, count](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; i++) {
+              const float offset = (i & 1) ? 0.5f : -0.5f;
+              for (uint32_t n = 0; n < count; n += 100) {
+                BvhClass::BoundsType& bounds = data->bounds_[n];
+                bounds.min_.x += offset;
+                bounds.max_.x += offset;
+                data->bvh_.UpdateBounds(n, bounds);
+              }
+              data->bvh_.Refit();
+            }
+            BenchmarkClass::DoNotOptimize(data->bvh_);
+          });
+        });
+  }
+}
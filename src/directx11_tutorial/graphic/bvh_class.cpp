@@ -0,0 +1,359 @@
+#include "pch.h"
+#include "bvh_class.h"
+
+#if !defined(_XM_NO_INTRINSICS_)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "frustum_class.h"
+#include "framework/profiler.h"
+
+BvhClass::BoundsType BvhClass::TransformBounds(
+    const BoundsType& bounds, const DirectX::XMMATRIX& world) {
+  DirectX::XMFLOAT4X4 matrix{};
+  DirectX::XMStoreFloat4x4(&matrix, world);
+
+  const float center[3] = {(bounds.min_.x + bounds.max_.x) * 0.5f,
+                           (bounds.min_.y + bounds.max_.y) * 0.5f,
+                           (bounds.min_.z + bounds.max_.z) * 0.5f};
+  const float extents[3] = {(bounds.max_.x - bounds.min_.x) * 0.5f,
+                            (bounds.max_.y - bounds.min_.y) * 0.5f,
+                            (bounds.max_.z - bounds.min_.z) * 0.5f};
+
+  // 중심은 그대로 변환하고, 반지름은 행렬 성분의 절댓값으로 넓힙니다
+  float result_center[3]{}, result_extents[3]{};
+  for (int32_t column = 0; column < 3; column++) {
+    result_center[column] = matrix.m[3][column];
+    for (int32_t row = 0; row < 3; row++) {
+      result_center[column] += center[row] * matrix.m[row][column];
+      result_extents[column] +=
+          extents[row] * std::fabs(matrix.m[row][column]);
+    }
+  }
+
+  BoundsType result{};
+  result.min_ = {result_center[0] - result_extents[0],
+                 result_center[1] - result_extents[1],
+                 result_center[2] - result_extents[2]};
+  result.max_ = {result_center[0] + result_extents[0],
+                 result_center[1] + result_extents[1],
+                 result_center[2] + result_extents[2]};
+  return result;
+}
+
+bool BvhClass::Build(const BoundsType* bounds, const uint32_t count) {
+  PROFILE_FUNCTION();
+
+  Shutdown();
+  if (count == 0) return true;
+
+  bounds_.assign(bounds, bounds + count);
+  centers_.resize(count);
+  order_.resize(count);
+  object_node_.resize(count);
+  object_slot_.resize(count);
+  for (uint32_t i = 0; i < count; i++) {
+    centers_[i] = {(bounds[i].min_.x + bounds[i].max_.x) * 0.5f,
+                   (bounds[i].min_.y + bounds[i].max_.y) * 0.5f,
+                   (bounds[i].min_.z + bounds[i].max_.z) * 0.5f};
+    order_[i] = i;
+  }
+
+  // 자식 노드는 항상 부모보다 뒤에 만들어집니다. Refit 이 이 순서에 기댑니다
+  nodes_.reserve(count / 2 + 1);
+  BuildNode(-1, 0, 0, count);
+  return true;
+}
+
+void BvhClass::Shutdown() {
+  nodes_.clear();
+  order_.clear();
+  bounds_.clear();
+  centers_.clear();
+  object_node_.clear();
+  object_slot_.clear();
+  dirty_nodes_.clear();
+  stack_.clear();
+}
+
+void BvhClass::UpdateBounds(const uint32_t object, const BoundsType& bounds) {
+  bounds_[object] = bounds;
+
+  const int32_t node = object_node_[object];
+  SetSlot(nodes_[node], object_slot_[object], bounds);
+  MarkDirty(node);
+}
+
+void BvhClass::Refit() {
+  PROFILE_FUNCTION();
+
+  // 인덱스가 큰 노드(자식)부터 꺼내 부모의 슬롯 상자를 갱신합니다.
+  // 상자가 그대로면 그 위로는 올라가지 않습니다
+  while (dirty_nodes_.empty() == false) {
+    std::pop_heap(dirty_nodes_.begin(), dirty_nodes_.end());
+    const int32_t index = dirty_nodes_.back();
+    dirty_nodes_.pop_back();
+
+    NodeType& node = nodes_[index];
+    node.dirty_ = false;
+    if (node.parent_ < 0) continue;
+
+    const BoundsType bounds = GetNodeBounds(node);
+    NodeType& parent = nodes_[node.parent_];
+    const uint32_t slot = node.parent_slot_;
+    if (parent.min_x_[slot] == bounds.min_.x &&
+        parent.min_y_[slot] == bounds.min_.y &&
+        parent.min_z_[slot] == bounds.min_.z &&
+        parent.max_x_[slot] == bounds.max_.x &&
+        parent.max_y_[slot] == bounds.max_.y &&
+        parent.max_z_[slot] == bounds.max_.z)
+      continue;
+
+    SetSlot(parent, slot, bounds);
+    MarkDirty(node.parent_);
+  }
+}
+
+void BvhClass::Cull(FrustumClass& frustum, std::vector<uint32_t>& visible) {
+  PROFILE_FUNCTION();
+
+  visible.clear();
+  if (nodes_.empty()) return;
+
+  const DirectX::XMFLOAT4* planes = frustum.GetPlanes();
+
+  stack_.clear();
+  stack_.push_back(0);
+  while (stack_.empty() == false) {
+    const NodeType& node = nodes_[stack_.back()];
+    stack_.pop_back();
+
+    uint32_t inside_mask = 0;
+    const uint32_t visible_mask =
+        TestNode(node, planes, FrustumClass::PLANE_COUNT, inside_mask);
+
+    for (uint32_t slot = 0; slot < WIDTH; slot++) {
+      if ((visible_mask & (1u << slot)) == 0) continue;
+
+      // 완전히 안에 있거나 물체 하나면 그 아래 물체를 더 검사하지 않고 넣습니다
+      if ((inside_mask & (1u << slot)) || node.child_[slot] < 0) {
+        const uint32_t* first = &order_[node.first_[slot]];
+        visible.insert(visible.end(), first, first + node.count_[slot]);
+      } else {
+        stack_.push_back(node.child_[slot]);
+      }
+    }
+  }
+}
+
+uint32_t BvhClass::GetNodeCount() {
+  return static_cast<uint32_t>(nodes_.size());
+}
+
+uint32_t BvhClass::GetObjectCount() {
+  return static_cast<uint32_t>(order_.size());
+}
+
+int32_t BvhClass::BuildNode(const int32_t parent, const uint32_t parent_slot,
+                            const uint32_t begin, const uint32_t end) {
+  const int32_t index = static_cast<int32_t>(nodes_.size());
+
+  // 빈 슬롯은 뒤집힌 상자라서 어떤 평면 검사도 통과하지 못합니다
+  NodeType empty{};
+  for (uint32_t slot = 0; slot < WIDTH; slot++) {
+    SetSlot(empty, slot, BoundsType{{FLT_MAX, FLT_MAX, FLT_MAX},
+                                    {-FLT_MAX, -FLT_MAX, -FLT_MAX}});
+    empty.child_[slot] = -1;
+  }
+  empty.parent_ = parent;
+  empty.parent_slot_ = parent_slot;
+  empty.dirty_ = false;
+  nodes_.push_back(empty);
+
+  // 물체가 4개 이하면 하나씩, 아니면 두 번 반으로 나눠 네 덩어리로 만듭니다
+  uint32_t ranges[WIDTH + 1]{};
+  uint32_t range_count = 0;
+  if (end - begin <= WIDTH) {
+    for (uint32_t i = begin; i <= end; i++) ranges[range_count++] = i;
+    range_count--;
+  } else {
+    uint32_t middle = 0, left = 0, right = 0;
+    SplitRange(begin, end, middle);
+    SplitRange(begin, middle, left);
+    SplitRange(middle, end, right);
+    ranges[0] = begin;
+    ranges[1] = left;
+    ranges[2] = middle;
+    ranges[3] = right;
+    ranges[4] = end;
+    range_count = WIDTH;
+  }
+
+  for (uint32_t slot = 0; slot < range_count; slot++) {
+    const uint32_t first = ranges[slot];
+    const uint32_t count = ranges[slot + 1] - first;
+    if (count == 0) continue;
+
+    int32_t child = 0;
+    BoundsType bounds{};
+    if (count == 1) {
+      const uint32_t object = order_[first];
+      child = ~static_cast<int32_t>(object);
+      bounds = bounds_[object];
+      object_node_[object] = index;
+      object_slot_[object] = static_cast<uint8_t>(slot);
+    } else {
+      child = BuildNode(index, slot, first, first + count);
+      bounds = GetNodeBounds(nodes_[child]);
+    }
+
+    // 재귀 중에 nodes_ 가 다시 할당될 수 있어 여기서 다시 참조합니다
+    NodeType& node = nodes_[index];
+    node.child_[slot] = child;
+    node.first_[slot] = first;
+    node.count_[slot] = count;
+    SetSlot(node, slot, bounds);
+  }
+
+  return index;
+}
+
+void BvhClass::SplitRange(const uint32_t begin, const uint32_t end,
+                          uint32_t& middle) {
+  // 중심점이 가장 넓게 퍼진 축의 중앙값으로 나눕니다
+  DirectX::XMFLOAT3 min{FLT_MAX, FLT_MAX, FLT_MAX};
+  DirectX::XMFLOAT3 max{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+  for (uint32_t i = begin; i < end; i++) {
+    const DirectX::XMFLOAT3& center = centers_[order_[i]];
+    min = {(std::min)(min.x, center.x), (std::min)(min.y, center.y),
+           (std::min)(min.z, center.z)};
+    max = {(std::max)(max.x, center.x), (std::max)(max.y, center.y),
+           (std::max)(max.z, center.z)};
+  }
+
+  const float extent[3] = {max.x - min.x, max.y - min.y, max.z - min.z};
+  const int32_t axis = extent[0] > extent[1]
+                           ? (extent[0] > extent[2] ? 0 : 2)
+                           : (extent[1] > extent[2] ? 1 : 2);
+
+  middle = begin + (end - begin) / 2;
+  std::nth_element(order_.begin() + begin, order_.begin() + middle,
+                   order_.begin() + end, [this, axis](uint32_t a, uint32_t b) {
+                     const DirectX::XMFLOAT3& ca = centers_[a];
+                     const DirectX::XMFLOAT3& cb = centers_[b];
+                     return (&ca.x)[axis] < (&cb.x)[axis];
+                   });
+}
+
+void BvhClass::SetSlot(NodeType& node, const uint32_t slot,
+                       const BoundsType& bounds) {
+  node.min_x_[slot] = bounds.min_.x;
+  node.min_y_[slot] = bounds.min_.y;
+  node.min_z_[slot] = bounds.min_.z;
+  node.max_x_[slot] = bounds.max_.x;
+  node.max_y_[slot] = bounds.max_.y;
+  node.max_z_[slot] = bounds.max_.z;
+}
+
+BvhClass::BoundsType BvhClass::GetNodeBounds(const NodeType& node) {
+  BoundsType bounds{{FLT_MAX, FLT_MAX, FLT_MAX},
+                    {-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+  for (uint32_t slot = 0; slot < WIDTH; slot++) {
+    if (node.count_[slot] == 0) continue;
+
+    bounds.min_.x = (std::min)(bounds.min_.x, node.min_x_[slot]);
+    bounds.min_.y = (std::min)(bounds.min_.y, node.min_y_[slot]);
+    bounds.min_.z = (std::min)(bounds.min_.z, node.min_z_[slot]);
+    bounds.max_.x = (std::max)(bounds.max_.x, node.max_x_[slot]);
+    bounds.max_.y = (std::max)(bounds.max_.y, node.max_y_[slot]);
+    bounds.max_.z = (std::max)(bounds.max_.z, node.max_z_[slot]);
+  }
+
+  return bounds;
+}
+
+void BvhClass::MarkDirty(const int32_t node) {
+  if (nodes_[node].dirty_) return;
+
+  nodes_[node].dirty_ = true;
+  dirty_nodes_.push_back(node);
+  std::push_heap(dirty_nodes_.begin(), dirty_nodes_.end());
+}
+
+uint32_t BvhClass::TestNode(const NodeType& node,
+                            const DirectX::XMFLOAT4* planes,
+                            const uint32_t plane_count,
+                            uint32_t& inside_mask) {
+#if !defined(_XM_NO_INTRINSICS_)
+  const __m128 min_x = _mm_load_ps(node.min_x_);
+  const __m128 min_y = _mm_load_ps(node.min_y_);
+  const __m128 min_z = _mm_load_ps(node.min_z_);
+  const __m128 max_x = _mm_load_ps(node.max_x_);
+  const __m128 max_y = _mm_load_ps(node.max_y_);
+  const __m128 max_z = _mm_load_ps(node.max_z_);
+  const __m128 zero = _mm_setzero_ps();
+
+  __m128 outside = zero;
+  __m128 inside = _mm_cmpeq_ps(zero, zero);
+  for (uint32_t i = 0; i < plane_count; i++) {
+    const DirectX::XMFLOAT4& plane = planes[i];
+    const __m128 normal_x = _mm_set1_ps(plane.x);
+    const __m128 normal_y = _mm_set1_ps(plane.y);
+    const __m128 normal_z = _mm_set1_ps(plane.z);
+    const __m128 distance = _mm_set1_ps(plane.w);
+
+    // 법선 방향으로 가장 먼 꼭짓점(p)과 가장 가까운 꼭짓점(n)입니다
+    const __m128 p_x = plane.x > 0.0f ? max_x : min_x;
+    const __m128 p_y = plane.y > 0.0f ? max_y : min_y;
+    const __m128 p_z = plane.z > 0.0f ? max_z : min_z;
+    const __m128 n_x = plane.x > 0.0f ? min_x : max_x;
+    const __m128 n_y = plane.y > 0.0f ? min_y : max_y;
+    const __m128 n_z = plane.z > 0.0f ? min_z : max_z;
+
+    const __m128 p_distance = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(normal_x, p_x), _mm_mul_ps(normal_y, p_y)),
+        _mm_add_ps(_mm_mul_ps(normal_z, p_z), distance));
+    const __m128 n_distance = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(normal_x, n_x), _mm_mul_ps(normal_y, n_y)),
+        _mm_add_ps(_mm_mul_ps(normal_z, n_z), distance));
+
+    outside = _mm_or_ps(outside, _mm_cmplt_ps(p_distance, zero));
+    inside = _mm_and_ps(inside, _mm_cmpge_ps(n_distance, zero));
+  }
+
+  const uint32_t visible_mask = ~_mm_movemask_ps(outside) & 0xF;
+  inside_mask = _mm_movemask_ps(inside) & visible_mask;
+  return visible_mask;
+#else
+  uint32_t visible_mask = 0;
+  inside_mask = 0;
+  for (uint32_t slot = 0; slot < WIDTH; slot++) {
+    bool outside = false, inside = true;
+    for (uint32_t i = 0; i < plane_count; i++) {
+      const DirectX::XMFLOAT4& plane = planes[i];
+      const float p_distance =
+          plane.x * (plane.x > 0.0f ? node.max_x_[slot] : node.min_x_[slot]) +
+          plane.y * (plane.y > 0.0f ? node.max_y_[slot] : node.min_y_[slot]) +
+          plane.z * (plane.z > 0.0f ? node.max_z_[slot] : node.min_z_[slot]) +
+          plane.w;
+      const float n_distance =
+          plane.x * (plane.x > 0.0f ? node.min_x_[slot] : node.max_x_[slot]) +
+          plane.y * (plane.y > 0.0f ? node.min_y_[slot] : node.max_y_[slot]) +
+          plane.z * (plane.z > 0.0f ? node.min_z_[slot] : node.max_z_[slot]) +
+          plane.w;
+      outside |= p_distance < 0.0f;
+      inside &= n_distance >= 0.0f;
+    }
+
+    if (outside) continue;
+    visible_mask |= 1u << slot;
+    if (inside) inside_mask |= 1u << slot;
+  }
+
+  return visible_mask;
+#endif
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+class FrustumClass;
+
+// 장면 물체의 경계 상자로 만든 4갈래 BVH 입니다. 노드마다 자식 4개의
+// 상자를 성분별 배열로 두어 SIMD 로 한 번에 절두체와 검사합니다.
+// 물체가 움직이면 UpdateBounds 후 Refit 으로 바뀐 경로만 다시 맞춥니다.
+class BvhClass {
+ public:
+  struct BoundsType {
+    DirectX::XMFLOAT3 min_;
+    DirectX::XMFLOAT3 max_;
+  };
+
+  static const uint32_t WIDTH = 4;
+
+  // 모델 공간 상자를 world 로 변환한 뒤 다시 감싸는 축 정렬 상자를 구합니다
+  static BoundsType TransformBounds(const BoundsType& bounds,
+                                    const DirectX::XMMATRIX& world);
+
+  bool Build(const BoundsType* bounds, const uint32_t count);
+  void Shutdown();
+
+  // 물체의 상자를 바꿉니다. 트리는 다음 Refit 에서 갱신됩니다
+  void UpdateBounds(const uint32_t object, const BoundsType& bounds);
+  void Refit();
+
+  // 절두체와 겹치는 물체의 인덱스를 visible 에 채웁니다
+  void Cull(FrustumClass& frustum, std::vector<uint32_t>& visible);
+
+  uint32_t GetNodeCount();
+  uint32_t GetObjectCount();
+
+ private:
+  // child_ 가 0 이상이면 자식 노드, 음수이면 ~child_ 가 물체 인덱스입니다.
+  // first_, count_ 는 order_ 에서 그 자식 아래 물체들의 범위입니다
+  struct alignas(16) NodeType {
+    float min_x_[WIDTH], min_y_[WIDTH], min_z_[WIDTH];
+    float max_x_[WIDTH], max_y_[WIDTH], max_z_[WIDTH];
+    int32_t child_[WIDTH];
+    uint32_t first_[WIDTH];
+    uint32_t count_[WIDTH];
+    int32_t parent_;
+    uint32_t parent_slot_;
+    bool dirty_;
+  };
+
+  int32_t BuildNode(const int32_t parent, const uint32_t parent_slot,
+                    const uint32_t begin, const uint32_t end);
+  void SplitRange(const uint32_t begin, const uint32_t end,
+                  uint32_t& middle);
+  void SetSlot(NodeType& node, const uint32_t slot, const BoundsType& bounds);
+  BoundsType GetNodeBounds(const NodeType& node);
+  void MarkDirty(const int32_t node);
+
+  // 자식 4개를 검사해 겹치는 자식과 완전히 안에 있는 자식의 비트를 구합니다
+  static uint32_t TestNode(const NodeType& node,
+                           const DirectX::XMFLOAT4* planes,
+                           const uint32_t plane_count, uint32_t& inside_mask);
+
+ private:
+  std::vector<NodeType> nodes_;
+  std::vector<uint32_t> order_;
+  std::vector<BoundsType> bounds_;
+  std::vector<DirectX::XMFLOAT3> centers_;
+  std::vector<int32_t> object_node_;
+  std::vector<uint8_t> object_slot_;
+  std::vector<int32_t> dirty_nodes_;
+  std::vector<int32_t> stack_;
+};
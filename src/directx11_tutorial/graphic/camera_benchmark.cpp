@@ -0,0 +1,23 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <DirectXMath.h>
+
+#include "framework/benchmark_class.h"
+#include "graphic/camera_class.h"
+
+void RegisterCameraBenchmarks(BenchmarkClass& benchmark) {
+  // 카메라의 뷰 행렬 재계산
+  benchmark.Add("CameraClass::Render", 1, [](uint64_t iterations) {
+    CameraClass camera{};
+    camera.SetPosition(0.0f, 0.0f, -5.0f);
+    DirectX::XMMATRIX view{};
+
+    for (uint64_t i = 0; i < iterations; i++) {
+      camera.SetRotation(0.0f, static_cast<float>(i & 0xFF), 0.0f);
+      camera.Render();
+      camera.GetViewMatrix(view);
+      BenchmarkClass::DoNotOptimize(view);
+    }
+  });
+}
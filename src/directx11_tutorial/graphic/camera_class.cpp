@@ -1,6 +1,8 @@
 #include "pch.h"
 #include "camera_class.h"
 
+#include "framework/profiler.h"
+
 void CameraClass::SetPosition(const float x, const float y, const float z) {
   position_.x = x;
   position_.y = y;
@@ -18,6 +20,8 @@ DirectX::XMFLOAT3 CameraClass::GetPosition() { return position_; }
 DirectX::XMFLOAT3 CameraClass::GetRotation() { return rotation_; }
 
 void CameraClass::Render() {
+  PROFILE_FUNCTION();
+
   DirectX::XMFLOAT3 up{}, position{}, look_at{};
   DirectX::XMVECTOR up_vector{}, position_vector{}, look_at_vector{};
   float yaw = 0, pitch = 0, roll = 0;
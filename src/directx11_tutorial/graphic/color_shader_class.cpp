@@ -3,19 +3,101 @@
 
 #include <d3dcompiler.h>
 
+#include <format>
+
 #include "com_throw.h"
+#include "constant_ring_allocator_class.h"
+#include "d3d_query_backend_class.h"
+#include "device_context_class.h"
+#include "shader_cache_class.h"
+#include "framework/profiler.h"
+
+namespace {
+// 기본 링 버퍼 크기입니다. 드로우당 256 byte 이므로 16384 드로우를 담습니다
+const uint32_t CONSTANT_RING_SIZE = 4 * 1024 * 1024;
+// 컴파일한 셰이더 bytecode 를 보관하는 디렉터리입니다
+const wchar_t* SHADER_CACHE_DIRECTORY = L"shader/cache";
+
+// ShaderCacheClass::Load 에 넘기는 셰이더 순서입니다
+enum ShaderIndex : uint32_t {
+  COLOR_VERTEX_SHADER = 0,
+  COLOR_PIXEL_SHADER,
+  INSTANCED_VERTEX_SHADER,
+  SHADER_COUNT,
+};
+}  // namespace
+
+bool ColorShaderClass::Initialize(
+    ResourceManagerClass* resources, const bool precomputed_wvp,
+    const ModelClass::VertexFormatType vertex_format,
+    JobSystemClass* job_system) {
+  resources_ = resources;
+  precomputed_wvp_ = precomputed_wvp;
+  error_.clear();
+
+  // 모든 셰이더를 캐시에서 매핑하고, 캐시에 없는 셰이더만 함께 컴파일합니다
+  const ShaderCacheClass::ShaderDescType shaders[SHADER_COUNT] = {
+      {precomputed_wvp ? L"shader/vertex_wvp.hlsl" : L"shader/vertex.hlsl",
+       "ColorVertexShader", "vs_5_0", {}, D3D10_SHADER_ENABLE_STRICTNESS},
+      {L"shader/pixel.hlsl", "ColorPixelShader", "ps_5_0", {},
+       D3D10_SHADER_ENABLE_STRICTNESS},
+      {L"shader/vertex_instanced.hlsl", "ColorVertexShader", "vs_5_0", {},
+       D3D10_SHADER_ENABLE_STRICTNESS},
+  };
+
+  ShaderCacheClass shader_cache{};
+  shader_cache.Initialize(SHADER_CACHE_DIRECTORY, ShaderCacheClass::CompileD3D,
+                          D3D_COMPILER_VERSION);
+  const bool loaded = shader_cache.Load(shaders, SHADER_COUNT, job_system);
+
+  OutputDebugStringA(std::format("Shader cache: {} hit, {} compiled\n",
+                                 shader_cache.GetHitCount(),
+                                 shader_cache.GetMissCount())
+                         .c_str());
+
+  if (loaded == false) {
+    for (uint32_t i = 0; i < SHADER_COUNT; i++)
+      if (shader_cache.GetBytecode(i) == nullptr)
+        AppendShaderError(shader_cache.GetError(i), shaders[i].path_);
+    return false;
+  }
 
-bool ColorShaderClass::Initialize(ID3D11Device* device, const HWND hwnd) {
   // 정점 및 픽셀 셰이더를 초기화 합니다
-  return InitializeShader(device, hwnd, L"shader/vertex.hlsl", L"shader/pixel.hlsl");
+  if (InitializeShader(shader_cache.GetBytecode(COLOR_VERTEX_SHADER),
+                       shader_cache.GetBytecodeSize(COLOR_VERTEX_SHADER),
+                       shader_cache.GetBytecode(COLOR_PIXEL_SHADER),
+                       shader_cache.GetBytecodeSize(COLOR_PIXEL_SHADER),
+                       vertex_format) == false)
+    return false;
+
+  // 같은 메시의 복사본을 한 번에 그리는 인스턴싱 셰이더를 초기화합니다
+  if (InitializeInstancedShader(
+          shader_cache.GetBytecode(INSTANCED_VERTEX_SHADER),
+          shader_cache.GetBytecodeSize(INSTANCED_VERTEX_SHADER),
+          vertex_format) == false)
+    return false;
+
+  // 매핑한 캐시 파일은 셰이더 객체를 만든 뒤에는 필요 없습니다
+  shader_cache.Shutdown();
+
+  // 미리 곱한 행렬 경로에서는 드로우 상수를 링 버퍼에 모아 씁니다
+  if (precomputed_wvp)
+    return InitializeConstantRing(CONSTANT_RING_SIZE);
+
+  return true;
 }
 
-void ColorShaderClass::Shutdown() { ShutdownShader(); }
+void ColorShaderClass::Shutdown() {
+  ShutdownConstantRing();
+  ShutdownShader();
+}
 
-void ColorShaderClass::Render(ID3D11DeviceContext* device_context,
+void ColorShaderClass::Render(DeviceContextClass* device_context,
                               const int32_t index_count,
                               DirectX::XMMATRIX world, DirectX::XMMATRIX view,
                               DirectX::XMMATRIX projection) {
+  PROFILE_FUNCTION();
+
   // 렌더링에 사용할 셰이더 매개 변수를 설정합니다
   SetShaderParameters(device_context, world, view, projection);
 
@@ -23,173 +105,361 @@ void ColorShaderClass::Render(ID3D11DeviceContext* device_context,
   RenderShader(device_context, index_count);
 }
 
-bool ColorShaderClass::InitializeShader(ID3D11Device* device, const HWND hwnd,
-                                        const std::filesystem::path& vs_path,
-                                        const std::filesystem::path& ps_path) {
-  ID3DBlob* error_message = nullptr;
+bool ColorShaderClass::WriteConstants(DeviceContextClass* device_context,
+                                      const DirectX::XMMATRIX* worlds,
+                                      const uint32_t count,
+                                      const DirectX::XMMATRIX& view_projection,
+                                      ConstantSliceType* slices) {
+  PROFILE_FUNCTION();
+
+  if (count == 0) return true;
+
+  const uint32_t stride =
+      ConstantRingAllocatorClass::AlignSize(sizeof(WvpBufferType));
+
+  // count * stride 는 uint32 를 넘을 수 있으므로 64 bit 로 계산합니다.
+  // 버퍼 하나에 담을 수 없는 배치는 그리지 않습니다
+  const uint64_t size = static_cast<uint64_t>(count) * stride;
+  if (size > ConstantRingAllocatorClass::MAX_CAPACITY) return false;
+
+  // 오프셋 바인딩을 쓸 수 없으면 상수를 보관했다가 드로우마다 올립니다
+  if (constant_buffer_offsetting_ == false) {
+    staged_constants_.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+      shader_constants::FillWvpBuffer(&staged_constants_[i], worlds[i],
+                                      view_projection);
+      slices[i].offset_ = i * stride;
+    }
+    return true;
+  }
+
+  // 링 버퍼보다 큰 배치라면 버퍼를 키웁니다
+  if (size > constant_ring_allocator_->GetCapacity()) {
+    uint32_t capacity = 0;
+    ConstantRingAllocatorClass::GrowCapacity(
+        constant_ring_allocator_->GetCapacity(), size, capacity);
+
+    // 이전 링 버퍼는 GPU 가 다 읽을 때까지 관리자가 해제를 미룹니다
+    ShutdownConstantRing();
+    if (InitializeConstantRing(capacity) == false) return false;
 
-  // 정점 셰이더 코드를 컴파일한다
-  ID3DBlob* vertex_shader_buffer = nullptr;
-  if (FAILED(D3DCompileFromFile(vs_path.c_str(), nullptr, nullptr,
-                                "ColorVertexShader", "vs_5_0",
-                                D3D10_SHADER_ENABLE_STRICTNESS, 0,
-                                &vertex_shader_buffer, &error_message))) {
-    if (error_message)
-      OutputShaderErrorMessage(error_message, hwnd, vs_path);
-    else
-      MessageBox(hwnd, vs_path.c_str(), L"Missing Shader File", MB_OK);
+    // 새 버퍼에서 오프셋 바인딩을 쓸 수 없게 됐다면 보관 경로로 씁니다
+    if (constant_buffer_offsetting_ == false)
+      return WriteConstants(device_context, worlds, count, view_projection,
+                            slices);
+  }
 
+  // 모든 드로우의 상수를 위한 연속 영역을 예약하고 한 번만 매핑합니다
+  uint32_t offset = 0;
+  bool discard = false;
+  if (constant_ring_allocator_->Reserve(static_cast<uint32_t>(size), offset,
+                                        discard) == false)
     return false;
+
+  ID3D11Buffer* constant_ring = resources_->Get(constant_ring_);
+  D3D11_MAPPED_SUBRESOURCE mapped_resource{};
+  com::ThrowIfFailed(device_context->GetContext()->Map(
+      constant_ring, 0,
+      discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0,
+      &mapped_resource));
+
+  uint8_t* data = reinterpret_cast<uint8_t*>(mapped_resource.pData) + offset;
+  for (uint32_t i = 0; i < count; i++) {
+    shader_constants::FillWvpBuffer(
+        reinterpret_cast<WvpBufferType*>(data + i * stride), worlds[i],
+        view_projection);
+    slices[i].offset_ = offset + i * stride;
   }
 
-  // 픽셀 셰이더 코드를 컴파일한다
-  ID3DBlob* pixel_shader_buffer = nullptr;
-  if (FAILED(D3DCompileFromFile(ps_path.c_str(), nullptr, nullptr,
-                                "ColorPixelShader", "ps_5_0",
-                                D3D10_SHADER_ENABLE_STRICTNESS, 0,
-                                &pixel_shader_buffer, &error_message))) {
-    if (error_message)
-      OutputShaderErrorMessage(error_message, hwnd, ps_path);
-    else
-      MessageBox(hwnd, ps_path.c_str(), L"Missing Shader File", MB_OK);
+  device_context->GetContext()->Unmap(constant_ring, 0);
+  return true;
+}
 
-    return false;
+void ColorShaderClass::Render(DeviceContextClass* device_context,
+                              const int32_t index_count,
+                              const ConstantSliceType& slice) {
+  PROFILE_FUNCTION();
+  PROFILE_GPU_SCOPE(device_context->GetGpuProfiler(),
+                    "ColorShaderClass::Render");
+
+  SetProgram(device_context, ProgramType::COLOR);
+  Draw(device_context, index_count, 0, slice);
+}
+
+void ColorShaderClass::Draw(DeviceContextClass* device_context,
+                            const int32_t index_count,
+                            const uint32_t start_index,
+                            const ConstantSliceType& slice) {
+  if (constant_buffer_offsetting_) {
+    // 링 버퍼의 해당 조각을 상수 단위(16 byte) 오프셋으로 바인딩합니다
+    const UINT first_constant = slice.offset_ / 16;
+    const UINT constant_count = ConstantRingAllocatorClass::ALIGNMENT / 16;
+    ID3D11Buffer* constant_ring = resources_->Get(constant_ring_);
+    device_context->VSSetConstantBuffers1(0, 1, &constant_ring,
+                                            &first_constant, &constant_count);
+  } else {
+    // 이전 런타임에서는 드로우마다 작은 상수 버퍼를 갱신합니다
+    SetShaderParameters(
+        device_context,
+        staged_constants_[slice.offset_ /
+                          ConstantRingAllocatorClass::ALIGNMENT]);
   }
 
-  // 버퍼로부터 정점 셰이더를 생성한다
-  com::ThrowIfFailed(device->CreateVertexShader(
-      vertex_shader_buffer->GetBufferPointer(),
-      vertex_shader_buffer->GetBufferSize(), nullptr, &vertex_shader_));
-
-  // 버퍼로부터 픽셀 셰이더를 생성한다
-  com::ThrowIfFailed(device->CreatePixelShader(
-      pixel_shader_buffer->GetBufferPointer(),
-      pixel_shader_buffer->GetBufferSize(), nullptr, &pixel_shader_));
-
-  // 정점 input layout description을 설정합니다
-  // 이 설정은 ModelClass 와 셰이더의 VertexType 구조와 일치해야합니다
-  D3D11_INPUT_ELEMENT_DESC polygon_layout[2]{};
-  polygon_layout[0].SemanticName = "POSITION";
-  polygon_layout[0].SemanticIndex = 0;
-  polygon_layout[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-  polygon_layout[0].InputSlot = 0;
-  polygon_layout[0].AlignedByteOffset = 0;
-  polygon_layout[0].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-  polygon_layout[0].InstanceDataStepRate = 0;
-
-  polygon_layout[1].SemanticName = "COLOR";
-  polygon_layout[1].SemanticIndex = 0;
-  polygon_layout[1].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-  polygon_layout[1].InputSlot = 0;
-  polygon_layout[1].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-  polygon_layout[1].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-  polygon_layout[1].InstanceDataStepRate = 0;
-
-  // layout 의 요소 수를 가져옵니다
-  const int32_t count = ARRAYSIZE(polygon_layout);
+  // 바인딩된 셰이더로 인덱스 구간을 그립니다
+  device_context->DrawIndexed(index_count, start_index, 0);
+}
 
-  // 정점 input layout 을 만듭니다
-  com::ThrowIfFailed(device->CreateInputLayout(
-      polygon_layout, count, vertex_shader_buffer->GetBufferPointer(),
-      vertex_shader_buffer->GetBufferSize(), &layout_));
+void ColorShaderClass::DrawInstanced(DeviceContextClass* device_context,
+                                     const InstancedDrawType& draw) {
+  device_context->DrawIndexedInstanced(draw.index_count_,
+                                       draw.instance_count_,
+                                       draw.start_index_, 0,
+                                       draw.start_instance_);
+}
 
-  // 더 이상 사용되지 않는 정점, 픽셀 셰이더 버퍼를 해제합니다
-  vertex_shader_buffer->Release();
-  vertex_shader_buffer = nullptr;
+bool ColorShaderClass::CanRecordDraws() { return constant_buffer_offsetting_; }
 
-  pixel_shader_buffer->Release();
-  pixel_shader_buffer = nullptr;
+void ColorShaderClass::SetViewProjection(
+    DeviceContextClass* device_context,
+    const DirectX::XMMATRIX& view_projection) {
+  // 뷰-투영 행렬을 transpose 하여 프레임 상수 버퍼에 복사합니다
+  ID3D11Buffer* frame_buffer = resources_->Get(frame_buffer_);
+  D3D11_MAPPED_SUBRESOURCE mapped_resource{};
+  com::ThrowIfFailed(device_context->GetContext()->Map(
+      frame_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource));
+  reinterpret_cast<WvpBufferType*>(mapped_resource.pData)
+      ->world_view_projection_ = DirectX::XMMatrixTranspose(view_projection);
+  device_context->GetContext()->Unmap(frame_buffer, 0);
+}
+
+void ColorShaderClass::SetProgram(DeviceContextClass* device_context,
+                                  const ProgramType program) {
+  if (program == ProgramType::INSTANCED) {
+    // 인스턴싱 input layout 과 셰이더, 프레임 상수 버퍼를 설정합니다
+    ID3D11Buffer* frame_buffer = resources_->Get(frame_buffer_);
+    device_context->VSSetConstantBuffers(0, 1, &frame_buffer);
+    device_context->IASetInputLayout(resources_->Get(instanced_layout_));
+    device_context->VSSetShader(resources_->Get(instanced_vertex_shader_));
+  } else {
+    // 정점 입력 레이아웃과 정점 셰이더를 설정합니다. 상수 버퍼는 드로우마다
+    // 바인딩합니다
+    device_context->IASetInputLayout(resources_->Get(layout_));
+    device_context->VSSetShader(resources_->Get(vertex_shader_));
+  }
+
+  device_context->PSSetShader(resources_->Get(pixel_shader_));
+}
+
+bool ColorShaderClass::InitializeShader(
+    const void* vs_bytecode, const size_t vs_size, const void* ps_bytecode,
+    const size_t ps_size, const ModelClass::VertexFormatType vertex_format) {
+  // bytecode 로부터 정점 셰이더를 생성한다
+  vertex_shader_ = resources_->CreateVertexShader(vs_bytecode, vs_size);
+
+  // bytecode 로부터 픽셀 셰이더를 생성한다
+  pixel_shader_ = resources_->CreatePixelShader(ps_bytecode, ps_size);
+
+  // 정점 input layout description 은 ModelClass 의 정점 구조체 선언으로부터
+  // 컴파일 타임에 만들어져 있으므로 정점 버퍼와 항상 일치합니다
+  uint32_t count = 0;
+  const D3D11_INPUT_ELEMENT_DESC* polygon_layout =
+      ModelClass::GetInputElements(vertex_format, count);
+
+  // 정점 input layout 을 만듭니다
+  layout_ = resources_->CreateInputLayout(polygon_layout, count, vs_bytecode,
+                                          vs_size);
 
   // 정점 셰이더에 있는 행렬 상수 버퍼의 description 을 작성합니다
   D3D11_BUFFER_DESC matrix_buffer_desc{};
   matrix_buffer_desc.Usage = D3D11_USAGE_DYNAMIC;
-  matrix_buffer_desc.ByteWidth = sizeof(MatrixBufferType);
+  matrix_buffer_desc.ByteWidth = precomputed_wvp_ ? sizeof(WvpBufferType)
+                                                  : sizeof(MatrixBufferType);
   matrix_buffer_desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
   matrix_buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
   matrix_buffer_desc.MiscFlags = 0;
   matrix_buffer_desc.StructureByteStride = 0;
 
   // 상수 버퍼 포인터를 만들어 이 클래스에서 정점 셰이더 상수 버퍼에 접근할 수 있게 합니다
-  com::ThrowIfFailed(
-      device->CreateBuffer(&matrix_buffer_desc, nullptr, &matrix_buffer_));
+  matrix_buffer_ = resources_->CreateBuffer(matrix_buffer_desc, nullptr);
 
   return true;
 }
 
-void ColorShaderClass::ShutdownShader() {
-  if (matrix_buffer_) {
-    matrix_buffer_->Release();
-    matrix_buffer_ = nullptr;
-  }
+bool ColorShaderClass::InitializeInstancedShader(
+    const void* vs_bytecode, const size_t vs_size,
+    const ModelClass::VertexFormatType vertex_format) {
+  // bytecode 로부터 정점 셰이더를 생성한다
+  instanced_vertex_shader_ =
+      resources_->CreateVertexShader(vs_bytecode, vs_size);
 
-  if (layout_) {
-    layout_->Release();
-    layout_ = nullptr;
-  }
+  // 슬롯 0 은 ModelClass 의 정점 구조체, 슬롯 1 은 ModelClass::InstanceType
+  // 선언으로부터 컴파일 타임에 만든 요소입니다
+  uint32_t count = 0;
+  const D3D11_INPUT_ELEMENT_DESC* polygon_layout =
+      ModelClass::GetInstancedInputElements(vertex_format, count);
 
-  if (pixel_shader_) {
-    pixel_shader_->Release();
-    pixel_shader_ = nullptr;
-  }
+  // 정점 input layout 을 만듭니다
+  instanced_layout_ = resources_->CreateInputLayout(polygon_layout, count,
+                                                    vs_bytecode, vs_size);
 
-  if (vertex_shader_) {
-    vertex_shader_->Release();
-    vertex_shader_ = nullptr;
-  }
+  // 프레임당 한 번 올리는 뷰-투영 상수 버퍼를 만듭니다
+  D3D11_BUFFER_DESC frame_buffer_desc{};
+  frame_buffer_desc.Usage = D3D11_USAGE_DYNAMIC;
+  frame_buffer_desc.ByteWidth = sizeof(WvpBufferType);
+  frame_buffer_desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+  frame_buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+  frame_buffer_desc.MiscFlags = 0;
+  frame_buffer_desc.StructureByteStride = 0;
+
+  frame_buffer_ = resources_->CreateBuffer(frame_buffer_desc, nullptr);
+
+  return true;
 }
 
-void ColorShaderClass::OutputShaderErrorMessage(
-    ID3DBlob* error_message, const HWND hwnd,
-    const std::filesystem::path& path) {
-  // 출력창에 에러 메시지를 표시합니다
-  OutputDebugString(
-      reinterpret_cast<const wchar_t*>(error_message->GetBufferPointer()));
+void ColorShaderClass::ShutdownShader() {
+  if (resources_ == nullptr) return;
+
+  resources_->Release(frame_buffer_);
+  resources_->Release(instanced_layout_);
+  resources_->Release(instanced_vertex_shader_);
+  resources_->Release(matrix_buffer_);
+  resources_->Release(layout_);
+  resources_->Release(pixel_shader_);
+  resources_->Release(vertex_shader_);
+}
 
-  error_message->Release();
-  error_message = nullptr;
+const std::string& ColorShaderClass::GetError() { return error_; }
 
-  MessageBox(hwnd, L"Error copiling shader.", path.c_str(), MB_OK);
+void ColorShaderClass::AppendShaderError(const std::string& error_message,
+                                         const std::filesystem::path& path) {
+  error_ += "Error compiling shader " + path.string() + "\n" + error_message;
+  if (error_.back() != '\n') error_ += '\n';
 }
 
-void ColorShaderClass::SetShaderParameters(ID3D11DeviceContext* device_context,
+void ColorShaderClass::SetShaderParameters(DeviceContextClass* device_context,
                                            DirectX::XMMATRIX& world,
                                            DirectX::XMMATRIX& view,
                                            DirectX::XMMATRIX& projection) {
-  // 행렬을 transpose 하여 셰이더에서 사용할 수 있게 합니다
-  world = DirectX::XMMatrixTranspose(world);
-  view = DirectX::XMMatrixTranspose(view);
-  projection = DirectX::XMMatrixTranspose(projection);
-
   // 상수 버퍼의 내용을 쓸 수 있도록 잠급니다
+  ID3D11Buffer* matrix_buffer = resources_->Get(matrix_buffer_);
   D3D11_MAPPED_SUBRESOURCE mapped_resource{};
-  com::ThrowIfFailed(device_context->Map(
-      matrix_buffer_, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource));
+  com::ThrowIfFailed(device_context->GetContext()->Map(
+      matrix_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource));
 
   // 상수 버퍼 데이터에 대한 포인터를 가져옵니다
   MatrixBufferType* data =
       reinterpret_cast<MatrixBufferType*>(mapped_resource.pData);
 
-  // 상수 버퍼에 행렬을 복사합니다
-  data->world_ = world;
-  data->view_ = view;
-  data->projection_ = projection;
+  // 상수 버퍼에 행렬을 transpose 하여 복사합니다
+  shader_constants::FillMatrixBuffer(data, world, view, projection);
 
   // 상수 버퍼의 잠금을 풉니다
-  device_context->Unmap(matrix_buffer_, 0);
+  device_context->GetContext()->Unmap(matrix_buffer, 0);
 
   uint32_t buffer_number = 0;
-  device_context->VSSetConstantBuffers(buffer_number, 1, &matrix_buffer_);
+  device_context->VSSetConstantBuffers(buffer_number, 1, &matrix_buffer);
 }
 
-void ColorShaderClass::RenderShader(ID3D11DeviceContext* device_context,
+void ColorShaderClass::SetShaderParameters(
+    DeviceContextClass* device_context, const WvpBufferType& constants) {
+  // 상수 버퍼의 내용을 쓸 수 있도록 잠급니다
+  ID3D11Buffer* matrix_buffer = resources_->Get(matrix_buffer_);
+  D3D11_MAPPED_SUBRESOURCE mapped_resource{};
+  com::ThrowIfFailed(device_context->GetContext()->Map(
+      matrix_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource));
+
+  // 상수 버퍼에 월드-뷰-투영 행렬 하나(64 byte)만 복사합니다
+  *reinterpret_cast<WvpBufferType*>(mapped_resource.pData) = constants;
+
+  // 상수 버퍼의 잠금을 풉니다
+  device_context->GetContext()->Unmap(matrix_buffer, 0);
+
+  uint32_t buffer_number = 0;
+  device_context->VSSetConstantBuffers(buffer_number, 1, &matrix_buffer);
+}
+
+bool ColorShaderClass::InitializeConstantRing(const uint32_t capacity) {
+  ID3D11Device* device = resources_->GetDevice();
+
+  // D3D11.1 런타임이 상수 버퍼 오프셋 바인딩을 지원하는지 확인합니다
+  D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+  if (FAILED(device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options,
+                                         sizeof(options))))
+    return true;
+
+  // 오프셋 바인딩 호출은 DeviceContextClass 가 같은 인터페이스로 합니다
+  ID3D11DeviceContext* immediate_context = nullptr;
+  ID3D11DeviceContext1* device_context1 = nullptr;
+  device->GetImmediateContext(&immediate_context);
+  const HRESULT result = immediate_context->QueryInterface(
+      __uuidof(ID3D11DeviceContext1),
+      reinterpret_cast<void**>(&device_context1));
+  immediate_context->Release();
+  if (device_context1) device_context1->Release();
+
+  // 지원하지 않으면 드로우마다 Map 하는 기존 방식으로 동작합니다
+  if (FAILED(result) || options.ConstantBufferOffsetting == false) {
+    ShutdownConstantRing();
+    return true;
+  }
+
+  // 링 버퍼로 사용할 큰 동적 상수 버퍼를 만듭니다
+  D3D11_BUFFER_DESC ring_desc{};
+  ring_desc.Usage = D3D11_USAGE_DYNAMIC;
+  ring_desc.ByteWidth = capacity;
+  ring_desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+  ring_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+  ring_desc.MiscFlags = 0;
+  ring_desc.StructureByteStride = 0;
+
+  constant_ring_ = resources_->CreateBuffer(ring_desc, nullptr);
+
+  constant_ring_allocator_ = new ConstantRingAllocatorClass{};
+  if (constant_ring_allocator_ == nullptr) return false;
+
+  // 상수 버퍼에 NO_OVERWRITE 매핑을 못 하면 배치마다 버퍼를 새로 받습니다
+  map_no_overwrite_ = options.MapNoOverwriteOnDynamicConstantBuffer != FALSE;
+  constant_ring_allocator_->Initialize(capacity, map_no_overwrite_);
+
+  constant_buffer_offsetting_ = true;
+  return true;
+}
+
+void ColorShaderClass::ShutdownConstantRing() {
+  constant_buffer_offsetting_ = false;
+
+  if (constant_ring_allocator_) {
+    constant_ring_allocator_->Shutdown();
+    delete constant_ring_allocator_;
+    constant_ring_allocator_ = nullptr;
+  }
+
+  if (resources_) resources_->Release(constant_ring_);
+}
+
+void ColorShaderClass::RenderShader(DeviceContextClass* device_context,
                                     const int32_t index_count) {
-  // 정점 입력 레이아웃을 설정합니다
-  device_context->IASetInputLayout(layout_);
+  PROFILE_GPU_SCOPE(device_context->GetGpuProfiler(),
+                    "ColorShaderClass::RenderShader");
 
-  // 삼각형을 그릴 정점 셰이더와 픽셀 셰이더를 설정합니다
-  device_context->VSSetShader(vertex_shader_, nullptr, 0);
-  device_context->PSSetShader(pixel_shader_, nullptr, 0);
+  // 정점 입력 레이아웃과 삼각형을 그릴 셰이더를 설정합니다
+  SetProgram(device_context, ProgramType::COLOR);
 
   // 삼각형을 그립니다
   device_context->DrawIndexed(index_count, 0, 0);
 }
+
+void ColorShaderClass::RenderInstanced(
+    DeviceContextClass* device_context, const InstancedDrawType* draws,
+    const uint32_t draw_count, const DirectX::XMMATRIX& view_projection) {
+  PROFILE_FUNCTION();
+  PROFILE_GPU_SCOPE(device_context->GetGpuProfiler(),
+                    "ColorShaderClass::RenderInstanced");
+
+  SetViewProjection(device_context, view_projection);
+  SetProgram(device_context, ProgramType::INSTANCED);
+
+  // 드로우마다 인덱스 구간의 모든 인스턴스를 한 번의 호출로 그립니다
+  for (uint32_t i = 0; i < draw_count; i++)
+    DrawInstanced(device_context, draws[i]);
+}
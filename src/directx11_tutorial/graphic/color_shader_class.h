@@ -1,38 +1,139 @@
 #pragma once
-#include <d3d11.h>
+#include <d3d11_1.h>
 #include <DirectXMath.h>
 #include <filesystem>
+#include <string>
+#include <vector>
+
+#include "model_class.h"
+#include "resource_manager_class.h"
+#include "shader_constants.h"
+
+class ConstantRingAllocatorClass;
+class DeviceContextClass;
+class JobSystemClass;
 
 class ColorShaderClass {
  public:
-  bool Initialize(ID3D11Device* device, const HWND hwnd);
+  using MatrixBufferType = shader_constants::MatrixBufferType;
+  using WvpBufferType = shader_constants::WvpBufferType;
+
+  // WriteConstants 가 돌려주는 드로우 하나의 상수 위치입니다
+  struct ConstantSliceType {
+    uint32_t offset_ = 0;
+  };
+
+  // 인덱스 구간 하나를 인스턴스 구간 하나로 그리는 인스턴싱 드로우입니다
+  struct InstancedDrawType {
+    uint32_t index_count_;
+    uint32_t instance_count_;
+    uint32_t start_index_;
+    uint32_t start_instance_;
+  };
+
+  // 셰이더와 input layout 의 조합입니다. RenderQueueClass 키의 셰이더
+  // 번호로 씁니다
+  enum class ProgramType : uint32_t {
+    COLOR = 0,
+    INSTANCED,
+  };
+
+  // precomputed_wvp 가 true 이면 vertex_wvp.hlsl 셰이더와 WvpBufferType 을
+  // 사용합니다. input layout 은 vertex_format 의 정점 배치로 만듭니다.
+  // job_system 이 있으면 캐시에 없는 셰이더를 병렬로 컴파일합니다.
+  // 셰이더와 상수 버퍼는 resources 에서 만들고 핸들로 들고 있습니다.
+  // 작업 스레드에서 불릴 수 있으므로 창을 띄우지 않습니다. 실패하면
+  // GetError 로 이유를 읽어 호출한 쪽에서 알립니다
+  bool Initialize(ResourceManagerClass* resources,
+                  const bool precomputed_wvp,
+                  const ModelClass::VertexFormatType vertex_format,
+                  JobSystemClass* job_system = nullptr);
   void Shutdown();
-  void Render(ID3D11DeviceContext* device_context, const int32_t index_count,
+  // 마지막 Initialize 가 실패한 이유입니다
+  const std::string& GetError();
+  void Render(DeviceContextClass* device_context, const int32_t index_count,
               DirectX::XMMATRIX world, DirectX::XMMATRIX view,
               DirectX::XMMATRIX projection);
 
- private:
-  struct MatrixBufferType {
-    DirectX::XMMATRIX world_;
-    DirectX::XMMATRIX view_;
-    DirectX::XMMATRIX projection_;
-  };
+  // 여러 드로우의 월드-뷰-투영 상수를 링 버퍼에 한 번에 씁니다.
+  // precomputed_wvp 로 초기화했을 때만 사용할 수 있습니다. 상수가 버퍼
+  // 최대 크기를 넘으면 아무것도 쓰지 않고 false 를 반환합니다
+  bool WriteConstants(DeviceContextClass* device_context,
+                      const DirectX::XMMATRIX* worlds, const uint32_t count,
+                      const DirectX::XMMATRIX& view_projection,
+                      ConstantSliceType* slices);
+  // WriteConstants 로 쓴 상수 조각을 오프셋으로 바인딩해서 그립니다
+  void Render(DeviceContextClass* device_context, const int32_t index_count,
+              const ConstantSliceType& slice);
+
+  // 인스턴스 스트림의 월드 행렬로 드로우마다 인스턴스 구간의 복사본을 한
+  // 번에 그립니다. 뷰-투영 행렬과 셰이더는 호출당 한 번만 설정합니다
+  void RenderInstanced(DeviceContextClass* device_context,
+                       const InstancedDrawType* draws,
+                       const uint32_t draw_count,
+                       const DirectX::XMMATRIX& view_projection);
+
+  // 아래 함수들은 바인딩과 드로우를 나눠, 렌더 큐가 상태가 바뀔 때만
+  // 바인딩하게 합니다.
+  // 인스턴싱 프로그램이 쓰는 뷰-투영 행렬을 프레임 상수 버퍼에 올립니다
+  void SetViewProjection(DeviceContextClass* device_context,
+                         const DirectX::XMMATRIX& view_projection);
+  // 프로그램의 input layout 과 셰이더, 프레임 상수 버퍼를 바인딩합니다
+  void SetProgram(DeviceContextClass* device_context,
+                  const ProgramType program);
+  // COLOR 프로그램으로 WriteConstants 의 상수 조각을 바인딩해 그립니다
+  void Draw(DeviceContextClass* device_context, const int32_t index_count,
+            const uint32_t start_index, const ConstantSliceType& slice);
+  // INSTANCED 프로그램으로 드로우 하나를 그립니다
+  void DrawInstanced(DeviceContextClass* device_context,
+                     const InstancedDrawType& draw);
+  // Draw 가 드로우마다 상수 버퍼를 Map 하지 않으면 true 입니다. 이때만
+  // COLOR 프로그램의 드로우를 명령 목록에 기록할 수 있습니다
+  bool CanRecordDraws();
 
-  bool InitializeShader(ID3D11Device* device, const HWND hwnd,
-                        const std::filesystem::path& vs_path,
-                        const std::filesystem::path& ps_path);
+ private:
+  // ShaderCacheClass 가 넘겨준 bytecode 로 셰이더와 input layout 을
+  // 만듭니다
+  bool InitializeShader(const void* vs_bytecode, const size_t vs_size,
+                        const void* ps_bytecode, const size_t ps_size,
+                        const ModelClass::VertexFormatType vertex_format);
+  bool InitializeInstancedShader(
+      const void* vs_bytecode, const size_t vs_size,
+      const ModelClass::VertexFormatType vertex_format);
   void ShutdownShader();
-  void OutputShaderErrorMessage(ID3DBlob* error_message, const HWND hwnd,
-                                const std::filesystem::path& path);
+  // 컴파일 오류를 error_ 에 덧붙입니다
+  void AppendShaderError(const std::string& error_message,
+                         const std::filesystem::path& path);
 
-  void SetShaderParameters(ID3D11DeviceContext* device_context,
+  void SetShaderParameters(DeviceContextClass* device_context,
                            DirectX::XMMATRIX& world, DirectX::XMMATRIX& view,
                            DirectX::XMMATRIX& projection);
-  void RenderShader(ID3D11DeviceContext* device_context,
+  void SetShaderParameters(DeviceContextClass* device_context,
+                           const WvpBufferType& constants);
+  bool InitializeConstantRing(const uint32_t capacity);
+  void ShutdownConstantRing();
+  void RenderShader(DeviceContextClass* device_context,
                     const int32_t index_count);
 
-  ID3D11VertexShader* vertex_shader_ = nullptr;
-  ID3D11PixelShader* pixel_shader_ = nullptr;
-  ID3D11InputLayout* layout_ = nullptr;
-  ID3D11Buffer* matrix_buffer_ = nullptr;
+  bool precomputed_wvp_ = false;
+  std::string error_;
+  ResourceManagerClass* resources_ = nullptr;
+  ResourceManagerClass::VertexShaderHandleType vertex_shader_{};
+  ResourceManagerClass::PixelShaderHandleType pixel_shader_{};
+  ResourceManagerClass::InputLayoutHandleType layout_{};
+  ResourceManagerClass::BufferHandleType matrix_buffer_{};
+
+  // 인스턴싱 경로의 정점 셰이더, input layout, 뷰-투영 상수 버퍼입니다
+  ResourceManagerClass::VertexShaderHandleType instanced_vertex_shader_{};
+  ResourceManagerClass::InputLayoutHandleType instanced_layout_{};
+  ResourceManagerClass::BufferHandleType frame_buffer_{};
+
+  // 상수 버퍼 오프셋 바인딩(D3D11.1)이 가능할 때 사용하는 링 버퍼입니다
+  bool constant_buffer_offsetting_ = false;
+  bool map_no_overwrite_ = false;
+  ResourceManagerClass::BufferHandleType constant_ring_{};
+  ConstantRingAllocatorClass* constant_ring_allocator_ = nullptr;
+
+  // 오프셋 바인딩을 쓸 수 없을 때 드로우마다 Map 하기 위해 보관하는 상수입니다
+  std::vector<WvpBufferType> staged_constants_;
 };
@@ -0,0 +1,84 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <memory>
+#include <string>
+
+#include "framework/benchmark_class.h"
+#include "framework/job_system_class.h"
+#include "graphic/command_list_class.h"
+
+void RegisterCommandListBenchmarks(BenchmarkClass& benchmark) {
+  // 10 만 드로우를 16 묶음의 소프트웨어 명령 목록에 기록한 뒤, 묶음 순서대로
+  // 하나의 목록으로 재생하기. 묶음을 작업 스레드에서 동시에 기록하는 경우와
+  // 한 스레드에서 차례로 기록하는 경우를 비교합니다
+  for (const bool threaded : {false, true}) {
+    const uint32_t draw_count = 100000;
+    const uint32_t chunk_count = 16;
+    const std::string name = "CommandListClass/" +
+                             std::to_string(draw_count) +
+                             (threaded ? "/parallel" : "/serial");
+
+    benchmark.AddFixture(name, draw_count, [threaded, draw_count] {
+      struct DataType {
+        JobSystemClass job_system_;
+        CommandListClass chunks_[chunk_count];
+        CommandListClass replay_;
+        ~DataType() { job_system_.Shutdown(); }
+      };
+      auto data = std::make_shared<DataType>();
+      data->job_system_.Initialize();
+
+      return BenchmarkClass::BodyType([data, threaded,
+                                       draw_count](uint64_t iterations) {
+        const auto handle = [](const uintptr_t value) {
+          return reinterpret_cast<const void*>(value << 4);
+        };
+
+        // 묶음 하나의 드로우를 기록합니다. 묶음마다 모든 상태를 설정합니다
+        const auto record = [&](uint32_t chunk) {
+          CommandListClass& list = data->chunks_[chunk];
+          list.Reset();
+          const uint32_t begin = draw_count * chunk / chunk_count;
+          const uint32_t end = draw_count * (chunk + 1) / chunk_count;
+          for (uint32_t draw = begin; draw < end; draw++) {
+            const uintptr_t mesh = 100 + draw / 16 % 64;
+            const void* buffers[2] = {handle(mesh), handle(200)};
+            const uint32_t strides[2] = {16, 80};
+            const void* constant_buffer = handle(300);
+            const uint32_t first_constant = draw % 4096 * 16;
+            const uint32_t constant_count = 16;
+
+            if (draw == begin) {
+              list.SetInputLayout(handle(1));
+              list.SetVertexShader(handle(11));
+              list.SetPixelShader(handle(20));
+              list.SetPrimitiveTopology(4);
+            }
+            if (draw == begin || draw % 16 == 0) {
+              list.SetVertexBuffers(0, 2, buffers, strides, nullptr);
+              list.SetIndexBuffer(handle(mesh + 1000), 57, 0);
+            }
+            list.SetVertexConstantBuffers(0, 1, &constant_buffer,
+                                          &first_constant, &constant_count);
+            list.DrawIndexed(36, 0, 0);
+          }
+        };
+
+        for (uint64_t i = 0; i < iterations; i++) {
+          if (threaded) {
+            data->job_system_.ParallelFor(chunk_count, record);
+          } else {
+            for (uint32_t chunk = 0; chunk < chunk_count; chunk++)
+              record(chunk);
+          }
+
+          data->replay_.Reset();
+          for (const CommandListClass& chunk : data->chunks_)
+            chunk.Execute(data->replay_);
+          BenchmarkClass::DoNotOptimize(data->replay_.GetCommandCount());
+        }
+      });
+    });
+  }
+}
@@ -0,0 +1,193 @@
+#include "pch.h"
+#include "command_list_class.h"
+
+#include <algorithm>
+
+namespace {
+// 슬롯 수를 슬롯 최대치로 자릅니다
+uint32_t ClampSlots(const uint32_t count, const uint32_t max_slots) {
+  return (std::min)(count, max_slots);
+}
+}  // namespace
+
+void CommandListClass::Reset() {
+  words_.clear();
+  command_count_ = 0;
+}
+
+uint32_t CommandListClass::GetCommandCount() { return command_count_; }
+
+size_t CommandListClass::GetSize() { return words_.size() * sizeof(uint64_t); }
+
+void CommandListClass::SetInputLayout(const void* layout) {
+  Begin(CommandType::INPUT_LAYOUT, 1);
+  PushHandle(layout);
+}
+
+void CommandListClass::SetVertexBuffers(const uint32_t start,
+                                        const uint32_t count,
+                                        const void* const* buffers,
+                                        const uint32_t* strides,
+                                        const uint32_t* offsets) {
+  const uint32_t slots =
+      ClampSlots(count, StateFilterClass::MAX_VERTEX_BUFFERS);
+  Begin(CommandType::VERTEX_BUFFERS, 2 + slots * 3);
+  Push(start);
+  Push(slots);
+  PushHandles(buffers, slots);
+  PushArray(strides, slots, 0);
+  PushArray(offsets, slots, 0);
+}
+
+void CommandListClass::SetIndexBuffer(const void* buffer,
+                                      const uint32_t format,
+                                      const uint32_t offset) {
+  Begin(CommandType::INDEX_BUFFER, 3);
+  PushHandle(buffer);
+  Push(format);
+  Push(offset);
+}
+
+void CommandListClass::SetPrimitiveTopology(const uint32_t topology) {
+  Begin(CommandType::PRIMITIVE_TOPOLOGY, 1);
+  Push(topology);
+}
+
+void CommandListClass::SetVertexShader(const void* shader) {
+  Begin(CommandType::VERTEX_SHADER, 1);
+  PushHandle(shader);
+}
+
+void CommandListClass::SetPixelShader(const void* shader) {
+  Begin(CommandType::PIXEL_SHADER, 1);
+  PushHandle(shader);
+}
+
+void CommandListClass::SetVertexConstantBuffers(
+    const uint32_t start, const uint32_t count, const void* const* buffers,
+    const uint32_t* first_constants, const uint32_t* constant_counts) {
+  PushConstantBuffers(CommandType::VERTEX_CONSTANT_BUFFERS, start, count,
+                      buffers, first_constants, constant_counts);
+}
+
+void CommandListClass::SetPixelConstantBuffers(
+    const uint32_t start, const uint32_t count, const void* const* buffers,
+    const uint32_t* first_constants, const uint32_t* constant_counts) {
+  PushConstantBuffers(CommandType::PIXEL_CONSTANT_BUFFERS, start, count,
+                      buffers, first_constants, constant_counts);
+}
+
+void CommandListClass::SetRenderTargets(const uint32_t count,
+                                        const void* const* views,
+                                        const void* depth_stencil_view) {
+  const uint32_t slots =
+      ClampSlots(count, StateFilterClass::MAX_RENDER_TARGETS);
+  Begin(CommandType::RENDER_TARGETS, 2 + slots);
+  Push(slots);
+  PushHandles(views, slots);
+  PushHandle(depth_stencil_view);
+}
+
+void CommandListClass::SetDepthStencilState(const void* state,
+                                            const uint32_t stencil_ref) {
+  Begin(CommandType::DEPTH_STENCIL_STATE, 2);
+  PushHandle(state);
+  Push(stencil_ref);
+}
+
+void CommandListClass::SetBlendState(const void* state,
+                                     const float* blend_factor,
+                                     const uint32_t sample_mask) {
+  Begin(CommandType::BLEND_STATE, 6);
+  PushHandle(state);
+  for (uint32_t i = 0; i < 4; i++)
+    PushFloat(blend_factor ? blend_factor[i] : 1.0f);
+  Push(sample_mask);
+}
+
+void CommandListClass::SetRasterizerState(const void* state) {
+  Begin(CommandType::RASTERIZER_STATE, 1);
+  PushHandle(state);
+}
+
+void CommandListClass::SetViewports(
+    const uint32_t count, const StateFilterClass::ViewportType* viewports) {
+  const uint32_t slots = ClampSlots(count, StateFilterClass::MAX_VIEWPORTS);
+  Begin(CommandType::VIEWPORTS, 1 + slots * 6);
+  Push(slots);
+  for (uint32_t i = 0; i < slots; i++) {
+    PushFloat(viewports[i].top_left_x_);
+    PushFloat(viewports[i].top_left_y_);
+    PushFloat(viewports[i].width_);
+    PushFloat(viewports[i].height_);
+    PushFloat(viewports[i].min_depth_);
+    PushFloat(viewports[i].max_depth_);
+  }
+}
+
+void CommandListClass::DrawIndexed(const uint32_t index_count,
+                                   const uint32_t start_index,
+                                   const int32_t base_vertex) {
+  Begin(CommandType::DRAW_INDEXED, 3);
+  Push(index_count);
+  Push(start_index);
+  Push(static_cast<uint32_t>(base_vertex));
+}
+
+void CommandListClass::DrawIndexedInstanced(const uint32_t index_count,
+                                            const uint32_t instance_count,
+                                            const uint32_t start_index,
+                                            const int32_t base_vertex,
+                                            const uint32_t start_instance) {
+  Begin(CommandType::DRAW_INDEXED_INSTANCED, 5);
+  Push(index_count);
+  Push(instance_count);
+  Push(start_index);
+  Push(static_cast<uint32_t>(base_vertex));
+  Push(start_instance);
+}
+
+void CommandListClass::Begin(const CommandType type,
+                             const uint32_t word_count) {
+  words_.push_back(static_cast<uint64_t>(type) |
+                   static_cast<uint64_t>(word_count) << 32);
+  command_count_++;
+}
+
+void CommandListClass::Push(const uint64_t value) { words_.push_back(value); }
+
+void CommandListClass::PushHandle(const void* handle) {
+  words_.push_back(reinterpret_cast<uintptr_t>(handle));
+}
+
+void CommandListClass::PushFloat(const float value) {
+  words_.push_back(std::bit_cast<uint32_t>(value));
+}
+
+void CommandListClass::PushArray(const uint32_t* values, const uint32_t count,
+                                 const uint32_t fallback) {
+  for (uint32_t i = 0; i < count; i++)
+    words_.push_back(values ? values[i] : fallback);
+}
+
+void CommandListClass::PushHandles(const void* const* handles,
+                                   const uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) PushHandle(handles[i]);
+}
+
+void CommandListClass::PushConstantBuffers(const CommandType type,
+                                           const uint32_t start,
+                                           const uint32_t count,
+                                           const void* const* buffers,
+                                           const uint32_t* first_constants,
+                                           const uint32_t* constant_counts) {
+  const uint32_t slots =
+      ClampSlots(count, StateFilterClass::MAX_CONSTANT_BUFFERS);
+  Begin(type, 3 + slots * 3);
+  Push(start);
+  Push(slots);
+  Push(first_constants != nullptr);
+  PushHandles(buffers, slots);
+  PushArray(first_constants, slots, 0);
+  PushArray(constant_counts, slots, 0);
+}
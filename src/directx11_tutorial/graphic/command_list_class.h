@@ -0,0 +1,227 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "state_filter_class.h"
+
+// 파이프라인 상태 설정과 드로우를 메모리에 기록해 두었다가 나중에 같은
+// 순서로 다시 호출하는 소프트웨어 명령 목록입니다. 드라이버가 명령 목록을
+// 지원하지 않을 때 지연 컨텍스트 대신 씁니다.
+// 리소스는 StateFilterClass 처럼 주소로만 저장하므로 그래픽스 API 와
+// 무관합니다. Execute 는 같은 이름의 함수를 가진 어떤 대상에도 재생할 수
+// 있으므로, 이 클래스 자신이나 호출을 기록하는 가짜 대상으로도 재생됩니다.
+class CommandListClass {
+ public:
+  enum class CommandType : uint32_t {
+    INPUT_LAYOUT = 0,
+    VERTEX_BUFFERS,
+    INDEX_BUFFER,
+    PRIMITIVE_TOPOLOGY,
+    VERTEX_SHADER,
+    VERTEX_CONSTANT_BUFFERS,
+    PIXEL_SHADER,
+    PIXEL_CONSTANT_BUFFERS,
+    RENDER_TARGETS,
+    DEPTH_STENCIL_STATE,
+    BLEND_STATE,
+    RASTERIZER_STATE,
+    VIEWPORTS,
+    DRAW_INDEXED,
+    DRAW_INDEXED_INSTANCED,
+  };
+
+  // 기록을 비웁니다. 메모리는 다음 기록을 위해 남겨 둡니다
+  void Reset();
+
+  uint32_t GetCommandCount();
+  // 기록에 쓴 바이트 수입니다
+  size_t GetSize();
+
+  // 인자는 StateFilterClass 의 Set 함수와 같습니다. 슬롯 수는 각 슬롯
+  // 최대치로 자릅니다
+  void SetInputLayout(const void* layout);
+  void SetVertexBuffers(const uint32_t start, const uint32_t count,
+                        const void* const* buffers, const uint32_t* strides,
+                        const uint32_t* offsets);
+  void SetIndexBuffer(const void* buffer, const uint32_t format,
+                      const uint32_t offset);
+  void SetPrimitiveTopology(const uint32_t topology);
+  void SetVertexShader(const void* shader);
+  void SetPixelShader(const void* shader);
+  void SetVertexConstantBuffers(const uint32_t start, const uint32_t count,
+                                const void* const* buffers,
+                                const uint32_t* first_constants,
+                                const uint32_t* constant_counts);
+  void SetPixelConstantBuffers(const uint32_t start, const uint32_t count,
+                               const void* const* buffers,
+                               const uint32_t* first_constants,
+                               const uint32_t* constant_counts);
+  void SetRenderTargets(const uint32_t count, const void* const* views,
+                        const void* depth_stencil_view);
+  void SetDepthStencilState(const void* state, const uint32_t stencil_ref);
+  void SetBlendState(const void* state, const float* blend_factor,
+                     const uint32_t sample_mask);
+  void SetRasterizerState(const void* state);
+  void SetViewports(const uint32_t count,
+                    const StateFilterClass::ViewportType* viewports);
+  void DrawIndexed(const uint32_t index_count, const uint32_t start_index,
+                   const int32_t base_vertex);
+  void DrawIndexedInstanced(const uint32_t index_count,
+                            const uint32_t instance_count,
+                            const uint32_t start_index,
+                            const int32_t base_vertex,
+                            const uint32_t start_instance);
+
+  // 기록한 명령을 순서대로 target 의 같은 이름 함수로 호출합니다
+  template <typename Target>
+  void Execute(Target& target) const;
+
+ private:
+  // 명령은 머리 한 워드(종류, 인자 워드 수)와 인자 워드들입니다. 모든 값을
+  // 64 bit 워드로 저장하므로 정렬을 신경 쓰지 않아도 됩니다
+  void Begin(const CommandType type, const uint32_t word_count);
+  void Push(const uint64_t value);
+  void PushHandle(const void* handle);
+  void PushFloat(const float value);
+  // count 개를 쓰고, values 가 nullptr 이면 fallback 으로 채웁니다
+  void PushArray(const uint32_t* values, const uint32_t count,
+                 const uint32_t fallback);
+  void PushHandles(const void* const* handles, const uint32_t count);
+  void PushConstantBuffers(const CommandType type, const uint32_t start,
+                           const uint32_t count, const void* const* buffers,
+                           const uint32_t* first_constants,
+                           const uint32_t* constant_counts);
+
+  // 재생할 때 워드를 차례로 읽습니다
+  struct ReaderType {
+    const uint64_t* cursor_;
+
+    uint32_t ReadUint() { return static_cast<uint32_t>(*cursor_++); }
+    int32_t ReadInt() { return static_cast<int32_t>(ReadUint()); }
+    const void* ReadHandle() {
+      return reinterpret_cast<const void*>(static_cast<uintptr_t>(*cursor_++));
+    }
+    float ReadFloat() { return std::bit_cast<float>(ReadUint()); }
+  };
+
+  std::vector<uint64_t> words_;
+  uint32_t command_count_ = 0;
+};
+
+template <typename Target>
+void CommandListClass::Execute(Target& target) const {
+  const uint32_t MAX_SLOTS = StateFilterClass::MAX_VERTEX_BUFFERS;
+  const void* handles[MAX_SLOTS];
+  uint32_t values[2][MAX_SLOTS];
+
+  ReaderType reader{words_.data()};
+  const uint64_t* end = words_.data() + words_.size();
+  while (reader.cursor_ < end) {
+    const uint64_t header = *reader.cursor_++;
+    const CommandType type = static_cast<CommandType>(header & 0xffffffff);
+    const uint64_t* next = reader.cursor_ + (header >> 32);
+
+    switch (type) {
+      case CommandType::INPUT_LAYOUT:
+        target.SetInputLayout(reader.ReadHandle());
+        break;
+      case CommandType::VERTEX_BUFFERS: {
+        const uint32_t start = reader.ReadUint();
+        const uint32_t count = reader.ReadUint();
+        for (uint32_t i = 0; i < count; i++) handles[i] = reader.ReadHandle();
+        for (uint32_t i = 0; i < count; i++) values[0][i] = reader.ReadUint();
+        for (uint32_t i = 0; i < count; i++) values[1][i] = reader.ReadUint();
+        target.SetVertexBuffers(start, count, handles, values[0], values[1]);
+        break;
+      }
+      case CommandType::INDEX_BUFFER: {
+        const void* buffer = reader.ReadHandle();
+        const uint32_t format = reader.ReadUint();
+        target.SetIndexBuffer(buffer, format, reader.ReadUint());
+        break;
+      }
+      case CommandType::PRIMITIVE_TOPOLOGY:
+        target.SetPrimitiveTopology(reader.ReadUint());
+        break;
+      case CommandType::VERTEX_SHADER:
+        target.SetVertexShader(reader.ReadHandle());
+        break;
+      case CommandType::PIXEL_SHADER:
+        target.SetPixelShader(reader.ReadHandle());
+        break;
+      case CommandType::VERTEX_CONSTANT_BUFFERS:
+      case CommandType::PIXEL_CONSTANT_BUFFERS: {
+        // 오프셋 없이 기록했으면 오프셋 배열도 없이 재생합니다
+        const uint32_t start = reader.ReadUint();
+        const uint32_t count = reader.ReadUint();
+        const bool ranged = reader.ReadUint() != 0;
+        for (uint32_t i = 0; i < count; i++) handles[i] = reader.ReadHandle();
+        for (uint32_t i = 0; i < count; i++) values[0][i] = reader.ReadUint();
+        for (uint32_t i = 0; i < count; i++) values[1][i] = reader.ReadUint();
+        if (type == CommandType::VERTEX_CONSTANT_BUFFERS)
+          target.SetVertexConstantBuffers(start, count, handles,
+                                          ranged ? values[0] : nullptr,
+                                          ranged ? values[1] : nullptr);
+        else
+          target.SetPixelConstantBuffers(start, count, handles,
+                                         ranged ? values[0] : nullptr,
+                                         ranged ? values[1] : nullptr);
+        break;
+      }
+      case CommandType::RENDER_TARGETS: {
+        const uint32_t count = reader.ReadUint();
+        for (uint32_t i = 0; i < count; i++) handles[i] = reader.ReadHandle();
+        target.SetRenderTargets(count, handles, reader.ReadHandle());
+        break;
+      }
+      case CommandType::DEPTH_STENCIL_STATE: {
+        const void* state = reader.ReadHandle();
+        target.SetDepthStencilState(state, reader.ReadUint());
+        break;
+      }
+      case CommandType::BLEND_STATE: {
+        const void* state = reader.ReadHandle();
+        float blend_factor[4];
+        for (float& factor : blend_factor) factor = reader.ReadFloat();
+        target.SetBlendState(state, blend_factor, reader.ReadUint());
+        break;
+      }
+      case CommandType::RASTERIZER_STATE:
+        target.SetRasterizerState(reader.ReadHandle());
+        break;
+      case CommandType::VIEWPORTS: {
+        StateFilterClass::ViewportType
+            viewports[StateFilterClass::MAX_VIEWPORTS];
+        const uint32_t count = reader.ReadUint();
+        for (uint32_t i = 0; i < count; i++) {
+          viewports[i].top_left_x_ = reader.ReadFloat();
+          viewports[i].top_left_y_ = reader.ReadFloat();
+          viewports[i].width_ = reader.ReadFloat();
+          viewports[i].height_ = reader.ReadFloat();
+          viewports[i].min_depth_ = reader.ReadFloat();
+          viewports[i].max_depth_ = reader.ReadFloat();
+        }
+        target.SetViewports(count, viewports);
+        break;
+      }
+      case CommandType::DRAW_INDEXED: {
+        const uint32_t index_count = reader.ReadUint();
+        const uint32_t start_index = reader.ReadUint();
+        target.DrawIndexed(index_count, start_index, reader.ReadInt());
+        break;
+      }
+      case CommandType::DRAW_INDEXED_INSTANCED: {
+        const uint32_t index_count = reader.ReadUint();
+        const uint32_t instance_count = reader.ReadUint();
+        const uint32_t start_index = reader.ReadUint();
+        const int32_t base_vertex = reader.ReadInt();
+        target.DrawIndexedInstanced(index_count, instance_count, start_index,
+                                    base_vertex, reader.ReadUint());
+        break;
+      }
+    }
+
+    reader.cursor_ = next;
+  }
+}
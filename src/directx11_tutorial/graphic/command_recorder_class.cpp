@@ -0,0 +1,112 @@
+#include "pch.h"
+#include "command_recorder_class.h"
+
+#include "com_throw.h"
+#include "framework/profiler.h"
+
+bool CommandRecorderClass::Initialize(ID3D11Device* device,
+                                      const uint32_t max_chunk_count,
+                                      const bool emulated) {
+  // 드라이버가 명령 목록을 직접 지원할 때만 지연 컨텍스트를 씁니다.
+  // 지원하지 않으면 런타임이 명령 목록을 흉내 내는데, 상태 설정을 미리
+  // 걸러 두는 소프트웨어 목록이 더 가볍습니다
+  mode_ = ModeType::EMULATED;
+  if (emulated == false && device != nullptr) {
+    D3D11_FEATURE_DATA_THREADING threading{};
+    if (SUCCEEDED(device->CheckFeatureSupport(
+            D3D11_FEATURE_THREADING, &threading, sizeof(threading))) &&
+        threading.DriverCommandLists)
+      mode_ = ModeType::DEFERRED;
+  }
+
+  context_pool_.Initialize(max_chunk_count);
+  if (mode_ == ModeType::EMULATED)
+    command_list_pool_.Initialize(max_chunk_count);
+
+  contexts_.assign(max_chunk_count, nullptr);
+  native_lists_.assign(max_chunk_count, nullptr);
+  for (uint32_t chunk = 0; chunk < max_chunk_count; chunk++) {
+    contexts_[chunk] = context_pool_.Create();
+
+    if (mode_ == ModeType::DEFERRED) {
+      // 래퍼가 참조를 하나 더 잡으므로 만든 참조는 바로 놓습니다
+      ID3D11DeviceContext* deferred_context = nullptr;
+      com::ThrowIfFailed(device->CreateDeferredContext(0, &deferred_context));
+      const bool result = contexts_[chunk]->Initialize(deferred_context);
+      deferred_context->Release();
+      if (result == false) return false;
+    } else {
+      command_lists_.push_back(command_list_pool_.Create());
+      if (contexts_[chunk]->Initialize(command_lists_.back()) == false)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+void CommandRecorderClass::Shutdown() {
+  for (ID3D11CommandList*& native_list : native_lists_) {
+    if (native_list) {
+      native_list->Release();
+      native_list = nullptr;
+    }
+  }
+  native_lists_.clear();
+
+  for (DeviceContextClass* context : contexts_) {
+    if (context) {
+      context->Shutdown();
+      context_pool_.Destroy(context);
+    }
+  }
+  contexts_.clear();
+  context_pool_.Shutdown();
+
+  for (CommandListClass* command_list : command_lists_)
+    command_list_pool_.Destroy(command_list);
+  command_lists_.clear();
+  command_list_pool_.Shutdown();
+}
+
+CommandRecorderClass::ModeType CommandRecorderClass::GetMode() {
+  return mode_;
+}
+
+uint32_t CommandRecorderClass::GetMaxChunkCount() {
+  return static_cast<uint32_t>(contexts_.size());
+}
+
+DeviceContextClass* CommandRecorderClass::BeginChunk(const uint32_t chunk) {
+  DeviceContextClass* context = contexts_[chunk];
+
+  // 지연 컨텍스트는 FinishCommandList 뒤 기본 상태에서 시작합니다.
+  // 소프트웨어 목록은 지난 기록을 비우고 그림자 사본도 버립니다
+  if (mode_ == ModeType::EMULATED) {
+    command_lists_[chunk]->Reset();
+    context->ClearState();
+  }
+
+  return context;
+}
+
+void CommandRecorderClass::EndChunk(const uint32_t chunk) {
+  if (mode_ == ModeType::DEFERRED)
+    native_lists_[chunk] = contexts_[chunk]->FinishCommandList();
+}
+
+void CommandRecorderClass::Execute(DeviceContextClass* immediate,
+                                   const uint32_t count) {
+  PROFILE_FUNCTION();
+
+  // 명령 목록은 항상 묶음 번호 순서대로 재생하므로 결과가 결정적입니다
+  for (uint32_t chunk = 0; chunk < count; chunk++) {
+    if (mode_ == ModeType::DEFERRED) {
+      immediate->ExecuteCommandList(native_lists_[chunk]);
+      native_lists_[chunk]->Release();
+      native_lists_[chunk] = nullptr;
+    } else {
+      immediate->ExecuteCommandList(*command_lists_[chunk]);
+    }
+  }
+}
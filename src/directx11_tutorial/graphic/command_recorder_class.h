@@ -0,0 +1,86 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <d3d11.h>
+
+#include "command_list_class.h"
+#include "device_context_class.h"
+#include "framework/job_system_class.h"
+#include "framework/pool_allocator_class.h"
+#include "framework/profiler.h"
+
+// 장면을 묶음으로 나눠 작업 스레드에서 동시에 기록하고, 묶음 번호 순서대로
+// 즉시 컨텍스트에서 재생합니다. 드라이버가 명령 목록을 지원하면 묶음마다
+// D3D11 지연 컨텍스트에 기록해 FinishCommandList 로 닫고, 아니면 묶음마다
+// CommandListClass 에 기록했다가 즉시 컨텍스트로 다시 호출합니다.
+// 지연 컨텍스트는 즉시 컨텍스트의 상태를 물려받지 않으므로 묶음마다 렌더
+// 타겟과 뷰포트부터 설정해야 합니다. 지연 컨텍스트의 목록을 재생하고 나면
+// 즉시 컨텍스트의 상태는 기본값입니다.
+class CommandRecorderClass {
+ public:
+  enum class ModeType : uint32_t {
+    // D3D11 지연 컨텍스트와 드라이버 명령 목록
+    DEFERRED = 0,
+    // CommandListClass 에 기록해 즉시 컨텍스트로 다시 호출
+    EMULATED,
+  };
+
+  // max_chunk_count 는 한 번에 기록할 수 있는 최대 묶음 수입니다.
+  // emulated 가 true 이거나 device 가 nullptr 이면 드라이버 지원과 무관하게
+  // 소프트웨어 명령 목록을 씁니다
+  bool Initialize(ID3D11Device* device, const uint32_t max_chunk_count,
+                  const bool emulated = false);
+  void Shutdown();
+
+  ModeType GetMode();
+  uint32_t GetMaxChunkCount();
+
+  // [0, chunk_count) 묶음마다 record(context, chunk) 를 job_system 에서
+  // 동시에 부른 뒤, 기록이 끝난 순서와 무관하게 묶음 번호 순서대로
+  // immediate 에서 재생합니다. context 는 그 묶음만 쓰는 컨텍스트입니다.
+  // chunk_count 는 최대 묶음 수로 자르고, job_system 이 nullptr 이면 호출
+  // 스레드에서 차례로 기록합니다
+  template <typename RecordFunction>
+  void Record(JobSystemClass* job_system, DeviceContextClass* immediate,
+              const uint32_t chunk_count, const RecordFunction& record);
+
+ private:
+  // 묶음을 기록하기 전에 컨텍스트를 준비하고, 기록한 뒤 목록을 닫습니다
+  DeviceContextClass* BeginChunk(const uint32_t chunk);
+  void EndChunk(const uint32_t chunk);
+  // [0, count) 묶음의 목록을 차례로 재생합니다
+  void Execute(DeviceContextClass* immediate, const uint32_t count);
+
+  ModeType mode_ = ModeType::EMULATED;
+  // 묶음마다 하나씩입니다. 객체는 풀에서 만듭니다
+  PoolAllocatorClass<DeviceContextClass> context_pool_;
+  PoolAllocatorClass<CommandListClass> command_list_pool_;
+  std::vector<DeviceContextClass*> contexts_;
+  std::vector<CommandListClass*> command_lists_;
+  std::vector<ID3D11CommandList*> native_lists_;
+};
+
+template <typename RecordFunction>
+void CommandRecorderClass::Record(JobSystemClass* job_system,
+                                  DeviceContextClass* immediate,
+                                  const uint32_t chunk_count,
+                                  const RecordFunction& record) {
+  PROFILE_SCOPE("CommandRecorderClass::Record");
+
+  const uint32_t count = (std::min)(chunk_count, GetMaxChunkCount());
+  auto record_chunk = [&](uint32_t chunk) {
+    record(BeginChunk(chunk), chunk);
+    EndChunk(chunk);
+  };
+
+  // 묶음마다 자기 컨텍스트에만 기록하므로 잠금이 필요 없습니다
+  if (job_system) {
+    job_system->ParallelFor(count, record_chunk);
+  } else {
+    for (uint32_t chunk = 0; chunk < count; chunk++) record_chunk(chunk);
+  }
+
+  Execute(immediate, count);
+}
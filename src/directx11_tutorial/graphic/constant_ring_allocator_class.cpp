@@ -0,0 +1,70 @@
+#include "pch.h"
+#include "constant_ring_allocator_class.h"
+
+uint32_t ConstantRingAllocatorClass::AlignSize(const uint32_t size) {
+  return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+bool ConstantRingAllocatorClass::GrowCapacity(const uint32_t capacity,
+                                              const uint64_t size,
+                                              uint32_t& grown) {
+  if (size > MAX_CAPACITY) return false;
+
+  // 64 bit 로 키우므로 넘치지 않고, 0 에서 시작해도 멈춥니다
+  uint64_t result = capacity > ALIGNMENT ? capacity : ALIGNMENT;
+  while (result < size) result *= 2;
+
+  grown = static_cast<uint32_t>(result > MAX_CAPACITY ? MAX_CAPACITY : result);
+  return true;
+}
+
+bool ConstantRingAllocatorClass::Initialize(const uint32_t capacity,
+                                            const bool no_overwrite) {
+  capacity_ = capacity & ~(ALIGNMENT - 1);
+  no_overwrite_ = no_overwrite;
+
+  // 처음 예약은 항상 discard 가 되도록 끝에 있는 것으로 시작합니다
+  head_ = capacity_;
+  reserved_bytes_ = 0;
+  discard_count_ = 0;
+
+  return capacity_ > 0;
+}
+
+void ConstantRingAllocatorClass::Shutdown() {
+  capacity_ = 0;
+  head_ = 0;
+}
+
+bool ConstantRingAllocatorClass::Reserve(const uint32_t size,
+                                         uint32_t& offset, bool& discard) {
+  const uint32_t aligned_size = AlignSize(size);
+  if (aligned_size == 0 || aligned_size > capacity_) return false;
+
+  // 남은 공간이 부족하거나 덮어쓰기가 허용되지 않으면 처음으로 돌아갑니다
+  discard = no_overwrite_ == false || head_ + aligned_size > capacity_;
+  if (discard) {
+    head_ = 0;
+    discard_count_++;
+  }
+
+  offset = head_;
+  head_ += aligned_size;
+  reserved_bytes_ += aligned_size;
+
+  return true;
+}
+
+uint32_t ConstantRingAllocatorClass::GetCapacity() { return capacity_; }
+
+uint32_t ConstantRingAllocatorClass::GetUsedBytes() {
+  return discard_count_ > 0 ? head_ : 0;
+}
+
+uint64_t ConstantRingAllocatorClass::GetReservedBytes() {
+  return reserved_bytes_;
+}
+
+uint64_t ConstantRingAllocatorClass::GetDiscardCount() {
+  return discard_count_;
+}
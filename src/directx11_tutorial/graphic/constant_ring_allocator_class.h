@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+
+// 큰 상수 버퍼 하나를 256 byte 정렬 조각으로 나눠 주는 링 할당기입니다.
+// GPU 리소스와 무관하게 오프셋만 관리합니다. 끝에 닿으면 처음으로 돌아가며,
+// 이때 호출자는 버퍼를 WRITE_DISCARD 로 매핑해 이전 내용을 버려야 합니다.
+class ConstantRingAllocatorClass {
+ public:
+  // VSSetConstantBuffers1 의 오프셋은 16 상수(256 byte) 단위여야 합니다
+  static const uint32_t ALIGNMENT = 256;
+  // D3D11 리소스 하나의 최대 크기(128 MB)입니다
+  static const uint32_t MAX_CAPACITY = 128 * 1024 * 1024;
+
+  static uint32_t AlignSize(const uint32_t size);
+  // size 바이트를 담을 때까지 capacity 를 두 배씩 키운 크기를 grown 에
+  // 씁니다. size 가 MAX_CAPACITY 보다 크면 false 를 반환합니다
+  static bool GrowCapacity(const uint32_t capacity, const uint64_t size,
+                           uint32_t& grown);
+
+  // no_overwrite 가 false 이면 매 예약마다 처음부터 다시 씁니다 (항상 discard)
+  bool Initialize(const uint32_t capacity, const bool no_overwrite);
+  void Shutdown();
+
+  // size 바이트 연속 영역을 예약합니다. 처음으로 돌아갔다면 discard 가 true 가
+  // 됩니다. 용량보다 크면 false 를 반환합니다
+  bool Reserve(const uint32_t size, uint32_t& offset, bool& discard);
+
+  uint32_t GetCapacity();
+  uint32_t GetUsedBytes();
+  uint64_t GetReservedBytes();
+  uint64_t GetDiscardCount();
+
+ private:
+  uint32_t capacity_ = 0;
+  uint32_t head_ = 0;
+  bool no_overwrite_ = false;
+  uint64_t reserved_bytes_ = 0;
+  uint64_t discard_count_ = 0;
+};
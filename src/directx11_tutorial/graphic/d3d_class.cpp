@@ -2,12 +2,30 @@
 #include "d3d_class.h"
 
 #include "com_throw.h"
+#include "device_context_class.h"
+#include "upscale_shader_class.h"
+#include "framework/profiler.h"
+
+namespace {
+// 프레임 지연 대기 객체를 PresenterClass 가 기다리는 스왑 체인으로
+// 감쌉니다
+struct FrameLatencyWaitType {
+  HANDLE waitable_;
+
+  void WaitForFrameLatency() {
+    // 표시가 멈춰도 프레임 루프까지 멈추지 않도록 1초까지만 기다립니다
+    if (waitable_) ::WaitForSingleObjectEx(waitable_, 1000, TRUE);
+  }
+};
+}  // namespace
 
-bool D3DClass::Initialize(const int32_t width, const int32_t height, bool vsync,
+bool D3DClass::Initialize(const int32_t width, const int32_t height,
+                          const PresenterClass::SettingsType& present,
                           HWND hwnd, bool fullscreen, float screen_depth,
                           float screen_near) {
-  // vsync(수직동기화) 상태를 저장합니다
-  vsync_enabled_ = vsync;
+  // 장면 타겟의 최대 크기인 화면 크기를 저장합니다
+  width_ = width;
+  height_ = height;
 
   // DirectX 그래픽 인터페이스 팩토리를 생성합니다
   IDXGIFactory* factory = nullptr;
@@ -79,42 +97,121 @@ bool D3DClass::Initialize(const int32_t width, const int32_t height, bool vsync,
   factory->Release();
   factory = nullptr;
 
-  // 스왑 체인 description을 초기화합니다.
-  DXGI_SWAP_CHAIN_DESC swap_chain_desc{};
-  swap_chain_desc.BufferCount = 1; // backbuffer 를 1개만 사용하도록 지정합니다
-  swap_chain_desc.BufferDesc.Width = width; // backbuffer 의 넓이를 지정합니다
-  swap_chain_desc.BufferDesc.Height = height; // backbuffer 의 높이를 지정합니다
-  swap_chain_desc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; // 32bit surface를 지정합니다.
-  swap_chain_desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT; // backbuffer 의 사용 용도를 설정합니다
-  swap_chain_desc.OutputWindow = hwnd; // 렌더링이 이루어질 윈도우의 핸들을 설정합니다
-  swap_chain_desc.SwapEffect = DXGI_SWAP_EFFECT_DISCARD; // 출력된 이후의 backbuffer 의 내용을 버리도록 합니다
-  swap_chain_desc.Flags = 0; // 추가 옵션 플래그를 사용하지 않습니다
-  swap_chain_desc.Windowed = fullscreen ? false : true; // 창모드(true) or 풀스크린(false) 모드를 설정합니다
-  swap_chain_desc.BufferDesc.ScanlineOrdering =
-      DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED; // 스캔 라인의 정렬을 지정되지 않음으로(unspecified) 설정합니다
-  swap_chain_desc.BufferDesc.Scaling = DXGI_MODE_SCALING_UNSPECIFIED; // 스캔라이닝을 지정되지 않음으로(unspecified) 설정합니다
-
-  // 멀티샘플링을 끕니다
+  // 피쳐 레벨을 DirectX 11로 설정합니다
+  D3D_FEATURE_LEVEL feature_level = D3D_FEATURE_LEVEL_11_0;
+
+  // Direct3D 디바이스, Direct3D 디바이스 컨텍스트를 생성합니다
+  com::ThrowIfFailed(D3D11CreateDevice(
+      NULL, D3D_DRIVER_TYPE_HARDWARE, NULL, 0, &feature_level, 1,
+      D3D11_SDK_VERSION, &device_, NULL, &device_context_));
+
+  // 스왑 체인은 디바이스를 만든 어댑터의 팩토리에서 만들어야 합니다
+  IDXGIDevice* dxgi_device = nullptr;
+  com::ThrowIfFailed(
+      device_->QueryInterface(__uuidof(IDXGIDevice), (void**)&dxgi_device));
+  IDXGIAdapter* device_adapter = nullptr;
+  com::ThrowIfFailed(dxgi_device->GetAdapter(&device_adapter));
+  IDXGIFactory2* swap_chain_factory = nullptr;
+  com::ThrowIfFailed(device_adapter->GetParent(__uuidof(IDXGIFactory2),
+                                               (void**)&swap_chain_factory));
+  device_adapter->Release();
+  dxgi_device->Release();
+
+  // 수직 동기 없이 표시할 때 티어링을 허용할 수 있는지 확인합니다.
+  // DXGI 1.5 이전의 팩토리는 지원하지 않습니다
+  BOOL allow_tearing = FALSE;
+  IDXGIFactory5* tearing_factory = nullptr;
+  if (SUCCEEDED(swap_chain_factory->QueryInterface(
+          __uuidof(IDXGIFactory5), (void**)&tearing_factory))) {
+    if (FAILED(tearing_factory->CheckFeatureSupport(
+            DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allow_tearing,
+            sizeof(allow_tearing))))
+      allow_tearing = FALSE;
+    tearing_factory->Release();
+  }
+
+  // 전체 화면 독점 모드에서는 티어링 플래그로 표시할 수 없습니다. 버퍼
+  // 수와 최대 프레임 지연이 범위를 벗어나면 실패합니다
+  if (presenter_.Initialize(present, allow_tearing && !fullscreen) == false) {
+    swap_chain_factory->Release();
+    return false;
+  }
+
+  // 스왑 체인 description을 초기화합니다. 플립 모델은 표시한 backbuffer 를
+  // 복사하지 않고 화면과 맞바꾸며, backbuffer 가 2개 이상이어야 합니다
+  DXGI_SWAP_CHAIN_DESC1 swap_chain_desc{};
+  swap_chain_desc.Width = width;
+  swap_chain_desc.Height = height;
+  swap_chain_desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+  swap_chain_desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+  swap_chain_desc.BufferCount = present.buffer_count_;
+  swap_chain_desc.Scaling = DXGI_SCALING_STRETCH;
+  swap_chain_desc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+  swap_chain_desc.AlphaMode = DXGI_ALPHA_MODE_UNSPECIFIED;
+  swap_chain_desc.Flags = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+  if (allow_tearing)
+    swap_chain_desc.Flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+
+  // 플립 모델은 멀티샘플링된 backbuffer 를 쓸 수 없습니다
   swap_chain_desc.SampleDesc.Count = 1;
   swap_chain_desc.SampleDesc.Quality = 0;
 
-  // backbuffer 의 새로고침 비율을 설정합니다
-  if (vsync_enabled_) {
-    swap_chain_desc.BufferDesc.RefreshRate.Numerator = numerator;
-    swap_chain_desc.BufferDesc.RefreshRate.Denominator = denominator;
+  // 창모드 여부와 전체 화면에서의 새로고침 비율을 설정합니다
+  DXGI_SWAP_CHAIN_FULLSCREEN_DESC fullscreen_desc{};
+  if (present.mode_ == PresenterClass::ModeType::VSYNC) {
+    fullscreen_desc.RefreshRate.Numerator = numerator;
+    fullscreen_desc.RefreshRate.Denominator = denominator;
   } else {
-    swap_chain_desc.BufferDesc.RefreshRate.Numerator = 0;
-    swap_chain_desc.BufferDesc.RefreshRate.Denominator = 1;
+    fullscreen_desc.RefreshRate.Numerator = 0;
+    fullscreen_desc.RefreshRate.Denominator = 1;
   }
-
-  // 피쳐 레벨을 DirectX 11로 설정합니다
-  D3D_FEATURE_LEVEL feature_level = D3D_FEATURE_LEVEL_11_0;
-
-  // 스왑 체인, Direct3D 디바이스, Direct3D 디바이스 컨텍스트를 생성합니다
-  com::ThrowIfFailed(D3D11CreateDeviceAndSwapChain(
-      NULL, D3D_DRIVER_TYPE_HARDWARE, NULL, 0, &feature_level, 1,
-      D3D11_SDK_VERSION, &swap_chain_desc, &swap_chain_, &device_, NULL,
-      &device_context_));
+  fullscreen_desc.ScanlineOrdering = DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED;
+  fullscreen_desc.Scaling = DXGI_MODE_SCALING_UNSPECIFIED;
+  fullscreen_desc.Windowed = fullscreen ? false : true;
+
+  // 스왑 체인을 생성하고, 대기 객체를 쓰기 위해 DXGI 1.3 인터페이스로
+  // 바꿉니다
+  IDXGISwapChain1* swap_chain = nullptr;
+  com::ThrowIfFailed(swap_chain_factory->CreateSwapChainForHwnd(
+      device_, hwnd, &swap_chain_desc, &fullscreen_desc, nullptr,
+      &swap_chain));
+  swap_chain_factory->Release();
+  swap_chain_factory = nullptr;
+
+  const HRESULT result = swap_chain->QueryInterface(
+      __uuidof(IDXGISwapChain2), (void**)&swap_chain_);
+  swap_chain->Release();
+  com::ThrowIfFailed(result);
+
+  // 표시를 기다리는 프레임 수를 제한하고, 대기열에 자리가 나면 신호를 받을
+  // 객체를 가져옵니다
+  com::ThrowIfFailed(
+      swap_chain_->SetMaximumFrameLatency(present.max_frame_latency_));
+  frame_latency_waitable_ = swap_chain_->GetFrameLatencyWaitableObject();
+
+  // 파이프라인 상태는 모두 래퍼를 거쳐 설정합니다
+  context_ = new DeviceContextClass{};
+  if (context_ == nullptr) return false;
+  if (context_->Initialize(device_context_) == false) return false;
+
+  // 즉시 컨텍스트에 넣는 명령의 GPU 시간을 타임스탬프 쿼리로 잽니다.
+  // 해상도 조절이 프레임의 GPU 시간을 읽으므로 프로파일러를 끈 빌드에서도
+  // 만들고, 그 빌드에서는 프레임 구간만 잽니다
+  D3DQueryBackendClass query_backend{};
+  if (query_backend.Initialize(device_, device_context_) == false)
+    return false;
+
+  gpu_profiler_ = new D3DGpuProfilerType{};
+  if (gpu_profiler_ == nullptr) return false;
+  if (gpu_profiler_->Initialize(query_backend, GPU_PROFILER_FRAME_COUNT,
+                                GPU_PROFILER_MAX_SCOPES) == false)
+    return false;
+  context_->SetGpuProfiler(gpu_profiler_);
+
+  // 버퍼, 셰이더, 뷰는 관리자가 핸들로 나눠 주고 해제합니다
+  resources_ = new ResourceManagerClass{};
+  if (resources_ == nullptr) return false;
+  if (resources_->Initialize(device_) == false) return false;
 
   // backbuffer 의 포인터를 가져옵니다
   ID3D11Texture2D* back_buffer = nullptr;
@@ -122,8 +219,10 @@ bool D3DClass::Initialize(const int32_t width, const int32_t height, bool vsync,
                                             (LPVOID*)&back_buffer));
 
   // backbuffer 의 포인터로 렌더 타겟 뷰를 생성합니다.
+  ID3D11RenderTargetView* render_target_view = nullptr;
   com::ThrowIfFailed(device_->CreateRenderTargetView(back_buffer, nullptr,
-                                                     &render_target_view_));
+                                                     &render_target_view));
+  render_target_view_ = resources_->AddRenderTargetView(render_target_view);
 
   // backbuffer 포인터를 더이상 사용하지 않으므로 할당 해제합니다
   back_buffer->Release();
@@ -173,7 +272,7 @@ bool D3DClass::Initialize(const int32_t width, const int32_t height, bool vsync,
                                                       &depth_stencil_state_));
 
   // 깊이-스텐실 상태를 설정합니다
-  device_context_->OMSetDepthStencilState(depth_stencil_state_, 1);
+  context_->OMSetDepthStencilState(depth_stencil_state_, 1);
 
   // 깊이-스텐실 뷰의 description을 작성합니다
   D3D11_DEPTH_STENCIL_VIEW_DESC depth_stencil_view_desc{};
@@ -182,12 +281,13 @@ bool D3DClass::Initialize(const int32_t width, const int32_t height, bool vsync,
   depth_stencil_view_desc.Texture2D.MipSlice = 0;
 
   // 깊이-스텐실 뷰를 생성합니다
+  ID3D11DepthStencilView* depth_stencil_view = nullptr;
   com::ThrowIfFailed(device_->CreateDepthStencilView(
-      depth_stencil_buffer_, &depth_stencil_view_desc, &depth_stencil_view_));
+      depth_stencil_buffer_, &depth_stencil_view_desc, &depth_stencil_view));
+  depth_stencil_view_ = resources_->AddDepthStencilView(depth_stencil_view);
 
   // 렌더 타겟 뷰와 깊이-스텐실 버퍼를 출력 파이프 라인에 바인딩합니다
-  device_context_->OMSetRenderTargets(1, &render_target_view_,
-                                      depth_stencil_view_);
+  context_->OMSetRenderTargets(1, &render_target_view, depth_stencil_view);
 
   // 어떤 도형을 어떻게 그릴 것인지 결정하는 rasterizer description을
   // 작성합니다
@@ -208,19 +308,24 @@ bool D3DClass::Initialize(const int32_t width, const int32_t height, bool vsync,
       device_->CreateRasterizerState(&rasterizer_desc, &rasterizer_state_));
 
   // rasterizer 상태를 설정합니다.
-  device_context_->RSSetState(rasterizer_state_);
+  context_->RSSetState(rasterizer_state_);
 
   // 렌더링을 위한 뷰포트를 설정합니다
-  D3D11_VIEWPORT viewport{};
-  viewport.Width = static_cast<float>(width);
-  viewport.Height = static_cast<float>(height);
-  viewport.MinDepth = 0.0f;
-  viewport.MaxDepth = 1.0f;
-  viewport.TopLeftX = 0.0f;
-  viewport.TopLeftY = 0.0f;
+  viewport_.Width = static_cast<float>(width);
+  viewport_.Height = static_cast<float>(height);
+  viewport_.MinDepth = 0.0f;
+  viewport_.MaxDepth = 1.0f;
+  viewport_.TopLeftX = 0.0f;
+  viewport_.TopLeftY = 0.0f;
 
   // 뷰포트를 생성합니다
-  device_context_->RSSetViewports(1, &viewport);
+  context_->RSSetViewports(1, &viewport_);
+  scene_viewport_ = viewport_;
+
+  // 낮춘 해상도로 그리는 장면 타겟을 돌려 쓸 풀입니다
+  if (scene_target_pool_.Initialize(SCENE_TARGET_GRANULARITY,
+                                    SCENE_TARGET_IDLE_FRAMES) == false)
+    return false;
 
   // 투영 행렬을 설정합니다
   float field_of_view = DirectX::XM_PI / 4.0f;
@@ -250,11 +355,6 @@ void D3DClass::Shutdown() {
     rasterizer_state_ = nullptr;
   }
 
-  if (depth_stencil_view_) {
-    depth_stencil_view_->Release();
-    depth_stencil_view_ = nullptr;
-  }
-
   if (depth_stencil_state_) {
     depth_stencil_state_->Release();
     depth_stencil_state_ = nullptr;
@@ -265,9 +365,39 @@ void D3DClass::Shutdown() {
     depth_stencil_buffer_ = nullptr;
   }
 
-  if (render_target_view_) {
-    render_target_view_->Release();
-    render_target_view_ = nullptr;
+  // 장면 타겟은 뷰를 직접 들고 있으므로 관리자보다 먼저 해제합니다
+  if (scene_target_) {
+    scene_target_pool_.Release(scene_target_);
+    scene_target_ = nullptr;
+  }
+  scene_target_pool_.Shutdown();
+  upscale_shader_ = nullptr;
+
+  if (frame_latency_waitable_) {
+    ::CloseHandle(frame_latency_waitable_);
+    frame_latency_waitable_ = nullptr;
+  }
+
+  // 남은 버퍼, 셰이더, 뷰는 관리자가 모두 해제합니다
+  if (resources_) {
+    resources_->Release(depth_stencil_view_);
+    resources_->Release(render_target_view_);
+    resources_->Shutdown();
+    delete resources_;
+    resources_ = nullptr;
+  }
+
+  if (gpu_profiler_) {
+    if (context_) context_->SetGpuProfiler(nullptr);
+    gpu_profiler_->Shutdown();
+    delete gpu_profiler_;
+    gpu_profiler_ = nullptr;
+  }
+
+  if (context_) {
+    context_->Shutdown();
+    delete context_;
+    context_ = nullptr;
   }
 
   if (device_context_) {
@@ -286,31 +416,127 @@ void D3DClass::Shutdown() {
   }
 }
 
+void D3DClass::WaitForNextFrame() {
+  PROFILE_FUNCTION();
+
+  PresenterClass::SystemClockType clock{};
+  FrameLatencyWaitType swap_chain{frame_latency_waitable_};
+  presenter_.WaitForNextFrame(clock, swap_chain);
+
+  // 프레임 제한이나 수직 동기로 기다린 시간이 아니라, 지난 프레임이 CPU
+  // 나 GPU 때문에 걸린 시간으로 장면 해상도를 고칩니다. GPU 시간은 몇
+  // 프레임 전에 끝난 프레임의 것입니다
+  if (upscale_shader_) {
+    const int64_t gpu_time = gpu_profiler_ ? gpu_profiler_->GetFrameTime() : 0;
+    dynamic_resolution_.Update(
+        static_cast<double>(presenter_.GetBusyTime(gpu_time)) / 1e6);
+  }
+}
+
 void D3DClass::BeginScene(float red, float green, float blue, float alpha) {
+  // GPU 가 끝낸 지난 프레임의 구간을 읽고 이번 프레임 구간을 엽니다
+  if (gpu_profiler_) gpu_profiler_->BeginFrame(profiler::Now());
+
+  // 프레임마다 거른 상태 변경 수를 새로 셉니다
+  context_->GetStateFilter().ResetCounters();
+
+  // 이번 프레임의 해상도로 그릴 장면 타겟을 고릅니다
+  AcquireSceneTarget();
+
+  // 지난 프레임에 명령 목록을 실행했으면 상태가 기본값으로 돌아가 있습니다.
+  // 바뀌지 않은 상태는 래퍼가 거릅니다
+  SetFrameState(context_);
+
+  PROFILE_GPU_SCOPE(gpu_profiler_, "Clear");
+
   // 버퍼를 지울 색상을 설정합니다
   float color[4] = {red, green, blue, alpha};
 
-  // backbuffer 의 내용을 지웁니다
-  device_context_->ClearRenderTargetView(render_target_view_, color);
+  // 장면 타겟의 내용을 지웁니다
+  device_context_->ClearRenderTargetView(GetSceneRenderTargetView(), color);
 
   // 깊이 버퍼를 지웁니다
-  device_context_->ClearDepthStencilView(depth_stencil_view_, D3D11_CLEAR_DEPTH,
-                                         1.0f, 0);
+  device_context_->ClearDepthStencilView(GetSceneDepthStencilView(),
+                                         D3D11_CLEAR_DEPTH, 1.0f, 0);
 }
 
 void D3DClass::EndScene() {
+  // 낮춘 해상도로 그렸으면 backbuffer 전체로 늘려 그립니다. 깊이 버퍼는
+  // 쓰지 않습니다
+  if (scene_target_) {
+    PROFILE_GPU_SCOPE(gpu_profiler_, "Upscale");
+
+    const SceneTargetPoolType::DescType allocated =
+        scene_target_pool_.GetAllocatedDesc(scene_target_);
+    ID3D11RenderTargetView* back_buffer_view =
+        resources_->Get(render_target_view_);
+    context_->OMSetRenderTargets(1, &back_buffer_view, nullptr);
+    context_->RSSetViewports(1, &viewport_);
+    upscale_shader_->Render(context_, scene_target_->shader_resource_view_,
+                            static_cast<uint32_t>(scene_viewport_.Width),
+                            static_cast<uint32_t>(scene_viewport_.Height),
+                            allocated.width_, allocated.height_);
+
+    scene_target_pool_.Release(scene_target_);
+    scene_target_ = nullptr;
+  }
+
+  // 표시는 재지 않습니다
+  if (gpu_profiler_) gpu_profiler_->EndFrame();
+
   // 렌더링이 완료되었으므로 백버퍼의 내용을 화면에 표시합니다.
-  if (vsync_enabled_)
-    // 새로고침 비율을 고정합니다.
-    swap_chain_->Present(1, 0);
-  else
-    // 가능한 한 빠르게 표시합니다.
-    swap_chain_->Present(0, 0);
+  // 수직 동기를 끄면 가능한 한 빠르게, 지원하면 티어링을 허용해 표시합니다
+  swap_chain_->Present(
+      presenter_.GetSyncInterval(),
+      presenter_.IsTearingAllowed() ? DXGI_PRESENT_ALLOW_TEARING : 0);
+
+  // 플립 모델은 표시한 뒤 backbuffer 를 파이프라인에서 떼어 내므로, 다음
+  // 프레임에 다시 바인딩되도록 그림자 사본을 버립니다
+  context_->GetStateFilter().Invalidate();
+
+  // 프레임을 넘겼으므로 GPU 가 끝낸 프레임에서 놓은 리소스를 해제합니다
+  scene_target_pool_.EndFrame();
+  resources_->EndFrame();
+}
+
+void D3DClass::SetPresentMode(const PresenterClass::ModeType mode,
+                              const double frame_rate_limit) {
+  presenter_.SetMode(mode, frame_rate_limit);
+}
+
+PresenterClass::ModeType D3DClass::GetPresentMode() {
+  return presenter_.GetSettings().mode_;
+}
+
+bool D3DClass::SetDynamicResolution(
+    UpscaleShaderClass* upscale_shader,
+    const DynamicResolutionClass::SettingsType& settings) {
+  upscale_shader_ = nullptr;
+  if (upscale_shader == nullptr) return true;
+
+  if (dynamic_resolution_.Initialize(settings) == false) return false;
+  upscale_shader_ = upscale_shader;
+  return true;
+}
+
+float D3DClass::GetResolutionScale() {
+  return upscale_shader_ ? dynamic_resolution_.GetScale() : 1.0f;
 }
 
 ID3D11Device* D3DClass::GetDevice() { return device_; }
 
-ID3D11DeviceContext* D3DClass::GetDeviceContext() { return device_context_; }
+DeviceContextClass* D3DClass::GetDeviceContext() { return context_; }
+
+ResourceManagerClass* D3DClass::GetResourceManager() { return resources_; }
+
+void D3DClass::SetFrameState(DeviceContextClass* context) {
+  ID3D11RenderTargetView* render_target_view = GetSceneRenderTargetView();
+  context->OMSetRenderTargets(1, &render_target_view,
+                              GetSceneDepthStencilView());
+  context->OMSetDepthStencilState(depth_stencil_state_, 1);
+  context->RSSetState(rasterizer_state_);
+  context->RSSetViewports(1, &scene_viewport_);
+}
 
 void D3DClass::GetProjectionMatrix(DirectX::XMMATRIX& projection_matrix) {
   projection_matrix = projection_matrix_;
@@ -328,3 +554,88 @@ void D3DClass::GetVideoCardInfo(std::wstring& card_name, int32_t& memory) {
   card_name = video_card_name_;
   memory = video_card_memory_;
 }
+
+void D3DClass::SceneTargetType::Release() {
+  if (depth_stencil_view_) depth_stencil_view_->Release();
+  if (depth_texture_) depth_texture_->Release();
+  if (shader_resource_view_) shader_resource_view_->Release();
+  if (render_target_view_) render_target_view_->Release();
+  if (color_texture_) color_texture_->Release();
+  delete this;
+}
+
+void D3DClass::AcquireSceneTarget() {
+  uint32_t width = static_cast<uint32_t>(width_);
+  uint32_t height = static_cast<uint32_t>(height_);
+  if (upscale_shader_) {
+    width = dynamic_resolution_.GetScaledSize(width);
+    height = dynamic_resolution_.GetScaledSize(height);
+  }
+
+  // 화면 크기 그대로면 중간 타겟과 확대를 건너뜁니다
+  scene_target_ = nullptr;
+  if (width != static_cast<uint32_t>(width_) ||
+      height != static_cast<uint32_t>(height_)) {
+    scene_target_ = scene_target_pool_.Acquire(
+        {width, height, DXGI_FORMAT_R8G8B8A8_UNORM},
+        [this](const SceneTargetPoolType::DescType& desc) {
+          return CreateSceneTarget(desc);
+        });
+  }
+  if (scene_target_ == nullptr) {
+    width = static_cast<uint32_t>(width_);
+    height = static_cast<uint32_t>(height_);
+  }
+
+  // 장면 타겟에서 쓰는 왼쪽 위 영역에만 그립니다
+  scene_viewport_ = viewport_;
+  scene_viewport_.Width = static_cast<float>(width);
+  scene_viewport_.Height = static_cast<float>(height);
+}
+
+D3DClass::SceneTargetType* D3DClass::CreateSceneTarget(
+    const SceneTargetPoolType::DescType& desc) {
+  SceneTargetType* target = new SceneTargetType{};
+  if (target == nullptr) return nullptr;
+
+  // 그린 뒤 확대할 때 읽을 수 있는 색 텍스처를 만듭니다
+  D3D11_TEXTURE2D_DESC color_desc{};
+  color_desc.Width = desc.width_;
+  color_desc.Height = desc.height_;
+  color_desc.MipLevels = 1;
+  color_desc.ArraySize = 1;
+  color_desc.Format = static_cast<DXGI_FORMAT>(desc.format_);
+  color_desc.SampleDesc.Count = 1;
+  color_desc.SampleDesc.Quality = 0;
+  color_desc.Usage = D3D11_USAGE_DEFAULT;
+  color_desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+
+  // 렌더 타겟과 깊이-스텐실 뷰는 크기가 같아야 하므로 깊이 텍스처도 같은
+  // 크기로 만듭니다
+  D3D11_TEXTURE2D_DESC depth_desc = color_desc;
+  depth_desc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
+  depth_desc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
+
+  com::ThrowIfFailed(
+      device_->CreateTexture2D(&color_desc, nullptr, &target->color_texture_));
+  com::ThrowIfFailed(device_->CreateRenderTargetView(
+      target->color_texture_, nullptr, &target->render_target_view_));
+  com::ThrowIfFailed(device_->CreateShaderResourceView(
+      target->color_texture_, nullptr, &target->shader_resource_view_));
+  com::ThrowIfFailed(
+      device_->CreateTexture2D(&depth_desc, nullptr, &target->depth_texture_));
+  com::ThrowIfFailed(device_->CreateDepthStencilView(
+      target->depth_texture_, nullptr, &target->depth_stencil_view_));
+
+  return target;
+}
+
+ID3D11RenderTargetView* D3DClass::GetSceneRenderTargetView() {
+  return scene_target_ ? scene_target_->render_target_view_
+                       : resources_->Get(render_target_view_);
+}
+
+ID3D11DepthStencilView* D3DClass::GetSceneDepthStencilView() {
+  return scene_target_ ? scene_target_->depth_stencil_view_
+                       : resources_->Get(depth_stencil_view_);
+}
@@ -1,20 +1,59 @@
 #pragma once
 #include <d3d11.h>
+#include <dxgi1_5.h>
 #include <DirectXMath.h>
 #include <string>
 
+#include "d3d_query_backend_class.h"
+#include "dynamic_resolution_class.h"
+#include "presenter_class.h"
+#include "render_target_pool_class.h"
+#include "resource_manager_class.h"
+
+class DeviceContextClass;
+class UpscaleShaderClass;
+
 class D3DClass {
  public:
-  bool Initialize(const int32_t width, const int32_t height, bool vsync,
-                  HWND hwnd, bool fullscreen, float screen_depth,
-                  float screen_near);
+  // present 의 버퍼 수와 최대 프레임 지연으로 플립 모델 스왑 체인을
+  // 만듭니다
+  bool Initialize(const int32_t width, const int32_t height,
+                  const PresenterClass::SettingsType& present, HWND hwnd,
+                  bool fullscreen, float screen_depth, float screen_near);
   void Shutdown();
 
+  // 프레임의 입력을 읽기 전에 부릅니다. 스왑 체인 대기열에 자리가 나고
+  // 표시 방식이 정한 시각이 될 때까지 기다립니다
+  void WaitForNextFrame();
   void BeginScene(float red, float green, float blue, float alpha);
   void EndScene();
 
+  // 다음 프레임부터 표시 방식을 바꿉니다. frame_rate_limit 는 CAPPED 에서만
+  // 씁니다
+  void SetPresentMode(const PresenterClass::ModeType mode,
+                      const double frame_rate_limit);
+  PresenterClass::ModeType GetPresentMode();
+
+  // upscale_shader 가 있으면 지난 프레임 시간이 settings 의 예산에 맞도록
+  // 장면을 낮춘 해상도의 중간 타겟에 그리고, EndScene 에서 backbuffer 로
+  // 늘려 그립니다. nullptr 이면 항상 backbuffer 에 바로 그립니다.
+  // upscale_shader 는 이 객체보다 먼저 종료하지 않아야 합니다
+  bool SetDynamicResolution(
+      UpscaleShaderClass* upscale_shader,
+      const DynamicResolutionClass::SettingsType& settings);
+  // 이번 프레임의 장면 해상도 배율입니다
+  float GetResolutionScale();
+
   ID3D11Device* GetDevice();
-  ID3D11DeviceContext* GetDeviceContext();
+  // 버퍼, 셰이더, 뷰를 핸들로 나눠 주는 관리자입니다. EndScene 이 프레임을
+  // 넘길 때마다 GPU 가 끝낸 리소스를 해제합니다
+  ResourceManagerClass* GetResourceManager();
+  // 즉시 컨텍스트를 중복 상태 변경을 거르는 래퍼로 돌려줍니다. 거른 호출
+  // 수는 BeginScene 마다 다시 셉니다
+  DeviceContextClass* GetDeviceContext();
+  // 장면 렌더 타겟과 깊이-스텐실, 래스터라이저 상태, 뷰포트를 context 에
+  // 설정합니다. 상태를 물려받지 않는 지연 컨텍스트도 기록 전에 부릅니다
+  void SetFrameState(DeviceContextClass* context);
 
   void GetProjectionMatrix(DirectX::XMMATRIX& projection_matrix);
   void GetWorldMatrix(DirectX::XMMATRIX& world_matrix);
@@ -23,17 +62,63 @@ class D3DClass {
   void GetVideoCardInfo(std::wstring& card_name, int32_t& memory);
 
  private:
-  bool vsync_enabled_ = false;
+  // 장면 타겟은 이 단위로 크기를 올려 만들어 배율이 조금씩 바뀌어도 다시
+  // 쓰고, 이 프레임 수 동안 쓰지 않으면 해제합니다
+  static const uint32_t SCENE_TARGET_GRANULARITY = 64;
+  static const uint32_t SCENE_TARGET_IDLE_FRAMES = 3;
+  // GPU 프로파일러는 대기열의 프레임보다 많은 쿼리 묶음을 돌려 써서 결과를
+  // 기다리지 않고 읽습니다
+  static const uint32_t GPU_PROFILER_FRAME_COUNT = 4;
+  static const uint32_t GPU_PROFILER_MAX_SCOPES = 32;
+
+  // 낮춘 해상도로 그리는 장면의 색과 깊이 타겟입니다. 풀이 Release 로
+  // 해제합니다
+  struct SceneTargetType {
+    ID3D11Texture2D* color_texture_ = nullptr;
+    ID3D11RenderTargetView* render_target_view_ = nullptr;
+    ID3D11ShaderResourceView* shader_resource_view_ = nullptr;
+    ID3D11Texture2D* depth_texture_ = nullptr;
+    ID3D11DepthStencilView* depth_stencil_view_ = nullptr;
+
+    void Release();
+  };
+  using SceneTargetPoolType = RenderTargetPoolClass<SceneTargetType>;
+
+  // 배율에 맞는 장면 타겟을 풀에서 빌립니다. 배율이 1 이면 backbuffer 에
+  // 바로 그립니다
+  void AcquireSceneTarget();
+  SceneTargetType* CreateSceneTarget(const SceneTargetPoolType::DescType& desc);
+  ID3D11RenderTargetView* GetSceneRenderTargetView();
+  ID3D11DepthStencilView* GetSceneDepthStencilView();
+
+  int32_t width_ = 0;
+  int32_t height_ = 0;
   int32_t video_card_memory_ = 0;
   std::wstring video_card_name_{};
-  IDXGISwapChain* swap_chain_ = nullptr;
+  IDXGISwapChain2* swap_chain_ = nullptr;
+  // 대기열에 자리가 나면 신호를 받는 스왑 체인의 객체입니다
+  HANDLE frame_latency_waitable_ = nullptr;
+  PresenterClass presenter_{};
   ID3D11Device* device_ = nullptr;
   ID3D11DeviceContext* device_context_ = nullptr;
-  ID3D11RenderTargetView* render_target_view_ = nullptr;
+  DeviceContextClass* context_ = nullptr;
+  // 프로파일러를 끈 빌드에서는 해상도 조절을 위해 프레임 구간만 잽니다
+  D3DGpuProfilerType* gpu_profiler_ = nullptr;
+  ResourceManagerClass* resources_ = nullptr;
+  ResourceManagerClass::RenderTargetViewHandleType render_target_view_{};
   ID3D11Texture2D* depth_stencil_buffer_ = nullptr;
   ID3D11DepthStencilState* depth_stencil_state_ = nullptr;
-  ID3D11DepthStencilView* depth_stencil_view_ = nullptr;
+  ResourceManagerClass::DepthStencilViewHandleType depth_stencil_view_{};
   ID3D11RasterizerState* rasterizer_state_ = nullptr;
+  D3D11_VIEWPORT viewport_{};
+
+  UpscaleShaderClass* upscale_shader_ = nullptr;
+  DynamicResolutionClass dynamic_resolution_{};
+  SceneTargetPoolType scene_target_pool_{};
+  // 이번 프레임에 빌린 장면 타겟과 그 안에서 쓰는 크기입니다. 타겟이
+  // nullptr 이면 backbuffer 에 그립니다
+  SceneTargetType* scene_target_ = nullptr;
+  D3D11_VIEWPORT scene_viewport_{};
   DirectX::XMMATRIX projection_matrix_;
   DirectX::XMMATRIX world_matrix_;
   DirectX::XMMATRIX ortho_matrix_;
@@ -0,0 +1,64 @@
+#include "pch.h"
+#include "d3d_query_backend_class.h"
+
+#include "com_throw.h"
+
+bool D3DQueryBackendClass::Initialize(ID3D11Device* device,
+                                      ID3D11DeviceContext* context) {
+  if (device == nullptr || context == nullptr) return false;
+
+  device_ = device;
+  context_ = context;
+  return true;
+}
+
+D3DQueryBackendClass::QueryType D3DQueryBackendClass::CreateTimestamp() {
+  D3D11_QUERY_DESC query_desc{};
+  query_desc.Query = D3D11_QUERY_TIMESTAMP;
+
+  ID3D11Query* query = nullptr;
+  com::ThrowIfFailed(device_->CreateQuery(&query_desc, &query));
+  return query;
+}
+
+D3DQueryBackendClass::QueryType D3DQueryBackendClass::CreateDisjoint() {
+  D3D11_QUERY_DESC query_desc{};
+  query_desc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+
+  ID3D11Query* query = nullptr;
+  com::ThrowIfFailed(device_->CreateQuery(&query_desc, &query));
+  return query;
+}
+
+void D3DQueryBackendClass::Release(QueryType query) {
+  if (query) query->Release();
+}
+
+void D3DQueryBackendClass::Begin(QueryType query) { context_->Begin(query); }
+
+void D3DQueryBackendClass::End(QueryType query) { context_->End(query); }
+
+bool D3DQueryBackendClass::GetTimestamp(QueryType query, uint64_t& ticks) {
+  // 결과가 아직 없으면 S_FALSE 를 반환합니다
+  UINT64 data = 0;
+  const HRESULT result = context_->GetData(
+      query, &data, sizeof(data), D3D11_ASYNC_GETDATA_DONOTFLUSH);
+  com::ThrowIfFailed(result);
+  if (result != S_OK) return false;
+
+  ticks = data;
+  return true;
+}
+
+bool D3DQueryBackendClass::GetDisjoint(QueryType query, uint64_t& frequency,
+                                       bool& disjoint) {
+  D3D11_QUERY_DATA_TIMESTAMP_DISJOINT data{};
+  const HRESULT result = context_->GetData(
+      query, &data, sizeof(data), D3D11_ASYNC_GETDATA_DONOTFLUSH);
+  com::ThrowIfFailed(result);
+  if (result != S_OK) return false;
+
+  frequency = data.Frequency;
+  disjoint = data.Disjoint != FALSE;
+  return true;
+}
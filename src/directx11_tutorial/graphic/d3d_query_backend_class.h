@@ -0,0 +1,32 @@
+#pragma once
+#include <d3d11.h>
+
+#include <cstdint>
+
+#include "gpu_profiler_class.h"
+
+// GpuProfilerClass 가 쓰는 쿼리를 D3D11 쿼리로 만들고 즉시 컨텍스트에
+// 넣습니다. 결과는 플러시하지 않고 읽으므로 GPU 를 기다리지 않습니다.
+// 장치와 컨텍스트의 참조는 잡지 않습니다
+class D3DQueryBackendClass {
+ public:
+  using QueryType = ID3D11Query*;
+
+  bool Initialize(ID3D11Device* device, ID3D11DeviceContext* context);
+
+  QueryType CreateTimestamp();
+  QueryType CreateDisjoint();
+  void Release(QueryType query);
+
+  void Begin(QueryType query);
+  void End(QueryType query);
+
+  bool GetTimestamp(QueryType query, uint64_t& ticks);
+  bool GetDisjoint(QueryType query, uint64_t& frequency, bool& disjoint);
+
+ private:
+  ID3D11Device* device_ = nullptr;
+  ID3D11DeviceContext* context_ = nullptr;
+};
+
+using D3DGpuProfilerType = GpuProfilerClass<D3DQueryBackendClass>;
@@ -0,0 +1,396 @@
+#include "pch.h"
+#include "device_context_class.h"
+
+#include "com_throw.h"
+#include "command_list_class.h"
+
+static_assert(sizeof(StateFilterClass::ViewportType) == sizeof(D3D11_VIEWPORT),
+              "ViewportType must match D3D11_VIEWPORT");
+
+namespace {
+template <typename T>
+T* FromHandle(const void* handle) {
+  return static_cast<T*>(const_cast<void*>(handle));
+}
+
+template <typename T>
+T* const* FromHandles(const void* const* handles) {
+  return reinterpret_cast<T* const*>(const_cast<void* const*>(handles));
+}
+
+// 소프트웨어 명령 목록을 D3D 이름의 호출로 되돌립니다
+struct ReplayTargetType {
+  DeviceContextClass* context_;
+
+  void SetInputLayout(const void* layout) {
+    context_->IASetInputLayout(FromHandle<ID3D11InputLayout>(layout));
+  }
+  void SetVertexBuffers(const uint32_t start, const uint32_t count,
+                        const void* const* buffers, const uint32_t* strides,
+                        const uint32_t* offsets) {
+    context_->IASetVertexBuffers(start, count,
+                                 FromHandles<ID3D11Buffer>(buffers), strides,
+                                 offsets);
+  }
+  void SetIndexBuffer(const void* buffer, const uint32_t format,
+                      const uint32_t offset) {
+    context_->IASetIndexBuffer(FromHandle<ID3D11Buffer>(buffer),
+                               static_cast<DXGI_FORMAT>(format), offset);
+  }
+  void SetPrimitiveTopology(const uint32_t topology) {
+    context_->IASetPrimitiveTopology(
+        static_cast<D3D11_PRIMITIVE_TOPOLOGY>(topology));
+  }
+  void SetVertexShader(const void* shader) {
+    context_->VSSetShader(FromHandle<ID3D11VertexShader>(shader));
+  }
+  void SetPixelShader(const void* shader) {
+    context_->PSSetShader(FromHandle<ID3D11PixelShader>(shader));
+  }
+  void SetVertexConstantBuffers(const uint32_t start, const uint32_t count,
+                                const void* const* buffers,
+                                const uint32_t* first_constants,
+                                const uint32_t* constant_counts) {
+    if (first_constants)
+      context_->VSSetConstantBuffers1(start, count,
+                                      FromHandles<ID3D11Buffer>(buffers),
+                                      first_constants, constant_counts);
+    else
+      context_->VSSetConstantBuffers(start, count,
+                                     FromHandles<ID3D11Buffer>(buffers));
+  }
+  void SetPixelConstantBuffers(const uint32_t start, const uint32_t count,
+                               const void* const* buffers,
+                               const uint32_t*, const uint32_t*) {
+    context_->PSSetConstantBuffers(start, count,
+                                   FromHandles<ID3D11Buffer>(buffers));
+  }
+  void SetRenderTargets(const uint32_t count, const void* const* views,
+                        const void* depth_stencil_view) {
+    context_->OMSetRenderTargets(
+        count, FromHandles<ID3D11RenderTargetView>(views),
+        FromHandle<ID3D11DepthStencilView>(depth_stencil_view));
+  }
+  void SetDepthStencilState(const void* state, const uint32_t stencil_ref) {
+    context_->OMSetDepthStencilState(
+        FromHandle<ID3D11DepthStencilState>(state), stencil_ref);
+  }
+  void SetBlendState(const void* state, const float* blend_factor,
+                     const uint32_t sample_mask) {
+    context_->OMSetBlendState(FromHandle<ID3D11BlendState>(state),
+                              blend_factor, sample_mask);
+  }
+  void SetRasterizerState(const void* state) {
+    context_->RSSetState(FromHandle<ID3D11RasterizerState>(state));
+  }
+  void SetViewports(const uint32_t count,
+                    const StateFilterClass::ViewportType* viewports) {
+    context_->RSSetViewports(
+        count, reinterpret_cast<const D3D11_VIEWPORT*>(viewports));
+  }
+  void DrawIndexed(const uint32_t index_count, const uint32_t start_index,
+                   const int32_t base_vertex) {
+    context_->DrawIndexed(index_count, start_index, base_vertex);
+  }
+  void DrawIndexedInstanced(const uint32_t index_count,
+                            const uint32_t instance_count,
+                            const uint32_t start_index,
+                            const int32_t base_vertex,
+                            const uint32_t start_instance) {
+    context_->DrawIndexedInstanced(index_count, instance_count, start_index,
+                                   base_vertex, start_instance);
+  }
+};
+}  // namespace
+
+bool DeviceContextClass::Initialize(ID3D11DeviceContext* context) {
+  context_ = context;
+  context_->AddRef();
+
+  // 오프셋 바인딩을 지원하는 런타임이면 D3D11.1 인터페이스를 받아 둡니다
+  if (FAILED(context_->QueryInterface(__uuidof(ID3D11DeviceContext1),
+                                      reinterpret_cast<void**>(&context1_))))
+    context1_ = nullptr;
+
+  // 감싸기 전에 설정된 상태는 알 수 없습니다
+  state_filter_.Invalidate();
+  state_filter_.ResetCounters();
+  return true;
+}
+
+bool DeviceContextClass::Initialize(CommandListClass* command_list) {
+  command_list_ = command_list;
+
+  state_filter_.Invalidate();
+  state_filter_.ResetCounters();
+  return true;
+}
+
+void DeviceContextClass::Shutdown() {
+  command_list_ = nullptr;
+  gpu_profiler_ = nullptr;
+
+  if (context1_) {
+    context1_->Release();
+    context1_ = nullptr;
+  }
+
+  if (context_) {
+    context_->Release();
+    context_ = nullptr;
+  }
+}
+
+ID3D11DeviceContext* DeviceContextClass::GetContext() { return context_; }
+
+ID3D11DeviceContext1* DeviceContextClass::GetContext1() { return context1_; }
+
+StateFilterClass& DeviceContextClass::GetStateFilter() { return state_filter_; }
+
+void DeviceContextClass::SetGpuProfiler(
+    GpuProfilerClass<D3DQueryBackendClass>* gpu_profiler) {
+  gpu_profiler_ = gpu_profiler;
+}
+
+GpuProfilerClass<D3DQueryBackendClass>* DeviceContextClass::GetGpuProfiler() {
+  return gpu_profiler_;
+}
+
+void DeviceContextClass::ClearState() {
+  if (context_) context_->ClearState();
+  state_filter_.Invalidate();
+}
+
+ID3D11CommandList* DeviceContextClass::FinishCommandList() {
+  ID3D11CommandList* command_list = nullptr;
+  com::ThrowIfFailed(context_->FinishCommandList(FALSE, &command_list));
+  state_filter_.Invalidate();
+  return command_list;
+}
+
+void DeviceContextClass::ExecuteCommandList(ID3D11CommandList* command_list) {
+  context_->ExecuteCommandList(command_list, FALSE);
+  state_filter_.Invalidate();
+}
+
+void DeviceContextClass::ExecuteCommandList(
+    const CommandListClass& command_list) {
+  ReplayTargetType target{this};
+  command_list.Execute(target);
+}
+
+void DeviceContextClass::IASetInputLayout(ID3D11InputLayout* input_layout) {
+  if (state_filter_.SetInputLayout(input_layout) == false) return;
+
+  if (command_list_)
+    command_list_->SetInputLayout(input_layout);
+  else
+    context_->IASetInputLayout(input_layout);
+}
+
+void DeviceContextClass::IASetVertexBuffers(UINT start_slot, UINT buffer_count,
+                                            ID3D11Buffer* const* vertex_buffers,
+                                            const UINT* strides,
+                                            const UINT* offsets) {
+  // 바뀐 슬롯 구간만 다시 설정합니다
+  uint32_t start = 0, count = 0;
+  if (state_filter_.SetVertexBuffers(
+          start_slot, buffer_count,
+          reinterpret_cast<const void* const*>(vertex_buffers), strides,
+          offsets, start, count) == false)
+    return;
+
+  const uint32_t skip = start - start_slot;
+  if (command_list_)
+    command_list_->SetVertexBuffers(
+        start, count,
+        reinterpret_cast<const void* const*>(vertex_buffers + skip),
+        strides ? strides + skip : nullptr, offsets ? offsets + skip : nullptr);
+  else
+    context_->IASetVertexBuffers(start, count, vertex_buffers + skip,
+                                 strides + skip, offsets + skip);
+}
+
+void DeviceContextClass::IASetIndexBuffer(ID3D11Buffer* index_buffer,
+                                          DXGI_FORMAT format, UINT offset) {
+  if (state_filter_.SetIndexBuffer(index_buffer, format, offset) == false)
+    return;
+
+  if (command_list_)
+    command_list_->SetIndexBuffer(index_buffer, format, offset);
+  else
+    context_->IASetIndexBuffer(index_buffer, format, offset);
+}
+
+void DeviceContextClass::IASetPrimitiveTopology(
+    D3D11_PRIMITIVE_TOPOLOGY topology) {
+  if (state_filter_.SetPrimitiveTopology(topology) == false) return;
+
+  if (command_list_)
+    command_list_->SetPrimitiveTopology(topology);
+  else
+    context_->IASetPrimitiveTopology(topology);
+}
+
+void DeviceContextClass::VSSetShader(ID3D11VertexShader* vertex_shader) {
+  if (state_filter_.SetVertexShader(vertex_shader) == false) return;
+
+  if (command_list_)
+    command_list_->SetVertexShader(vertex_shader);
+  else
+    context_->VSSetShader(vertex_shader, nullptr, 0);
+}
+
+void DeviceContextClass::VSSetConstantBuffers(
+    UINT start_slot, UINT buffer_count,
+    ID3D11Buffer* const* constant_buffers) {
+  uint32_t start = 0, count = 0;
+  if (state_filter_.SetVertexConstantBuffers(
+          start_slot, buffer_count,
+          reinterpret_cast<const void* const*>(constant_buffers), nullptr,
+          nullptr, start, count) == false)
+    return;
+
+  ID3D11Buffer* const* buffers = constant_buffers + (start - start_slot);
+  if (command_list_)
+    command_list_->SetVertexConstantBuffers(
+        start, count, reinterpret_cast<const void* const*>(buffers), nullptr,
+        nullptr);
+  else
+    context_->VSSetConstantBuffers(start, count, buffers);
+}
+
+void DeviceContextClass::VSSetConstantBuffers1(
+    UINT start_slot, UINT buffer_count, ID3D11Buffer* const* constant_buffers,
+    const UINT* first_constants, const UINT* constant_counts) {
+  uint32_t start = 0, count = 0;
+  if (state_filter_.SetVertexConstantBuffers(
+          start_slot, buffer_count,
+          reinterpret_cast<const void* const*>(constant_buffers),
+          first_constants, constant_counts, start, count) == false)
+    return;
+
+  const uint32_t skip = start - start_slot;
+  if (command_list_)
+    command_list_->SetVertexConstantBuffers(
+        start, count,
+        reinterpret_cast<const void* const*>(constant_buffers + skip),
+        first_constants + skip, constant_counts + skip);
+  else
+    context1_->VSSetConstantBuffers1(start, count, constant_buffers + skip,
+                                     first_constants + skip,
+                                     constant_counts + skip);
+}
+
+void DeviceContextClass::PSSetShader(ID3D11PixelShader* pixel_shader) {
+  if (state_filter_.SetPixelShader(pixel_shader) == false) return;
+
+  if (command_list_)
+    command_list_->SetPixelShader(pixel_shader);
+  else
+    context_->PSSetShader(pixel_shader, nullptr, 0);
+}
+
+void DeviceContextClass::PSSetConstantBuffers(
+    UINT start_slot, UINT buffer_count,
+    ID3D11Buffer* const* constant_buffers) {
+  uint32_t start = 0, count = 0;
+  if (state_filter_.SetPixelConstantBuffers(
+          start_slot, buffer_count,
+          reinterpret_cast<const void* const*>(constant_buffers), nullptr,
+          nullptr, start, count) == false)
+    return;
+
+  ID3D11Buffer* const* buffers = constant_buffers + (start - start_slot);
+  if (command_list_)
+    command_list_->SetPixelConstantBuffers(
+        start, count, reinterpret_cast<const void* const*>(buffers), nullptr,
+        nullptr);
+  else
+    context_->PSSetConstantBuffers(start, count, buffers);
+}
+
+void DeviceContextClass::OMSetRenderTargets(
+    UINT view_count, ID3D11RenderTargetView* const* render_target_views,
+    ID3D11DepthStencilView* depth_stencil_view) {
+  const void* const* views =
+      reinterpret_cast<const void* const*>(render_target_views);
+  if (state_filter_.SetRenderTargets(view_count, views, depth_stencil_view) ==
+      false)
+    return;
+
+  if (command_list_)
+    command_list_->SetRenderTargets(view_count, views, depth_stencil_view);
+  else
+    context_->OMSetRenderTargets(view_count, render_target_views,
+                                 depth_stencil_view);
+}
+
+void DeviceContextClass::OMSetDepthStencilState(
+    ID3D11DepthStencilState* depth_stencil_state, UINT stencil_ref) {
+  if (state_filter_.SetDepthStencilState(depth_stencil_state, stencil_ref) ==
+      false)
+    return;
+
+  if (command_list_)
+    command_list_->SetDepthStencilState(depth_stencil_state, stencil_ref);
+  else
+    context_->OMSetDepthStencilState(depth_stencil_state, stencil_ref);
+}
+
+void DeviceContextClass::OMSetBlendState(ID3D11BlendState* blend_state,
+                                         const FLOAT blend_factor[4],
+                                         UINT sample_mask) {
+  if (state_filter_.SetBlendState(blend_state, blend_factor, sample_mask) ==
+      false)
+    return;
+
+  if (command_list_)
+    command_list_->SetBlendState(blend_state, blend_factor, sample_mask);
+  else
+    context_->OMSetBlendState(blend_state, blend_factor, sample_mask);
+}
+
+void DeviceContextClass::RSSetState(ID3D11RasterizerState* rasterizer_state) {
+  if (state_filter_.SetRasterizerState(rasterizer_state) == false) return;
+
+  if (command_list_)
+    command_list_->SetRasterizerState(rasterizer_state);
+  else
+    context_->RSSetState(rasterizer_state);
+}
+
+void DeviceContextClass::RSSetViewports(UINT viewport_count,
+                                        const D3D11_VIEWPORT* viewports) {
+  const StateFilterClass::ViewportType* shadow_viewports =
+      reinterpret_cast<const StateFilterClass::ViewportType*>(viewports);
+  if (state_filter_.SetViewports(viewport_count, shadow_viewports) == false)
+    return;
+
+  if (command_list_)
+    command_list_->SetViewports(viewport_count, shadow_viewports);
+  else
+    context_->RSSetViewports(viewport_count, viewports);
+}
+
+void DeviceContextClass::DrawIndexed(UINT index_count, UINT start_index,
+                                     INT base_vertex) {
+  if (command_list_)
+    command_list_->DrawIndexed(index_count, start_index, base_vertex);
+  else
+    context_->DrawIndexed(index_count, start_index, base_vertex);
+}
+
+void DeviceContextClass::DrawIndexedInstanced(UINT index_count,
+                                              UINT instance_count,
+                                              UINT start_index,
+                                              INT base_vertex,
+                                              UINT start_instance) {
+  if (command_list_)
+    command_list_->DrawIndexedInstanced(index_count, instance_count,
+                                        start_index, base_vertex,
+                                        start_instance);
+  else
+    context_->DrawIndexedInstanced(index_count, instance_count, start_index,
+                                   base_vertex, start_instance);
+}
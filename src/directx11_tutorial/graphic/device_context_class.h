@@ -0,0 +1,96 @@
+#pragma once
+#include <d3d11_1.h>
+
+#include "state_filter_class.h"
+
+class CommandListClass;
+class D3DQueryBackendClass;
+template <typename Backend>
+class GpuProfilerClass;
+
+// ID3D11DeviceContext 를 감싸 파이프라인 상태 설정을 StateFilterClass 로
+// 거르고, 이미 바인딩된 값과 같은 호출은 드라이버로 보내지 않습니다.
+// 상태 설정과 드로우는 이 클래스로, Map 이나 Clear 처럼 상태와 무관한
+// 호출은 GetContext() 로 직접 합니다. 바인딩된 객체는 컨텍스트가 참조를
+// 잡고 있으므로, 해제된 객체의 주소가 새 객체에 재사용되어 잘못 걸러지는
+// 일은 없습니다.
+// 드라이버 대신 CommandListClass 에 기록하도록 초기화하면, 걸러진 상태
+// 설정과 드로우가 소프트웨어 명령 목록에 쌓입니다. 이때 참조는 잡지
+// 않으므로 재생할 때까지 객체를 살려 두어야 합니다.
+class DeviceContextClass {
+ public:
+  // context 의 참조를 하나 더 잡습니다. 지연 컨텍스트도 감쌀 수 있습니다
+  bool Initialize(ID3D11DeviceContext* context);
+  // 호출을 command_list 에 기록합니다. GetContext() 는 nullptr 이므로
+  // Map 같은 직접 호출은 기록 전에 즉시 컨텍스트에서 끝내 두어야 합니다
+  bool Initialize(CommandListClass* command_list);
+  void Shutdown();
+
+  // 기록 중이면 nullptr 입니다
+  ID3D11DeviceContext* GetContext();
+  // 상수 버퍼 오프셋 바인딩(D3D11.1)을 쓸 수 없으면 nullptr 입니다
+  ID3D11DeviceContext1* GetContext1();
+  StateFilterClass& GetStateFilter();
+
+  // 이 컨텍스트에 넣는 명령의 GPU 시간을 잴 프로파일러입니다. 쿼리 결과는
+  // 즉시 컨텍스트에서만 읽을 수 있으므로 지연 컨텍스트와 기록 중인
+  // 컨텍스트는 nullptr 이고, PROFILE_GPU_SCOPE 는 아무것도 재지 않습니다
+  void SetGpuProfiler(GpuProfilerClass<D3DQueryBackendClass>* gpu_profiler);
+  GpuProfilerClass<D3DQueryBackendClass>* GetGpuProfiler();
+
+  // 컨텍스트의 모든 상태를 기본값으로 되돌리고 그림자 사본을 버립니다.
+  // 기록 중이면 그림자 사본만 버립니다
+  void ClearState();
+
+  // 지연 컨텍스트의 기록을 명령 목록으로 닫습니다. 지연 컨텍스트의 상태는
+  // 기본값으로 돌아갑니다
+  ID3D11CommandList* FinishCommandList();
+  // 명령 목록을 실행합니다. 실행 뒤 상태는 기본값이므로 그림자 사본을
+  // 버립니다
+  void ExecuteCommandList(ID3D11CommandList* command_list);
+  // 소프트웨어 명령 목록을 이 컨텍스트로 다시 호출합니다. 상태 설정을 다시
+  // 거르므로 목록 경계에서 겹치는 설정도 빠집니다
+  void ExecuteCommandList(const CommandListClass& command_list);
+
+  void IASetInputLayout(ID3D11InputLayout* input_layout);
+  void IASetVertexBuffers(UINT start_slot, UINT buffer_count,
+                          ID3D11Buffer* const* vertex_buffers,
+                          const UINT* strides, const UINT* offsets);
+  void IASetIndexBuffer(ID3D11Buffer* index_buffer, DXGI_FORMAT format,
+                        UINT offset);
+  void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology);
+
+  void VSSetShader(ID3D11VertexShader* vertex_shader);
+  void VSSetConstantBuffers(UINT start_slot, UINT buffer_count,
+                            ID3D11Buffer* const* constant_buffers);
+  void VSSetConstantBuffers1(UINT start_slot, UINT buffer_count,
+                             ID3D11Buffer* const* constant_buffers,
+                             const UINT* first_constants,
+                             const UINT* constant_counts);
+  void PSSetShader(ID3D11PixelShader* pixel_shader);
+  void PSSetConstantBuffers(UINT start_slot, UINT buffer_count,
+                            ID3D11Buffer* const* constant_buffers);
+
+  void OMSetRenderTargets(UINT view_count,
+                          ID3D11RenderTargetView* const* render_target_views,
+                          ID3D11DepthStencilView* depth_stencil_view);
+  void OMSetDepthStencilState(ID3D11DepthStencilState* depth_stencil_state,
+                              UINT stencil_ref);
+  void OMSetBlendState(ID3D11BlendState* blend_state,
+                       const FLOAT blend_factor[4], UINT sample_mask);
+
+  void RSSetState(ID3D11RasterizerState* rasterizer_state);
+  void RSSetViewports(UINT viewport_count, const D3D11_VIEWPORT* viewports);
+
+  void DrawIndexed(UINT index_count, UINT start_index, INT base_vertex);
+  void DrawIndexedInstanced(UINT index_count, UINT instance_count,
+                            UINT start_index, INT base_vertex,
+                            UINT start_instance);
+
+ private:
+  ID3D11DeviceContext* context_ = nullptr;
+  ID3D11DeviceContext1* context1_ = nullptr;
+  CommandListClass* command_list_ = nullptr;
+  GpuProfilerClass<D3DQueryBackendClass>* gpu_profiler_ = nullptr;
+  StateFilterClass state_filter_{};
+};
@@ -0,0 +1,67 @@
+#include "pch.h"
+#include "dynamic_resolution_class.h"
+
+#include <algorithm>
+#include <cmath>
+
+bool DynamicResolutionClass::Initialize(const SettingsType& settings) {
+  if (settings.budget_milliseconds_ <= 0.0) return false;
+  if (settings.min_scale_ <= 0.0f || settings.min_scale_ > settings.max_scale_)
+    return false;
+  if (settings.scale_step_ <= 0.0f || settings.dead_band_ < 0.0f) return false;
+
+  settings_ = settings;
+  Reset();
+  return true;
+}
+
+void DynamicResolutionClass::Reset() {
+  raw_scale_ = settings_.max_scale_;
+  scale_ = settings_.max_scale_;
+  error_[0] = 0.0f;
+  error_[1] = 0.0f;
+}
+
+float DynamicResolutionClass::Update(const double frame_milliseconds) {
+  if (frame_milliseconds <= 0.0) return scale_;
+
+  // 양수면 여유가 있고 음수면 예산을 넘었습니다. 한 프레임이 크게 튀어도
+  // 한 번에 예산만큼보다 많이 움직이지 않게 자릅니다
+  float error = static_cast<float>(
+      (settings_.budget_milliseconds_ - frame_milliseconds) /
+      settings_.budget_milliseconds_);
+  error = (std::clamp)(error, -1.0f, 1.0f);
+  if (std::fabs(error) < settings_.dead_band_) error = 0.0f;
+
+  // 증분형 PID 입니다. 적분 항이 연속 배율 자체에 쌓이므로 범위로 자르면
+  // 적분 포화도 함께 막힙니다
+  raw_scale_ += settings_.proportional_gain_ * (error - error_[0]) +
+                settings_.integral_gain_ * error +
+                settings_.derivative_gain_ *
+                    (error - 2.0f * error_[0] + error_[1]);
+  raw_scale_ =
+      (std::clamp)(raw_scale_, settings_.min_scale_, settings_.max_scale_);
+  error_[1] = error_[0];
+  error_[0] = error;
+
+  // 한 단위 넘게 벗어났을 때만 단위로 맞춰 바꿉니다. 범위 끝은 단위와
+  // 맞지 않아도 그대로 씁니다
+  if (raw_scale_ == settings_.min_scale_ ||
+      raw_scale_ == settings_.max_scale_) {
+    scale_ = raw_scale_;
+  } else if (std::fabs(raw_scale_ - scale_) >= settings_.scale_step_) {
+    const float stepped =
+        std::round(raw_scale_ / settings_.scale_step_) * settings_.scale_step_;
+    scale_ = (std::clamp)(stepped, settings_.min_scale_, settings_.max_scale_);
+  }
+
+  return scale_;
+}
+
+float DynamicResolutionClass::GetScale() { return scale_; }
+
+uint32_t DynamicResolutionClass::GetScaledSize(const uint32_t size) {
+  const uint32_t scaled =
+      static_cast<uint32_t>(std::lround(static_cast<double>(size) * scale_));
+  return (std::clamp)(scaled, 1u, (std::max)(size, 1u));
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+
+// 측정한 프레임 시간이 목표 예산에 맞도록 장면의 렌더링 해상도 배율을
+// 조절합니다. 오차는 (예산 - 프레임 시간) / 예산 이고, 증분형 PID 로
+// 연속 배율을 움직인 뒤 scale_step_ 단위로 자른 배율만 내보냅니다.
+// 작은 오차는 dead_band_ 로 무시하고, 연속 배율이 내보낸 배율에서 한 단위
+// 넘게 벗어나야 바꾸므로 잡음 섞인 프레임 시간에 배율이 흔들리지 않습니다.
+// 그래픽스 API 를 모르므로 기록한 프레임 시간 열로 시험할 수 있습니다.
+class DynamicResolutionClass {
+ public:
+  struct SettingsType {
+    // 프레임 하나에 쓸 수 있는 시간(ms)입니다
+    double budget_milliseconds_ = 16.0;
+    // 가로, 세로에 곱하는 배율의 범위입니다
+    float min_scale_ = 0.5f;
+    float max_scale_ = 1.0f;
+    float proportional_gain_ = 0.1f;
+    float integral_gain_ = 0.05f;
+    float derivative_gain_ = 0.02f;
+    // 예산에 대한 비율로 이보다 작은 오차는 0 으로 봅니다
+    float dead_band_ = 0.05f;
+    // 내보내는 배율의 단위입니다
+    float scale_step_ = 0.05f;
+  };
+
+  // 범위나 단위가 잘못되면 false 를 반환합니다. 배율은 최대에서 시작합니다
+  bool Initialize(const SettingsType& settings);
+  // 오차 기록을 지우고 배율을 최대로 되돌립니다
+  void Reset();
+
+  // 지난 프레임의 시간으로 배율을 갱신하고 반환합니다. 0 이하의 시간은
+  // 무시합니다
+  float Update(const double frame_milliseconds);
+
+  float GetScale();
+  // size 에 배율을 곱해 반올림한 크기입니다. 1 이상, size 이하입니다
+  uint32_t GetScaledSize(const uint32_t size);
+
+ private:
+  SettingsType settings_{};
+  // 자르기 전의 연속 배율과 내보내는 배율입니다
+  float raw_scale_ = 1.0f;
+  float scale_ = 1.0f;
+  // 지난 두 프레임의 오차입니다
+  float error_[2]{};
+};
@@ -0,0 +1,45 @@
+#include "pch.h"
+#include "frustum_class.h"
+
+void FrustumClass::ConstructFrustum(const DirectX::XMMATRIX& view_projection) {
+  DirectX::XMFLOAT4X4 matrix{};
+  DirectX::XMStoreFloat4x4(&matrix, view_projection);
+
+  // 행 벡터 규약(clip = v * M)이므로 M 의 열로 평면을 조합합니다.
+  // D3D 의 클립 공간 z 범위는 [0, w] 입니다
+  auto column = [&matrix](const int32_t index) {
+    return DirectX::XMVectorSet(matrix.m[0][index], matrix.m[1][index],
+                                matrix.m[2][index], matrix.m[3][index]);
+  };
+  const DirectX::XMVECTOR x = column(0);
+  const DirectX::XMVECTOR y = column(1);
+  const DirectX::XMVECTOR z = column(2);
+  const DirectX::XMVECTOR w = column(3);
+
+  const DirectX::XMVECTOR planes[PLANE_COUNT] = {
+      DirectX::XMVectorAdd(w, x),       // 왼쪽
+      DirectX::XMVectorSubtract(w, x),  // 오른쪽
+      DirectX::XMVectorAdd(w, y),       // 아래
+      DirectX::XMVectorSubtract(w, y),  // 위
+      z,                                // 가까운 평면
+      DirectX::XMVectorSubtract(w, z),  // 먼 평면
+  };
+
+  for (uint32_t i = 0; i < PLANE_COUNT; i++)
+    DirectX::XMStoreFloat4(&planes_[i], DirectX::XMPlaneNormalize(planes[i]));
+}
+
+bool FrustumClass::CheckBox(const DirectX::XMFLOAT3& min,
+                            const DirectX::XMFLOAT3& max) {
+  // 평면 법선 방향으로 가장 멀리 있는 꼭짓점마저 밖이면 상자 전체가 밖입니다
+  for (const DirectX::XMFLOAT4& plane : planes_) {
+    const float x = plane.x > 0.0f ? max.x : min.x;
+    const float y = plane.y > 0.0f ? max.y : min.y;
+    const float z = plane.z > 0.0f ? max.z : min.z;
+    if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f) return false;
+  }
+
+  return true;
+}
+
+const DirectX::XMFLOAT4* FrustumClass::GetPlanes() { return planes_; }
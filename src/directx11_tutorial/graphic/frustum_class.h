@@ -0,0 +1,22 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+
+// 뷰-투영 행렬에서 뽑은 여섯 개의 절두체 평면입니다.
+// 평면 법선은 절두체 안쪽을 향하고 길이 1 로 정규화되어 있습니다.
+class FrustumClass {
+ public:
+  static const uint32_t PLANE_COUNT = 6;
+
+  // CameraClass 의 뷰 행렬과 D3DClass 의 투영 행렬을 곱한 행렬로 만듭니다
+  void ConstructFrustum(const DirectX::XMMATRIX& view_projection);
+
+  // 축 정렬 상자가 절두체와 조금이라도 겹치면 true 를 반환합니다
+  bool CheckBox(const DirectX::XMFLOAT3& min, const DirectX::XMFLOAT3& max);
+
+  // 평면은 (nx, ny, nz, d) 이고 점 p 에 대해 dot(n, p) + d >= 0 이 안쪽입니다
+  const DirectX::XMFLOAT4* GetPlanes();
+
+ private:
+  DirectX::XMFLOAT4 planes_[PLANE_COUNT]{};
+};
@@ -0,0 +1,292 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "framework/profiler.h"
+
+// GPU 타임스탬프 쿼리로 이름 붙인 구간의 GPU 시간을 잽니다. 프레임마다
+// 쿼리 묶음 하나를 쓰고 frame_count 개의 묶음을 돌려 쓰므로, 결과는 몇
+// 프레임 뒤 GPU 가 끝낸 묶음에서 기다리지 않고 읽습니다. 아직 끝나지 않은
+// 묶음으로 돌아오면 그 프레임은 재지 않고 건너뜁니다.
+// 구간은 중첩할 수 있고, 읽은 결과는 profiler::Now() 시각으로 바꿔 CPU
+// 구간과 같은 트레이스의 GPU 트랙에 기록합니다. D3D11 에는 GPU 와 CPU
+// 시계를 맞추는 방법이 없으므로, 프레임의 첫 타임스탬프를 그 쿼리를 넣은
+// CPU 시각과 지난 프레임의 GPU 끝 시각 중 늦은 쪽에 맞춥니다.
+// Backend 는 아래 함수를 가진 쿼리 구현이면 되므로 D3D 없이도 시험할 수
+// 있습니다.
+//   QueryType, CreateTimestamp(), CreateDisjoint(), Release(query),
+//   Begin(query), End(query), GetTimestamp(query, ticks),
+//   GetDisjoint(query, frequency, disjoint)
+// Get 함수는 결과가 아직 없으면 false 를 반환합니다.
+template <typename Backend>
+class GpuProfilerClass {
+ public:
+  using QueryType = typename Backend::QueryType;
+
+  // 읽어 낸 구간 하나입니다. 시각은 profiler::Now() 와 같은 나노초입니다
+  struct ZoneType {
+    const char* name_;
+    uint32_t depth_;
+    int64_t begin_;
+    int64_t end_;
+  };
+
+  // 쿼리는 여기서 모두 만듭니다. max_scopes 는 프레임 구간을 포함한
+  // 프레임당 구간 수이고, 넘친 구간은 재지 않습니다
+  bool Initialize(const Backend& backend, const uint32_t frame_count,
+                  const uint32_t max_scopes);
+  // 쿼리를 모두 해제합니다. 읽지 않은 결과는 버립니다
+  void Shutdown();
+
+  // GPU 가 끝낸 지난 프레임들을 읽고, 이번 프레임의 "GPU frame" 구간을
+  // 엽니다. cpu_time 은 지금의 profiler::Now() 입니다
+  void BeginFrame(const int64_t cpu_time);
+  // 프레임 구간을 닫습니다. 열린 구간이 남아 있으면 함께 닫습니다
+  void EndFrame();
+
+  // name 은 프로그램이 끝날 때까지 유효한 문자열(리터럴)이어야 합니다
+  void BeginScope(const char* name);
+  void EndScope();
+
+  // 가장 최근에 읽은 프레임의 구간들입니다. 여는 순서로 놓여 있습니다
+  const std::vector<ZoneType>& GetZones() const { return zones_; }
+  // 가장 최근에 읽은 프레임의 GPU 시간(ns)입니다
+  int64_t GetFrameTime() const {
+    return zones_.empty() ? 0 : zones_[0].end_ - zones_[0].begin_;
+  }
+  uint64_t GetResolvedFrameCount() const { return resolved_frame_count_; }
+  // 묶음이 끝나지 않아 건너뛰었거나 GPU 시계가 흔들려 버린 프레임 수입니다
+  uint64_t GetDroppedFrameCount() const { return dropped_frame_count_; }
+
+ private:
+  static constexpr uint32_t NO_SCOPE = 0xffffffff;
+
+  // 구간 i 는 timestamps_[2 * i] 에서 열고 timestamps_[2 * i + 1] 에서
+  // 닫습니다
+  struct ScopeType {
+    const char* name_;
+    uint32_t depth_;
+  };
+
+  struct FrameType {
+    QueryType disjoint_;
+    std::vector<QueryType> timestamps_;
+    std::vector<ScopeType> scopes_;
+    int64_t cpu_time_;
+    bool pending_;
+  };
+
+  // 오래된 프레임부터 끝난 것을 읽습니다
+  void Resolve();
+  // frame 의 결과를 모두 읽었으면 zones_ 에 쓰고 true 를 반환합니다
+  bool ResolveFrame(FrameType& frame);
+
+  Backend backend_{};
+  uint32_t max_scopes_ = 0;
+  std::vector<FrameType> frames_;
+  // 이번 프레임이 쓰는 묶음과, 그 프레임을 재고 있는지입니다
+  uint64_t frame_index_ = 0;
+  bool frame_active_ = false;
+  // 가장 오래된 읽지 않은 묶음입니다
+  uint64_t resolve_index_ = 0;
+  // 열려 있는 구간 번호입니다. 재지 않는 구간은 NO_SCOPE 입니다
+  std::vector<uint32_t> open_scopes_;
+  // 읽고 있는 묶음의 타임스탬프 값입니다
+  std::vector<uint64_t> ticks_;
+
+  std::vector<ZoneType> zones_;
+  int64_t last_gpu_end_ = 0;
+  uint64_t resolved_frame_count_ = 0;
+  uint64_t dropped_frame_count_ = 0;
+};
+
+// 스코프가 끝날 때 구간을 닫습니다. profiler 가 nullptr 이면 아무것도 재지
+// 않습니다
+template <typename Profiler>
+class ScopedGpuZone {
+ public:
+  ScopedGpuZone(Profiler* profiler, const char* name) : profiler_(profiler) {
+    if (profiler_) profiler_->BeginScope(name);
+  }
+  ~ScopedGpuZone() {
+    if (profiler_) profiler_->EndScope();
+  }
+
+  ScopedGpuZone(const ScopedGpuZone&) = delete;
+  ScopedGpuZone& operator=(const ScopedGpuZone&) = delete;
+
+ private:
+  Profiler* profiler_;
+};
+
+#if PROFILER_ENABLED
+#define PROFILE_GPU_SCOPE(profiler, name) \
+  ::ScopedGpuZone PROFILE_CONCAT(profile_gpu_zone_, __LINE__)(profiler, name)
+#else
+#define PROFILE_GPU_SCOPE(profiler, name) ((void)0)
+#endif
+
+template <typename Backend>
+bool GpuProfilerClass<Backend>::Initialize(const Backend& backend,
+                                           const uint32_t frame_count,
+                                           const uint32_t max_scopes) {
+  if (frame_count == 0 || max_scopes == 0) return false;
+
+  backend_ = backend;
+  max_scopes_ = max_scopes;
+
+  frames_.resize(frame_count);
+  for (FrameType& frame : frames_) {
+    frame.disjoint_ = backend_.CreateDisjoint();
+    frame.timestamps_.resize(2 * max_scopes);
+    for (QueryType& timestamp : frame.timestamps_)
+      timestamp = backend_.CreateTimestamp();
+    frame.scopes_.reserve(max_scopes);
+    frame.cpu_time_ = 0;
+    frame.pending_ = false;
+  }
+
+  open_scopes_.reserve(max_scopes);
+  ticks_.resize(2 * max_scopes);
+  zones_.reserve(max_scopes);
+  frame_index_ = 0;
+  frame_active_ = false;
+  resolve_index_ = 0;
+  last_gpu_end_ = 0;
+  resolved_frame_count_ = 0;
+  dropped_frame_count_ = 0;
+  return true;
+}
+
+template <typename Backend>
+void GpuProfilerClass<Backend>::Shutdown() {
+  for (FrameType& frame : frames_) {
+    for (QueryType& timestamp : frame.timestamps_) backend_.Release(timestamp);
+    backend_.Release(frame.disjoint_);
+  }
+  frames_.clear();
+  open_scopes_.clear();
+  zones_.clear();
+  frame_active_ = false;
+}
+
+template <typename Backend>
+void GpuProfilerClass<Backend>::BeginFrame(const int64_t cpu_time) {
+  if (frames_.empty()) return;
+
+  Resolve();
+
+  // 돌아온 묶음을 GPU 가 아직 끝내지 않았으면 기다리지 않고 건너뜁니다
+  FrameType& frame = frames_[frame_index_ % frames_.size()];
+  open_scopes_.clear();
+  frame_active_ = frame.pending_ == false;
+  if (frame_active_ == false) {
+    dropped_frame_count_++;
+    return;
+  }
+
+  frame.scopes_.clear();
+  frame.cpu_time_ = cpu_time;
+  backend_.Begin(frame.disjoint_);
+  BeginScope("GPU frame");
+}
+
+template <typename Backend>
+void GpuProfilerClass<Backend>::EndFrame() {
+  if (frame_active_ == false) return;
+
+  while (open_scopes_.empty() == false) EndScope();
+
+  FrameType& frame = frames_[frame_index_ % frames_.size()];
+  backend_.End(frame.disjoint_);
+  frame.pending_ = true;
+  frame_index_++;
+  frame_active_ = false;
+}
+
+template <typename Backend>
+void GpuProfilerClass<Backend>::BeginScope(const char* name) {
+  if (frame_active_ == false) return;
+
+  FrameType& frame = frames_[frame_index_ % frames_.size()];
+  const uint32_t scope = static_cast<uint32_t>(frame.scopes_.size());
+  if (scope == max_scopes_) {
+    open_scopes_.push_back(NO_SCOPE);
+    return;
+  }
+
+  frame.scopes_.push_back({name, static_cast<uint32_t>(open_scopes_.size())});
+  backend_.End(frame.timestamps_[2 * scope]);
+  open_scopes_.push_back(scope);
+}
+
+template <typename Backend>
+void GpuProfilerClass<Backend>::EndScope() {
+  if (frame_active_ == false || open_scopes_.empty()) return;
+
+  const uint32_t scope = open_scopes_.back();
+  open_scopes_.pop_back();
+  if (scope == NO_SCOPE) return;
+
+  FrameType& frame = frames_[frame_index_ % frames_.size()];
+  backend_.End(frame.timestamps_[2 * scope + 1]);
+}
+
+template <typename Backend>
+void GpuProfilerClass<Backend>::Resolve() {
+  // 묶음은 넣은 순서대로 끝나므로 끝나지 않은 묶음을 만나면 멈춥니다
+  while (resolve_index_ < frame_index_) {
+    FrameType& frame = frames_[resolve_index_ % frames_.size()];
+    if (ResolveFrame(frame) == false) break;
+
+    frame.pending_ = false;
+    resolve_index_++;
+  }
+}
+
+template <typename Backend>
+bool GpuProfilerClass<Backend>::ResolveFrame(FrameType& frame) {
+  uint64_t frequency = 0;
+  bool disjoint = false;
+  if (backend_.GetDisjoint(frame.disjoint_, frequency, disjoint) == false)
+    return false;
+
+  // 시계가 흔들렸거나 주파수를 모르면 타임스탬프를 믿을 수 없습니다
+  if (disjoint || frequency == 0) {
+    dropped_frame_count_++;
+    return true;
+  }
+
+  const uint32_t scope_count = static_cast<uint32_t>(frame.scopes_.size());
+  for (uint32_t i = 0; i < 2 * scope_count; i++)
+    if (backend_.GetTimestamp(frame.timestamps_[i], ticks_[i]) == false)
+      return false;
+
+  // 프레임의 첫 타임스탬프를 CPU 시계의 한 시각에 맞추고 나머지는 그로부터
+  // 지난 시간으로 바꿉니다
+  const int64_t origin = (std::max)(frame.cpu_time_, last_gpu_end_);
+  const double nanoseconds_per_tick = 1e9 / static_cast<double>(frequency);
+  const auto to_cpu_time = [&](const uint32_t query) {
+    // 드라이버가 닫는 시각을 여는 시각보다 앞서 돌려주는 일도 있습니다
+    const uint64_t elapsed =
+        ticks_[query] > ticks_[0] ? ticks_[query] - ticks_[0] : 0;
+    return origin + static_cast<int64_t>(static_cast<double>(elapsed) *
+                                         nanoseconds_per_tick);
+  };
+
+  zones_.clear();
+  for (uint32_t i = 0; i < scope_count; i++) {
+    const ScopeType& scope = frame.scopes_[i];
+    const int64_t begin = to_cpu_time(2 * i);
+    const int64_t end = (std::max)(begin, to_cpu_time(2 * i + 1));
+    zones_.push_back({scope.name_, scope.depth_, begin, end});
+#if PROFILER_ENABLED
+    profiler::RecordGpu(scope.name_, begin, end);
+#endif
+  }
+
+  if (zones_.empty() == false) last_gpu_end_ = zones_[0].end_;
+  resolved_frame_count_++;
+  return true;
+}
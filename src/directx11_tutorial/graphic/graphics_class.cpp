@@ -1,16 +1,90 @@
 #include "pch.h"
 #include "graphics_class.h"
 
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
 #include "d3d_class.h"
+#include "d3d_query_backend_class.h"
+#include "device_context_class.h"
+#include "color_shader_class.h"
+#include "upscale_shader_class.h"
+#include "command_recorder_class.h"
+#endif
+#include "soft_rasterizer_class.h"
 #include "camera_class.h"
 #include "model_class.h"
-#include "color_shader_class.h"
+#include "transform_class.h"
+#include "frustum_class.h"
+#include "bvh_class.h"
+#include "lod_selector_class.h"
+#include "render_queue_class.h"
+#include "framework/profiler.h"
+#include "framework/job_system_class.h"
+#include "framework/frame_arena_class.h"
+
+#if defined(_WIN32)
+namespace {
+// 렌더 큐 키의 레이어, 재질, 메시 번호입니다. 지금은 불투명 레이어에
+// 재질이 없는 모델 하나뿐입니다
+const uint32_t OPAQUE_LAYER = 0;
+const uint32_t DEFAULT_MATERIAL = 0;
+const uint32_t MODEL_MESH = 0;
+
+// 정렬된 렌더 큐를 D3D 호출로 옮깁니다. 키가 바뀐 상태만 바인딩됩니다
+struct RenderExecutorType {
+  DeviceContextClass* device_context_;
+  ColorShaderClass* color_shader_;
+  ModelClass* model_;
+
+  void BindLayer(const uint32_t) {}
+  void BindShader(const uint32_t shader) {
+    color_shader_->SetProgram(
+        device_context_, static_cast<ColorShaderClass::ProgramType>(shader));
+  }
+  void BindMaterial(const uint32_t) {}
+  void BindMesh(const uint32_t) { model_->Render(device_context_); }
+
+  void Draw(const RenderQueueClass::DrawType& draw) {
+    if (draw.instance_count_ > 0) {
+      color_shader_->DrawInstanced(
+          device_context_, {draw.index_count_, draw.instance_count_,
+                            draw.start_index_, draw.start_instance_});
+    } else {
+      color_shader_->Draw(device_context_,
+                          static_cast<int32_t>(draw.index_count_),
+                          draw.start_index_, {draw.constant_offset_});
+    }
+  }
+};
+}  // namespace
 
 bool GraphicsClass::Initialize(const int32_t width, const int32_t height,
-                               HWND hwnd) {
+                               HWND hwnd,
+                               const std::filesystem::path& model_path) {
+  job_system_ = new JobSystemClass{};
+  if (job_system_ == nullptr) return false;
+  if (job_system_->Initialize() == false) return false;
+
+  frame_arena_ = new FrameArenaClass{};
+  if (frame_arena_ == nullptr) return false;
+  if (frame_arena_->Initialize(FRAME_ARENA_CAPACITY, FRAME_ARENA_FRAMES) ==
+      false)
+    return false;
+
+  // 스왑 체인은 윈도우 스레드에서 만듭니다
   d3d_ = new D3DClass{};
   if (d3d_ == nullptr) return false;
-  if (d3d_->Initialize(width, height, VSYNC_ENABLED, hwnd, FULL_SCREEN,
+  PresenterClass::SettingsType present{};
+  present.mode_ = PRESENT_MODE;
+  present.frame_rate_limit_ = FRAME_RATE_LIMIT;
+  present.buffer_count_ = SWAP_CHAIN_BUFFER_COUNT;
+  present.max_frame_latency_ = MAX_FRAME_LATENCY;
+  if (d3d_->Initialize(width, height, present, hwnd, FULL_SCREEN,
                        SCREEN_DEPTH, SCREEN_NEAR) == false) {
     ::MessageBox(hwnd, L"Could not initialzie Direct3D", L"Error", MB_OK);
     return false;
@@ -22,27 +96,312 @@ bool GraphicsClass::Initialize(const int32_t width, const int32_t height,
 
   model_ = new ModelClass{};
   if (model_ == nullptr) return false;
-  if (model_->Initialize(d3d_->GetDevice()) == false) {
-    MessageBox(hwnd, L"Could not initialize the model object.", L"Error",
-               MB_OK);
-    return false;
-  }
+  model_->SetVertexFormat(VERTEX_FORMAT);
 
   color_shader_ = new ColorShaderClass{};
   if (color_shader_ == nullptr) return false;
-  if (color_shader_->Initialize(d3d_->GetDevice(), hwnd) == false) {
-    ::MessageBox(hwnd, L"Could not initialzie the color shader object.", L"Error", MB_OK);
+
+  if (DYNAMIC_RESOLUTION) {
+    upscale_shader_ = new UpscaleShaderClass{};
+    if (upscale_shader_ == nullptr) return false;
+  }
+
+  // 디바이스는 free-threaded 이므로 모델과 셰이더를 동시에 불러옵니다.
+  // 모델 파싱과 셰이더 컴파일도 안에서 같은 작업 시스템으로 나눠집니다.
+  // 작업 스레드에서는 창을 띄울 수 없고 예외가 밖으로 나가면 프로그램이
+  // 끝나므로, 결과와 오류 메시지를 모았다가 모두 끝난 뒤 여기서 알립니다
+  const uint32_t job_count = upscale_shader_ ? 3 : 2;
+  bool results[3] = {};
+  std::string errors[3];
+  job_system_->ParallelFor(job_count, [&](uint32_t job) {
+    try {
+      if (job == 0) {
+        results[job] =
+            InitializeModel(d3d_->GetResourceManager(), model_path);
+      } else if (job == 1) {
+        results[job] = color_shader_->Initialize(
+            d3d_->GetResourceManager(), PRECOMPUTED_WVP, VERTEX_FORMAT,
+            job_system_);
+        if (results[job] == false) errors[job] = color_shader_->GetError();
+      } else {
+        results[job] = upscale_shader_->Initialize(d3d_->GetResourceManager(),
+                                                   job_system_);
+        if (results[job] == false) errors[job] = upscale_shader_->GetError();
+      }
+    } catch (const std::exception& exception) {
+      results[job] = false;
+      errors[job] = exception.what();
+    }
+  });
+
+  const char* failures[3] = {"Could not initialize the model object.",
+                             "Could not initialize the color shader object.",
+                             "Could not initialize the upscale shader object."};
+  for (uint32_t job = 0; job < job_count; job++) {
+    if (results[job]) continue;
+
+    // 셰이더 컴파일러 메시지는 ANSI 문자열입니다
+    OutputDebugStringA(errors[job].c_str());
+    const char* message =
+        errors[job].empty() ? failures[job] : errors[job].c_str();
+    ::MessageBoxA(hwnd, message, failures[job], MB_OK);
+    return false;
+  }
+
+  // 장면을 낮춘 해상도로 그려 늘리는 동적 해상도를 켭니다
+  if (upscale_shader_) {
+    DynamicResolutionClass::SettingsType resolution{};
+    resolution.budget_milliseconds_ = FRAME_TIME_BUDGET_MS;
+    resolution.min_scale_ = MIN_RESOLUTION_SCALE;
+    if (d3d_->SetDynamicResolution(upscale_shader_, resolution) == false)
+      return false;
+  }
+
+  render_queue_ = new RenderQueueClass{};
+  if (render_queue_ == nullptr) return false;
+  if (render_queue_->Initialize(RENDER_QUEUE_CAPACITY) == false) return false;
+
+  // 작업 스레드마다 묶음 하나를 기록할 수 있게 합니다
+  command_recorder_ = new CommandRecorderClass{};
+  if (command_recorder_ == nullptr) return false;
+  if (command_recorder_->Initialize(d3d_->GetDevice(),
+                                    job_system_->GetThreadCount()) == false)
+    return false;
+
+  // 모델이 소비할 CPU 측 인스턴스 목록을 만듭니다
+  if (INSTANCED_RENDERING) {
+    DirectX::XMMATRIX world_matrix{}, projection_matrix{};
+    d3d_->GetWorldMatrix(world_matrix);
+    d3d_->GetProjectionMatrix(projection_matrix);
+    if (BuildInstances(world_matrix) == false) return false;
+
+    lod_selector_ = new LodSelectorClass{};
+    if (lod_selector_ == nullptr) return false;
+    lod_selector_->SetProjection(projection_matrix, height);
+    lod_selector_->SetErrorThreshold(LOD_PIXEL_ERROR, LOD_HYSTERESIS);
+  }
+
+  return true;
+}
+#endif
+
+bool GraphicsClass::InitializeModel(ResourceManagerClass* resources,
+                                    const std::filesystem::path& model_path) {
+  if (model_path.empty()) return model_->Initialize(resources);
+
+  // OBJ, PLY 파싱은 작업 시스템으로 나눠 처리합니다
+  return model_->Initialize(resources, model_path, job_system_);
+}
+
+bool GraphicsClass::BuildInstances(const DirectX::XMMATRIX& world) {
+  const float spacing = 2.5f;
+  const float origin = -0.5f * spacing * (INSTANCE_GRID_SIZE - 1);
+  const int32_t count = INSTANCE_GRID_SIZE * INSTANCE_GRID_SIZE;
+
+  TransformClass transforms{};
+  if (transforms.Initialize(count + 1) == false) return false;
+
+  // 전달받은 월드 행렬을 모든 인스턴스의 부모 변환으로 둡니다
+  DirectX::XMVECTOR scale{}, rotation{}, translation{};
+  DirectX::XMMatrixDecompose(&scale, &rotation, &translation, world);
+
+  DirectX::XMFLOAT3 root_scale{}, root_translation{};
+  DirectX::XMFLOAT4 root_rotation{};
+  DirectX::XMStoreFloat3(&root_scale, scale);
+  DirectX::XMStoreFloat4(&root_rotation, rotation);
+  DirectX::XMStoreFloat3(&root_translation, translation);
+
+  const int32_t root = transforms.Create();
+  transforms.SetScale(root, root_scale.x, root_scale.y, root_scale.z);
+  transforms.SetRotation(root, root_rotation);
+  transforms.SetPosition(root, root_translation.x, root_translation.y,
+                         root_translation.z);
+
+  // 원점을 중심으로 XY 평면에 격자로 배치합니다
+  for (int32_t y = 0; y < INSTANCE_GRID_SIZE; y++) {
+    for (int32_t x = 0; x < INSTANCE_GRID_SIZE; x++) {
+      const int32_t index = transforms.Create(root);
+      transforms.SetPosition(index, origin + spacing * x,
+                             origin + spacing * y, 0.0f);
+    }
+  }
+
+  transforms.Update(job_system_);
+
+  // 연속된 월드 행렬을 인스턴스 목록으로 옮기고, 모델의 경계 상자를
+  // 월드 공간으로 옮겨 BVH 를 만듭니다
+  BvhClass::BoundsType model_bounds{};
+  model_->GetBoundingBox(model_bounds.min_, model_bounds.max_);
+
+  // LOD 거리는 모델 경계 상자를 감싸는 구로 잽니다
+  const DirectX::XMVECTOR model_min = DirectX::XMLoadFloat3(&model_bounds.min_);
+  const DirectX::XMVECTOR model_max = DirectX::XMLoadFloat3(&model_bounds.max_);
+  const DirectX::XMVECTOR model_center =
+      DirectX::XMVectorScale(DirectX::XMVectorAdd(model_min, model_max), 0.5f);
+  const float model_radius =
+      0.5f * DirectX::XMVectorGetX(DirectX::XMVector3Length(
+                 DirectX::XMVectorSubtract(model_max, model_min)));
+
+  const DirectX::XMFLOAT4X4* worlds = transforms.GetWorldMatrices();
+  std::vector<BvhClass::BoundsType> bounds(count);
+  instances_.resize(count);
+  instance_lods_.resize(count);
+  for (int32_t i = 0; i < count; i++) {
+    instances_[i].world_ = worlds[root + 1 + i];
+    instances_[i].color_ = DirectX::XMFLOAT4{1.0f, 1.0f, 1.0f, 1.0f};
+
+    const DirectX::XMMATRIX world =
+        DirectX::XMLoadFloat4x4(&instances_[i].world_);
+    bounds[i] = BvhClass::TransformBounds(model_bounds, world);
+
+    // 행 벡터 규약이므로 앞 세 행의 길이가 축 배율입니다
+    const float scale = (std::max)(
+        (std::max)(
+            DirectX::XMVectorGetX(DirectX::XMVector3Length(world.r[0])),
+            DirectX::XMVectorGetX(DirectX::XMVector3Length(world.r[1]))),
+        DirectX::XMVectorGetX(DirectX::XMVector3Length(world.r[2])));
+    InstanceLodType& lod = instance_lods_[i];
+    DirectX::XMStoreFloat3(
+        &lod.center_, DirectX::XMVector3TransformCoord(model_center, world));
+    lod.radius_ = model_radius * scale;
+    lod.scale_ = scale;
+    lod.level_ = 0;
+  }
+  transforms.Shutdown();
+
+  frustum_ = new FrustumClass{};
+  if (frustum_ == nullptr) return false;
+
+  bvh_ = new BvhClass{};
+  if (bvh_ == nullptr) return false;
+  return bvh_->Build(bounds.data(), count);
+}
+
+void GraphicsClass::CullInstances(const DirectX::XMMATRIX& view_projection) {
+  PROFILE_FUNCTION();
+
+  frustum_->ConstructFrustum(view_projection);
+  bvh_->Cull(*frustum_, visible_);
+
+  // 카메라에서 경계 구 표면까지의 거리로 보이는 인스턴스의 LOD 를 고릅니다
+  const DirectX::XMFLOAT3 camera_position = camera_->GetPosition();
+  const DirectX::XMVECTOR eye = DirectX::XMLoadFloat3(&camera_position);
+  const ModelClass::LodType* lods = model_->GetLods();
+  const uint32_t lod_count = static_cast<uint32_t>(model_->GetLodCount());
+
+  const uint32_t visible_count = static_cast<uint32_t>(visible_.size());
+  const uint32_t chunk_count =
+      (visible_count + LOD_CHUNK_SIZE - 1) / LOD_CHUNK_SIZE;
+  // 묶음마다 MAX_LODS 개씩, 단계별 인스턴스 수를 센 뒤 모을 위치로
+  // 바꿉니다. 이번 프레임에만 쓰므로 프레임 할당기에서 받습니다
+  uint32_t* chunk_lod_offsets = frame_arena_->Allocate<uint32_t>(
+      size_t{chunk_count} * ModelClass::MAX_LODS);
+  std::fill_n(chunk_lod_offsets, size_t{chunk_count} * ModelClass::MAX_LODS,
+              0);
+
+  job_system_->ParallelFor(chunk_count, [&](uint32_t chunk) {
+    uint32_t* counts =
+        chunk_lod_offsets + size_t{chunk} * ModelClass::MAX_LODS;
+    const uint32_t begin = chunk * LOD_CHUNK_SIZE;
+    const uint32_t end = (std::min)(begin + LOD_CHUNK_SIZE, visible_count);
+    for (uint32_t i = begin; i < end; i++) {
+      InstanceLodType& lod = instance_lods_[visible_[i]];
+      const float distance =
+          DirectX::XMVectorGetX(DirectX::XMVector3Length(
+              DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&lod.center_),
+                                        eye))) -
+          lod.radius_;
+      lod.level_ = lod_selector_->SelectLevel(lods, lod_count, distance,
+                                              lod.scale_, lod.level_);
+      counts[lod.level_]++;
+    }
+  });
+
+  // 단계마다 인스턴스가 연속되도록 단계 순서로, 같은 단계 안에서는 묶음
+  // 순서로 모읍니다. 묶음마다 단계별로 쓰기 시작할 위치를 정합니다
+  std::fill(std::begin(lod_instance_counts_), std::end(lod_instance_counts_),
+            0);
+  uint32_t offset = 0;
+  for (uint32_t level = 0; level < ModelClass::MAX_LODS; level++) {
+    for (uint32_t chunk = 0; chunk < chunk_count; chunk++) {
+      uint32_t& chunk_offset =
+          chunk_lod_offsets[size_t{chunk} * ModelClass::MAX_LODS + level];
+      const uint32_t count = chunk_offset;
+      chunk_offset = offset;
+      offset += count;
+      lod_instance_counts_[level] += count;
+    }
+  }
+
+  // 모델이 인스턴스 목록을 복사해 가므로 모은 목록도 이번 프레임에만
+  // 씁니다
+  ModelClass::InstanceType* visible_instances =
+      frame_arena_->Allocate<ModelClass::InstanceType>(visible_count);
+  job_system_->ParallelFor(chunk_count, [&](uint32_t chunk) {
+    uint32_t* offsets =
+        chunk_lod_offsets + size_t{chunk} * ModelClass::MAX_LODS;
+    const uint32_t begin = chunk * LOD_CHUNK_SIZE;
+    const uint32_t end = (std::min)(begin + LOD_CHUNK_SIZE, visible_count);
+    for (uint32_t i = begin; i < end; i++) {
+      const uint32_t index = visible_[i];
+      visible_instances[offsets[instance_lods_[index].level_]++] =
+          instances_[index];
+    }
+  });
+
+  model_->SetInstances(visible_instances,
+                       static_cast<int32_t>(visible_count));
+}
+
+bool GraphicsClass::InitializeSoftware(
+    const int32_t width, const int32_t height,
+    const std::filesystem::path& model_path) {
+  job_system_ = new JobSystemClass{};
+  if (job_system_ == nullptr) return false;
+  if (job_system_->Initialize() == false) return false;
+
+  frame_arena_ = new FrameArenaClass{};
+  if (frame_arena_ == nullptr) return false;
+  if (frame_arena_->Initialize(FRAME_ARENA_CAPACITY, FRAME_ARENA_FRAMES) ==
+      false)
+    return false;
+
+  soft_rasterizer_ = new SoftRasterizerClass{};
+  if (soft_rasterizer_ == nullptr) return false;
+  if (soft_rasterizer_->Initialize(width, height, SCREEN_DEPTH, SCREEN_NEAR,
+                                   job_system_) == false)
     return false;
+
+  camera_ = new CameraClass{};
+  if (camera_ == nullptr) return false;
+  camera_->SetPosition(0.0f, 0.0f, -5.0f);
+
+  // 디바이스 없이 CPU 측 정점, 인덱스만 만듭니다
+  model_ = new ModelClass{};
+  if (model_ == nullptr) return false;
+  model_->SetVertexFormat(VERTEX_FORMAT);
+  if (InitializeModel(nullptr, model_path) == false) return false;
+
+  if (INSTANCED_RENDERING) {
+    DirectX::XMMATRIX world_matrix{}, projection_matrix{};
+    soft_rasterizer_->GetWorldMatrix(world_matrix);
+    soft_rasterizer_->GetProjectionMatrix(projection_matrix);
+    if (BuildInstances(world_matrix) == false) return false;
+
+    lod_selector_ = new LodSelectorClass{};
+    if (lod_selector_ == nullptr) return false;
+    lod_selector_->SetProjection(projection_matrix, height);
+    lod_selector_->SetErrorThreshold(LOD_PIXEL_ERROR, LOD_HYSTERESIS);
   }
 
   return true;
 }
 
 void GraphicsClass::Shutdown() {
-  if (d3d_) {
-    d3d_->Shutdown();
-    delete d3d_;
-    d3d_ = nullptr;
+  if (soft_rasterizer_) {
+    soft_rasterizer_->Shutdown();
+    delete soft_rasterizer_;
+    soft_rasterizer_ = nullptr;
   }
 
   if (model_) {
@@ -56,16 +415,108 @@ void GraphicsClass::Shutdown() {
     camera_ = nullptr;
   }
 
+#if defined(_WIN32)
   if (color_shader_) {
     color_shader_->Shutdown();
     delete color_shader_;
     color_shader_ = nullptr;
   }
+
+  if (upscale_shader_) {
+    if (d3d_) d3d_->SetDynamicResolution(nullptr, {});
+    upscale_shader_->Shutdown();
+    delete upscale_shader_;
+    upscale_shader_ = nullptr;
+  }
+
+  if (command_recorder_) {
+    command_recorder_->Shutdown();
+    delete command_recorder_;
+    command_recorder_ = nullptr;
+  }
+#endif
+
+  if (render_queue_) {
+    render_queue_->Shutdown();
+    delete render_queue_;
+    render_queue_ = nullptr;
+  }
+
+  if (lod_selector_) {
+    delete lod_selector_;
+    lod_selector_ = nullptr;
+  }
+
+  if (bvh_) {
+    bvh_->Shutdown();
+    delete bvh_;
+    bvh_ = nullptr;
+  }
+
+  if (frustum_) {
+    delete frustum_;
+    frustum_ = nullptr;
+  }
+
+  if (frame_arena_) {
+    frame_arena_->Shutdown();
+    delete frame_arena_;
+    frame_arena_ = nullptr;
+  }
+
+#if defined(_WIN32)
+  // 모델과 셰이더가 핸들을 모두 놓은 뒤에 리소스 관리자와 디바이스를
+  // 해제합니다
+  if (d3d_) {
+    d3d_->Shutdown();
+    delete d3d_;
+    d3d_ = nullptr;
+  }
+#endif
+
+  // 다른 객체가 모두 작업을 마친 뒤에 작업 스레드를 멈춥니다
+  if (job_system_) {
+    job_system_->Shutdown();
+    delete job_system_;
+    job_system_ = nullptr;
+  }
+}
+
+bool GraphicsClass::Frame() {
+#if defined(_WIN32)
+  // 대기열에 자리가 난 뒤에 프레임을 시작해야 입력에서 화면까지의 지연이
+  // 짧습니다
+  if (d3d_) d3d_->WaitForNextFrame();
+#endif
+
+  return Render();
+}
+
+void GraphicsClass::SetPresentMode(const PresenterClass::ModeType mode,
+                                   const double frame_rate_limit) {
+#if defined(_WIN32)
+  if (d3d_) d3d_->SetPresentMode(mode, frame_rate_limit);
+#else
+  (void)mode;
+  (void)frame_rate_limit;
+#endif
 }
 
-bool GraphicsClass::Frame() { return Render(); }
+bool GraphicsClass::SaveScreenshot(const std::filesystem::path& path) {
+  if (soft_rasterizer_ == nullptr) return false;
+
+  return soft_rasterizer_->SaveToFile(path);
+}
 
 bool GraphicsClass::Render() {
+  PROFILE_FUNCTION();
+
+  // 지난 프레임의 임시 데이터는 여기서부터 다시 씁니다
+  frame_arena_->BeginFrame();
+
+  if (soft_rasterizer_) return RenderSoftware();
+
+#if defined(_WIN32)
   d3d_->BeginScene(0.5f, 0.5f, 0.5f, 1.0f);
 
   // 카메라의 위치에 따라 뷰 행렬을 생성합니다
@@ -77,13 +528,157 @@ bool GraphicsClass::Render() {
   camera_->GetViewMatrix(view_matrix);
   d3d_->GetProjectionMatrix(projection_matrix);
 
-  // 모델 정점, 인덱스 버퍼를 그래픽 파이프 라인에 배치하여 드로잉을 준비합니다
-  model_->Render(d3d_->GetDeviceContext());
+  // 보이는 인스턴스만 남긴 뒤 Render 에서 인스턴스 버퍼로 올립니다
+  if (INSTANCED_RENDERING)
+    CullInstances(DirectX::XMMatrixMultiply(view_matrix, projection_matrix));
+
+  // 양자화된 정점 위치를 모델 공간으로 되돌리는 행렬을 월드 행렬 앞에
+  // 곱합니다. 인스턴스 스트림에는 ModelClass 가 직접 곱해 올립니다
+  world_matrix =
+      DirectX::XMMatrixMultiply(model_->GetPositionTransform(), world_matrix);
+
+  DeviceContextClass* device_context = d3d_->GetDeviceContext();
+
+  // 뷰-투영 행렬은 드로우마다가 아니라 프레임당 한 번만 계산합니다
+  const DirectX::XMMATRIX view_projection_matrix =
+      DirectX::XMMatrixMultiply(view_matrix, projection_matrix);
+
+  // 드로우를 정렬 키와 함께 렌더 큐에 모았다가, 정렬한 뒤 셰이더와 모델
+  // 버퍼는 키가 바뀔 때만 바인딩하며 그립니다
+  render_queue_->Reset();
 
   // 색상 쉐이더를 사용하여 모델을 렌더링합니다
-  color_shader_->Render(d3d_->GetDeviceContext(), model_->GetIndexCount(),
-                        world_matrix, view_matrix, projection_matrix);
+  if (INSTANCED_RENDERING) {
+    // 인스턴스마다의 월드 행렬은 인스턴스 스트림에 있으므로 LOD 단계마다
+    // 드로우 한 번이면 됩니다
+    color_shader_->SetViewProjection(device_context, view_projection_matrix);
+
+    const uint64_t key = RenderQueueClass::MakeKey(
+        OPAQUE_LAYER,
+        static_cast<uint32_t>(ColorShaderClass::ProgramType::INSTANCED),
+        DEFAULT_MATERIAL, MODEL_MESH, 0.0f);
+    uint32_t first_instance = 0;
+    for (int32_t level = 0; level < model_->GetLodCount(); level++) {
+      const uint32_t instance_count = lod_instance_counts_[level];
+      if (instance_count == 0) continue;
+
+      const ModelClass::LodType& lod = model_->GetLods()[level];
+      render_queue_->Submit(key, {lod.index_count_, lod.first_index_,
+                                  instance_count, first_instance, 0});
+      first_instance += instance_count;
+    }
+  } else if (PRECOMPUTED_WVP) {
+    // 모든 드로우의 상수를 먼저 한 번에 쓰고, 오프셋으로 바인딩해 그립니다.
+    // 상수를 쓰지 못한 배치는 그리지 않습니다
+    ColorShaderClass::ConstantSliceType slice{};
+    const bool written = color_shader_->WriteConstants(
+        device_context, &world_matrix, 1, view_projection_matrix, &slice);
+
+    // 모델 중심의 뷰 공간 깊이로 앞에서 뒤로 정렬합니다
+    const float depth =
+        DirectX::XMVectorGetZ(
+            DirectX::XMVector3TransformCoord(world_matrix.r[3], view_matrix)) /
+        SCREEN_DEPTH;
+    const uint64_t key = RenderQueueClass::MakeKey(
+        OPAQUE_LAYER,
+        static_cast<uint32_t>(ColorShaderClass::ProgramType::COLOR),
+        DEFAULT_MATERIAL, MODEL_MESH, depth);
+    if (written)
+      render_queue_->Submit(
+          key, {static_cast<uint32_t>(model_->GetIndexCount()), 0, 0, 0,
+                slice.offset_});
+  } else {
+    // 드로우마다 행렬 세 개를 올리는 경로는 렌더 큐를 거치지 않습니다
+    model_->Render(device_context);
+    color_shader_->Render(device_context, model_->GetIndexCount(),
+                          world_matrix, view_matrix, projection_matrix);
+  }
+
+  render_queue_->Sort();
+
+  // 드로우가 충분히 많으면 정렬된 큐를 연속 구간으로 나눠 묶음마다 다른
+  // 스레드에서 기록하고, 묶음 순서대로 재생합니다
+  const uint32_t draw_count = render_queue_->GetCount();
+  const uint32_t chunk_count = (std::min)(
+      command_recorder_->GetMaxChunkCount(), draw_count / RECORD_CHUNK_SIZE);
+  if (PARALLEL_RECORDING && chunk_count > 1 &&
+      (INSTANCED_RENDERING || color_shader_->CanRecordDraws())) {
+    // 명령 목록은 즉시 컨텍스트에서 실행되므로 실행까지 함께 잽니다
+    PROFILE_GPU_SCOPE(device_context->GetGpuProfiler(), "Render queue");
+
+    // 명령 목록 안에서는 Map 을 쓰지 않도록 인스턴스 버퍼를 먼저 올립니다
+    model_->UpdateInstanceBuffer(device_context);
+
+    command_recorder_->Record(
+        job_system_, device_context, chunk_count,
+        [&](DeviceContextClass* context, uint32_t chunk) {
+          d3d_->SetFrameState(context);
+          RenderExecutorType executor{context, color_shader_, model_};
+          render_queue_->Execute(executor, draw_count * chunk / chunk_count,
+                                 draw_count * (chunk + 1) / chunk_count);
+        });
+  } else {
+    PROFILE_GPU_SCOPE(device_context->GetGpuProfiler(), "Render queue");
+
+    RenderExecutorType executor{device_context, color_shader_, model_};
+    render_queue_->Execute(executor);
+  }
 
   d3d_->EndScene();
   return true;
+#else
+  return false;
+#endif
+}
+
+bool GraphicsClass::RenderSoftware() {
+  PROFILE_FUNCTION();
+
+  soft_rasterizer_->BeginScene(0.5f, 0.5f, 0.5f, 1.0f);
+
+  // 카메라의 위치에 따라 뷰 행렬을 생성합니다
+  camera_->Render();
+
+  // 카메라 및 소프트웨어 렌더러에서 월드, 뷰 및 투영 행렬을 가져옵니다
+  DirectX::XMMATRIX world_matrix{}, view_matrix{}, projection_matrix{};
+  soft_rasterizer_->GetWorldMatrix(world_matrix);
+  camera_->GetViewMatrix(view_matrix);
+  soft_rasterizer_->GetProjectionMatrix(projection_matrix);
+
+  // 색상 파이프라인 커널로 모델을 타일에 배치합니다
+  if (INSTANCED_RENDERING) {
+    const DirectX::XMMATRIX view_projection_matrix =
+        DirectX::XMMatrixMultiply(view_matrix, projection_matrix);
+    CullInstances(view_projection_matrix);
+
+    // 인스턴스는 LOD 단계 순서로 놓여 있으므로 단계마다 한 번씩 그립니다
+    const ModelClass::InstanceType* instances = model_->GetInstances();
+    int32_t instance = 0;
+    for (int32_t level = 0; level < model_->GetLodCount(); level++) {
+      const ModelClass::LodType& lod = model_->GetLods()[level];
+      const int32_t count = static_cast<int32_t>(lod_instance_counts_[level]);
+      soft_rasterizer_->DrawIndexedInstanced(
+          model_->GetVertices(), model_->GetVertexCount(),
+          model_->GetIndices() + lod.first_index_,
+          static_cast<int32_t>(lod.index_count_), instances + instance, count,
+          view_projection_matrix);
+      instance += count;
+    }
+  } else if (PRECOMPUTED_WVP) {
+    const DirectX::XMMATRIX view_projection_matrix =
+        DirectX::XMMatrixMultiply(view_matrix, projection_matrix);
+
+    soft_rasterizer_->DrawIndexed(
+        model_->GetVertices(), model_->GetVertexCount(), model_->GetIndices(),
+        model_->GetIndexCount(),
+        DirectX::XMMatrixMultiply(world_matrix, view_projection_matrix));
+  } else {
+    soft_rasterizer_->DrawIndexed(
+        model_->GetVertices(), model_->GetVertexCount(), model_->GetIndices(),
+        model_->GetIndexCount(), world_matrix, view_matrix, projection_matrix);
+  }
+
+  // 모든 타일을 병렬로 래스터화합니다
+  soft_rasterizer_->EndScene();
+  return true;
 }
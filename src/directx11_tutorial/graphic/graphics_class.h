@@ -1,28 +1,139 @@
 #pragma once
 #include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <DirectXMath.h>
+
+#include "dynamic_resolution_class.h"
+#include "model_class.h"
+#include "presenter_class.h"
 
 // GLOBALS
 const bool FULL_SCREEN = false;
-const bool VSYNC_ENABLED = true;
+// 처음 표시 방식과 CAPPED 의 초당 프레임 수입니다. 실행 중에는 F1(VSYNC),
+// F2(UNCAPPED), F3(CAPPED) 로 바꿉니다
+const PresenterClass::ModeType PRESENT_MODE = PresenterClass::ModeType::VSYNC;
+const double FRAME_RATE_LIMIT = 60.0;
+// 플립 모델 스왑 체인의 버퍼 수와 표시를 기다리며 쌓을 수 있는 프레임
+// 수입니다
+const uint32_t SWAP_CHAIN_BUFFER_COUNT = 3;
+const uint32_t MAX_FRAME_LATENCY = 1;
+// 프레임 시간이 예산을 넘으면 장면을 낮춘 해상도로 그려 화면 크기로
+// 늘립니다. 배율은 가로, 세로에 곱하며 최소 배율 아래로는 낮추지 않습니다
+const bool DYNAMIC_RESOLUTION = true;
+const double FRAME_TIME_BUDGET_MS = 16.0;
+const float MIN_RESOLUTION_SCALE = 0.5f;
 const float SCREEN_DEPTH = 1000.0f;
 const float SCREEN_NEAR = 0.1f;
+// 월드-뷰-투영 행렬을 CPU 에서 미리 곱해 하나만 올립니다
+const bool PRECOMPUTED_WVP = true;
+// 같은 메시의 복사본을 인스턴스 스트림으로 한 번에 그립니다
+const bool INSTANCED_RENDERING = true;
+// 인스턴싱 경로에서 격자로 배치할 한 변의 복사본 수입니다
+const int32_t INSTANCE_GRID_SIZE = 1;
+// GPU 정점 버퍼와 메시 캐시의 정점 배치입니다
+const ModelClass::VertexFormatType VERTEX_FORMAT =
+    ModelClass::VertexFormatType::SNORM16;
+// 인스턴스마다 LOD 를 고를 때 허용하는 화면 오차(픽셀)와 단계를 바꿀 때
+// 두는 여유 비율입니다
+const float LOD_PIXEL_ERROR = 1.0f;
+const float LOD_HYSTERESIS = 0.25f;
+// 드로우가 많으면 렌더 큐를 묶음으로 나눠 작업 스레드에서 명령 목록으로
+// 기록합니다
+const bool PARALLEL_RECORDING = true;
+// 프레임 할당기가 돌려 쓰는 영역 수입니다. 그만큼의 프레임 동안 임시
+// 데이터가 유효합니다
+const uint32_t FRAME_ARENA_FRAMES = 3;
 
+#if defined(_WIN32)
 class D3DClass;
-class CameraClass;
-class ModelClass;
 class ColorShaderClass;
+class UpscaleShaderClass;
+class CommandRecorderClass;
+#endif
+class SoftRasterizerClass;
+class CameraClass;
+class FrustumClass;
+class BvhClass;
+class LodSelectorClass;
+class JobSystemClass;
+class RenderQueueClass;
+class FrameArenaClass;
 
 class GraphicsClass {
  public:
-  bool Initialize(const int32_t width, const int32_t height, HWND hwnd);
+#if defined(_WIN32)
+  // model_path 가 비어 있으면 기본 삼각형 모델을 씁니다
+  bool Initialize(const int32_t width, const int32_t height, HWND hwnd,
+                  const std::filesystem::path& model_path = {});
+#endif
+  // 윈도우와 GPU 없이 소프트웨어 렌더러로 초기화합니다. D3D11 이 없는
+  // 빌드에서는 이 초기화만 쓸 수 있습니다
+  bool InitializeSoftware(const int32_t width, const int32_t height,
+                          const std::filesystem::path& model_path = {});
   void Shutdown();
   bool Frame();
 
+  // 다음 프레임부터 표시 방식을 바꿉니다. 소프트웨어 렌더러에서는 아무것도
+  // 하지 않습니다
+  void SetPresentMode(const PresenterClass::ModeType mode,
+                      const double frame_rate_limit);
+
+  // 소프트웨어 렌더러의 마지막 프레임을 파일로 저장합니다
+  bool SaveScreenshot(const std::filesystem::path& path);
+
  private:
+  // LOD 선택을 작업 하나로 묶어 실행하는 인스턴스 수입니다
+  static const uint32_t LOD_CHUNK_SIZE = 4096;
+  // 한 프레임에 렌더 큐로 받을 수 있는 최대 드로우 수입니다
+  static const uint32_t RENDER_QUEUE_CAPACITY = 65536;
+  // 명령 목록 묶음 하나에 넣을 최소 드로우 수입니다. 묶음마다 모든 상태를
+  // 다시 바인딩하므로 이보다 적으면 나누지 않습니다
+  static const uint32_t RECORD_CHUNK_SIZE = 256;
+  // 프레임 할당기 영역 하나의 처음 바이트 수입니다. 모자라면 늘어납니다
+  static const size_t FRAME_ARENA_CAPACITY = 1 << 20;
+
   bool Render();
+  bool RenderSoftware();
+  bool InitializeModel(ResourceManagerClass* resources,
+                       const std::filesystem::path& model_path);
+  bool BuildInstances(const DirectX::XMMATRIX& world);
+  // 절두체 안의 인스턴스만 모아 LOD 단계를 고르고, 단계 순서로 묶어 모델의
+  // 인스턴스 목록으로 넘깁니다
+  // 선택과 모으기는 인스턴스 묶음마다 작업 시스템에서 나눠 실행합니다
+  void CullInstances(const DirectX::XMMATRIX& view_projection);
+
+  // 인스턴스의 월드 공간 경계 구와 배율, 지난 프레임의 LOD 단계입니다
+  struct InstanceLodType {
+    DirectX::XMFLOAT3 center_;
+    float radius_;
+    float scale_;
+    uint32_t level_;
+  };
 
+  // 초기화와 프레임 단계가 함께 쓰는 작업 시스템입니다
+  JobSystemClass* job_system_ = nullptr;
+  // 프레임 단계의 임시 데이터를 받는 할당기입니다
+  FrameArenaClass* frame_arena_ = nullptr;
+#if defined(_WIN32)
   D3DClass* d3d_ = nullptr;
+  ColorShaderClass* color_shader_ = nullptr;
+  UpscaleShaderClass* upscale_shader_ = nullptr;
+  CommandRecorderClass* command_recorder_ = nullptr;
+#endif
+  SoftRasterizerClass* soft_rasterizer_ = nullptr;
   CameraClass* camera_ = nullptr;
   ModelClass* model_ = nullptr;
-  ColorShaderClass* color_shader_ = nullptr;
+  FrustumClass* frustum_ = nullptr;
+  BvhClass* bvh_ = nullptr;
+  LodSelectorClass* lod_selector_ = nullptr;
+  RenderQueueClass* render_queue_ = nullptr;
+
+  // 전체 인스턴스와 이번 프레임에 보이는 인스턴스 번호입니다
+  std::vector<ModelClass::InstanceType> instances_;
+  std::vector<uint32_t> visible_;
+  std::vector<InstanceLodType> instance_lods_;
+  // 보이는 인스턴스 목록에서 LOD 단계마다 차지하는 인스턴스 수입니다
+  uint32_t lod_instance_counts_[ModelClass::MAX_LODS]{};
 };
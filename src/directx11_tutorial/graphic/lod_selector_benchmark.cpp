@@ -0,0 +1,46 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <DirectXMath.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "framework/benchmark_class.h"
+#include "graphic/lod_selector_class.h"
+#include "graphic/model_class.h"
+
+void RegisterLodSelectorBenchmarks(BenchmarkClass& benchmark) {
+  // 100 만 인스턴스의 LOD 단계를 거리로 고르기
+  benchmark.AddFixture("LodSelectorClass::SelectLevel/1M", 1000000, [] {
+    struct DataType {
+      LodSelectorClass selector_;
+      std::vector<float> distances_;
+      std::vector<uint32_t> levels_;
+    };
+    auto data = std::make_shared<DataType>();
+    data->selector_.SetProjection(
+        DirectX::XMMatrixPerspectiveFovLH(DirectX::XM_PI / 4.0f, 16.0f / 9.0f,
+                                          0.1f, 1000.0f),
+        1080);
+
+    std::mt19937 random{42};
+    std::uniform_real_distribution<float> distance(0.0f, 1000.0f);
+    for (uint32_t i = 0; i < 1000000; i++)
+      data->distances_.push_back(distance(random));
+    data->levels_.resize(data->distances_.size());
+
+    return BenchmarkClass::BodyType([data](uint64_t iterations) {
+      const ModelClass::LodType lods[ModelClass::MAX_LODS] = {
+          {0, 0, 0.0f}, {0, 0, 0.01f}, {0, 0, 0.04f}, {0, 0, 0.16f}};
+      for (uint64_t i = 0; i < iterations; i++) {
+        for (size_t n = 0; n < data->distances_.size(); n++)
+          data->levels_[n] = data->selector_.SelectLevel(
+              lods, ModelClass::MAX_LODS, data->distances_[n], 1.0f,
+              data->levels_[n]);
+        BenchmarkClass::DoNotOptimize(data->levels_);
+      }
+    });
+  });
+}
@@ -0,0 +1,46 @@
+#include "pch.h"
+#include "lod_selector_class.h"
+
+void LodSelectorClass::SetProjection(const DirectX::XMMATRIX& projection,
+                                     const int32_t screen_height) {
+  // m[1][1] 은 1 / tan(fov / 2) 이므로 거리 1 에서 화면 높이가 2 / m[1][1]
+  // 입니다
+  DirectX::XMFLOAT4X4 matrix{};
+  DirectX::XMStoreFloat4x4(&matrix, projection);
+  pixels_per_unit_ = 0.5f * static_cast<float>(screen_height) * matrix.m[1][1];
+}
+
+void LodSelectorClass::SetErrorThreshold(const float pixel_error,
+                                         const float hysteresis) {
+  pixel_error_ = pixel_error;
+  hysteresis_ = hysteresis;
+}
+
+uint32_t LodSelectorClass::SelectLevel(const ModelClass::LodType* lods,
+                                       const uint32_t lod_count,
+                                       const float distance, const float scale,
+                                       const uint32_t current_level) {
+  // 카메라가 경계 구 안에 있으면 원본을 그립니다
+  if (distance <= 0.0f) return 0;
+
+  // 오차는 단계가 거칠수록 커지므로 거친 단계부터 처음 허용되는 단계를
+  // 찾습니다. 현재보다 거친 단계로 갈 때는 한도를 줄이고, 현재 단계를
+  // 지킬 때는 한도를 늘려 경계에서 오가지 않게 합니다
+  for (uint32_t level = lod_count - 1; level > 0; level--) {
+    float limit = pixel_error_;
+    if (level > current_level)
+      limit *= 1.0f - hysteresis_;
+    else if (level == current_level)
+      limit *= 1.0f + hysteresis_;
+
+    if (GetProjectedError(lods[level].error_, distance, scale) <= limit)
+      return level;
+  }
+  return 0;
+}
+
+float LodSelectorClass::GetProjectedError(const float error,
+                                          const float distance,
+                                          const float scale) {
+  return error * scale * pixels_per_unit_ / distance;
+}
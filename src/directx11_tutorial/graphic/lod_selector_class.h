@@ -0,0 +1,34 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+
+#include "model_class.h"
+
+// LOD 단계의 모델 공간 오차를 화면에 투영한 픽셀 크기로 바꿔, 허용 픽셀
+// 오차 안에 드는 가장 거친 단계를 고릅니다. 경계 근처에서 단계가 매
+// 프레임 바뀌며 깜빡이지 않도록 인스턴스의 현재 단계를 기준으로
+// 히스테리시스를 둡니다.
+class LodSelectorClass {
+ public:
+  // 투영 행렬의 y 축 배율과 화면 높이로 거리 1 에서 단위 길이가 몇
+  // 픽셀인지 구합니다
+  void SetProjection(const DirectX::XMMATRIX& projection,
+                     const int32_t screen_height);
+  // pixel_error 는 허용하는 화면 오차, hysteresis 는 단계를 바꿀 때 그
+  // 오차에 두는 여유 비율입니다
+  void SetErrorThreshold(const float pixel_error, const float hysteresis);
+
+  // distance 는 카메라에서 인스턴스 경계 구 표면까지의 거리, scale 은
+  // 인스턴스 월드 행렬의 가장 큰 축 배율입니다
+  uint32_t SelectLevel(const ModelClass::LodType* lods,
+                       const uint32_t lod_count, const float distance,
+                       const float scale, const uint32_t current_level);
+  // 모델 공간 오차 error 를 distance 에서 본 픽셀 크기입니다
+  float GetProjectedError(const float error, const float distance,
+                          const float scale);
+
+ private:
+  float pixels_per_unit_ = 0.0f;
+  float pixel_error_ = 1.0f;
+  float hysteresis_ = 0.25f;
+};
@@ -0,0 +1,66 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <filesystem>
+#include <vector>
+
+#include "framework/benchmark_class.h"
+#include "graphic/mesh_file_class.h"
+#include "graphic/model_class.h"
+
+void RegisterMeshFileBenchmarks(BenchmarkClass& benchmark) {
+  // 약 100MB 메시 파일을 매핑하고 모든 페이지를 한 번씩 읽기
+  benchmark.AddFixture("MeshFileClass::Open/100MB", 1, [] {
+    const uint32_t vertex_count = 3500000;
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "benchmark_mesh.bin";
+
+    {
+      std::vector<ModelClass::VertexType> vertices(vertex_count);
+      std::vector<uint32_t> indices(vertex_count);
+      for (uint32_t i = 0; i < vertex_count; i++) {
+        vertices[i].position_ = {static_cast<float>(i), 0.0f, 0.0f};
+        vertices[i].color_ = {1.0f, 1.0f, 1.0f, 1.0f};
+        indices[i] = i;
+      }
+
+      const MeshFileClass::AttributeType attributes[] = {
+          {"POSITION", 0, MeshFileClass::FormatType::FLOAT3, 0, 0},
+          {"COLOR", 0, MeshFileClass::FormatType::FLOAT4, 12, 0}};
+      const float bounds_min[3] = {0.0f, 0.0f, 0.0f};
+      const float bounds_max[3] = {static_cast<float>(vertex_count), 0.0f,
+                                   0.0f};
+      const MeshFileClass::LodType lod{0, vertex_count / 3 * 3, 0.0f, 0};
+      MeshFileClass::Write(path, attributes, 2, &lod, 1, vertices.data(),
+                           vertex_count, sizeof(ModelClass::VertexType),
+                           indices.data(), vertex_count, sizeof(uint32_t),
+                           bounds_min, bounds_max);
+    }
+
+    return BenchmarkClass::BodyType([path](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; i++) {
+        MeshFileClass mesh{};
+        if (mesh.Open(path) == false) return;
+
+        // GPU 업로드처럼 정점, 인덱스 덩어리를 처음부터 끝까지 훑습니다
+        const MeshFileClass::HeaderType& header = mesh.GetHeader();
+        const uint8_t* vertices =
+            static_cast<const uint8_t*>(mesh.GetVertexData());
+        const uint8_t* indices =
+            static_cast<const uint8_t*>(mesh.GetIndexData());
+        uint64_t sum = 0;
+        for (uint64_t offset = 0;
+             offset < uint64_t{header.vertex_count_} * header.vertex_stride_;
+             offset += 4096)
+          sum += vertices[offset];
+        for (uint64_t offset = 0;
+             offset < uint64_t{header.index_count_} * header.index_size_;
+             offset += 4096)
+          sum += indices[offset];
+        BenchmarkClass::DoNotOptimize(sum);
+
+        mesh.Close();
+      }
+    });
+  });
+}
@@ -0,0 +1,225 @@
+#include "pch.h"
+#include "mesh_file_class.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+static_assert(sizeof(MeshFileClass::AttributeType) == 32,
+              "mesh file attribute layout changed");
+static_assert(sizeof(MeshFileClass::LodType) == 16,
+              "mesh file lod layout changed");
+static_assert(sizeof(MeshFileClass::HeaderType) == 72,
+              "mesh file header layout changed");
+
+namespace {
+uint64_t AlignOffset(const uint64_t offset) {
+  return (offset + MeshFileClass::ALIGNMENT - 1) &
+         ~static_cast<uint64_t>(MeshFileClass::ALIGNMENT - 1);
+}
+
+// 가장 큰 인덱스를 구합니다. 분기 없는 최댓값이라 컴파일러가 벡터화합니다
+template <typename IndexType>
+uint32_t FindMaxIndex(const uint8_t* data, const uint64_t count) {
+  const IndexType* indices = reinterpret_cast<const IndexType*>(data);
+  IndexType max_index = 0;
+  for (uint64_t i = 0; i < count; i++)
+    max_index = (std::max)(max_index, indices[i]);
+  return max_index;
+}
+}  // namespace
+
+bool MeshFileClass::Write(const std::filesystem::path& path,
+                          const AttributeType* attributes,
+                          const uint32_t attribute_count,
+                          const LodType* lods, const uint32_t lod_count,
+                          const void* vertices, const uint32_t vertex_count,
+                          const uint32_t vertex_stride, const void* indices,
+                          const uint32_t index_count,
+                          const uint32_t index_size, const float bounds_min[3],
+                          const float bounds_max[3]) {
+  if (attribute_count > MAX_ATTRIBUTES) return false;
+  if (lod_count == 0 || lod_count > MAX_LODS) return false;
+  if (index_size != 2 && index_size != 4) return false;
+
+  HeaderType header{};
+  header.magic_ = MAGIC;
+  header.version_ = VERSION;
+  header.vertex_count_ = vertex_count;
+  header.index_count_ = index_count;
+  header.vertex_stride_ = vertex_stride;
+  header.index_size_ = index_size;
+  header.attribute_count_ = attribute_count;
+  header.lod_count_ = lod_count;
+  std::memcpy(header.bounds_min_, bounds_min, sizeof(header.bounds_min_));
+  std::memcpy(header.bounds_max_, bounds_max, sizeof(header.bounds_max_));
+
+  const uint64_t vertex_bytes =
+      static_cast<uint64_t>(vertex_count) * vertex_stride;
+  const uint64_t index_bytes = static_cast<uint64_t>(index_count) * index_size;
+  header.vertex_offset_ =
+      AlignOffset(sizeof(HeaderType) + sizeof(AttributeType) * attribute_count +
+                  sizeof(LodType) * lod_count);
+  header.index_offset_ = AlignOffset(header.vertex_offset_ + vertex_bytes);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) return false;
+
+  // 정렬을 맞추기 위한 0 바이트를 채웁니다
+  const char padding[ALIGNMENT]{};
+  auto pad_to = [&file, &padding](const uint64_t offset) {
+    const uint64_t position = static_cast<uint64_t>(file.tellp());
+    file.write(padding, static_cast<std::streamsize>(offset - position));
+  };
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(attributes),
+             sizeof(AttributeType) * attribute_count);
+  file.write(reinterpret_cast<const char*>(lods), sizeof(LodType) * lod_count);
+  pad_to(header.vertex_offset_);
+  file.write(static_cast<const char*>(vertices),
+             static_cast<std::streamsize>(vertex_bytes));
+  pad_to(header.index_offset_);
+  file.write(static_cast<const char*>(indices),
+             static_cast<std::streamsize>(index_bytes));
+
+  return file.good();
+}
+
+uint32_t MeshFileClass::GetFormatSize(const FormatType format) {
+  switch (format) {
+    case FormatType::FLOAT2:
+    case FormatType::SNORM16X4:
+    case FormatType::HALF4:
+      return 8;
+    case FormatType::FLOAT3:
+      return 12;
+    case FormatType::FLOAT4:
+      return 16;
+    case FormatType::UNORM8X4:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+bool MeshFileClass::Open(const std::filesystem::path& path) {
+  Close();
+
+  if (file_.Open(path) == false) return false;
+
+  const uint8_t* data = file_.GetData();
+  const uint64_t size = file_.GetSize();
+
+  // 헤더와 각 덩어리가 파일 안에 들어가는지 확인합니다
+  if (size < sizeof(HeaderType)) {
+    Close();
+    return false;
+  }
+  std::memcpy(&header_, data, sizeof(HeaderType));
+
+  const uint64_t attribute_end =
+      sizeof(HeaderType) +
+      static_cast<uint64_t>(sizeof(AttributeType)) * header_.attribute_count_;
+  const uint64_t lod_end =
+      attribute_end +
+      static_cast<uint64_t>(sizeof(LodType)) * header_.lod_count_;
+  const uint64_t vertex_bytes =
+      static_cast<uint64_t>(header_.vertex_count_) * header_.vertex_stride_;
+  const uint64_t index_bytes =
+      static_cast<uint64_t>(header_.index_count_) * header_.index_size_;
+
+  if (header_.magic_ != MAGIC || header_.version_ != VERSION ||
+      header_.attribute_count_ > MAX_ATTRIBUTES ||
+      header_.lod_count_ == 0 || header_.lod_count_ > MAX_LODS ||
+      (header_.index_size_ != 2 && header_.index_size_ != 4) ||
+      header_.vertex_offset_ % ALIGNMENT != 0 ||
+      header_.index_offset_ % ALIGNMENT != 0 ||
+      header_.vertex_offset_ < lod_end ||
+      header_.vertex_offset_ > size ||
+      vertex_bytes > size - header_.vertex_offset_ ||
+      header_.index_offset_ < header_.vertex_offset_ + vertex_bytes ||
+      header_.index_offset_ > size ||
+      index_bytes > size - header_.index_offset_) {
+    Close();
+    return false;
+  }
+
+  attributes_ =
+      reinterpret_cast<const AttributeType*>(data + sizeof(HeaderType));
+  lods_ = reinterpret_cast<const LodType*>(data + attribute_end);
+
+  // 속성이 정점 안에 들어가는지 확인합니다
+  for (uint32_t i = 0; i < header_.attribute_count_; i++) {
+    const uint32_t format_size = GetFormatSize(attributes_[i].format_);
+    if (format_size == 0 ||
+        attributes_[i].offset_ + format_size > header_.vertex_stride_) {
+      Close();
+      return false;
+    }
+  }
+
+  // LOD 구간이 인덱스 덩어리 안의 삼각형 목록인지 확인합니다
+  for (uint32_t i = 0; i < header_.lod_count_; i++) {
+    const LodType& lod = lods_[i];
+    if (lod.first_index_ % 3 != 0 || lod.index_count_ % 3 != 0 ||
+        lod.first_index_ > header_.index_count_ ||
+        lod.index_count_ > header_.index_count_ - lod.first_index_) {
+      Close();
+      return false;
+    }
+  }
+
+  // 인덱스가 정점 덩어리 안을 가리키는지 확인합니다
+  if (header_.index_count_ > 0) {
+    const uint8_t* indices = data + header_.index_offset_;
+    const uint32_t max_index =
+        header_.index_size_ == 2
+            ? FindMaxIndex<uint16_t>(indices, header_.index_count_)
+            : FindMaxIndex<uint32_t>(indices, header_.index_count_);
+    if (max_index >= header_.vertex_count_) {
+      Close();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void MeshFileClass::Close() {
+  file_.Close();
+  header_ = HeaderType{};
+  attributes_ = nullptr;
+  lods_ = nullptr;
+}
+
+const MeshFileClass::HeaderType& MeshFileClass::GetHeader() {
+  return header_;
+}
+
+const MeshFileClass::AttributeType* MeshFileClass::GetAttributes() {
+  return attributes_;
+}
+
+const MeshFileClass::AttributeType* MeshFileClass::FindAttribute(
+    const char* semantic, const uint32_t semantic_index) {
+  for (uint32_t i = 0; i < header_.attribute_count_; i++) {
+    const AttributeType& attribute = attributes_[i];
+    if (attribute.semantic_index_ == semantic_index &&
+        strncmp(attribute.semantic_, semantic, sizeof(attribute.semantic_)) ==
+            0)
+      return &attribute;
+  }
+
+  return nullptr;
+}
+
+const MeshFileClass::LodType* MeshFileClass::GetLods() { return lods_; }
+
+const void* MeshFileClass::GetVertexData() {
+  return file_.GetData() + header_.vertex_offset_;
+}
+
+const void* MeshFileClass::GetIndexData() {
+  return file_.GetData() + header_.index_offset_;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+
+#include "framework/mapped_file_class.h"
+
+// 버전이 있는 이진 메시 파일입니다. 파일은 헤더, 정점 속성 설명, LOD 표,
+// ALIGNMENT 로 정렬된 정점/인덱스 덩어리 순서로 놓입니다.
+// 모든 값은 little-endian 이며, 읽을 때는 파일을 매핑해 복사 없이
+// 정점, 인덱스 포인터를 그대로 넘겨줍니다.
+class MeshFileClass {
+ public:
+  static const uint32_t MAGIC = 0x4853454D;  // "MESH"
+  static const uint32_t VERSION = 2;
+  static const uint32_t ALIGNMENT = 64;
+  static const uint32_t MAX_ATTRIBUTES = 8;
+  static const uint32_t MAX_LODS = 8;
+
+  enum class FormatType : uint32_t {
+    UNKNOWN = 0,
+    FLOAT2 = 1,
+    FLOAT3 = 2,
+    FLOAT4 = 3,
+    SNORM16X4 = 4,
+    HALF4 = 5,
+    UNORM8X4 = 6,
+  };
+
+  struct AttributeType {
+    char semantic_[16];
+    uint32_t semantic_index_;
+    FormatType format_;
+    uint32_t offset_;
+    uint32_t reserved_;
+  };
+
+  // 모든 LOD 는 같은 정점 덩어리를 쓰고 인덱스 덩어리의 구간만 다릅니다.
+  // 0 번이 원본이며 error_ 는 모델 공간 단위의 최대 기하 오차입니다
+  struct LodType {
+    uint32_t first_index_;
+    uint32_t index_count_;
+    float error_;
+    uint32_t reserved_;
+  };
+
+  struct HeaderType {
+    uint32_t magic_;
+    uint32_t version_;
+    uint32_t vertex_count_;
+    uint32_t index_count_;
+    uint32_t vertex_stride_;
+    uint32_t index_size_;  // 2 또는 4
+    uint32_t attribute_count_;
+    uint32_t lod_count_;
+    uint64_t vertex_offset_;
+    uint64_t index_offset_;
+    float bounds_min_[3];
+    float bounds_max_[3];
+  };
+
+  // 메시를 파일로 씁니다. 정점, 인덱스 덩어리는 ALIGNMENT 로 정렬됩니다
+  static bool Write(const std::filesystem::path& path,
+                    const AttributeType* attributes,
+                    const uint32_t attribute_count, const LodType* lods,
+                    const uint32_t lod_count, const void* vertices,
+                    const uint32_t vertex_count, const uint32_t vertex_stride,
+                    const void* indices, const uint32_t index_count,
+                    const uint32_t index_size, const float bounds_min[3],
+                    const float bounds_max[3]);
+
+  static uint32_t GetFormatSize(const FormatType format);
+
+  // 파일을 매핑하고 헤더와 덩어리 범위를 검증합니다
+  bool Open(const std::filesystem::path& path);
+  void Close();
+
+  const HeaderType& GetHeader();
+  const AttributeType* GetAttributes();
+  const LodType* GetLods();
+  // semantic 이 같은 속성을 찾습니다. 없으면 nullptr 을 반환합니다
+  const AttributeType* FindAttribute(const char* semantic,
+                                     const uint32_t semantic_index);
+
+  // 매핑된 파일 안을 가리킵니다. Close 전까지만 유효합니다
+  const void* GetVertexData();
+  const void* GetIndexData();
+
+ private:
+  MappedFileClass file_;
+  HeaderType header_{};
+  const AttributeType* attributes_ = nullptr;
+  const LodType* lods_ = nullptr;
+};
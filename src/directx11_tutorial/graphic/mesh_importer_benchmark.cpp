@@ -0,0 +1,55 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "framework/benchmark_class.h"
+#include "framework/job_system_class.h"
+#include "graphic/mesh_importer_class.h"
+
+void RegisterMeshImporterBenchmarks(BenchmarkClass& benchmark) {
+  // 512x512 격자 OBJ 를 파싱하고 중복 정점을 합쳐 인덱스 스트림을 만들기
+  for (const bool threaded : {false, true}) {
+    const std::string name = std::string("MeshImporterClass::Import/obj/512") +
+                             (threaded ? "/threaded" : "");
+    const uint32_t grid = 512;
+
+    benchmark.AddFixture(name, grid * grid, [threaded, grid] {
+      struct DataType {
+        std::filesystem::path path_;
+        JobSystemClass job_system_;
+        ~DataType() { job_system_.Shutdown(); }
+      };
+      auto data = std::make_shared<DataType>();
+      if (threaded) data->job_system_.Initialize();
+      data->path_ =
+          std::filesystem::temp_directory_path() / "benchmark_grid.obj";
+
+      {
+        std::ofstream file(data->path_, std::ios::trunc);
+        for (uint32_t y = 0; y < grid; y++)
+          for (uint32_t x = 0; x < grid; x++)
+            file << "v " << x * 0.01f << ' ' << y * 0.01f << " 0\n";
+        for (uint32_t y = 0; y + 1 < grid; y++) {
+          for (uint32_t x = 0; x + 1 < grid; x++) {
+            const uint32_t v = y * grid + x + 1;
+            file << "f " << v << ' ' << v + 1 << ' ' << v + grid + 1 << ' '
+                 << v + grid << '\n';
+          }
+        }
+      }
+
+      return BenchmarkClass::BodyType([data, threaded](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+          MeshImporterClass importer{};
+          importer.Import(data->path_,
+                          threaded ? &data->job_system_ : nullptr);
+          BenchmarkClass::DoNotOptimize(importer.GetIndexCount());
+        }
+      });
+    });
+  }
+}
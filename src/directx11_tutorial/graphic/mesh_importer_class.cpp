@@ -0,0 +1,769 @@
+#include "pch.h"
+#include "mesh_importer_class.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cwctype>
+#include <iterator>
+#include <string_view>
+
+#include "framework/mapped_file_class.h"
+#include "framework/profiler.h"
+#include "framework/job_system_class.h"
+
+namespace {
+// PLY 스칼라 형식입니다. 인덱스는 PLY_TYPES 의 순서와 같습니다
+struct PlyTypeInfo {
+  const char* name_;
+  const char* alias_;
+  uint32_t size_;
+};
+const PlyTypeInfo PLY_TYPES[] = {
+    {"char", "int8", 1},     {"uchar", "uint8", 1},  {"short", "int16", 2},
+    {"ushort", "uint16", 2}, {"int", "int32", 4},    {"uint", "uint32", 4},
+    {"float", "float32", 4}, {"double", "float64", 8},
+};
+const uint32_t PLY_TYPE_COUNT = static_cast<uint32_t>(std::size(PLY_TYPES));
+const uint32_t PLY_UCHAR = 1;
+// ASCII PLY 에서 한 요소가 가질 수 있는 최대 속성 수입니다
+const size_t MAX_ASCII_PROPERTIES = 32;
+
+// OBJ 의 음수(상대) 인덱스는 청크를 합친 뒤에야 절대 인덱스가 됩니다.
+// 이 비트가 켜진 값은 청크 안의 위치 인덱스입니다
+const int64_t OBJ_RELATIVE = int64_t{1} << 62;
+
+const DirectX::XMFLOAT4 DEFAULT_COLOR{1.0f, 1.0f, 1.0f, 1.0f};
+
+bool IsSpace(const char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+const char* SkipSpaces(const char* p, const char* end) {
+  while (p < end && IsSpace(*p)) p++;
+  return p;
+}
+
+const char* SkipToken(const char* p, const char* end) {
+  while (p < end && IsSpace(*p) == false && *p != '\n') p++;
+  return p;
+}
+
+const char* NextLine(const char* p, const char* end) {
+  const void* newline = std::memchr(p, '\n', end - p);
+  return newline ? static_cast<const char*>(newline) + 1 : end;
+}
+
+// 공백을 건너뛰고 숫자 하나를 읽습니다. 실패하면 nullptr 을 반환합니다
+template <typename T>
+const char* ParseNumber(const char* p, const char* end, T& value) {
+  p = SkipSpaces(p, end);
+  if (p < end && *p == '+') p++;
+
+  const std::from_chars_result result = std::from_chars(p, end, value);
+  if (result.ec != std::errc{}) return nullptr;
+  return result.ptr;
+}
+
+uint32_t FindPlyType(const std::string_view name) {
+  for (uint32_t i = 0; i < PLY_TYPE_COUNT; i++)
+    if (name == PLY_TYPES[i].name_ || name == PLY_TYPES[i].alias_) return i;
+  return PLY_TYPE_COUNT;
+}
+
+double ReadPlyScalar(const char* p, const uint32_t type,
+                     const bool big_endian) {
+  uint8_t bytes[8]{};
+  const uint32_t size = PLY_TYPES[type].size_;
+  std::memcpy(bytes, p, size);
+  if (big_endian) std::reverse(bytes, bytes + size);
+
+  switch (type) {
+    case 0: return static_cast<double>(*reinterpret_cast<int8_t*>(bytes));
+    case 1: return static_cast<double>(*reinterpret_cast<uint8_t*>(bytes));
+    case 2: return static_cast<double>(*reinterpret_cast<int16_t*>(bytes));
+    case 3: return static_cast<double>(*reinterpret_cast<uint16_t*>(bytes));
+    case 4: return static_cast<double>(*reinterpret_cast<int32_t*>(bytes));
+    case 5: return static_cast<double>(*reinterpret_cast<uint32_t*>(bytes));
+    case 6: return static_cast<double>(*reinterpret_cast<float*>(bytes));
+    default: return *reinterpret_cast<double*>(bytes);
+  }
+}
+
+// 정점 요소에서 읽어야 하는 속성의 위치입니다
+struct PlyVertexFieldsType {
+  int32_t position_[3] = {-1, -1, -1};
+  int32_t color_[4] = {-1, -1, -1, -1};
+  bool color_normalized_ = false;
+};
+
+uint64_t HashVertex(const DirectX::XMFLOAT3& position,
+                    const DirectX::XMFLOAT4& color) {
+  uint64_t words[4]{};
+  std::memcpy(words, &position, sizeof(position));
+  std::memcpy(reinterpret_cast<uint8_t*>(words) + sizeof(position), &color,
+              sizeof(color));
+
+  const uint64_t hash = words[0] * 0x9E3779B97F4A7C15ull ^
+                        words[1] * 0xC2B2AE3D27D4EB4Full ^
+                        words[2] * 0x165667B19E3779F9ull ^
+                        words[3] * 0x27D4EB2F165667C5ull;
+  return hash ^ (hash >> 29);
+}
+}  // namespace
+
+bool MeshImporterClass::Import(const std::filesystem::path& path,
+                               JobSystemClass* job_system) {
+  PROFILE_FUNCTION();
+
+  Shutdown();
+
+  MappedFileClass file{};
+  if (file.Open(path) == false) return false;
+
+  const char* begin = reinterpret_cast<const char*>(file.GetData());
+  const char* end = begin + file.GetSize();
+
+  std::wstring extension = path.extension().wstring();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](wchar_t c) { return static_cast<wchar_t>(towlower(c)); });
+
+  bool result = false;
+  if (extension == L".obj")
+    result = ImportObj(begin, end, job_system);
+  else if (extension == L".ply")
+    result = ImportPly(begin, end, job_system);
+
+  file.Close();
+
+  result = result && BuildIndexedStream(job_system);
+
+  // 중간 데이터는 더 이상 필요 없습니다
+  positions_ = {};
+  colors_ = {};
+  corners_ = {};
+
+  if (result == false) Shutdown();
+  return result;
+}
+
+void MeshImporterClass::Shutdown() {
+  positions_ = {};
+  colors_ = {};
+  corners_ = {};
+  vertices_ = {};
+  indices_ = {};
+}
+
+const ModelClass::VertexType* MeshImporterClass::GetVertices() {
+  return vertices_.data();
+}
+
+const uint32_t* MeshImporterClass::GetIndices() { return indices_.data(); }
+
+uint32_t MeshImporterClass::GetVertexCount() {
+  return static_cast<uint32_t>(vertices_.size());
+}
+
+uint32_t MeshImporterClass::GetIndexCount() {
+  return static_cast<uint32_t>(indices_.size());
+}
+
+void MeshImporterClass::ReleaseGeometry(
+    std::vector<ModelClass::VertexType>& vertices,
+    std::vector<uint32_t>& indices) {
+  vertices = std::move(vertices_);
+  indices = std::move(indices_);
+  vertices_ = {};
+  indices_ = {};
+}
+
+bool MeshImporterClass::ImportObj(const char* begin, const char* end,
+                                  JobSystemClass* job_system) {
+  PROFILE_FUNCTION();
+
+  struct ChunkType {
+    std::vector<DirectX::XMFLOAT3> positions_;
+    std::vector<DirectX::XMFLOAT4> colors_;
+    std::vector<int64_t> corners_;
+    bool failed_ = false;
+  };
+
+  std::vector<const char*> bounds;
+  SplitLines(begin, end, GetChunkCount(end - begin, job_system), bounds);
+  std::vector<ChunkType> chunks(bounds.size() - 1);
+
+  // 1 단계: 청크마다 v 와 f 줄을 파싱합니다. 면은 부채꼴로 삼각형화합니다
+  ParallelFor(job_system, static_cast<uint32_t>(chunks.size()),
+              [&](uint32_t index) {
+    PROFILE_SCOPE("ObjChunk");
+    ChunkType& chunk = chunks[index];
+    const char* chunk_end = bounds[index + 1];
+    std::vector<int64_t> face;
+
+    for (const char* p = bounds[index]; p < chunk_end;
+         p = NextLine(p, chunk_end)) {
+      p = SkipSpaces(p, chunk_end);
+      if (chunk_end - p < 2 || IsSpace(p[1]) == false) continue;
+
+      if (p[0] == 'v') {
+        float values[7] = {0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+        int32_t count = 0;
+        const char* q = p + 1;
+        while (count < 6) {
+          const char* next = ParseNumber(q, chunk_end, values[count]);
+          if (next == nullptr) break;
+          q = next;
+          count++;
+        }
+        if (count < 3) {
+          chunk.failed_ = true;
+          return;
+        }
+
+        chunk.positions_.push_back({values[0], values[1], values[2]});
+        chunk.colors_.push_back(count >= 6 ? DirectX::XMFLOAT4{values[3],
+                                                               values[4],
+                                                               values[5], 1.0f}
+                                           : DEFAULT_COLOR);
+      } else if (p[0] == 'f') {
+        // "a", "a/b", "a/b/c", "a//c" 에서 위치 인덱스 a 만 씁니다
+        face.clear();
+        const char* q = p + 1;
+        while (true) {
+          int64_t value = 0;
+          const char* next = ParseNumber(q, chunk_end, value);
+          if (next == nullptr) break;
+          q = SkipToken(next, chunk_end);
+
+          if (value > UINT32_MAX || value < -int64_t{UINT32_MAX}) {
+            chunk.failed_ = true;
+            return;
+          } else if (value > 0) {
+            face.push_back(value - 1);
+          } else if (value < 0) {
+            face.push_back(OBJ_RELATIVE +
+                           static_cast<int64_t>(chunk.positions_.size()) +
+                           value);
+          } else {
+            chunk.failed_ = true;
+            return;
+          }
+        }
+
+        for (size_t i = 2; i < face.size(); i++) {
+          chunk.corners_.push_back(face[0]);
+          chunk.corners_.push_back(face[i - 1]);
+          chunk.corners_.push_back(face[i]);
+        }
+      }
+    }
+  });
+
+  // 2 단계: 청크별 시작 위치를 구하고 하나의 배열로 합칩니다
+  std::vector<size_t> position_offsets(chunks.size() + 1, 0);
+  std::vector<size_t> corner_offsets(chunks.size() + 1, 0);
+  for (size_t i = 0; i < chunks.size(); i++) {
+    if (chunks[i].failed_) return false;
+    position_offsets[i + 1] = position_offsets[i] + chunks[i].positions_.size();
+    corner_offsets[i + 1] = corner_offsets[i] + chunks[i].corners_.size();
+  }
+
+  const int64_t position_count = static_cast<int64_t>(position_offsets.back());
+  if (position_count >= UINT32_MAX) return false;
+
+  positions_.resize(position_offsets.back());
+  colors_.resize(position_offsets.back());
+  corners_.resize(corner_offsets.back());
+
+  std::vector<uint8_t> invalid(chunks.size(), 0);
+  ParallelFor(job_system, static_cast<uint32_t>(chunks.size()),
+              [&](uint32_t index) {
+    ChunkType& chunk = chunks[index];
+    std::copy(chunk.positions_.begin(), chunk.positions_.end(),
+              positions_.begin() + position_offsets[index]);
+    std::copy(chunk.colors_.begin(), chunk.colors_.end(),
+              colors_.begin() + position_offsets[index]);
+
+    uint32_t* corners = corners_.data() + corner_offsets[index];
+    for (const int64_t corner : chunk.corners_) {
+      int64_t absolute = corner;
+      if (corner >= OBJ_RELATIVE / 2)
+        absolute = corner - OBJ_RELATIVE +
+                   static_cast<int64_t>(position_offsets[index]);
+
+      if (absolute < 0 || absolute >= position_count) {
+        invalid[index] = 1;
+        return;
+      }
+      *corners++ = static_cast<uint32_t>(absolute);
+    }
+
+    chunk = ChunkType{};
+  });
+
+  return std::find(invalid.begin(), invalid.end(), 1) == invalid.end();
+}
+
+bool MeshImporterClass::ImportPly(const char* begin, const char* end,
+                                  JobSystemClass* job_system) {
+  PROFILE_FUNCTION();
+
+  // 헤더를 한 줄씩 읽어 요소와 속성 목록을 만듭니다
+  std::vector<ElementType> elements;
+  bool ascii = false, big_endian = false, header_ended = false;
+  const char* p = begin;
+
+  auto read_line = [&p, end]() {
+    const char* line_end = static_cast<const char*>(
+        std::memchr(p, '\n', end - p));
+    if (line_end == nullptr) line_end = end;
+
+    std::string_view line(p, line_end - p);
+    if (line.empty() == false && line.back() == '\r') line.remove_suffix(1);
+    p = line_end < end ? line_end + 1 : end;
+    return line;
+  };
+
+  auto split = [](std::string_view line, std::string_view* words,
+                  const uint32_t max_words) {
+    uint32_t count = 0;
+    while (count < max_words) {
+      const size_t start = line.find_first_not_of(" \t");
+      if (start == std::string_view::npos) break;
+      line.remove_prefix(start);
+      const size_t length = line.find_first_of(" \t");
+      words[count++] = line.substr(0, length);
+      if (length == std::string_view::npos) break;
+      line.remove_prefix(length);
+    }
+    return count;
+  };
+
+  if (read_line() != "ply") return false;
+
+  while (p < end) {
+    std::string_view words[6];
+    const uint32_t count = split(read_line(), words, 6);
+    if (count == 0) continue;
+
+    if (words[0] == "format" && count >= 2) {
+      ascii = words[1] == "ascii";
+      big_endian = words[1] == "binary_big_endian";
+      if (ascii == false && big_endian == false &&
+          words[1] != "binary_little_endian")
+        return false;
+    } else if (words[0] == "element" && count >= 3) {
+      ElementType element{};
+      element.name_ = std::string(words[1]);
+      if (std::from_chars(words[2].data(), words[2].data() + words[2].size(),
+                          element.count_)
+              .ec != std::errc{})
+        return false;
+      elements.push_back(std::move(element));
+    } else if (words[0] == "property" && count >= 3 &&
+               elements.empty() == false) {
+      PropertyType property{};
+      if (words[1] == "list" && count >= 5) {
+        property.list_ = true;
+        property.list_count_type_ = FindPlyType(words[2]);
+        property.type_ = FindPlyType(words[3]);
+        property.name_ = std::string(words[4]);
+        if (property.list_count_type_ == PLY_TYPE_COUNT) return false;
+      } else {
+        property.list_ = false;
+        property.type_ = FindPlyType(words[1]);
+        property.name_ = std::string(words[2]);
+      }
+      if (property.type_ == PLY_TYPE_COUNT) return false;
+      elements.back().properties_.push_back(std::move(property));
+    } else if (words[0] == "end_header") {
+      header_ended = true;
+      break;
+    }
+  }
+
+  if (header_ended == false) return false;
+
+  return ascii ? ReadPlyAscii(elements, p, end, job_system)
+               : ReadPlyBinary(elements, big_endian, p, end, job_system);
+}
+
+bool MeshImporterClass::ReadPlyAscii(const std::vector<ElementType>& elements,
+                                     const char* begin, const char* end,
+                                     JobSystemClass* job_system) {
+  PROFILE_FUNCTION();
+
+  const char* p = begin;
+  for (const ElementType& element : elements) {
+    // 요소의 줄 범위를 먼저 찾습니다
+    const char* section_begin = p;
+    for (uint32_t i = 0; i < element.count_; i++) {
+      if (p >= end) return false;
+      p = NextLine(p, end);
+    }
+    const char* section_end = p;
+
+    const bool is_vertex = element.name_ == "vertex";
+    const bool is_face = element.name_ == "face";
+    if (is_vertex == false && is_face == false) continue;
+
+    PlyVertexFieldsType fields{};
+    int32_t index_property = -1;
+    for (size_t i = 0; i < element.properties_.size(); i++) {
+      const PropertyType& property = element.properties_[i];
+      const std::string& name = property.name_;
+      if (is_vertex && property.list_) return false;
+      if (name == "x") fields.position_[0] = static_cast<int32_t>(i);
+      if (name == "y") fields.position_[1] = static_cast<int32_t>(i);
+      if (name == "z") fields.position_[2] = static_cast<int32_t>(i);
+      if (name == "red") fields.color_[0] = static_cast<int32_t>(i);
+      if (name == "green") fields.color_[1] = static_cast<int32_t>(i);
+      if (name == "blue") fields.color_[2] = static_cast<int32_t>(i);
+      if (name == "alpha") fields.color_[3] = static_cast<int32_t>(i);
+      if (property.list_ &&
+          (name == "vertex_indices" || name == "vertex_index"))
+        index_property = static_cast<int32_t>(i);
+    }
+    if (is_vertex && (fields.position_[0] < 0 || fields.position_[1] < 0 ||
+                      fields.position_[2] < 0))
+      return false;
+    if (is_face && index_property < 0) return false;
+    if (element.properties_.size() > MAX_ASCII_PROPERTIES) return false;
+    if (is_vertex && fields.color_[0] >= 0)
+      fields.color_normalized_ =
+          element.properties_[fields.color_[0]].type_ == PLY_UCHAR;
+
+    struct ChunkType {
+      std::vector<DirectX::XMFLOAT3> positions_;
+      std::vector<DirectX::XMFLOAT4> colors_;
+      std::vector<uint32_t> corners_;
+      bool failed_ = false;
+    };
+
+    std::vector<const char*> bounds;
+    SplitLines(section_begin, section_end,
+               GetChunkCount(section_end - section_begin, job_system),
+               bounds);
+    std::vector<ChunkType> chunks(bounds.size() - 1);
+
+    ParallelFor(job_system, static_cast<uint32_t>(chunks.size()),
+                [&](uint32_t index) {
+      PROFILE_SCOPE("PlyAsciiChunk");
+      ChunkType& chunk = chunks[index];
+      const char* chunk_end = bounds[index + 1];
+      std::vector<uint32_t> face;
+      double values[MAX_ASCII_PROPERTIES]{};
+
+      for (const char* q = bounds[index]; q < chunk_end;
+           q = NextLine(q, chunk_end)) {
+        const char* r = q;
+        for (size_t i = 0; i < element.properties_.size(); i++) {
+          const PropertyType& property = element.properties_[i];
+          if (property.list_ == false) {
+            double value = 0.0;
+            r = ParseNumber(r, chunk_end, value);
+            if (r == nullptr) break;
+            values[i] = value;
+            continue;
+          }
+
+          uint32_t count = 0;
+          r = ParseNumber(r, chunk_end, count);
+          face.clear();
+          for (uint32_t n = 0; r && n < count; n++) {
+            uint32_t value = 0;
+            r = ParseNumber(r, chunk_end, value);
+            face.push_back(value);
+          }
+          if (r == nullptr) break;
+
+          if (static_cast<int32_t>(i) == index_property) {
+            for (size_t n = 2; n < face.size(); n++) {
+              chunk.corners_.push_back(face[0]);
+              chunk.corners_.push_back(face[n - 1]);
+              chunk.corners_.push_back(face[n]);
+            }
+          }
+        }
+        if (r == nullptr) {
+          chunk.failed_ = true;
+          return;
+        }
+
+        if (is_vertex) {
+          chunk.positions_.push_back(
+              {static_cast<float>(values[fields.position_[0]]),
+               static_cast<float>(values[fields.position_[1]]),
+               static_cast<float>(values[fields.position_[2]])});
+
+          DirectX::XMFLOAT4 color = DEFAULT_COLOR;
+          float* channels = &color.x;
+          const float scale = fields.color_normalized_ ? 1.0f / 255.0f : 1.0f;
+          for (int32_t c = 0; c < 4; c++)
+            if (fields.color_[c] >= 0)
+              channels[c] = static_cast<float>(values[fields.color_[c]]) *
+                            scale;
+          chunk.colors_.push_back(color);
+        }
+      }
+    });
+
+    // 청크 결과를 순서대로 이어 붙입니다
+    for (ChunkType& chunk : chunks) {
+      if (chunk.failed_) return false;
+      positions_.insert(positions_.end(), chunk.positions_.begin(),
+                        chunk.positions_.end());
+      colors_.insert(colors_.end(), chunk.colors_.begin(),
+                     chunk.colors_.end());
+      corners_.insert(corners_.end(), chunk.corners_.begin(),
+                      chunk.corners_.end());
+    }
+  }
+
+  return true;
+}
+
+bool MeshImporterClass::ReadPlyBinary(const std::vector<ElementType>& elements,
+                                      const bool big_endian, const char* begin,
+                                      const char* end,
+                                      JobSystemClass* job_system) {
+  PROFILE_FUNCTION();
+
+  const char* p = begin;
+  for (const ElementType& element : elements) {
+    const bool is_vertex = element.name_ == "vertex";
+    const bool is_face = element.name_ == "face";
+
+    // 리스트가 없으면 요소 하나의 크기가 고정입니다
+    bool fixed = true;
+    uint32_t stride = 0;
+    std::vector<uint32_t> offsets;
+    for (const PropertyType& property : element.properties_) {
+      offsets.push_back(stride);
+      if (property.list_) fixed = false;
+      stride += PLY_TYPES[property.type_].size_;
+    }
+
+    if (is_vertex) {
+      if (fixed == false ||
+          static_cast<uint64_t>(end - p) <
+              static_cast<uint64_t>(stride) * element.count_)
+        return false;
+
+      PlyVertexFieldsType fields{};
+      for (size_t i = 0; i < element.properties_.size(); i++) {
+        const std::string& name = element.properties_[i].name_;
+        if (name == "x") fields.position_[0] = static_cast<int32_t>(i);
+        if (name == "y") fields.position_[1] = static_cast<int32_t>(i);
+        if (name == "z") fields.position_[2] = static_cast<int32_t>(i);
+        if (name == "red") fields.color_[0] = static_cast<int32_t>(i);
+        if (name == "green") fields.color_[1] = static_cast<int32_t>(i);
+        if (name == "blue") fields.color_[2] = static_cast<int32_t>(i);
+        if (name == "alpha") fields.color_[3] = static_cast<int32_t>(i);
+      }
+      if (fields.position_[0] < 0 || fields.position_[1] < 0 ||
+          fields.position_[2] < 0)
+        return false;
+      if (fields.color_[0] >= 0)
+        fields.color_normalized_ =
+            element.properties_[fields.color_[0]].type_ == PLY_UCHAR;
+
+      // 정점은 크기가 고정이라 범위로 나눠 병렬로 읽습니다
+      const size_t first = positions_.size();
+      positions_.resize(first + element.count_);
+      colors_.resize(first + element.count_);
+
+      const uint32_t chunk_count = GetChunkCount(
+          static_cast<uint64_t>(stride) * element.count_, job_system);
+      const char* data = p;
+      ParallelFor(job_system, chunk_count, [&](uint32_t chunk) {
+        const uint64_t chunk_begin =
+            uint64_t{element.count_} * chunk / chunk_count;
+        const uint64_t chunk_end =
+            uint64_t{element.count_} * (chunk + 1) / chunk_count;
+
+        for (uint64_t i = chunk_begin; i < chunk_end; i++) {
+          const char* vertex = data + i * stride;
+          auto read = [&](const int32_t property) {
+            return ReadPlyScalar(vertex + offsets[property],
+                                 element.properties_[property].type_,
+                                 big_endian);
+          };
+
+          DirectX::XMFLOAT3& position = positions_[first + i];
+          position.x = static_cast<float>(read(fields.position_[0]));
+          position.y = static_cast<float>(read(fields.position_[1]));
+          position.z = static_cast<float>(read(fields.position_[2]));
+
+          DirectX::XMFLOAT4 color = DEFAULT_COLOR;
+          float* channels = &color.x;
+          const float scale = fields.color_normalized_ ? 1.0f / 255.0f : 1.0f;
+          for (int32_t c = 0; c < 4; c++)
+            if (fields.color_[c] >= 0)
+              channels[c] = static_cast<float>(read(fields.color_[c])) * scale;
+          colors_[first + i] = color;
+        }
+      });
+
+      p += static_cast<uint64_t>(stride) * element.count_;
+      continue;
+    }
+
+    if (fixed) {
+      if (static_cast<uint64_t>(end - p) <
+          static_cast<uint64_t>(stride) * element.count_)
+        return false;
+      p += static_cast<uint64_t>(stride) * element.count_;
+      continue;
+    }
+
+    // 리스트가 있는 요소는 길이가 달라 순서대로 읽습니다
+    std::vector<uint32_t> face;
+    for (uint32_t n = 0; n < element.count_; n++) {
+      for (const PropertyType& property : element.properties_) {
+        const uint32_t item_size = PLY_TYPES[property.type_].size_;
+        if (property.list_ == false) {
+          if (static_cast<uint64_t>(end - p) < item_size) return false;
+          p += item_size;
+          continue;
+        }
+
+        const uint32_t count_size = PLY_TYPES[property.list_count_type_].size_;
+        if (static_cast<uint64_t>(end - p) < count_size) return false;
+        const uint32_t count = static_cast<uint32_t>(
+            ReadPlyScalar(p, property.list_count_type_, big_endian));
+        p += count_size;
+        if (static_cast<uint64_t>(end - p) <
+            static_cast<uint64_t>(item_size) * count)
+          return false;
+
+        if (is_face && (property.name_ == "vertex_indices" ||
+                        property.name_ == "vertex_index")) {
+          face.resize(count);
+          for (uint32_t i = 0; i < count; i++)
+            face[i] = static_cast<uint32_t>(ReadPlyScalar(
+                p + i * item_size, property.type_, big_endian));
+
+          for (uint32_t i = 2; i < count; i++) {
+            corners_.push_back(face[0]);
+            corners_.push_back(face[i - 1]);
+            corners_.push_back(face[i]);
+          }
+        }
+        p += static_cast<uint64_t>(item_size) * count;
+      }
+    }
+  }
+
+  return true;
+}
+
+void MeshImporterClass::SplitLines(const char* begin, const char* end,
+                                   const uint32_t chunk_count,
+                                   std::vector<const char*>& bounds) {
+  bounds.clear();
+  bounds.push_back(begin);
+
+  const uint64_t size = end - begin;
+  for (uint32_t i = 1; i < chunk_count; i++) {
+    const char* p = begin + size * i / chunk_count;
+    p = (std::max)(p, bounds.back());
+    if (p > begin && p[-1] != '\n') p = NextLine(p, end);
+    bounds.push_back(p);
+  }
+
+  bounds.push_back(end);
+}
+
+void MeshImporterClass::ParallelFor(
+    JobSystemClass* job_system, const uint32_t count,
+    const std::function<void(uint32_t)>& task) {
+  if (job_system) {
+    job_system->ParallelFor(count, task);
+  } else {
+    for (uint32_t i = 0; i < count; i++) task(i);
+  }
+}
+
+uint32_t MeshImporterClass::GetChunkCount(const uint64_t size,
+                                          JobSystemClass* job_system) {
+  if (job_system == nullptr) return 1;
+
+  const uint64_t by_size = (std::max)(size / MIN_CHUNK_SIZE, uint64_t{1});
+  return static_cast<uint32_t>(
+      (std::min)(by_size, uint64_t{job_system->GetThreadCount()} * 4));
+}
+
+bool MeshImporterClass::BuildIndexedStream(JobSystemClass* job_system) {
+  PROFILE_FUNCTION();
+
+  const uint32_t position_count = static_cast<uint32_t>(positions_.size());
+  const uint32_t UNASSIGNED = UINT32_MAX;
+  const uint64_t EMPTY_SLOT = UINT64_MAX;
+
+  // 1 단계: 값이 같은 위치마다 가장 앞의 인덱스(대표)를 찾습니다.
+  // 해시 상위 비트로 나눈 조각마다 따로 해시 테이블을 두어 병렬로 처리합니다
+  std::vector<uint64_t> hashes(position_count);
+  const uint32_t hash_chunks =
+      GetChunkCount(uint64_t{position_count} * 64, job_system);
+  ParallelFor(job_system, hash_chunks, [&](uint32_t chunk) {
+    const uint32_t begin =
+        static_cast<uint32_t>(uint64_t{position_count} * chunk / hash_chunks);
+    const uint32_t end = static_cast<uint32_t>(uint64_t{position_count} *
+                                               (chunk + 1) / hash_chunks);
+    for (uint32_t i = begin; i < end; i++)
+      hashes[i] = HashVertex(positions_[i], colors_[i]);
+  });
+
+  std::vector<uint32_t> canonical(position_count);
+  const uint32_t shard_count =
+      job_system ? job_system->GetThreadCount() : 1;
+  ParallelFor(job_system, shard_count, [&](uint32_t shard) {
+    uint32_t capacity = 16;
+    while (capacity < position_count * 2u / shard_count) capacity <<= 1;
+
+    // 슬롯에는 해시 상위 32비트와 위치 인덱스를 함께 넣어 비교를 줄입니다
+    std::vector<uint64_t> table(capacity, EMPTY_SLOT);
+    for (uint32_t i = 0; i < position_count; i++) {
+      const uint64_t hash = hashes[i];
+      if ((hash >> 40) % shard_count != shard) continue;
+
+      const uint32_t tag = static_cast<uint32_t>(hash >> 32);
+      uint32_t slot = static_cast<uint32_t>(hash) & (capacity - 1);
+      while (table[slot] != EMPTY_SLOT) {
+        const uint32_t other = static_cast<uint32_t>(table[slot]);
+        if (static_cast<uint32_t>(table[slot] >> 32) == tag &&
+            std::memcmp(&positions_[other], &positions_[i],
+                        sizeof(DirectX::XMFLOAT3)) == 0 &&
+            std::memcmp(&colors_[other], &colors_[i],
+                        sizeof(DirectX::XMFLOAT4)) == 0)
+          break;
+        slot = (slot + 1) & (capacity - 1);
+      }
+
+      if (table[slot] == EMPTY_SLOT) table[slot] = (uint64_t{tag} << 32) | i;
+      canonical[i] = static_cast<uint32_t>(table[slot]);
+    }
+  });
+  hashes = {};
+
+  // 2 단계: 처음 참조되는 순서대로 정점 번호를 매겨 인덱스 스트림을 만듭니다
+  std::vector<uint32_t> remap(position_count, UNASSIGNED);
+  vertices_.clear();
+  vertices_.reserve(position_count);
+  indices_.resize(corners_.size());
+
+  for (size_t i = 0; i < corners_.size(); i++) {
+    const uint32_t corner = corners_[i];
+    if (corner >= position_count) return false;
+
+    const uint32_t source = canonical[corner];
+    if (remap[source] == UNASSIGNED) {
+      remap[source] = static_cast<uint32_t>(vertices_.size());
+      vertices_.push_back({positions_[source], colors_[source]});
+    }
+
+    indices_[i] = remap[source];
+  }
+
+  return vertices_.empty() == false && indices_.empty() == false;
+}
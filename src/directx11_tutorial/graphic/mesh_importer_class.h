@@ -0,0 +1,78 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "model_class.h"
+
+class JobSystemClass;
+
+// Wavefront OBJ 와 ASCII/이진 PLY 를 읽어 중복을 제거한 인덱스 정점 스트림을
+// 만듭니다. 파일은 매핑해서 읽고, 줄 단위 청크로 나눠 병렬로 파싱합니다.
+// 숫자는 std::from_chars 로 읽고 strtod 나 iostream 은 쓰지 않습니다.
+class MeshImporterClass {
+ public:
+  // 청크 하나의 최소 크기입니다. 작은 파일은 나누지 않습니다
+  static const uint32_t MIN_CHUNK_SIZE = 1 << 20;
+
+  // job_system 이 있으면 청크를 병렬로 파싱합니다
+  bool Import(const std::filesystem::path& path,
+              JobSystemClass* job_system = nullptr);
+  void Shutdown();
+
+  const ModelClass::VertexType* GetVertices();
+  const uint32_t* GetIndices();
+  uint32_t GetVertexCount();
+  uint32_t GetIndexCount();
+
+  // 결과를 복사하지 않고 넘겨줍니다. 이후 importer 는 비어 있습니다
+  void ReleaseGeometry(std::vector<ModelClass::VertexType>& vertices,
+                       std::vector<uint32_t>& indices);
+
+ private:
+  struct PropertyType {
+    std::string name_;
+    uint32_t type_;
+    uint32_t list_count_type_;
+    bool list_;
+  };
+
+  struct ElementType {
+    std::string name_;
+    uint32_t count_;
+    std::vector<PropertyType> properties_;
+  };
+
+  bool ImportObj(const char* begin, const char* end,
+                 JobSystemClass* job_system);
+  bool ImportPly(const char* begin, const char* end,
+                 JobSystemClass* job_system);
+  bool ReadPlyAscii(const std::vector<ElementType>& elements,
+                    const char* begin, const char* end,
+                    JobSystemClass* job_system);
+  bool ReadPlyBinary(const std::vector<ElementType>& elements,
+                     const bool big_endian, const char* begin,
+                     const char* end, JobSystemClass* job_system);
+
+  // [begin, end) 를 줄 경계에서 대략 같은 크기의 청크로 나눕니다
+  static void SplitLines(const char* begin, const char* end,
+                         const uint32_t chunk_count,
+                         std::vector<const char*>& bounds);
+  static void ParallelFor(JobSystemClass* job_system, const uint32_t count,
+                          const std::function<void(uint32_t)>& task);
+  uint32_t GetChunkCount(const uint64_t size, JobSystemClass* job_system);
+
+  // positions_, colors_, corners_ 로부터 중복 없는 정점과 인덱스를 만듭니다
+  bool BuildIndexedStream(JobSystemClass* job_system);
+
+ private:
+  std::vector<DirectX::XMFLOAT3> positions_;
+  std::vector<DirectX::XMFLOAT4> colors_;
+  std::vector<uint32_t> corners_;
+
+  std::vector<ModelClass::VertexType> vertices_;
+  std::vector<uint32_t> indices_;
+};
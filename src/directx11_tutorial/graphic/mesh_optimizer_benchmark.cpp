@@ -0,0 +1,47 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "framework/benchmark_class.h"
+#include "graphic/mesh_optimizer_class.h"
+#include "graphic/model_class.h"
+
+void RegisterMeshOptimizerBenchmarks(BenchmarkClass& benchmark) {
+  // 삼각형 순서를 섞은 256x256 격자를 정점 캐시, overdraw, fetch 순으로
+  // 최적화하기
+  benchmark.AddFixture("MeshOptimizerClass::Optimize/256", 255 * 255 * 2, [] {
+    const uint32_t grid = 256;
+    auto vertices = std::make_shared<std::vector<ModelClass::VertexType>>();
+    auto indices = std::make_shared<std::vector<uint32_t>>();
+
+    for (uint32_t y = 0; y < grid; y++)
+      for (uint32_t x = 0; x < grid; x++)
+        vertices->push_back({{static_cast<float>(x), static_cast<float>(y),
+                              0.0f},
+                             {1.0f, 1.0f, 1.0f, 1.0f}});
+
+    std::vector<uint32_t> quads;
+    for (uint32_t i = 0; i < (grid - 1) * (grid - 1); i++) quads.push_back(i);
+    std::shuffle(quads.begin(), quads.end(), std::mt19937{42});
+    for (const uint32_t quad : quads) {
+      const uint32_t v = quad / (grid - 1) * grid + quad % (grid - 1);
+      indices->insert(indices->end(),
+                      {v, v + 1, v + grid, v + 1, v + grid + 1, v + grid});
+    }
+
+    return BenchmarkClass::BodyType([vertices, indices](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; i++) {
+        std::vector<ModelClass::VertexType> optimized_vertices = *vertices;
+        std::vector<uint32_t> optimized_indices = *indices;
+        MeshOptimizerClass::StatisticsType before{}, after{};
+        MeshOptimizerClass::Optimize(optimized_vertices, optimized_indices,
+                                     before, after);
+        BenchmarkClass::DoNotOptimize(after);
+      }
+    });
+  });
+}
@@ -0,0 +1,379 @@
+#include "pch.h"
+#include "mesh_optimizer_class.h"
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "framework/profiler.h"
+
+namespace {
+// Tom Forsyth, "Linear-Speed Vertex Cache Optimisation" 의 점수 상수입니다
+const float CACHE_DECAY_POWER = 1.5f;
+const float LAST_TRIANGLE_SCORE = 0.75f;
+const float VALENCE_BOOST_SCALE = 2.0f;
+const float VALENCE_BOOST_POWER = 0.5f;
+const uint32_t MAX_VALENCE = 32;
+const uint32_t NO_TRIANGLE = UINT32_MAX;
+
+// 캐시 위치와 남은 삼각형 수에 따른 점수를 미리 계산해 둡니다
+struct ScoreTableType {
+  float cache_[MeshOptimizerClass::CACHE_SIZE];
+  float valence_[MAX_VALENCE + 1];
+
+  ScoreTableType() {
+    const float scale = 1.0f / (MeshOptimizerClass::CACHE_SIZE - 3);
+    for (uint32_t i = 0; i < MeshOptimizerClass::CACHE_SIZE; i++) {
+      // 마지막 삼각형의 세 정점은 일부러 낮은 고정 점수를 줍니다
+      cache_[i] = i < 3 ? LAST_TRIANGLE_SCORE
+                        : std::pow(1.0f - (i - 3) * scale, CACHE_DECAY_POWER);
+    }
+
+    valence_[0] = 0.0f;
+    for (uint32_t i = 1; i <= MAX_VALENCE; i++)
+      valence_[i] =
+          VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i),
+                                         -VALENCE_BOOST_POWER);
+  }
+};
+
+float GetVertexScore(const ScoreTableType& table, const int32_t cache_position,
+                     const uint32_t live_triangles) {
+  // 더 그릴 삼각형이 없는 정점은 점수에 기여하지 않습니다
+  if (live_triangles == 0) return -1.0f;
+
+  const float cache_score =
+      cache_position >= 0 ? table.cache_[cache_position] : 0.0f;
+  const float valence_score =
+      live_triangles <= MAX_VALENCE
+          ? table.valence_[live_triangles]
+          : VALENCE_BOOST_SCALE *
+                std::pow(static_cast<float>(live_triangles),
+                         -VALENCE_BOOST_POWER);
+  return cache_score + valence_score;
+}
+
+bool ValidateIndices(const uint32_t* indices, const uint32_t index_count,
+                     const uint32_t vertex_count) {
+  for (uint32_t i = 0; i < index_count; i++)
+    if (indices[i] >= vertex_count) return false;
+  return true;
+}
+
+// FIFO 정점 캐시를 흉내 냅니다. stamps[v] 는 v 가 들어간 시각이며
+// 그 뒤로 cache_size 개가 더 들어오면 밀려난 것으로 봅니다
+uint32_t CountMisses(const uint32_t* triangle, std::vector<uint32_t>& stamps,
+                     uint32_t& timestamp, const uint32_t cache_size) {
+  uint32_t misses = 0;
+  for (uint32_t k = 0; k < 3; k++) {
+    const uint32_t vertex = triangle[k];
+    if (timestamp - stamps[vertex] > cache_size) {
+      stamps[vertex] = timestamp++;
+      misses++;
+    }
+  }
+  return misses;
+}
+}  // namespace
+
+MeshOptimizerClass::StatisticsType MeshOptimizerClass::AnalyzeVertexCache(
+    const uint32_t* indices, const uint32_t index_count,
+    const uint32_t vertex_count, const uint32_t cache_size) {
+  StatisticsType statistics{};
+  const uint32_t triangle_count = index_count / 3;
+  if (triangle_count == 0 ||
+      ValidateIndices(indices, index_count, vertex_count) == false)
+    return statistics;
+
+  std::vector<uint32_t> stamps(vertex_count, 0);
+  std::vector<uint8_t> referenced(vertex_count, 0);
+  uint32_t timestamp = cache_size + 1;
+  uint32_t misses = 0;
+  uint32_t unique = 0;
+
+  for (uint32_t t = 0; t < triangle_count; t++) {
+    const uint32_t* triangle = &indices[t * 3];
+    misses += CountMisses(triangle, stamps, timestamp, cache_size);
+    for (uint32_t k = 0; k < 3; k++) {
+      if (referenced[triangle[k]] == 0) {
+        referenced[triangle[k]] = 1;
+        unique++;
+      }
+    }
+  }
+
+  statistics.acmr_ = static_cast<float>(misses) / triangle_count;
+  statistics.atvr_ = static_cast<float>(misses) / unique;
+  return statistics;
+}
+
+void MeshOptimizerClass::OptimizeVertexCache(uint32_t* indices,
+                                             const uint32_t index_count,
+                                             const uint32_t vertex_count) {
+  PROFILE_FUNCTION();
+
+  const uint32_t triangle_count = index_count / 3;
+  if (triangle_count == 0 ||
+      ValidateIndices(indices, index_count, vertex_count) == false)
+    return;
+
+  static const ScoreTableType table{};
+
+  // 정점마다 아직 그리지 않은 인접 삼각형 목록을 만듭니다
+  std::vector<uint32_t> offsets(vertex_count + 1, 0);
+  for (uint32_t i = 0; i < triangle_count * 3; i++) offsets[indices[i] + 1]++;
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  std::vector<uint32_t> live(vertex_count, 0);
+  std::vector<uint32_t> adjacency(triangle_count * 3);
+  for (uint32_t i = 0; i < triangle_count * 3; i++) {
+    const uint32_t vertex = indices[i];
+    adjacency[offsets[vertex] + live[vertex]++] = i / 3;
+  }
+
+  std::vector<int32_t> cache_positions(vertex_count, -1);
+  std::vector<float> vertex_scores(vertex_count);
+  for (uint32_t v = 0; v < vertex_count; v++)
+    vertex_scores[v] = GetVertexScore(table, -1, live[v]);
+
+  std::vector<float> triangle_scores(triangle_count);
+  std::vector<uint8_t> emitted(triangle_count, 0);
+  uint32_t best_triangle = NO_TRIANGLE;
+  float best_score = -1.0f;
+  for (uint32_t t = 0; t < triangle_count; t++) {
+    const uint32_t* triangle = &indices[t * 3];
+    triangle_scores[t] = vertex_scores[triangle[0]] +
+                         vertex_scores[triangle[1]] +
+                         vertex_scores[triangle[2]];
+    if (triangle_scores[t] > best_score) {
+      best_score = triangle_scores[t];
+      best_triangle = t;
+    }
+  }
+
+  std::vector<uint32_t> output(triangle_count * 3);
+  uint32_t cache[CACHE_SIZE + 3];
+  uint32_t new_cache[CACHE_SIZE + 3];
+  uint32_t cache_count = 0;
+  uint32_t cursor = 0;
+
+  for (uint32_t n = 0; n < triangle_count; n++) {
+    // 캐시 안에서 이어 갈 삼각형이 없으면 입력 순서로 다음 것을 고릅니다
+    if (best_triangle == NO_TRIANGLE) {
+      while (emitted[cursor]) cursor++;
+      best_triangle = cursor;
+    }
+
+    const uint32_t* triangle = &indices[best_triangle * 3];
+    std::copy(triangle, triangle + 3, &output[n * 3]);
+    emitted[best_triangle] = 1;
+
+    // 방금 그린 삼각형을 각 정점의 목록에서 뺍니다
+    uint32_t new_count = 0;
+    for (uint32_t k = 0; k < 3; k++) {
+      const uint32_t vertex = triangle[k];
+      uint32_t* begin = &adjacency[offsets[vertex]];
+      uint32_t* end = begin + live[vertex];
+      uint32_t* found = std::find(begin, end, best_triangle);
+      if (found != end) {
+        *found = *(end - 1);
+        live[vertex]--;
+      }
+
+      if (std::find(new_cache, new_cache + new_count, vertex) ==
+          new_cache + new_count)
+        new_cache[new_count++] = vertex;
+    }
+
+    // 나머지 캐시 항목은 한 칸씩 뒤로 밀립니다
+    for (uint32_t i = 0; i < cache_count; i++) {
+      const uint32_t vertex = cache[i];
+      if (vertex != triangle[0] && vertex != triangle[1] &&
+          vertex != triangle[2])
+        new_cache[new_count++] = vertex;
+    }
+
+    // 위치가 바뀐 정점과 그 삼각형의 점수만 다시 계산합니다
+    best_triangle = NO_TRIANGLE;
+    best_score = -1.0f;
+    for (uint32_t i = 0; i < new_count; i++) {
+      const uint32_t vertex = new_cache[i];
+      cache_positions[vertex] = i < CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+
+      const float score =
+          GetVertexScore(table, cache_positions[vertex], live[vertex]);
+      const float delta = score - vertex_scores[vertex];
+      vertex_scores[vertex] = score;
+
+      const uint32_t* begin = &adjacency[offsets[vertex]];
+      for (const uint32_t* t = begin; t != begin + live[vertex]; t++) {
+        triangle_scores[*t] += delta;
+        if (triangle_scores[*t] > best_score) {
+          best_score = triangle_scores[*t];
+          best_triangle = *t;
+        }
+      }
+    }
+
+    cache_count = (std::min)(new_count, CACHE_SIZE);
+    std::copy(new_cache, new_cache + cache_count, cache);
+  }
+
+  std::copy(output.begin(), output.end(), indices);
+}
+
+void MeshOptimizerClass::OptimizeOverdraw(
+    uint32_t* indices, const uint32_t index_count,
+    const ModelClass::VertexType* vertices, const uint32_t vertex_count,
+    const float threshold) {
+  PROFILE_FUNCTION();
+
+  const uint32_t triangle_count = index_count / 3;
+  if (triangle_count < 2 ||
+      ValidateIndices(indices, index_count, vertex_count) == false)
+    return;
+
+  const float mesh_acmr =
+      AnalyzeVertexCache(indices, index_count, vertex_count).acmr_;
+
+  // 캐시가 완전히 끊기는 지점 중 지금까지의 ACMR 이 threshold 안에 있는
+  // 곳에서 클러스터를 나눕니다. 클러스터 안의 순서는 그대로 둡니다
+  std::vector<uint32_t> cluster_starts{0};
+  std::vector<uint32_t> stamps(vertex_count, 0);
+  uint32_t timestamp = FIFO_CACHE_SIZE + 1;
+  uint32_t cluster_misses = 0;
+
+  for (uint32_t t = 0; t < triangle_count; t++) {
+    const uint32_t misses =
+        CountMisses(&indices[t * 3], stamps, timestamp, FIFO_CACHE_SIZE);
+    const uint32_t cluster_size = t - cluster_starts.back();
+    if (misses == 3 && cluster_size > 0 &&
+        static_cast<float>(cluster_misses) / cluster_size <=
+            threshold * mesh_acmr) {
+      cluster_starts.push_back(t);
+      cluster_misses = 0;
+    }
+    cluster_misses += misses;
+  }
+
+  const uint32_t cluster_count = static_cast<uint32_t>(cluster_starts.size());
+  if (cluster_count < 2) return;
+  cluster_starts.push_back(triangle_count);
+
+  // 클러스터마다 넓이 가중 중심과 법선 합을 구합니다
+  std::vector<DirectX::XMFLOAT3> centroids(cluster_count);
+  std::vector<DirectX::XMFLOAT3> normals(cluster_count);
+  DirectX::XMVECTOR mesh_centroid = DirectX::XMVectorZero();
+  float mesh_area = 0.0f;
+
+  for (uint32_t c = 0; c < cluster_count; c++) {
+    DirectX::XMVECTOR centroid = DirectX::XMVectorZero();
+    DirectX::XMVECTOR normal = DirectX::XMVectorZero();
+    float area = 0.0f;
+
+    for (uint32_t t = cluster_starts[c]; t < cluster_starts[c + 1]; t++) {
+      const uint32_t* triangle = &indices[t * 3];
+      const DirectX::XMVECTOR p0 =
+          DirectX::XMLoadFloat3(&vertices[triangle[0]].position_);
+      const DirectX::XMVECTOR p1 =
+          DirectX::XMLoadFloat3(&vertices[triangle[1]].position_);
+      const DirectX::XMVECTOR p2 =
+          DirectX::XMLoadFloat3(&vertices[triangle[2]].position_);
+
+      const DirectX::XMVECTOR cross = DirectX::XMVector3Cross(
+          DirectX::XMVectorSubtract(p1, p0), DirectX::XMVectorSubtract(p2, p0));
+      const float triangle_area =
+          0.5f * DirectX::XMVectorGetX(DirectX::XMVector3Length(cross));
+
+      const DirectX::XMVECTOR center = DirectX::XMVectorScale(
+          DirectX::XMVectorAdd(DirectX::XMVectorAdd(p0, p1), p2), 1.0f / 3.0f);
+      centroid = DirectX::XMVectorAdd(
+          centroid, DirectX::XMVectorScale(center, triangle_area));
+      normal = DirectX::XMVectorAdd(normal, cross);
+      area += triangle_area;
+    }
+
+    mesh_centroid = DirectX::XMVectorAdd(mesh_centroid, centroid);
+    mesh_area += area;
+    if (area > 0.0f) centroid = DirectX::XMVectorScale(centroid, 1.0f / area);
+    DirectX::XMStoreFloat3(&centroids[c], centroid);
+    DirectX::XMStoreFloat3(&normals[c], normal);
+  }
+
+  if (mesh_area <= 0.0f) return;
+  mesh_centroid = DirectX::XMVectorScale(mesh_centroid, 1.0f / mesh_area);
+
+  // 메시 중심에서 바깥을 향하는 클러스터일수록 다른 면을 가릴 가능성이
+  // 높으므로 먼저 그립니다
+  std::vector<float> keys(cluster_count);
+  for (uint32_t c = 0; c < cluster_count; c++) {
+    const DirectX::XMVECTOR normal =
+        DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&normals[c]));
+    const DirectX::XMVECTOR offset = DirectX::XMVectorSubtract(
+        DirectX::XMLoadFloat3(&centroids[c]), mesh_centroid);
+    keys[c] = DirectX::XMVectorGetX(DirectX::XMVector3Dot(offset, normal));
+  }
+
+  std::vector<uint32_t> order(cluster_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&keys](const uint32_t a, const uint32_t b) {
+                     return keys[a] > keys[b];
+                   });
+
+  std::vector<uint32_t> output;
+  output.reserve(triangle_count * 3);
+  for (const uint32_t c : order)
+    output.insert(output.end(), indices + cluster_starts[c] * 3,
+                  indices + cluster_starts[c + 1] * 3);
+
+  std::copy(output.begin(), output.end(), indices);
+}
+
+uint32_t MeshOptimizerClass::OptimizeVertexFetch(
+    ModelClass::VertexType* vertices, uint32_t* indices,
+    const uint32_t index_count, const uint32_t vertex_count) {
+  PROFILE_FUNCTION();
+
+  if (ValidateIndices(indices, index_count, vertex_count) == false)
+    return vertex_count;
+
+  // 인덱스 스트림에서 처음 참조되는 순서로 정점 번호를 다시 매깁니다
+  const uint32_t UNASSIGNED = UINT32_MAX;
+  std::vector<uint32_t> remap(vertex_count, UNASSIGNED);
+  std::vector<ModelClass::VertexType> reordered;
+  reordered.reserve(vertex_count);
+
+  for (uint32_t i = 0; i < index_count; i++) {
+    const uint32_t vertex = indices[i];
+    if (remap[vertex] == UNASSIGNED) {
+      remap[vertex] = static_cast<uint32_t>(reordered.size());
+      reordered.push_back(vertices[vertex]);
+    }
+    indices[i] = remap[vertex];
+  }
+
+  std::copy(reordered.begin(), reordered.end(), vertices);
+  return static_cast<uint32_t>(reordered.size());
+}
+
+void MeshOptimizerClass::Optimize(std::vector<ModelClass::VertexType>& vertices,
+                                  std::vector<uint32_t>& indices,
+                                  StatisticsType& before,
+                                  StatisticsType& after) {
+  const uint32_t index_count = static_cast<uint32_t>(indices.size());
+  const uint32_t vertex_count = static_cast<uint32_t>(vertices.size());
+
+  before = AnalyzeVertexCache(indices.data(), index_count, vertex_count);
+
+  OptimizeVertexCache(indices.data(), index_count, vertex_count);
+  OptimizeOverdraw(indices.data(), index_count, vertices.data(),
+                   vertex_count);
+  vertices.resize(OptimizeVertexFetch(vertices.data(), indices.data(),
+                                      index_count, vertex_count));
+
+  after = AnalyzeVertexCache(indices.data(), index_count,
+                             static_cast<uint32_t>(vertices.size()));
+}
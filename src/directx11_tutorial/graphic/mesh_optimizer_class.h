@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "model_class.h"
+
+// 인덱스 메시를 GPU 가 읽기 좋은 순서로 다시 배치합니다.
+// 1. Forsyth 점수로 삼각형 순서를 바꿔 변환 후 정점 캐시 적중을 높이고
+// 2. 캐시 효율을 크게 잃지 않는 범위에서 클러스터를 바깥쪽 면부터 그려
+//    overdraw 를 줄이고
+// 3. 처음 참조되는 순서로 정점을 옮겨 정점 fetch 를 순차적으로 만듭니다
+class MeshOptimizerClass {
+ public:
+  // Forsyth 점수 계산에 쓰는 LRU 캐시 크기입니다
+  static constexpr uint32_t CACHE_SIZE = 32;
+  // ACMR/ATVR 을 잴 때 흉내 내는 FIFO 캐시 크기입니다
+  static constexpr uint32_t FIFO_CACHE_SIZE = 16;
+
+  struct StatisticsType {
+    float acmr_;  // 삼각형당 변환되는 정점 수 (0.5 ~ 3)
+    float atvr_;  // 정점당 변환 횟수 (1 이 최적)
+  };
+
+  static StatisticsType AnalyzeVertexCache(
+      const uint32_t* indices, const uint32_t index_count,
+      const uint32_t vertex_count,
+      const uint32_t cache_size = FIFO_CACHE_SIZE);
+
+  static void OptimizeVertexCache(uint32_t* indices, const uint32_t index_count,
+                                  const uint32_t vertex_count);
+  // threshold 는 클러스터를 나눌 때 허용하는 ACMR 증가 비율입니다
+  static void OptimizeOverdraw(uint32_t* indices, const uint32_t index_count,
+                               const ModelClass::VertexType* vertices,
+                               const uint32_t vertex_count,
+                               const float threshold = 1.05f);
+  // 참조되지 않는 정점은 버리고 남은 정점 수를 반환합니다
+  static uint32_t OptimizeVertexFetch(ModelClass::VertexType* vertices,
+                                      uint32_t* indices,
+                                      const uint32_t index_count,
+                                      const uint32_t vertex_count);
+
+  // 세 단계를 차례로 적용하고 전후 통계를 돌려줍니다
+  static void Optimize(std::vector<ModelClass::VertexType>& vertices,
+                       std::vector<uint32_t>& indices, StatisticsType& before,
+                       StatisticsType& after);
+};
@@ -0,0 +1,44 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "framework/benchmark_class.h"
+#include "graphic/mesh_simplifier_class.h"
+#include "graphic/model_class.h"
+
+void RegisterMeshSimplifierBenchmarks(BenchmarkClass& benchmark) {
+  // 물결 모양 256x256 격자를 삼각형 1/4 로 단순화하기
+  benchmark.AddFixture("MeshSimplifierClass::Simplify/256", 255 * 255 * 2, [] {
+    const uint32_t grid = 256;
+    auto vertices = std::make_shared<std::vector<ModelClass::VertexType>>();
+    auto indices = std::make_shared<std::vector<uint32_t>>();
+
+    for (uint32_t y = 0; y < grid; y++)
+      for (uint32_t x = 0; x < grid; x++)
+        vertices->push_back({{static_cast<float>(x), static_cast<float>(y),
+                              8.0f * std::sin(x * 0.05f)},
+                             {1.0f, 1.0f, 1.0f, 1.0f}});
+    for (uint32_t y = 0; y + 1 < grid; y++) {
+      for (uint32_t x = 0; x + 1 < grid; x++) {
+        const uint32_t v = y * grid + x;
+        indices->insert(indices->end(),
+                        {v, v + 1, v + grid, v + 1, v + grid + 1, v + grid});
+      }
+    }
+
+    return BenchmarkClass::BodyType([vertices, indices](uint64_t iterations) {
+      std::vector<uint32_t> output;
+      for (uint64_t i = 0; i < iterations; i++) {
+        const float error = MeshSimplifierClass::Simplify(
+            vertices->data(), static_cast<uint32_t>(vertices->size()),
+            indices->data(), static_cast<uint32_t>(indices->size()),
+            static_cast<uint32_t>(indices->size()) / 4, 1.0f, output);
+        BenchmarkClass::DoNotOptimize(error);
+        BenchmarkClass::DoNotOptimize(output);
+      }
+    });
+  });
+}
@@ -0,0 +1,365 @@
+#include "pch.h"
+#include "mesh_simplifier_class.h"
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "framework/profiler.h"
+
+namespace {
+const uint32_t NO_VERTEX = UINT32_MAX;
+// collapse 뒤 면 법선이 이 cos 값보다 덜 닮으면 뒤집힌 것으로 봅니다
+const float FLIP_THRESHOLD = 0.25f;
+// collapse 로 면적이 이 비율보다 작아지는 삼각형은 퇴화한 것으로 봅니다
+const float MIN_AREA_RATIO = 1e-3f;
+const float LOCKED_COST = std::numeric_limits<float>::max();
+
+// 평면 quadric 은 대칭 4x4 행렬의 10 개 계수로, 색 quadric 은 점까지의
+// 거리 제곱 합으로 둡니다. 모두 삼각형 면적으로 가중합니다
+struct QuadricType {
+  double a00_, a11_, a22_, a10_, a20_, a21_;
+  double b0_, b1_, b2_, c_;
+  double weight_;
+  double color_[4];  // sum(w * color)
+  double color_c_;   // sum(w * |color|^2)
+  double color_weight_;
+};
+
+void AddQuadric(QuadricType& target, const QuadricType& source) {
+  target.a00_ += source.a00_;
+  target.a11_ += source.a11_;
+  target.a22_ += source.a22_;
+  target.a10_ += source.a10_;
+  target.a20_ += source.a20_;
+  target.a21_ += source.a21_;
+  target.b0_ += source.b0_;
+  target.b1_ += source.b1_;
+  target.b2_ += source.b2_;
+  target.c_ += source.c_;
+  target.weight_ += source.weight_;
+  for (uint32_t i = 0; i < 4; i++) target.color_[i] += source.color_[i];
+  target.color_c_ += source.color_c_;
+  target.color_weight_ += source.color_weight_;
+}
+
+// 삼각형 평면까지의 거리 제곱을 면적으로 가중해 더합니다. 면적을
+// 돌려줍니다
+double AddPlane(QuadricType& quadric, const DirectX::XMFLOAT3& p0,
+                const DirectX::XMFLOAT3& p1, const DirectX::XMFLOAT3& p2) {
+  const double e1[3] = {p1.x - p0.x, p1.y - p0.y, p1.z - p0.z};
+  const double e2[3] = {p2.x - p0.x, p2.y - p0.y, p2.z - p0.z};
+  double n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2],
+                 e1[0] * e2[1] - e1[1] * e2[0]};
+  const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+  if (length == 0.0) return 0.0;
+
+  for (double& value : n) value /= length;
+  const double d = -(n[0] * p0.x + n[1] * p0.y + n[2] * p0.z);
+  const double w = length * 0.5;
+
+  quadric.a00_ += w * n[0] * n[0];
+  quadric.a11_ += w * n[1] * n[1];
+  quadric.a22_ += w * n[2] * n[2];
+  quadric.a10_ += w * n[1] * n[0];
+  quadric.a20_ += w * n[2] * n[0];
+  quadric.a21_ += w * n[2] * n[1];
+  quadric.b0_ += w * d * n[0];
+  quadric.b1_ += w * d * n[1];
+  quadric.b2_ += w * d * n[2];
+  quadric.c_ += w * d * d;
+  quadric.weight_ += w;
+  return w;
+}
+
+void AddColor(QuadricType& quadric, const DirectX::XMFLOAT4& color,
+              const double w) {
+  const double c[4] = {color.x, color.y, color.z, color.w};
+  for (uint32_t i = 0; i < 4; i++) {
+    quadric.color_[i] += w * c[i];
+    quadric.color_c_ += w * c[i] * c[i];
+  }
+  quadric.color_weight_ += w;
+}
+
+// 정점을 position, color 로 옮겼을 때 생기는 면적당 오차입니다
+float EvaluateQuadric(const QuadricType& q, const DirectX::XMFLOAT3& position,
+                      const DirectX::XMFLOAT4& color) {
+  const double x = position.x, y = position.y, z = position.z;
+  const double rx = q.a00_ * x + q.a10_ * y + q.a20_ * z + q.b0_;
+  const double ry = q.a10_ * x + q.a11_ * y + q.a21_ * z + q.b1_;
+  const double rz = q.a20_ * x + q.a21_ * y + q.a22_ * z + q.b2_;
+  const double plane_error =
+      x * rx + y * ry + z * rz + q.b0_ * x + q.b1_ * y + q.b2_ * z + q.c_;
+
+  const double c[4] = {color.x, color.y, color.z, color.w};
+  double color_error = q.color_c_;
+  for (uint32_t i = 0; i < 4; i++)
+    color_error += q.color_weight_ * c[i] * c[i] - 2.0 * c[i] * q.color_[i];
+
+  const double error =
+      (std::max)(plane_error, 0.0) +
+      MeshSimplifierClass::COLOR_WEIGHT * (std::max)(color_error, 0.0);
+  return static_cast<float>(error / (std::max)(q.weight_, 1e-12));
+}
+
+DirectX::XMVECTOR GetTriangleNormal(const DirectX::XMFLOAT3& p0,
+                                    const DirectX::XMFLOAT3& p1,
+                                    const DirectX::XMFLOAT3& p2) {
+  const DirectX::XMVECTOR v0 = DirectX::XMLoadFloat3(&p0);
+  return DirectX::XMVector3Cross(
+      DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&p1), v0),
+      DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&p2), v0));
+}
+
+bool IsSamePosition(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b) {
+  return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+bool IsSameColor(const DirectX::XMFLOAT4& a, const DirectX::XMFLOAT4& b) {
+  return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+}
+
+struct CandidateType {
+  uint32_t from_;  // 옮겨질 정점
+  uint32_t to_;    // 남는 정점
+  float cost_;
+};
+}  // namespace
+
+float MeshSimplifierClass::Simplify(const ModelClass::VertexType* vertices,
+                                    const uint32_t vertex_count,
+                                    const uint32_t* indices,
+                                    const uint32_t index_count,
+                                    const uint32_t target_index_count,
+                                    const float target_error,
+                                    std::vector<uint32_t>& output) {
+  PROFILE_FUNCTION();
+
+  output.assign(indices, indices + index_count / 3 * 3);
+  if (vertex_count == 0 || output.size() <= target_index_count) return 0.0f;
+
+  // 오차를 메시 크기에 대한 비율로 재도록 가장 긴 축을 1 로 맞춥니다
+  DirectX::XMVECTOR min = DirectX::XMLoadFloat3(&vertices[0].position_);
+  DirectX::XMVECTOR max = min;
+  for (uint32_t i = 0; i < vertex_count; i++) {
+    const DirectX::XMVECTOR position =
+        DirectX::XMLoadFloat3(&vertices[i].position_);
+    min = DirectX::XMVectorMin(min, position);
+    max = DirectX::XMVectorMax(max, position);
+  }
+  DirectX::XMFLOAT3 size{};
+  DirectX::XMStoreFloat3(&size, DirectX::XMVectorSubtract(max, min));
+  const float extent = (std::max)((std::max)(size.x, size.y), size.z);
+  const float scale = extent > 0.0f ? 1.0f / extent : 0.0f;
+
+  std::vector<DirectX::XMFLOAT3> positions(vertex_count);
+  for (uint32_t i = 0; i < vertex_count; i++)
+    DirectX::XMStoreFloat3(
+        &positions[i],
+        DirectX::XMVectorScale(
+            DirectX::XMVectorSubtract(
+                DirectX::XMLoadFloat3(&vertices[i].position_), min),
+            scale));
+
+  // 위치가 같은 정점(wedge)을 첫 정점으로 모읍니다. 이후 위상과 quadric 은
+  // 모두 이 위치 id 로 다룹니다
+  std::vector<uint32_t> order(vertex_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [vertices](const uint32_t a, const uint32_t b) {
+              const DirectX::XMFLOAT3& pa = vertices[a].position_;
+              const DirectX::XMFLOAT3& pb = vertices[b].position_;
+              if (pa.x != pb.x) return pa.x < pb.x;
+              if (pa.y != pb.y) return pa.y < pb.y;
+              if (pa.z != pb.z) return pa.z < pb.z;
+              return a < b;
+            });
+
+  // 색이 다른 wedge 가 있는 위치는 seam 이므로 움직이지 않습니다
+  std::vector<uint32_t> remap(vertex_count);
+  std::vector<uint8_t> locked(vertex_count, 0);
+  for (uint32_t i = 0; i < vertex_count; i++) {
+    const uint32_t vertex = order[i];
+    const bool same = i > 0 && IsSamePosition(vertices[order[i - 1]].position_,
+                                              vertices[vertex].position_);
+    remap[vertex] = same ? remap[order[i - 1]] : vertex;
+    if (IsSameColor(vertices[remap[vertex]].color_, vertices[vertex].color_) ==
+        false)
+      locked[remap[vertex]] = 1;
+  }
+
+  // 반대 방향 반변이 없는 모서리는 열린 경계이므로 양 끝을 고정합니다
+  std::vector<uint64_t> edges;
+  edges.reserve(output.size());
+  for (size_t i = 0; i < output.size(); i += 3) {
+    for (uint32_t e = 0; e < 3; e++) {
+      const uint64_t a = remap[output[i + e]];
+      const uint64_t b = remap[output[i + (e + 1) % 3]];
+      edges.push_back(a << 32 | b);
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  for (const uint64_t edge : edges) {
+    const uint64_t reverse = edge << 32 | edge >> 32;
+    if (std::binary_search(edges.begin(), edges.end(), reverse) == false) {
+      locked[edge >> 32] = 1;
+      locked[edge & 0xFFFFFFFF] = 1;
+    }
+  }
+
+  // 위치 id 마다 주변 삼각형의 평면 quadric 과 모서리 색 quadric 을 모읍니다
+  std::vector<QuadricType> quadrics(vertex_count, QuadricType{});
+  for (size_t i = 0; i < output.size(); i += 3) {
+    const uint32_t corners[3] = {output[i], output[i + 1], output[i + 2]};
+    QuadricType plane{};
+    const double area = AddPlane(plane, positions[corners[0]],
+                                 positions[corners[1]], positions[corners[2]]);
+    for (const uint32_t corner : corners) {
+      AddQuadric(quadrics[remap[corner]], plane);
+      AddColor(quadrics[remap[corner]], vertices[corner].color_, area / 3.0);
+    }
+  }
+
+  const uint32_t target = target_index_count / 3 * 3;
+  const float max_cost = target_error * target_error;
+  float result_cost = 0.0f;
+
+  std::vector<CandidateType> candidates;
+  std::vector<uint32_t> adjacency_offsets(vertex_count + 1);
+  std::vector<uint32_t> adjacency;
+  std::vector<uint32_t> collapse(vertex_count, NO_VERTEX);
+  std::vector<uint8_t> touched(vertex_count);
+
+  // 한 pass 에서는 싼 collapse 부터 서로 겹치지 않게 골라 적용하고, 목표에
+  // 닿거나 더 줄일 수 없을 때까지 pass 를 반복합니다
+  while (output.size() > target) {
+    const uint32_t triangle_count = static_cast<uint32_t>(output.size() / 3);
+
+    // 위치 id 마다 이웃 삼각형 목록을 만듭니다
+    std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0);
+    for (const uint32_t index : output) adjacency_offsets[remap[index] + 1]++;
+    for (uint32_t i = 0; i < vertex_count; i++)
+      adjacency_offsets[i + 1] += adjacency_offsets[i];
+    adjacency.resize(output.size());
+    std::vector<uint32_t> cursor(adjacency_offsets.begin(),
+                                 adjacency_offsets.end() - 1);
+    for (uint32_t i = 0; i < output.size(); i++)
+      adjacency[cursor[remap[output[i]]]++] = i / 3;
+
+    // 모서리마다 두 방향 중 더 싼 collapse 를 후보로 둡니다
+    candidates.clear();
+    for (uint32_t i = 0; i < output.size(); i++) {
+      const uint32_t v0 = output[i];
+      const uint32_t v1 = output[i - i % 3 + (i + 1) % 3];
+      const float cost01 =
+          locked[remap[v0]]
+              ? LOCKED_COST
+              : EvaluateQuadric(quadrics[remap[v0]], positions[v1],
+                                vertices[v1].color_);
+      const float cost10 =
+          locked[remap[v1]]
+              ? LOCKED_COST
+              : EvaluateQuadric(quadrics[remap[v1]], positions[v0],
+                                vertices[v0].color_);
+      const float cost = (std::min)(cost01, cost10);
+      if (cost == LOCKED_COST || cost > max_cost) continue;
+      candidates.push_back(cost01 <= cost10 ? CandidateType{v0, v1, cost01}
+                                            : CandidateType{v1, v0, cost10});
+    }
+    if (candidates.empty()) break;
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const CandidateType& a, const CandidateType& b) {
+                return a.cost_ < b.cost_;
+              });
+
+    // collapse 하나는 대개 삼각형 두 개를 지웁니다
+    const uint32_t removable = triangle_count - target / 3;
+    uint32_t removed = 0, collapse_count = 0;
+    std::fill(touched.begin(), touched.end(), 0);
+    std::fill(collapse.begin(), collapse.end(), NO_VERTEX);
+
+    for (const CandidateType& candidate : candidates) {
+      if (removed >= removable) break;
+
+      const uint32_t from = remap[candidate.from_];
+      const uint32_t to = remap[candidate.to_];
+      if (from == to || touched[from] || touched[to]) continue;
+
+      // 남는 삼각형의 법선이 뒤집히거나 퇴화하면 건너뜁니다
+      bool flipped = false;
+      uint32_t collapsed_triangles = 0;
+      for (uint32_t a = adjacency_offsets[from];
+           a < adjacency_offsets[from + 1] && !flipped; a++) {
+        const uint32_t* triangle = &output[adjacency[a] * 3];
+        DirectX::XMFLOAT3 moved[3]{};
+        bool removed_triangle = false;
+        for (uint32_t c = 0; c < 3; c++) {
+          const uint32_t corner = remap[triangle[c]];
+          if (corner == to) removed_triangle = true;
+          moved[c] = corner == from ? positions[candidate.to_]
+                                    : positions[triangle[c]];
+        }
+        if (removed_triangle) {
+          collapsed_triangles++;
+          continue;
+        }
+
+        const DirectX::XMVECTOR before =
+            GetTriangleNormal(positions[triangle[0]], positions[triangle[1]],
+                              positions[triangle[2]]);
+        const DirectX::XMVECTOR after =
+            GetTriangleNormal(moved[0], moved[1], moved[2]);
+        const float before_length =
+            DirectX::XMVectorGetX(DirectX::XMVector3Length(before));
+        const float after_length =
+            DirectX::XMVectorGetX(DirectX::XMVector3Length(after));
+        if (after_length <= MIN_AREA_RATIO * before_length ||
+            DirectX::XMVectorGetX(DirectX::XMVector3Dot(before, after)) <
+                FLIP_THRESHOLD * after_length * before_length)
+          flipped = true;
+      }
+      if (flipped) continue;
+
+      // 이번 pass 의 뒤집힘 검사가 유효하도록 주변 정점은 더 움직이지
+      // 않습니다
+      for (uint32_t a = adjacency_offsets[from];
+           a < adjacency_offsets[from + 1]; a++)
+        for (uint32_t c = 0; c < 3; c++)
+          touched[remap[output[adjacency[a] * 3 + c]]] = 1;
+
+      collapse[from] = candidate.to_;
+      AddQuadric(quadrics[to], quadrics[from]);
+      result_cost = (std::max)(result_cost, candidate.cost_);
+      removed += collapsed_triangles;
+      collapse_count++;
+    }
+    if (collapse_count == 0) break;
+
+    // 인덱스를 옮기고 위치가 겹쳐 퇴화한 삼각형을 지웁니다
+    size_t write = 0;
+    for (size_t i = 0; i < output.size(); i += 3) {
+      uint32_t triangle[3]{};
+      for (uint32_t c = 0; c < 3; c++) {
+        const uint32_t target_vertex = collapse[remap[output[i + c]]];
+        triangle[c] =
+            target_vertex != NO_VERTEX ? target_vertex : output[i + c];
+      }
+      if (remap[triangle[0]] == remap[triangle[1]] ||
+          remap[triangle[1]] == remap[triangle[2]] ||
+          remap[triangle[2]] == remap[triangle[0]])
+        continue;
+
+      output[write++] = triangle[0];
+      output[write++] = triangle[1];
+      output[write++] = triangle[2];
+    }
+    output.resize(write);
+  }
+
+  return std::sqrt(result_cost);
+}
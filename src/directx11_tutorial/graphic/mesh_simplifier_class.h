@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "model_class.h"
+
+// Garland-Heckbert quadric error metric 으로 삼각형 수를 줄입니다.
+// 정점을 이웃 정점 위치로 옮기는 half-edge collapse 만 쓰므로 정점 버퍼는
+// 그대로 두고 인덱스만 새로 만듭니다. 그래서 LOD 단계들이 하나의 정점
+// 버퍼를 함께 쓸 수 있습니다.
+// - 위치 오차는 면적 가중 평면 quadric, 색 오차는 면적 가중 점 quadric
+//   으로 재고
+// - 열린 경계와 색이 갈리는 seam 의 정점은 움직이지 않으며
+// - 삼각형을 뒤집는 collapse 는 건너뜁니다
+class MeshSimplifierClass {
+ public:
+  // 색 오차 제곱에 곱하는 가중치입니다. 채널 하나가 완전히 바뀌는 오차가
+  // 메시 크기의 10% 만큼 위치가 어긋나는 오차와 같습니다
+  static constexpr float COLOR_WEIGHT = 0.01f;
+
+  // 삼각형이 target_index_count 이하가 되거나 다음 collapse 의 오차가
+  // target_error 를 넘을 때까지 줄여 output 에 씁니다. 오차는 모두 메시의
+  // 가장 긴 축 길이에 대한 비율이며, 실제로 생긴 최대 오차를 반환합니다
+  static float Simplify(const ModelClass::VertexType* vertices,
+                        const uint32_t vertex_count, const uint32_t* indices,
+                        const uint32_t index_count,
+                        const uint32_t target_index_count,
+                        const float target_error,
+                        std::vector<uint32_t>& output);
+};
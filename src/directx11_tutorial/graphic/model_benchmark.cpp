@@ -0,0 +1,19 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include "framework/benchmark_class.h"
+#include "graphic/model_class.h"
+
+void RegisterModelBenchmarks(BenchmarkClass& benchmark) {
+  // GPU 버퍼 없이 CPU 측 정점, 인덱스를 만들고 최적화해 LOD 를 짓는
+  // 시간입니다. 메시 보고는 프로파일러를 켠 빌드에서만 출력되므로 Release
+  // 빌드로 잽니다
+  benchmark.Add("ModelClass::Initialize(cpu)", 1, [](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i++) {
+      ModelClass model{};
+      model.Initialize(nullptr);
+      BenchmarkClass::DoNotOptimize(model);
+      model.Shutdown();
+    }
+  });
+}
@@ -1,25 +1,495 @@
 #include "pch.h"
 #include "model_class.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#if defined(_WIN32)
 #include "com_throw.h"
+#include "device_context_class.h"
+#endif
+#include "framework/profiler.h"
+#include "mesh_file_class.h"
+#include "mesh_importer_class.h"
+#include "mesh_optimizer_class.h"
+#include "mesh_simplifier_class.h"
+
+namespace {
+// LOD 단계마다 메시 크기에 대해 허용하는 단순화 오차입니다
+const float LOD_TARGET_ERROR = 0.05f;
+// 삼각형이 이보다 적어질 단계는 만들지 않습니다
+const uint32_t MIN_LOD_TRIANGLES = 64;
+
+static_assert(ModelClass::MAX_LODS <= MeshFileClass::MAX_LODS,
+              "mesh file cannot store every LOD");
+
+#if defined(_WIN32)
+using InstanceLayout = VertexLayoutClass<ModelClass::InstanceType, 1,
+                                         D3D11_INPUT_PER_INSTANCE_DATA>;
+
+// 정점 스트림 뒤에 인스턴스 스트림을 이어 붙인 input layout 입니다
+template <typename Vertex>
+constexpr auto INSTANCED_ELEMENTS = vertex_layout::Concat(
+    VertexLayoutClass<Vertex>::INPUT_ELEMENTS, InstanceLayout::INPUT_ELEMENTS);
+#endif
+
+// 정점 포맷마다 컴파일 타임에 만든 배치를 가리킵니다
+struct VertexLayoutType {
+  uint32_t stride_;
+  const MeshFileClass::AttributeType* attributes_;
+  uint32_t attribute_count_;
+#if defined(_WIN32)
+  const D3D11_INPUT_ELEMENT_DESC* elements_;
+  uint32_t element_count_;
+  const D3D11_INPUT_ELEMENT_DESC* instanced_elements_;
+  uint32_t instanced_element_count_;
+#endif
+};
+
+template <typename Vertex>
+constexpr VertexLayoutType MakeVertexLayout() {
+  using Layout = VertexLayoutClass<Vertex>;
+  return {Layout::STRIDE,
+          Layout::FILE_ATTRIBUTES.data(),
+          Layout::ATTRIBUTE_COUNT,
+#if defined(_WIN32)
+          Layout::INPUT_ELEMENTS.data(),
+          Layout::ELEMENT_COUNT,
+          INSTANCED_ELEMENTS<Vertex>.data(),
+          static_cast<uint32_t>(INSTANCED_ELEMENTS<Vertex>.size()),
+#endif
+  };
+}
+
+// VertexFormatType 의 값 순서와 같아야 합니다
+constexpr VertexLayoutType VERTEX_LAYOUTS[] = {
+    MakeVertexLayout<ModelClass::VertexType>(),
+    MakeVertexLayout<ModelClass::Snorm16VertexType>(),
+    MakeVertexLayout<ModelClass::Half16VertexType>(),
+};
+
+static_assert(VERTEX_LAYOUTS[static_cast<uint32_t>(
+                                 ModelClass::VertexFormatType::FLOAT32)]
+                      .stride_ == 28,
+              "FLOAT32 vertex layout changed");
+static_assert(VERTEX_LAYOUTS[static_cast<uint32_t>(
+                                 ModelClass::VertexFormatType::SNORM16)]
+                      .stride_ == 12,
+              "SNORM16 vertex layout changed");
+static_assert(VERTEX_LAYOUTS[static_cast<uint32_t>(
+                                 ModelClass::VertexFormatType::HALF16)]
+                      .stride_ == 12,
+              "HALF16 vertex layout changed");
+#if defined(_WIN32)
+static_assert(InstanceLayout::ELEMENT_COUNT == 5,
+              "instance stream must expand to WORLD0-3 and INSTANCECOLOR");
+#endif
+
+const VertexLayoutType& GetVertexLayout(
+    const ModelClass::VertexFormatType format) {
+  return VERTEX_LAYOUTS[static_cast<uint32_t>(format)];
+}
+
+#if PROFILER_ENABLED
+// 디버그 출력 창에, Windows 가 아니면 표준 오류로 한 줄을 남깁니다
+void DebugOutput(const char* message) {
+#if defined(_WIN32)
+  OutputDebugStringA(message);
+#else
+  std::fputs(message, stderr);
+#endif
+}
+#endif
+
+// 경계 상자의 중심과 반 크기입니다. 크기가 0 인 축은 역수도 0 으로 둡니다
+void GetQuantizationBounds(const DirectX::XMFLOAT3& bounds_min,
+                           const DirectX::XMFLOAT3& bounds_max,
+                           DirectX::XMVECTOR& center,
+                           DirectX::XMVECTOR& extent,
+                           DirectX::XMVECTOR& inverse_extent) {
+  const DirectX::XMVECTOR min = DirectX::XMLoadFloat3(&bounds_min);
+  const DirectX::XMVECTOR max = DirectX::XMLoadFloat3(&bounds_max);
+  center = DirectX::XMVectorScale(DirectX::XMVectorAdd(min, max), 0.5f);
+  extent = DirectX::XMVectorScale(DirectX::XMVectorSubtract(max, min), 0.5f);
+
+  DirectX::XMFLOAT3 size{};
+  DirectX::XMStoreFloat3(&size, extent);
+  inverse_extent = DirectX::XMVectorSet(size.x > 0.0f ? 1.0f / size.x : 0.0f,
+                                        size.y > 0.0f ? 1.0f / size.y : 0.0f,
+                                        size.z > 0.0f ? 1.0f / size.z : 0.0f,
+                                        0.0f);
+}
+
+void StorePosition(DirectX::PackedVector::XMSHORTN4& position,
+                   const DirectX::XMVECTOR value) {
+  DirectX::PackedVector::XMStoreShortN4(&position, value);
+}
+
+void StorePosition(DirectX::PackedVector::XMHALF4& position,
+                   const DirectX::XMVECTOR value) {
+  DirectX::PackedVector::XMStoreHalf4(&position, value);
+}
+
+DirectX::XMVECTOR LoadPosition(
+    const DirectX::PackedVector::XMSHORTN4& position) {
+  return DirectX::PackedVector::XMLoadShortN4(&position);
+}
+
+DirectX::XMVECTOR LoadPosition(const DirectX::PackedVector::XMHALF4& position) {
+  return DirectX::PackedVector::XMLoadHalf4(&position);
+}
+
+// VertexType 배열을 양자화 정점으로 묶습니다
+template <typename PackedVertex>
+void PackVertices(const ModelClass::VertexType* vertices, const uint32_t count,
+                  const DirectX::XMFLOAT3& bounds_min,
+                  const DirectX::XMFLOAT3& bounds_max, PackedVertex* output) {
+  DirectX::XMVECTOR center{}, extent{}, inverse_extent{};
+  GetQuantizationBounds(bounds_min, bounds_max, center, extent,
+                        inverse_extent);
+
+  for (uint32_t i = 0; i < count; i++) {
+    StorePosition(output[i].position_,
+                  DirectX::XMVectorMultiply(
+                      DirectX::XMVectorSubtract(
+                          DirectX::XMLoadFloat3(&vertices[i].position_),
+                          center),
+                      inverse_extent));
+    DirectX::PackedVector::XMStoreUByteN4(
+        &output[i].color_, DirectX::XMLoadFloat4(&vertices[i].color_));
+  }
+}
+
+// 양자화 정점을 VertexType 으로 풉니다
+template <typename PackedVertex>
+void UnpackVertices(const PackedVertex* input, const uint32_t count,
+                    const DirectX::XMFLOAT3& bounds_min,
+                    const DirectX::XMFLOAT3& bounds_max,
+                    ModelClass::VertexType* vertices) {
+  DirectX::XMVECTOR center{}, extent{}, inverse_extent{};
+  GetQuantizationBounds(bounds_min, bounds_max, center, extent,
+                        inverse_extent);
+
+  for (uint32_t i = 0; i < count; i++) {
+    DirectX::XMStoreFloat3(
+        &vertices[i].position_,
+        DirectX::XMVectorAdd(
+            DirectX::XMVectorMultiply(LoadPosition(input[i].position_),
+                                      extent),
+            center));
+    DirectX::XMStoreFloat4(
+        &vertices[i].color_,
+        DirectX::PackedVector::XMLoadUByteN4(&input[i].color_));
+  }
+}
+
+// VertexType 배열을 format 배치로 묶습니다
+void PackVertices(const ModelClass::VertexFormatType format,
+                  const ModelClass::VertexType* vertices, const uint32_t count,
+                  const DirectX::XMFLOAT3& bounds_min,
+                  const DirectX::XMFLOAT3& bounds_max, void* output) {
+  switch (format) {
+    case ModelClass::VertexFormatType::SNORM16:
+      PackVertices(vertices, count, bounds_min, bounds_max,
+                   static_cast<ModelClass::Snorm16VertexType*>(output));
+      break;
+    case ModelClass::VertexFormatType::HALF16:
+      PackVertices(vertices, count, bounds_min, bounds_max,
+                   static_cast<ModelClass::Half16VertexType*>(output));
+      break;
+    default:
+      std::memcpy(output, vertices, sizeof(ModelClass::VertexType) * count);
+      break;
+  }
+}
+
+// format 배치로 묶인 정점을 VertexType 으로 풉니다
+void UnpackVertices(const ModelClass::VertexFormatType format,
+                    const void* input, const uint32_t count,
+                    const DirectX::XMFLOAT3& bounds_min,
+                    const DirectX::XMFLOAT3& bounds_max,
+                    ModelClass::VertexType* vertices) {
+  switch (format) {
+    case ModelClass::VertexFormatType::SNORM16:
+      UnpackVertices(static_cast<const ModelClass::Snorm16VertexType*>(input),
+                     count, bounds_min, bounds_max, vertices);
+      break;
+    case ModelClass::VertexFormatType::HALF16:
+      UnpackVertices(static_cast<const ModelClass::Half16VertexType*>(input),
+                     count, bounds_min, bounds_max, vertices);
+      break;
+    default:
+      std::memcpy(vertices, input, sizeof(ModelClass::VertexType) * count);
+      break;
+  }
+}
+}  // namespace
+
+uint32_t ModelClass::GetVertexStride(const VertexFormatType format) {
+  return GetVertexLayout(format).stride_;
+}
+
+#if defined(_WIN32)
+const D3D11_INPUT_ELEMENT_DESC* ModelClass::GetInputElements(
+    const VertexFormatType format, uint32_t& count) {
+  count = GetVertexLayout(format).element_count_;
+  return GetVertexLayout(format).elements_;
+}
+
+const D3D11_INPUT_ELEMENT_DESC* ModelClass::GetInstancedInputElements(
+    const VertexFormatType format, uint32_t& count) {
+  count = GetVertexLayout(format).instanced_element_count_;
+  return GetVertexLayout(format).instanced_elements_;
+}
+#endif
+
+void ModelClass::SetVertexFormat(const VertexFormatType format) {
+  vertex_format_ = format;
+}
+
+ModelClass::VertexFormatType ModelClass::GetVertexFormat() {
+  return vertex_format_;
+}
+
+bool ModelClass::Initialize(ResourceManagerClass* resources) {
+  resources_ = resources;
+
+  // CPU 측 정점 및 인덱스 데이터를 만듭니다
+  if (InitializeGeometry() == false) return false;
+  OptimizeGeometry();
+  BuildLods();
+
+  // 소프트웨어 렌더링에서는 GPU 버퍼가 필요 없습니다
+  if (resources == nullptr) return true;
 
-bool ModelClass::Initialize(ID3D11Device* device) {
   // 정점 및 인덱스 버퍼를 초기화합니다
-  return InitializeBuffers(device);
+  return UploadGeometry(resources);
+}
+
+bool ModelClass::Initialize(ResourceManagerClass* resources,
+                            const std::filesystem::path& mesh_path,
+                            JobSystemClass* job_system) {
+  PROFILE_FUNCTION();
+
+  resources_ = resources;
+
+  const std::filesystem::path extension = mesh_path.extension();
+  if (extension == ".obj" || extension == ".ply")
+    return ImportMesh(resources, mesh_path, job_system);
+
+  MeshFileClass mesh{};
+  if (mesh.Open(mesh_path) == false) return false;
+
+  const bool result = InitializeMesh(resources, mesh);
+  mesh.Close();
+  return result;
+}
+
+bool ModelClass::SaveMesh(const std::filesystem::path& mesh_path) {
+  const VertexLayoutType& layout = GetVertexLayout(vertex_format_);
+
+  std::vector<uint8_t> vertices(static_cast<size_t>(layout.stride_) *
+                                vertex_count_);
+  PackVertices(vertex_format_, vertices_.data(), vertex_count_, bounds_min_,
+               bounds_max_, vertices.data());
+
+  std::vector<MeshFileClass::LodType> lods(lods_.size());
+  for (size_t i = 0; i < lods_.size(); i++)
+    lods[i] = {lods_[i].first_index_, lods_[i].index_count_, lods_[i].error_,
+               0};
+  const uint32_t lod_count = static_cast<uint32_t>(lods.size());
+
+  if (static_cast<uint32_t>(vertex_count_) <= MAX_16BIT_VERTICES) {
+    const std::vector<uint16_t> indices(indices_.begin(), indices_.end());
+    return MeshFileClass::Write(
+        mesh_path, layout.attributes_, layout.attribute_count_, lods.data(),
+        lod_count, vertices.data(), vertex_count_, layout.stride_,
+        indices.data(), index_count_, sizeof(uint16_t), &bounds_min_.x,
+        &bounds_max_.x);
+  }
+
+  return MeshFileClass::Write(
+      mesh_path, layout.attributes_, layout.attribute_count_, lods.data(),
+      lod_count, vertices.data(), vertex_count_, layout.stride_,
+      indices_.data(), index_count_, sizeof(uint32_t), &bounds_min_.x,
+      &bounds_max_.x);
+}
+
+bool ModelClass::InitializeMesh(ResourceManagerClass* resources,
+                                MeshFileClass& mesh) {
+  const MeshFileClass::HeaderType& header = mesh.GetHeader();
+
+  // 파일의 정점 배치가 어떤 정점 포맷인지 찾습니다
+  const uint32_t format_count =
+      static_cast<uint32_t>(std::size(VERTEX_LAYOUTS));
+  uint32_t format_index = 0;
+  for (; format_index < format_count; format_index++) {
+    const VertexLayoutType& layout = VERTEX_LAYOUTS[format_index];
+    if (header.vertex_stride_ != layout.stride_) continue;
+
+    bool match = true;
+    for (uint32_t i = 0; i < layout.attribute_count_; i++) {
+      const MeshFileClass::AttributeType& expected = layout.attributes_[i];
+      const MeshFileClass::AttributeType* attribute =
+          mesh.FindAttribute(expected.semantic_, expected.semantic_index_);
+      if (attribute == nullptr || attribute->format_ != expected.format_ ||
+          attribute->offset_ != expected.offset_)
+        match = false;
+    }
+    if (match) break;
+  }
+  if (format_index == format_count) return false;
+  const VertexFormatType file_format =
+      static_cast<VertexFormatType>(format_index);
+
+  vertex_count_ = static_cast<int32_t>(header.vertex_count_);
+  index_count_ = static_cast<int32_t>(header.index_count_);
+  bounds_min_ = DirectX::XMFLOAT3(header.bounds_min_);
+  bounds_max_ = DirectX::XMFLOAT3(header.bounds_max_);
+
+  // 파일에는 MAX_LODS 보다 많은 단계가 있을 수 있습니다. 렌더러는 단계별
+  // 배열을 MAX_LODS 개만 두므로 원본부터 MAX_LODS 개만 쓰고 가장 거친
+  // 단계들은 버립니다
+  const uint32_t lod_count = (std::min)(header.lod_count_, uint32_t{MAX_LODS});
+  lods_.resize(lod_count);
+  for (uint32_t i = 0; i < lod_count; i++) {
+    const MeshFileClass::LodType& lod = mesh.GetLods()[i];
+    lods_[i] = {lod.first_index_, lod.index_count_, lod.error_};
+  }
+
+  // 파일 배치가 GPU 배치와 같으면 매핑된 파일을 D3D11_SUBRESOURCE_DATA 로
+  // 바로 넘깁니다
+  if (resources && file_format == vertex_format_) {
+    vertices_.clear();
+    indices_.clear();
+    return InitializeBuffers(resources, mesh.GetVertexData(),
+                             mesh.GetIndexData(), header.index_size_);
+  }
+
+  // 소프트웨어 렌더링은 매핑이 닫힌 뒤에도 쓰므로 CPU 측으로 풀어 둡니다
+  vertices_.resize(vertex_count_);
+  UnpackVertices(file_format, mesh.GetVertexData(), vertex_count_,
+                 bounds_min_, bounds_max_, vertices_.data());
+
+  indices_.resize(index_count_);
+  if (header.index_size_ == sizeof(uint16_t)) {
+    const uint16_t* indices =
+        static_cast<const uint16_t*>(mesh.GetIndexData());
+    std::copy(indices, indices + index_count_, indices_.begin());
+  } else {
+    std::memcpy(indices_.data(), mesh.GetIndexData(),
+                sizeof(uint32_t) * index_count_);
+  }
+
+  // 포맷이 다른 캐시는 GPU 포맷으로 다시 묶어 올립니다
+  if (resources) return UploadGeometry(resources);
+  return true;
+}
+
+bool ModelClass::ImportMesh(ResourceManagerClass* resources,
+                            const std::filesystem::path& path,
+                            JobSystemClass* job_system) {
+  std::filesystem::path cache_path = path;
+  cache_path += ".mesh";
+
+  // 원본보다 새로운 캐시가 있으면 파싱 없이 캐시를 매핑합니다
+  std::error_code error;
+  const auto source_time = std::filesystem::last_write_time(path, error);
+  if (error) return false;
+  const auto cache_time = std::filesystem::last_write_time(cache_path, error);
+  if (!error && cache_time >= source_time) {
+    MeshFileClass mesh{};
+    if (mesh.Open(cache_path)) {
+      const bool result = InitializeMesh(resources, mesh);
+      mesh.Close();
+      if (result) return true;
+    }
+  }
+
+  MeshImporterClass importer{};
+  if (importer.Import(path, job_system) == false) return false;
+  importer.ReleaseGeometry(vertices_, indices_);
+  OptimizeGeometry();
+
+  vertex_count_ = static_cast<int32_t>(vertices_.size());
+  index_count_ = static_cast<int32_t>(indices_.size());
+  ComputeBoundingBox();
+  BuildLods();
+
+  // 최적화, 단순화한 결과를 저장하므로 캐시를 읽을 때는 다시 하지 않습니다.
+  // 캐시를 쓰지 못해도 다음 실행에서 다시 가져오면 되므로 무시합니다
+  SaveMesh(cache_path);
+
+  if (resources == nullptr) return true;
+  return UploadGeometry(resources);
 }
 
 void ModelClass::Shutdown() {
   ShutdownBuffers();
 }
 
-void ModelClass::Render(ID3D11DeviceContext* device_context) {
+#if defined(_WIN32)
+void ModelClass::Render(DeviceContextClass* device_context) {
+  PROFILE_FUNCTION();
+
   // 그리기를 준비하기 위해 파이프 라인에 정점, 인덱스 버퍼를 놓습니다.
   RenderBuffers(device_context);
 }
+#endif
+
+int ModelClass::GetIndexCount() {
+  if (lods_.empty()) return index_count_;
+  return static_cast<int>(lods_[0].index_count_);
+}
+
+int ModelClass::GetVertexCount() { return vertex_count_; }
+
+const ModelClass::VertexType* ModelClass::GetVertices() {
+  return vertices_.data();
+}
+
+const uint32_t* ModelClass::GetIndices() { return indices_.data(); }
+
+const ModelClass::LodType* ModelClass::GetLods() { return lods_.data(); }
+
+int ModelClass::GetLodCount() { return static_cast<int>(lods_.size()); }
+
+void ModelClass::GetBoundingBox(DirectX::XMFLOAT3& min,
+                                DirectX::XMFLOAT3& max) {
+  min = bounds_min_;
+  max = bounds_max_;
+}
+
+DirectX::XMMATRIX ModelClass::GetPositionTransform() {
+  if (vertex_format_ == VertexFormatType::FLOAT32)
+    return DirectX::XMMatrixIdentity();
+
+  // 정규화된 위치 n 을 n * extent + center 로 되돌립니다
+  DirectX::XMVECTOR center{}, extent{}, inverse_extent{};
+  GetQuantizationBounds(bounds_min_, bounds_max_, center, extent,
+                        inverse_extent);
+  return DirectX::XMMatrixMultiply(
+      DirectX::XMMatrixScalingFromVector(extent),
+      DirectX::XMMatrixTranslationFromVector(center));
+}
+
+void ModelClass::SetInstances(const InstanceType* instances,
+                              const int32_t count) {
+  instances_.assign(instances, instances + count);
+  instances_dirty_ = true;
+}
+
+const ModelClass::InstanceType* ModelClass::GetInstances() {
+  return instances_.data();
+}
 
-int ModelClass::GetIndexCount() { return index_count_; }
+int ModelClass::GetInstanceCount() {
+  return static_cast<int>(instances_.size());
+}
 
-bool ModelClass::InitializeBuffers(ID3D11Device* device) {
+bool ModelClass::InitializeGeometry() {
   // 정점 배열의 정점 수를 설정합니다
   vertex_count_ = 3;
 
@@ -27,34 +497,148 @@ bool ModelClass::InitializeBuffers(ID3D11Device* device) {
   index_count_ = 3;
 
   // 정점 배열을 만듭니다.
-  VertexType* vertices = new VertexType[vertex_count_];
-  if (vertices == nullptr) return false;
+  vertices_.resize(vertex_count_);
 
   // 정점 배열에 데이터를 설정합니다
-  vertices[0].position_ =
+  vertices_[0].position_ =
       DirectX::XMFLOAT3(-1.0f, -1.0f, 0.0f);  // Bottom left.
-  vertices[0].color_ = DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f);
+  vertices_[0].color_ = DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f);
 
-  vertices[1].position_ = DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f);  // Top middle.
-  vertices[1].color_ = DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f);
+  vertices_[1].position_ = DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f);  // Top middle.
+  vertices_[1].color_ = DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f);
 
-  vertices[2].position_ =
+  vertices_[2].position_ =
       DirectX::XMFLOAT3(1.0f, -1.0f, 0.0f);  // Bottom right.
-  vertices[2].color_ = DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f);
+  vertices_[2].color_ = DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f);
 
   // 인덱스 배열을 만듭니다
-  uint32_t* indices = new uint32_t[index_count_];
-  if (!indices) return false;
+  indices_.resize(index_count_);
 
   // 인덱스 배열의 값을 설정합니다
-  indices[0] = 0;  // Bottom left.
-  indices[1] = 1;  // Top middle.
-  indices[2] = 2;  // Bottom right.
+  indices_[0] = 0;  // Bottom left.
+  indices_[1] = 1;  // Top middle.
+  indices_[2] = 2;  // Bottom right.
+
+  ComputeBoundingBox();
+  return true;
+}
+
+void ModelClass::ComputeBoundingBox() {
+  if (vertices_.empty()) {
+    bounds_min_ = bounds_max_ = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+    return;
+  }
+
+  DirectX::XMVECTOR min = DirectX::XMLoadFloat3(&vertices_[0].position_);
+  DirectX::XMVECTOR max = min;
+  for (const VertexType& vertex : vertices_) {
+    const DirectX::XMVECTOR position = DirectX::XMLoadFloat3(&vertex.position_);
+    min = DirectX::XMVectorMin(min, position);
+    max = DirectX::XMVectorMax(max, position);
+  }
+
+  DirectX::XMStoreFloat3(&bounds_min_, min);
+  DirectX::XMStoreFloat3(&bounds_max_, max);
+}
+
+void ModelClass::OptimizeGeometry() {
+  PROFILE_FUNCTION();
+
+  MeshOptimizerClass::StatisticsType before{}, after{};
+  MeshOptimizerClass::Optimize(vertices_, indices_, before, after);
+  vertex_count_ = static_cast<int32_t>(vertices_.size());
+
+  // 보고는 프로파일러를 켠 빌드에서만 남깁니다
+#if PROFILER_ENABLED
+  char message[128];
+  std::snprintf(message, sizeof(message),
+                "Mesh optimized: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+                before.acmr_, after.acmr_, before.atvr_, after.atvr_);
+  DebugOutput(message);
+#endif
+}
 
-  // 정적 정점 버퍼의 description 을 설정합니다
+void ModelClass::BuildLods() {
+  PROFILE_FUNCTION();
+
+  lods_.assign(1, LodType{0, static_cast<uint32_t>(indices_.size()), 0.0f});
+
+  // 단순화 오차는 메시의 가장 긴 축에 대한 비율이므로 모델 공간으로
+  // 되돌립니다
+  const float extent = (std::max)(
+      (std::max)(bounds_max_.x - bounds_min_.x, bounds_max_.y - bounds_min_.y),
+      bounds_max_.z - bounds_min_.z);
+
+  // 바로 앞 단계를 절반으로 줄여 다음 단계를 만듭니다. 앞 단계 대비 오차를
+  // 앞 단계의 오차에 더해 원본 대비 오차의 상한으로 둡니다
+  std::vector<uint32_t> lod_indices;
+  while (lods_.size() < MAX_LODS) {
+    const LodType previous = lods_.back();
+    const uint32_t target = previous.index_count_ / 2 / 3 * 3;
+    if (target < MIN_LOD_TRIANGLES * 3) break;
+
+    const float error = MeshSimplifierClass::Simplify(
+        vertices_.data(), vertex_count_,
+        indices_.data() + previous.first_index_, previous.index_count_, target,
+        LOD_TARGET_ERROR, lod_indices);
+
+    // 오차 한도에 막혀 거의 줄지 않았으면 더 거친 단계는 만들지 않습니다
+    const uint32_t lod_index_count = static_cast<uint32_t>(lod_indices.size());
+    if (lod_index_count > previous.index_count_ / 4 * 3) break;
+
+    MeshOptimizerClass::OptimizeVertexCache(lod_indices.data(), lod_index_count,
+                                            vertex_count_);
+    lods_.push_back({static_cast<uint32_t>(indices_.size()), lod_index_count,
+                     previous.error_ + error * extent});
+    indices_.insert(indices_.end(), lod_indices.begin(), lod_indices.end());
+  }
+  index_count_ = static_cast<int32_t>(indices_.size());
+
+#if PROFILER_ENABLED
+  for (size_t i = 0; i < lods_.size(); i++) {
+    char message[128];
+    std::snprintf(message, sizeof(message),
+                  "Mesh LOD %zu: %u triangles, error %.5f\n", i,
+                  lods_[i].index_count_ / 3, lods_[i].error_);
+    DebugOutput(message);
+  }
+#endif
+}
+
+bool ModelClass::UploadGeometry(ResourceManagerClass* resources) {
+  // FLOAT32 는 CPU 측 배치와 같으므로 묶지 않고 바로 올립니다
+  const void* vertices = vertices_.data();
+  std::vector<uint8_t> packed;
+  if (vertex_format_ != VertexFormatType::FLOAT32) {
+    packed.resize(static_cast<size_t>(GetVertexStride(vertex_format_)) *
+                  vertex_count_);
+    PackVertices(vertex_format_, vertices_.data(), vertex_count_, bounds_min_,
+                 bounds_max_, packed.data());
+    vertices = packed.data();
+  }
+
+  // 정점 수가 허락하면 인덱스를 R16_UINT 로 줄여 대역폭을 반으로 줄입니다
+  if (static_cast<uint32_t>(vertex_count_) <= MAX_16BIT_VERTICES) {
+    const std::vector<uint16_t> indices(indices_.begin(), indices_.end());
+    return InitializeBuffers(resources, vertices, indices.data(),
+                             sizeof(uint16_t));
+  }
+
+  return InitializeBuffers(resources, vertices, indices_.data(),
+                           sizeof(uint32_t));
+}
+
+#if defined(_WIN32)
+bool ModelClass::InitializeBuffers(ResourceManagerClass* resources,
+                                   const void* vertices, const void* indices,
+                                   const uint32_t index_size) {
+  // 정적 정점 버퍼의 description 을 설정합니다. 한 번 올리고 바꾸지 않으므로
+  // IMMUTABLE 이고, 작은 메시는 같은 내용을 다시 올리면 관리자가 버퍼를
+  // 공유합니다
   D3D11_BUFFER_DESC vertex_buffer_desc{};
-  vertex_buffer_desc.Usage = D3D11_USAGE_DEFAULT;
-  vertex_buffer_desc.ByteWidth = sizeof(VertexType) * vertex_count_;
+  vertex_buffer_desc.Usage = D3D11_USAGE_IMMUTABLE;
+  vertex_buffer_desc.ByteWidth =
+      GetVertexStride(vertex_format_) * vertex_count_;
   vertex_buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
   vertex_buffer_desc.CPUAccessFlags = 0;
   vertex_buffer_desc.MiscFlags = 0;
@@ -67,13 +651,12 @@ bool ModelClass::InitializeBuffers(ID3D11Device* device) {
   vertex_data.SysMemSlicePitch = 0;
 
   // 이제 정점 버퍼를 만듭니다
-  com::ThrowIfFailed(
-      device->CreateBuffer(&vertex_buffer_desc, &vertex_data, &vertex_buffer_));
+  vertex_buffer_ = resources->CreateBuffer(vertex_buffer_desc, &vertex_data);
 
   // 정적 인덱스 버퍼의 description 을 설정합니다
   D3D11_BUFFER_DESC index_buffer_desc{};
-  index_buffer_desc.Usage = D3D11_USAGE_DEFAULT;
-  index_buffer_desc.ByteWidth = sizeof(unsigned long) * index_count_;
+  index_buffer_desc.Usage = D3D11_USAGE_IMMUTABLE;
+  index_buffer_desc.ByteWidth = index_size * index_count_;
   index_buffer_desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
   index_buffer_desc.CPUAccessFlags = 0;
   index_buffer_desc.MiscFlags = 0;
@@ -86,44 +669,116 @@ bool ModelClass::InitializeBuffers(ID3D11Device* device) {
   index_data.SysMemSlicePitch = 0;
 
   // 인덱스 버퍼를 생성합니다
-  com::ThrowIfFailed(
-      device->CreateBuffer(&index_buffer_desc, &index_data, &index_buffer_));
-
-  // 생성되고 값이 할당된 정점 버퍼와 인덱스 버퍼를 해제합니다
-  delete[] vertices;
-  vertices = nullptr;
-
-  delete[] indices;
-  indices = nullptr;
+  index_buffer_ = resources->CreateBuffer(index_buffer_desc, &index_data);
+  index_format_ = index_size == sizeof(uint16_t) ? DXGI_FORMAT_R16_UINT
+                                                 : DXGI_FORMAT_R32_UINT;
 
   return true;
 }
 
 void ModelClass::ShutdownBuffers() {
-  // 인덱스 버퍼를 해제합니다.
-  if (index_buffer_) {
-    index_buffer_->Release();
-    index_buffer_ = nullptr;
-  }
+  instance_capacity_ = 0;
 
-  // 정점 버퍼를 해제합니다.
-  if (vertex_buffer_) {
-    vertex_buffer_->Release();
-    vertex_buffer_ = nullptr;
-  }
+  // 소프트웨어 렌더링에서는 GPU 버퍼가 없습니다
+  if (resources_ == nullptr) return;
+
+  // 인스턴스, 인덱스, 정점 버퍼의 참조를 놓습니다
+  resources_->Release(instance_buffer_);
+  resources_->Release(index_buffer_);
+  resources_->Release(vertex_buffer_);
+  resources_ = nullptr;
 }
 
-void ModelClass::RenderBuffers(ID3D11DeviceContext* device_context) {
+void ModelClass::RenderBuffers(DeviceContextClass* device_context) {
   // 정점 버퍼의 단위와 오프셋을 설정합니다.
-  uint32_t stride = sizeof(VertexType);
+  uint32_t stride = GetVertexStride(vertex_format_);
   uint32_t offset = 0;
 
   // 렌더링 할 수 있도록 Input Assembler 에서 정점 버퍼를 활성으로 설정합니다.
-  device_context->IASetVertexBuffers(0, 1, &vertex_buffer_, &stride, &offset);
+  ID3D11Buffer* vertex_buffer = resources_->Get(vertex_buffer_);
+  if (instances_.empty()) {
+    device_context->IASetVertexBuffers(0, 1, &vertex_buffer, &stride, &offset);
+  } else {
+    // 인스턴스 목록이 바뀌었으면 인스턴스 버퍼를 갱신합니다
+    UpdateInstanceBuffer(device_context);
+
+    // 정점 스트림(0)과 인스턴스 스트림(1)을 함께 설정합니다
+    ID3D11Buffer* buffers[2] = {vertex_buffer,
+                                resources_->Get(instance_buffer_)};
+    uint32_t strides[2] = {stride, sizeof(InstanceType)};
+    uint32_t offsets[2] = {0, 0};
+    device_context->IASetVertexBuffers(0, 2, buffers, strides, offsets);
+  }
 
   // 렌더링 할 수 있도록 Input Assembler 에서 인덱스 버퍼를 활성으로 설정합니다.
-  device_context->IASetIndexBuffer(index_buffer_, DXGI_FORMAT_R32_UINT, 0);
+  device_context->IASetIndexBuffer(resources_->Get(index_buffer_),
+                                   index_format_, 0);
 
   // 정점 버퍼로 그릴 기본형을 설정합니다. 여기서는 삼각형으로 설정합니다.
   device_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
+
+void ModelClass::UpdateInstanceBuffer(DeviceContextClass* device_context) {
+  if (instances_dirty_ == false) return;
+  instances_dirty_ = false;
+
+  ID3D11DeviceContext* context = device_context->GetContext();
+
+  const int32_t count = static_cast<int32_t>(instances_.size());
+
+  // 용량이 부족하면 두 배씩 늘려 동적 인스턴스 버퍼를 다시 만듭니다. 이전
+  // 버퍼는 GPU 가 다 읽을 때까지 관리자가 해제를 미룹니다
+  if (count > instance_capacity_) {
+    resources_->Release(instance_buffer_);
+
+    instance_capacity_ = (std::max)(instance_capacity_, 1024);
+    while (instance_capacity_ < count) instance_capacity_ *= 2;
+
+    D3D11_BUFFER_DESC instance_buffer_desc{};
+    instance_buffer_desc.Usage = D3D11_USAGE_DYNAMIC;
+    instance_buffer_desc.ByteWidth = sizeof(InstanceType) * instance_capacity_;
+    instance_buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    instance_buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    instance_buffer_desc.MiscFlags = 0;
+    instance_buffer_desc.StructureByteStride = 0;
+
+    instance_buffer_ = resources_->CreateBuffer(instance_buffer_desc, nullptr);
+  }
+
+  // 인스턴스 데이터를 한 번에 복사합니다
+  ID3D11Buffer* instance_buffer = resources_->Get(instance_buffer_);
+  D3D11_MAPPED_SUBRESOURCE mapped_resource{};
+  com::ThrowIfFailed(context->Map(instance_buffer, 0, D3D11_MAP_WRITE_DISCARD,
+                                  0, &mapped_resource));
+  if (vertex_format_ == VertexFormatType::FLOAT32) {
+    std::memcpy(mapped_resource.pData, instances_.data(),
+                sizeof(InstanceType) * count);
+  } else {
+    // 양자화된 위치를 되돌리는 행렬을 인스턴스 월드 행렬 앞에 곱해 씁니다
+    const DirectX::XMMATRIX position_transform = GetPositionTransform();
+    InstanceType* instances =
+        reinterpret_cast<InstanceType*>(mapped_resource.pData);
+    for (int32_t i = 0; i < count; i++) {
+      DirectX::XMStoreFloat4x4(
+          &instances[i].world_,
+          DirectX::XMMatrixMultiply(
+              position_transform,
+              DirectX::XMLoadFloat4x4(&instances_[i].world_)));
+      instances[i].color_ = instances_[i].color_;
+    }
+  }
+  context->Unmap(instance_buffer, 0);
+}
+#else
+// D3D11 이 없는 빌드에서는 resources 가 언제나 nullptr 이므로 GPU 버퍼를
+// 만들 일이 없습니다
+bool ModelClass::InitializeBuffers(ResourceManagerClass*, const void*,
+                                   const void*, const uint32_t) {
+  return false;
+}
+
+void ModelClass::ShutdownBuffers() {
+  instance_capacity_ = 0;
+  resources_ = nullptr;
+}
+#endif
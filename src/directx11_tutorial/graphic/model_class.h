@@ -1,28 +1,199 @@
 #pragma once
+#if defined(_WIN32)
 #include <d3d11.h>
+#endif
 #include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#include <filesystem>
+#include <vector>
 
-class ModelClass {
- public:
-  bool Initialize(ID3D11Device* device);
-  void Shutdown();
-  void Render(ID3D11DeviceContext* device_context);
+#if defined(_WIN32)
+#include "resource_manager_class.h"
+#endif
+#include "vertex_layout_class.h"
 
-  int GetIndexCount();
+class MeshFileClass;
+class ResourceManagerClass;
+class JobSystemClass;
+class DeviceContextClass;
 
- private:
+class ModelClass {
+ public:
   struct VertexType {
     DirectX::XMFLOAT3 position_;
     DirectX::XMFLOAT4 color_;
   };
 
-  bool InitializeBuffers(ID3D11Device* device);
+  // 양자화 포맷의 GPU 정점입니다. 위치는 경계 상자를 [-1, 1] 로
+  // 정규화한 값이며 GetPositionTransform 으로 되돌립니다
+  struct Snorm16VertexType {
+    DirectX::PackedVector::XMSHORTN4 position_;
+    DirectX::PackedVector::XMUBYTEN4 color_;
+  };
+
+  struct Half16VertexType {
+    DirectX::PackedVector::XMHALF4 position_;
+    DirectX::PackedVector::XMUBYTEN4 color_;
+  };
+
+  // GPU 정점 버퍼의 배치입니다
+  enum class VertexFormatType : uint32_t {
+    FLOAT32 = 0,  // VertexType, 28 byte
+    SNORM16 = 1,  // Snorm16VertexType, 12 byte
+    HALF16 = 2,   // Half16VertexType, 12 byte
+  };
+  // 정점 수가 이 값 이하이면 16 비트 인덱스를 씁니다
+  static const uint32_t MAX_16BIT_VERTICES = 1 << 16;
+  // 원본을 포함한 LOD 단계 수의 상한입니다
+  static const uint32_t MAX_LODS = 4;
+
+  // 인덱스 버퍼 안의 LOD 구간입니다. 모든 단계가 같은 정점 버퍼를 쓰고,
+  // error_ 는 원본과의 모델 공간 최대 거리입니다
+  struct LodType {
+    uint32_t first_index_;
+    uint32_t index_count_;
+    float error_;
+  };
+
+  static uint32_t GetVertexStride(const VertexFormatType format);
+#if defined(_WIN32)
+  // 컴파일 타임에 만든 input layout 요소입니다. 정점 스트림(슬롯 0)만
+  // 쓰거나, 인스턴스 스트림(슬롯 1)까지 이어 붙인 배열을 돌려줍니다
+  static const D3D11_INPUT_ELEMENT_DESC* GetInputElements(
+      const VertexFormatType format, uint32_t& count);
+  static const D3D11_INPUT_ELEMENT_DESC* GetInstancedInputElements(
+      const VertexFormatType format, uint32_t& count);
+#endif
+
+  // 인스턴스마다 두 번째 정점 스트림으로 전달되는 데이터입니다.
+  // world_ 는 transpose 하지 않은 행 우선 행렬입니다
+  struct InstanceType {
+    DirectX::XMFLOAT4X4 world_;
+    DirectX::XMFLOAT4 color_;
+  };
+
+  // GPU 정점 버퍼와 메시 캐시의 배치를 고릅니다. Initialize 전에
+  // 호출해야 하며 기본값은 FLOAT32 입니다
+  void SetVertexFormat(const VertexFormatType format);
+  VertexFormatType GetVertexFormat();
+
+  // GPU 버퍼는 resources 에서 만들고 Shutdown 까지 핸들로 들고 있습니다.
+  // resources 가 nullptr 이면 GPU 버퍼 없이 CPU 측 정점, 인덱스만 만듭니다.
+  // D3D11 이 없는 빌드에서는 resources 가 언제나 nullptr 이어야 합니다
+  bool Initialize(ResourceManagerClass* resources);
+  // 이진 메시 파일을 매핑해 복사 없이 GPU 버퍼를 만듭니다. resources 가
+  // nullptr 이면 CPU 측 정점, 인덱스로 옮겨 둡니다.
+  // .obj, .ply 는 옆에 둔 "<원본>.mesh" 캐시가 원본보다 새로우면 캐시를
+  // 읽고, 아니면 원본을 가져온 뒤 캐시를 새로 씁니다
+  bool Initialize(ResourceManagerClass* resources,
+                  const std::filesystem::path& mesh_path,
+                  JobSystemClass* job_system = nullptr);
+  // 현재 CPU 측 정점, 인덱스를 정점 포맷에 맞춰 이진 메시 파일로 저장합니다
+  bool SaveMesh(const std::filesystem::path& mesh_path);
+  void Shutdown();
+#if defined(_WIN32)
+  void Render(DeviceContextClass* device_context);
+#endif
+
+  // 원본(LOD 0)의 인덱스 수입니다
+  int GetIndexCount();
+  int GetVertexCount();
+
+  // 0 번이 원본이고 단계가 올라갈수록 삼각형이 절반 정도로 줄어듭니다
+  const LodType* GetLods();
+  int GetLodCount();
+
+  // 인스턴스 목록을 설정합니다. 다음 Render 에서 인스턴스 버퍼로 올라갑니다
+  void SetInstances(const InstanceType* instances, const int32_t count);
+#if defined(_WIN32)
+  // 인스턴스 목록이 바뀌었으면 인스턴스 버퍼로 올립니다. Render 가 부르지만,
+  // 명령 목록에 기록할 때는 Map 을 쓸 수 없으므로 기록 전에 즉시
+  // 컨텍스트로 먼저 부릅니다
+  void UpdateInstanceBuffer(DeviceContextClass* device_context);
+#endif
+  const InstanceType* GetInstances();
+  int GetInstanceCount();
+
+  // 소프트웨어 렌더러가 사용하는 CPU 측 정점, 인덱스 데이터입니다.
+  // 인덱스는 모든 LOD 단계를 이어 붙인 배열입니다
+  const VertexType* GetVertices();
+  const uint32_t* GetIndices();
+
+  // 모델 공간에서 정점을 감싸는 축 정렬 경계 상자입니다
+  void GetBoundingBox(DirectX::XMFLOAT3& min, DirectX::XMFLOAT3& max);
+  // 양자화된 정점 위치를 모델 공간으로 되돌리는 행렬입니다. GPU 경로에서
+  // 월드 행렬 앞에 곱합니다
+  DirectX::XMMATRIX GetPositionTransform();
+
+ private:
+  bool InitializeGeometry();
+  void ComputeBoundingBox();
+  // 정점 캐시, overdraw, 정점 fetch 순서를 최적화하고 ACMR/ATVR 을
+  // 디버그 출력으로 남깁니다
+  void OptimizeGeometry();
+  // 원본 인덱스 뒤에 단순화한 LOD 단계들을 이어 붙입니다
+  void BuildLods();
+  bool InitializeMesh(ResourceManagerClass* resources, MeshFileClass& mesh);
+  bool ImportMesh(ResourceManagerClass* resources,
+                  const std::filesystem::path& path,
+                  JobSystemClass* job_system);
+  // CPU 측 정점을 정점 포맷으로 묶고 인덱스를 줄여서 GPU 버퍼를 만듭니다
+  bool UploadGeometry(ResourceManagerClass* resources);
+  bool InitializeBuffers(ResourceManagerClass* resources, const void* vertices,
+                         const void* indices, const uint32_t index_size);
   void ShutdownBuffers();
-  void RenderBuffers(ID3D11DeviceContext* device_context);
+#if defined(_WIN32)
+  void RenderBuffers(DeviceContextClass* device_context);
+#endif
 
  private:
-  ID3D11Buffer* vertex_buffer_ = nullptr;
-  ID3D11Buffer* index_buffer_ = nullptr;
+  ResourceManagerClass* resources_ = nullptr;
+#if defined(_WIN32)
+  ResourceManagerClass::BufferHandleType vertex_buffer_{};
+  ResourceManagerClass::BufferHandleType index_buffer_{};
+  ResourceManagerClass::BufferHandleType instance_buffer_{};
+  DXGI_FORMAT index_format_ = DXGI_FORMAT_R32_UINT;
+#endif
   int32_t vertex_count_ = 0;
   int32_t index_count_ = 0;
+  int32_t instance_capacity_ = 0;
+  VertexFormatType vertex_format_ = VertexFormatType::FLOAT32;
+  bool instances_dirty_ = false;
+  DirectX::XMFLOAT3 bounds_min_{0.0f, 0.0f, 0.0f};
+  DirectX::XMFLOAT3 bounds_max_{0.0f, 0.0f, 0.0f};
+  std::vector<VertexType> vertices_;
+  std::vector<uint32_t> indices_;
+  std::vector<InstanceType> instances_;
+  std::vector<LodType> lods_;
+};
+
+// 정점, 인스턴스 구조체의 속성 선언입니다. input layout 과 메시 파일
+// 속성은 여기서 생성됩니다
+template <>
+struct VertexAttributes<ModelClass::VertexType> {
+  static constexpr VertexAttributeType ATTRIBUTES[] = {
+      VERTEX_ATTRIBUTE(ModelClass::VertexType, position_, "POSITION", 0),
+      VERTEX_ATTRIBUTE(ModelClass::VertexType, color_, "COLOR", 0)};
+};
+
+template <>
+struct VertexAttributes<ModelClass::Snorm16VertexType> {
+  static constexpr VertexAttributeType ATTRIBUTES[] = {
+      VERTEX_ATTRIBUTE(ModelClass::Snorm16VertexType, position_, "POSITION",
+                       0),
+      VERTEX_ATTRIBUTE(ModelClass::Snorm16VertexType, color_, "COLOR", 0)};
+};
+
+template <>
+struct VertexAttributes<ModelClass::Half16VertexType> {
+  static constexpr VertexAttributeType ATTRIBUTES[] = {
+      VERTEX_ATTRIBUTE(ModelClass::Half16VertexType, position_, "POSITION", 0),
+      VERTEX_ATTRIBUTE(ModelClass::Half16VertexType, color_, "COLOR", 0)};
+};
+
+template <>
+struct VertexAttributes<ModelClass::InstanceType> {
+  static constexpr VertexAttributeType ATTRIBUTES[] = {
+      VERTEX_ATTRIBUTE(ModelClass::InstanceType, world_, "WORLD", 0),
+      VERTEX_ATTRIBUTE(ModelClass::InstanceType, color_, "INSTANCECOLOR", 0)};
 };
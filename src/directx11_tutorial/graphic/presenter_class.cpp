@@ -0,0 +1,96 @@
+#include "pch.h"
+#include "presenter_class.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace {
+// 이보다 짧게 남으면 재우지 않고 돌며 기다립니다. 운영체제 타이머가 재운
+// 시간보다 늦게 깨우는 만큼을 덮습니다
+const int64_t SPIN_NANOSECONDS = 2000000;
+const double NANOSECONDS_PER_SECOND = 1e9;
+}  // namespace
+
+int64_t PresenterClass::SystemClockType::Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void PresenterClass::SystemClockType::SleepUntil(const int64_t time) {
+  const int64_t remaining = time - Now();
+  if (remaining > SPIN_NANOSECONDS)
+    std::this_thread::sleep_for(
+        std::chrono::nanoseconds(remaining - SPIN_NANOSECONDS));
+
+  while (Now() < time) std::this_thread::yield();
+}
+
+bool PresenterClass::Initialize(const SettingsType& settings,
+                                const bool tearing_supported) {
+  if (settings.buffer_count_ < MIN_BUFFER_COUNT ||
+      settings.buffer_count_ > MAX_BUFFER_COUNT)
+    return false;
+  if (settings.max_frame_latency_ == 0 ||
+      settings.max_frame_latency_ > MAX_FRAME_LATENCY)
+    return false;
+
+  settings_ = settings;
+  tearing_supported_ = tearing_supported;
+  last_frame_time_ = 0;
+  frame_interval_ = 0;
+  sleep_time_ = 0;
+  latency_wait_time_ = 0;
+  frame_count_ = 0;
+  SetMode(settings.mode_, settings.frame_rate_limit_);
+  return true;
+}
+
+void PresenterClass::SetMode(const ModeType mode,
+                             const double frame_rate_limit) {
+  settings_.mode_ = mode;
+  settings_.frame_rate_limit_ = frame_rate_limit;
+
+  // 목표 프레임률이 없으면 기다리지 않습니다
+  frame_period_ =
+      frame_rate_limit > 0.0
+          ? static_cast<int64_t>(NANOSECONDS_PER_SECOND / frame_rate_limit)
+          : 0;
+  next_frame_time_ = 0;
+}
+
+const PresenterClass::SettingsType& PresenterClass::GetSettings() {
+  return settings_;
+}
+
+uint32_t PresenterClass::GetSyncInterval() {
+  return settings_.mode_ == ModeType::VSYNC ? 1 : 0;
+}
+
+bool PresenterClass::IsTearingAllowed() {
+  // 수직 동기를 끈 표시에서만 티어링을 허용할 수 있습니다
+  return tearing_supported_ && GetSyncInterval() == 0;
+}
+
+int64_t PresenterClass::GetFrameInterval() { return frame_interval_; }
+
+int64_t PresenterClass::GetSleepTime() { return sleep_time_; }
+
+int64_t PresenterClass::GetLatencyWaitTime() { return latency_wait_time_; }
+
+int64_t PresenterClass::GetWorkTime() {
+  return (std::max)(frame_interval_ - sleep_time_ - latency_wait_time_,
+                    int64_t{0});
+}
+
+int64_t PresenterClass::GetBusyTime(const int64_t gpu_time) {
+  if (gpu_time > 0) return (std::max)(GetWorkTime(), gpu_time);
+
+  // 수직 동기에서 대기열을 기다린 시간까지 넣으면 프레임 시간이 항상 화면
+  // 주기 이상이 되어, 여유가 생겨도 해상도를 올리지 못합니다
+  if (settings_.mode_ == ModeType::VSYNC) return GetWorkTime();
+  return (std::max)(frame_interval_ - sleep_time_, int64_t{0});
+}
+
+uint64_t PresenterClass::GetFrameCount() { return frame_count_; }
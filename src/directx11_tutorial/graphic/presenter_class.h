@@ -0,0 +1,125 @@
+#pragma once
+#include <cstdint>
+
+// 스왑 체인을 어떻게 표시하고 다음 프레임을 언제 시작할지 정합니다.
+// 그래픽스 API 와 시계를 모르므로, WaitForNextFrame 은 같은 이름의 함수를
+// 가진 어떤 시계와 스왑 체인에도 쓸 수 있습니다. 실제로는 SystemClockType
+// 과 D3D 스왑 체인을, 시험에서는 시간을 직접 넘기는 가짜 시계와 대기열을
+// 흉내 내는 가짜 스왑 체인을 넘깁니다.
+//   Clock: int64_t Now(), void SleepUntil(int64_t) (나노초)
+//   SwapChain: void WaitForFrameLatency()
+class PresenterClass {
+ public:
+  enum class ModeType : uint32_t {
+    // 수직 동기에 맞춰 표시합니다
+    VSYNC = 0,
+    // 기다리지 않고 표시하고, 지원하면 티어링을 허용합니다
+    UNCAPPED,
+    // 목표 프레임률에 맞춰 CPU 가 기다린 뒤 기다리지 않고 표시합니다
+    CAPPED,
+  };
+
+  struct SettingsType {
+    ModeType mode_ = ModeType::VSYNC;
+    // CAPPED 에서 초당 프레임 수입니다
+    double frame_rate_limit_ = 60.0;
+    // 플립 모델 스왑 체인의 버퍼 수(2~3)입니다
+    uint32_t buffer_count_ = 3;
+    // 표시를 기다리며 대기열에 쌓을 수 있는 최대 프레임 수입니다. 작을수록
+    // 입력에서 화면까지의 지연이 짧습니다
+    uint32_t max_frame_latency_ = 1;
+  };
+
+  // steady_clock 을 쓰는 실제 시계입니다
+  struct SystemClockType {
+    int64_t Now();
+    // 대부분은 재우고 끝의 짧은 구간만 돌며 기다려 늦게 깨는 것을 줄입니다
+    void SleepUntil(const int64_t time);
+  };
+
+  static const uint32_t MIN_BUFFER_COUNT = 2;
+  static const uint32_t MAX_BUFFER_COUNT = 3;
+  static const uint32_t MAX_FRAME_LATENCY = 16;
+
+  // tearing_supported 는 스왑 체인이 티어링을 허용하도록 만들어졌는지입니다.
+  // 설정이 범위를 벗어나면 false 를 반환합니다
+  bool Initialize(const SettingsType& settings, const bool tearing_supported);
+
+  // 프레임 사이에 표시 방식을 바꿉니다. 다음 CAPPED 프레임은 바꾼 시각부터
+  // 다시 셉니다
+  void SetMode(const ModeType mode, const double frame_rate_limit);
+  const SettingsType& GetSettings();
+
+  // Present 에 넘길 동기 간격과 티어링 허용 여부입니다
+  uint32_t GetSyncInterval();
+  bool IsTearingAllowed();
+
+  // 프레임을 시작하기 전에 부릅니다. 스왑 체인 대기열에 자리가 날 때까지
+  // 기다리고, CAPPED 이면 다음 프레임 시각까지 잡니다. 한 주기 넘게
+  // 늦었으면 밀린 프레임을 따라잡지 않고 지금부터 다시 셉니다
+  template <typename Clock, typename SwapChain>
+  void WaitForNextFrame(Clock& clock, SwapChain& swap_chain);
+
+  // 마지막 두 프레임 시작 사이의 간격(나노초)입니다
+  int64_t GetFrameInterval();
+  // 마지막 WaitForNextFrame 이 CAPPED 의 프레임 시각을 맞추려고 잔
+  // 시간(나노초)입니다
+  int64_t GetSleepTime();
+  // 마지막 WaitForNextFrame 이 스왑 체인 대기열에 자리가 나기를 기다린
+  // 시간(나노초)입니다. 수직 동기에서는 대개 다음 vblank 까지의 시간이고,
+  // 그 밖에서는 GPU 가 밀린 시간입니다
+  int64_t GetLatencyWaitTime();
+  // 간격에서 기다린 시간을 모두 뺀, CPU 가 지난 프레임에 일한 시간입니다
+  int64_t GetWorkTime();
+  // 해상도 조절에 쓸, 지난 프레임이 CPU 나 GPU 때문에 걸린 시간입니다.
+  // gpu_time 은 잰 GPU 프레임 시간이고 모르면 0 입니다. GPU 시간을 알면
+  // 일한 시간과 GPU 시간 중 긴 쪽이고, 모르면 수직 동기에서는 일한 시간,
+  // 그 밖에서는 GPU 가 밀린 시간을 더한 값입니다
+  int64_t GetBusyTime(const int64_t gpu_time);
+  uint64_t GetFrameCount();
+
+ private:
+  // CAPPED 의 다음 프레임 시각을 정하고 그때까지 잡니다
+  template <typename Clock>
+  void WaitForDeadline(Clock& clock);
+
+  SettingsType settings_{};
+  bool tearing_supported_ = false;
+  // CAPPED 의 프레임 주기와 다음 프레임 시각입니다. 0 이면 다시 셉니다
+  int64_t frame_period_ = 0;
+  int64_t next_frame_time_ = 0;
+  int64_t last_frame_time_ = 0;
+  int64_t frame_interval_ = 0;
+  int64_t sleep_time_ = 0;
+  int64_t latency_wait_time_ = 0;
+  uint64_t frame_count_ = 0;
+};
+
+template <typename Clock, typename SwapChain>
+void PresenterClass::WaitForNextFrame(Clock& clock, SwapChain& swap_chain) {
+  // GPU 가 밀려 있으면 먼저 대기열이 빌 때까지 기다려야 CAPPED 의 시각이
+  // 실제 표시 간격과 어긋나지 않습니다
+  const int64_t wait_begin = clock.Now();
+  swap_chain.WaitForFrameLatency();
+  latency_wait_time_ = clock.Now() - wait_begin;
+  sleep_time_ = 0;
+  if (settings_.mode_ == ModeType::CAPPED) WaitForDeadline(clock);
+
+  const int64_t now = clock.Now();
+  if (frame_count_ > 0) frame_interval_ = now - last_frame_time_;
+  last_frame_time_ = now;
+  frame_count_++;
+}
+
+template <typename Clock>
+void PresenterClass::WaitForDeadline(Clock& clock) {
+  const int64_t now = clock.Now();
+  if (next_frame_time_ == 0 || now - next_frame_time_ > frame_period_)
+    next_frame_time_ = now;
+
+  if (next_frame_time_ > now) {
+    clock.SleepUntil(next_frame_time_);
+    sleep_time_ = clock.Now() - now;
+  }
+  next_frame_time_ += frame_period_;
+}
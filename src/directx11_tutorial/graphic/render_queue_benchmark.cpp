@@ -0,0 +1,79 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "framework/benchmark_class.h"
+#include "framework/job_system_class.h"
+#include "graphic/render_queue_class.h"
+
+void RegisterRenderQueueBenchmarks(BenchmarkClass& benchmark) {
+  // 레이어 4, 셰이더 64, 재질 1024, 메시 4096 개에 깊이가 제각각인 100 만
+  // 드로우 키를 정렬하기. 정렬은 제자리이므로 매번 키를 다시 넣습니다
+  const uint32_t draw_count = 1000000;
+  const auto make_keys = [draw_count] {
+    auto keys = std::make_shared<std::vector<uint64_t>>(draw_count);
+    std::mt19937 random{42};
+    std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+    for (uint64_t& key : *keys)
+      key = RenderQueueClass::MakeKey(random() % 4, random() % 64,
+                                      random() % 1024, random() % 4096,
+                                      depth(random));
+    return keys;
+  };
+
+  benchmark.AddFixture("RenderQueueClass::Sort/1M", draw_count, [make_keys] {
+    struct DataType {
+      RenderQueueClass render_queue_;
+      std::shared_ptr<std::vector<uint64_t>> keys_;
+      std::vector<RenderQueueClass::DrawType> draws_;
+      ~DataType() { render_queue_.Shutdown(); }
+    };
+    auto data = std::make_shared<DataType>();
+    data->keys_ = make_keys();
+    data->draws_.resize(data->keys_->size());
+    data->render_queue_.Initialize(static_cast<uint32_t>(data->keys_->size()));
+
+    return BenchmarkClass::BodyType([data](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; i++) {
+        data->render_queue_.Reset();
+        data->render_queue_.Submit(
+            data->keys_->data(), data->draws_.data(),
+            static_cast<uint32_t>(data->keys_->size()));
+        data->render_queue_.Sort();
+        BenchmarkClass::DoNotOptimize(data->render_queue_.GetKey(0));
+      }
+    });
+  });
+
+  // 모든 작업 스레드가 드로우를 하나씩 동시에 넣기
+  benchmark.AddFixture("RenderQueueClass::Submit/1M", draw_count, [make_keys] {
+    struct DataType {
+      JobSystemClass job_system_;
+      RenderQueueClass render_queue_;
+      std::shared_ptr<std::vector<uint64_t>> keys_;
+      ~DataType() {
+        render_queue_.Shutdown();
+        job_system_.Shutdown();
+      }
+    };
+    auto data = std::make_shared<DataType>();
+    data->job_system_.Initialize();
+    data->keys_ = make_keys();
+    data->render_queue_.Initialize(static_cast<uint32_t>(data->keys_->size()));
+
+    return BenchmarkClass::BodyType([data](uint64_t iterations) {
+      const uint32_t count = static_cast<uint32_t>(data->keys_->size());
+      for (uint64_t i = 0; i < iterations; i++) {
+        data->render_queue_.Reset();
+        data->job_system_.ParallelFor(count, [&](uint32_t index) {
+          data->render_queue_.Submit((*data->keys_)[index],
+                                     {36, 0, 0, 0, index * 256});
+        });
+        BenchmarkClass::DoNotOptimize(data->render_queue_.GetCount());
+      }
+    });
+  });
+}
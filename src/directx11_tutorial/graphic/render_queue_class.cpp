@@ -0,0 +1,173 @@
+#include "pch.h"
+#include "render_queue_class.h"
+
+#include <algorithm>
+
+uint64_t RenderQueueClass::MakeKey(const uint32_t layer, const uint32_t shader,
+                                   const uint32_t material,
+                                   const uint32_t mesh, const float depth) {
+  // 깊이는 [0, 1] 로 잘라 24 bit 고정 소수점으로 양자화합니다
+  const uint64_t depth_max = (uint64_t{1} << DEPTH_BITS) - 1;
+  const float clamped = (std::min)((std::max)(depth, 0.0f), 1.0f);
+  const uint64_t quantized =
+      static_cast<uint64_t>(clamped * static_cast<float>(depth_max) + 0.5f);
+
+  return (uint64_t{layer} & ((1u << LAYER_BITS) - 1)) << LAYER_SHIFT |
+         (uint64_t{shader} & ((1u << SHADER_BITS) - 1)) << SHADER_SHIFT |
+         (uint64_t{material} & ((1u << MATERIAL_BITS) - 1)) << MATERIAL_SHIFT |
+         (uint64_t{mesh} & ((1u << MESH_BITS) - 1)) << MESH_SHIFT |
+         (std::min)(quantized, depth_max) << DEPTH_SHIFT;
+}
+
+uint32_t RenderQueueClass::GetLayer(const uint64_t key) {
+  return static_cast<uint32_t>(key >> LAYER_SHIFT) & ((1u << LAYER_BITS) - 1);
+}
+
+uint32_t RenderQueueClass::GetShader(const uint64_t key) {
+  return static_cast<uint32_t>(key >> SHADER_SHIFT) &
+         ((1u << SHADER_BITS) - 1);
+}
+
+uint32_t RenderQueueClass::GetMaterial(const uint64_t key) {
+  return static_cast<uint32_t>(key >> MATERIAL_SHIFT) &
+         ((1u << MATERIAL_BITS) - 1);
+}
+
+uint32_t RenderQueueClass::GetMesh(const uint64_t key) {
+  return static_cast<uint32_t>(key >> MESH_SHIFT) & ((1u << MESH_BITS) - 1);
+}
+
+uint32_t RenderQueueClass::GetDepth(const uint64_t key) {
+  return static_cast<uint32_t>(key >> DEPTH_SHIFT) & ((1u << DEPTH_BITS) - 1);
+}
+
+bool RenderQueueClass::Initialize(const uint32_t capacity) {
+  // 프레임 중에는 메모리를 할당하지 않도록 미리 잡아 둡니다
+  capacity_ = capacity;
+  entries_.resize(capacity);
+  scratch_.resize(capacity);
+  draws_.resize(capacity);
+  histograms_.resize(RADIX_PASS_COUNT * RADIX_BUCKET_COUNT);
+
+  Reset();
+  return true;
+}
+
+void RenderQueueClass::Shutdown() {
+  capacity_ = 0;
+  count_.store(0, std::memory_order_relaxed);
+  entries_.clear();
+  entries_.shrink_to_fit();
+  scratch_.clear();
+  scratch_.shrink_to_fit();
+  draws_.clear();
+  draws_.shrink_to_fit();
+  histograms_.clear();
+  histograms_.shrink_to_fit();
+}
+
+void RenderQueueClass::Reset() {
+  count_.store(0, std::memory_order_relaxed);
+  dropped_count_.store(0, std::memory_order_relaxed);
+  state_change_count_ = 0;
+}
+
+bool RenderQueueClass::Submit(const uint64_t key, const DrawType& draw) {
+  return Submit(&key, &draw, 1);
+}
+
+bool RenderQueueClass::Submit(const uint64_t* keys, const DrawType* draws,
+                              const uint32_t count) {
+  if (count == 0) return true;
+
+  // 원자적 덧셈 한 번으로 연속된 슬롯을 예약하므로 스레드마다 서로 다른
+  // 영역에 씁니다
+  const uint32_t begin = count_.fetch_add(count, std::memory_order_relaxed);
+  const uint32_t end =
+      static_cast<uint32_t>((std::min)(uint64_t{begin} + count,
+                                       uint64_t{capacity_}));
+
+  for (uint32_t i = begin; i < end; i++) {
+    entries_[i] = {keys[i - begin], i};
+    draws_[i] = draws[i - begin];
+  }
+
+  const uint32_t written = end > begin ? end - begin : 0;
+  if (written < count) {
+    dropped_count_.fetch_add(count - written, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void RenderQueueClass::Sort() {
+  const uint32_t count = GetCount();
+
+  // 적은 수는 기수 정렬의 히스토그램 비용이 더 큽니다. 같은 키는 기수
+  // 정렬과 같이 받은 순서를 유지합니다
+  if (count < RADIX_SORT_THRESHOLD) {
+    std::sort(entries_.begin(), entries_.begin() + count,
+              [](const EntryType& a, const EntryType& b) {
+                return a.key_ != b.key_ ? a.key_ < b.key_
+                                        : a.index_ < b.index_;
+              });
+    return;
+  }
+
+  // 11 bit 자리 6 개의 히스토그램을 한 번의 순회로 모두 셉니다
+  const uint64_t mask = RADIX_BUCKET_COUNT - 1;
+  std::fill(histograms_.begin(), histograms_.end(), 0);
+  for (uint32_t i = 0; i < count; i++) {
+    const uint64_t key = entries_[i].key_;
+    for (uint32_t pass = 0; pass < RADIX_PASS_COUNT; pass++)
+      histograms_[pass * RADIX_BUCKET_COUNT +
+                  ((key >> (pass * RADIX_BITS)) & mask)]++;
+  }
+
+  // 하위 자리부터 안정 분배합니다. 모든 키의 자리 값이 같은 패스(한 프레임의
+  // layer, shader 처럼 거의 바뀌지 않는 필드)는 건너뜁니다
+  EntryType* source = entries_.data();
+  EntryType* destination = scratch_.data();
+  for (uint32_t pass = 0; pass < RADIX_PASS_COUNT; pass++) {
+    uint32_t* histogram = histograms_.data() + pass * RADIX_BUCKET_COUNT;
+    const uint32_t shift = pass * RADIX_BITS;
+    if (histogram[(source[0].key_ >> shift) & mask] == count) continue;
+
+    uint32_t offset = 0;
+    for (uint32_t bucket = 0; bucket < RADIX_BUCKET_COUNT; bucket++) {
+      const uint32_t bucket_count = histogram[bucket];
+      histogram[bucket] = offset;
+      offset += bucket_count;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+      const EntryType& entry = source[i];
+      destination[histogram[(entry.key_ >> shift) & mask]++] = entry;
+    }
+    std::swap(source, destination);
+  }
+
+  // 결과가 보조 버퍼에 있으면 버퍼를 맞바꿉니다
+  if (source != entries_.data()) entries_.swap(scratch_);
+}
+
+uint32_t RenderQueueClass::GetCount() {
+  return (std::min)(count_.load(std::memory_order_relaxed), capacity_);
+}
+
+uint32_t RenderQueueClass::GetCapacity() { return capacity_; }
+
+uint32_t RenderQueueClass::GetDroppedCount() {
+  return dropped_count_.load(std::memory_order_relaxed);
+}
+
+uint64_t RenderQueueClass::GetKey(const uint32_t index) {
+  return entries_[index].key_;
+}
+
+const RenderQueueClass::DrawType& RenderQueueClass::GetDraw(
+    const uint32_t index) {
+  return draws_[entries_[index].index_];
+}
+
+uint32_t RenderQueueClass::GetStateChangeCount() { return state_change_count_; }
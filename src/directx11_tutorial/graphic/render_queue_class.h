@@ -0,0 +1,160 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// 드로우를 64 bit 정렬 키와 인자 묶음으로 받아 두었다가, 프레임마다 키로
+// 기수 정렬해 상태 변경이 적은 순서로 실행하는 렌더 큐입니다.
+// 키는 상위 비트부터 layer, shader, material, mesh, depth 순서이므로 정렬하면
+// 같은 셰이더, 재질, 메시의 드로우가 이웃합니다. Submit 은 잠금 없이 여러
+// 스레드에서 동시에 부를 수 있습니다.
+class RenderQueueClass {
+ public:
+  // 키 필드의 비트 수와 위치입니다
+  static const uint32_t LAYER_BITS = 4;
+  static const uint32_t SHADER_BITS = 8;
+  static const uint32_t MATERIAL_BITS = 12;
+  static const uint32_t MESH_BITS = 16;
+  static const uint32_t DEPTH_BITS = 24;
+  static const uint32_t DEPTH_SHIFT = 0;
+  static const uint32_t MESH_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+  static const uint32_t MATERIAL_SHIFT = MESH_SHIFT + MESH_BITS;
+  static const uint32_t SHADER_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+  static const uint32_t LAYER_SHIFT = SHADER_SHIFT + SHADER_BITS;
+
+  // 이보다 적은 드로우는 기수 정렬 대신 비교 정렬합니다
+  static const uint32_t RADIX_SORT_THRESHOLD = 256;
+  // 기수 정렬의 자리 크기입니다. 64 bit 키를 6 번의 분배로 정렬합니다
+  static const uint32_t RADIX_BITS = 11;
+  static const uint32_t RADIX_BUCKET_COUNT = 1 << RADIX_BITS;
+  static const uint32_t RADIX_PASS_COUNT = (64 + RADIX_BITS - 1) / RADIX_BITS;
+
+  // 드로우 하나의 인자입니다. instance_count_ 가 0 이면 인스턴싱 없이
+  // 그리고, constant_offset_ 은 드로우 상수가 있는 위치입니다
+  struct DrawType {
+    uint32_t index_count_;
+    uint32_t start_index_;
+    uint32_t instance_count_;
+    uint32_t start_instance_;
+    uint32_t constant_offset_;
+  };
+
+  // depth 는 [0, 1] 로 정규화한 카메라 거리입니다. 앞에서 뒤로 그립니다.
+  // 반투명 레이어처럼 뒤에서 앞으로 그려야 하면 1 - depth 를 넘깁니다
+  static uint64_t MakeKey(const uint32_t layer, const uint32_t shader,
+                          const uint32_t material, const uint32_t mesh,
+                          const float depth);
+  static uint32_t GetLayer(const uint64_t key);
+  static uint32_t GetShader(const uint64_t key);
+  static uint32_t GetMaterial(const uint64_t key);
+  static uint32_t GetMesh(const uint64_t key);
+  static uint32_t GetDepth(const uint64_t key);
+
+  // capacity 는 한 프레임에 받을 수 있는 최대 드로우 수입니다
+  bool Initialize(const uint32_t capacity);
+  void Shutdown();
+
+  // 프레임을 시작할 때 받아 둔 드로우를 비웁니다
+  void Reset();
+
+  // 드로우를 받아 둡니다. 여러 스레드에서 동시에 부를 수 있고, 큐가 가득
+  // 차면 버린 뒤 false 를 반환합니다
+  bool Submit(const uint64_t key, const DrawType& draw);
+  // count 개의 드로우를 한 번의 예약으로 받아 둡니다
+  bool Submit(const uint64_t* keys, const DrawType* draws,
+              const uint32_t count);
+
+  // 받아 둔 드로우를 키 순서로 정렬합니다. 모든 Submit 이 끝난 뒤 한
+  // 스레드에서 부릅니다
+  void Sort();
+
+  // 정렬한 순서대로 드로우를 실행합니다. 키의 필드가 바로 앞 드로우와 다를
+  // 때만 executor 의 BindLayer, BindShader, BindMaterial, BindMesh 를
+  // 부르고, 드로우마다 Draw 를 부릅니다. 셰이더가 바뀌면 재질도 다시
+  // 바인딩합니다
+  template <typename Executor>
+  void Execute(Executor& executor);
+  // 정렬된 [begin, end) 구간만 실행하고 부른 Bind 수를 반환합니다. 구간의
+  // 첫 드로우는 모든 상태를 바인딩하므로, 구간을 나눠 서로 다른 명령
+  // 목록에 동시에 기록할 수 있습니다
+  template <typename Executor>
+  uint32_t Execute(Executor& executor, const uint32_t begin,
+                   const uint32_t end);
+
+  uint32_t GetCount();
+  uint32_t GetCapacity();
+  // 큐가 가득 차서 버린 드로우 수입니다
+  uint32_t GetDroppedCount();
+  // 정렬된 i 번째 드로우의 키와 인자입니다
+  uint64_t GetKey(const uint32_t index);
+  const DrawType& GetDraw(const uint32_t index);
+  // 마지막 Execute 에서 부른 Bind 호출 수입니다
+  uint32_t GetStateChangeCount();
+
+ private:
+  // 정렬 대상입니다. index_ 는 draws_ 에서 인자의 위치입니다
+  struct EntryType {
+    uint64_t key_;
+    uint32_t index_;
+  };
+
+  // 예약한 슬롯 수입니다. capacity_ 를 넘을 수 있으므로 읽을 때 자릅니다
+  std::atomic<uint32_t> count_{0};
+  std::atomic<uint32_t> dropped_count_{0};
+  uint32_t capacity_ = 0;
+  uint32_t state_change_count_ = 0;
+
+  std::vector<EntryType> entries_;
+  std::vector<EntryType> scratch_;
+  std::vector<DrawType> draws_;
+  // 자리마다 RADIX_BUCKET_COUNT 개씩 센 뒤 분배할 위치로 바꿉니다
+  std::vector<uint32_t> histograms_;
+};
+
+template <typename Executor>
+void RenderQueueClass::Execute(Executor& executor) {
+  state_change_count_ = Execute(executor, 0, GetCount());
+}
+
+template <typename Executor>
+uint32_t RenderQueueClass::Execute(Executor& executor, const uint32_t begin,
+                                   const uint32_t end) {
+  uint32_t state_change_count = 0;
+
+  uint32_t layer = 0, shader = 0, material = 0, mesh = 0;
+  for (uint32_t i = begin; i < end; i++) {
+    const uint64_t key = entries_[i].key_;
+    const bool first = i == begin;
+
+    // 상위 필드부터 비교해 달라진 상태만 다시 바인딩합니다
+    if (first || GetLayer(key) != layer) {
+      layer = GetLayer(key);
+      executor.BindLayer(layer);
+      state_change_count++;
+    }
+
+    bool shader_changed = false;
+    if (first || GetShader(key) != shader) {
+      shader = GetShader(key);
+      executor.BindShader(shader);
+      state_change_count++;
+      shader_changed = true;
+    }
+
+    if (shader_changed || GetMaterial(key) != material) {
+      material = GetMaterial(key);
+      executor.BindMaterial(material);
+      state_change_count++;
+    }
+
+    if (first || GetMesh(key) != mesh) {
+      mesh = GetMesh(key);
+      executor.BindMesh(mesh);
+      state_change_count++;
+    }
+
+    executor.Draw(draws_[entries_[i].index_]);
+  }
+
+  return state_change_count;
+}
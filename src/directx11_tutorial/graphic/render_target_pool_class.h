@@ -0,0 +1,148 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// 프레임마다 크기가 바뀌는 중간 렌더 타겟을 돌려 쓰는 풀입니다. 타겟은
+// 요청한 크기를 granularity 배수로 올린 크기로 만들고, 요청한 크기 이상인
+// 빈 타겟이 있으면 그중 가장 작은 것을 빌려 주므로 해상도가 조금씩 바뀌어도
+// 새로 만들지 않습니다. 빌린 쪽은 요청한 크기만큼의 왼쪽 위 영역만 씁니다.
+// max_idle_frames 프레임 동안 빌려 가지 않은 타겟은 해제합니다.
+// T 는 Release() 로 자신을 해제하는 객체이면 되고, 만드는 방법은 Acquire
+// 에 함수로 넘기므로 그래픽스 API 없이도 동작합니다.
+template <typename T>
+class RenderTargetPoolClass {
+ public:
+  // format_ 은 풀이 해석하지 않고 같은지만 비교합니다
+  struct DescType {
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    uint32_t format_ = 0;
+  };
+
+  bool Initialize(const uint32_t granularity, const uint32_t max_idle_frames);
+  // 빌려 준 타겟까지 모두 해제합니다. GPU 가 모든 작업을 마친 뒤에 부릅니다
+  void Shutdown();
+
+  // desc 이상인 빈 타겟을 빌려 줍니다. 없으면 create(allocated_desc) 로
+  // 만들고, create 가 nullptr 을 반환하면 nullptr 을 반환합니다
+  template <typename CreateFunction>
+  T* Acquire(const DescType& desc, const CreateFunction& create);
+  // 빌린 타겟을 돌려줍니다. 같은 프레임에 다시 빌려 줄 수 있습니다
+  void Release(T* target);
+  // 타겟이 실제로 만들어진 크기입니다
+  DescType GetAllocatedDesc(const T* target) const;
+
+  // 프레임을 넘기고 오래 쉰 타겟을 해제합니다
+  void EndFrame();
+
+  uint32_t GetTargetCount() const {
+    return static_cast<uint32_t>(entries_.size());
+  }
+  // 지금까지 만든 타겟 수입니다
+  uint64_t GetCreateCount() const { return create_count_; }
+
+ private:
+  struct EntryType {
+    T* target_;
+    DescType desc_;
+    uint64_t last_used_frame_;
+    bool in_use_;
+  };
+
+  uint32_t RoundUp(const uint32_t size) const {
+    return (size + granularity_ - 1) / granularity_ * granularity_;
+  }
+
+  uint32_t granularity_ = 1;
+  uint32_t max_idle_frames_ = 0;
+  uint64_t frame_ = 0;
+  uint64_t create_count_ = 0;
+  std::vector<EntryType> entries_;
+};
+
+template <typename T>
+bool RenderTargetPoolClass<T>::Initialize(const uint32_t granularity,
+                                          const uint32_t max_idle_frames) {
+  if (granularity == 0) return false;
+
+  granularity_ = granularity;
+  max_idle_frames_ = max_idle_frames;
+  frame_ = 0;
+  create_count_ = 0;
+  return true;
+}
+
+template <typename T>
+void RenderTargetPoolClass<T>::Shutdown() {
+  for (EntryType& entry : entries_) entry.target_->Release();
+  entries_.clear();
+}
+
+template <typename T>
+template <typename CreateFunction>
+T* RenderTargetPoolClass<T>::Acquire(const DescType& desc,
+                                     const CreateFunction& create) {
+  // 넓이가 가장 작은 빈 타겟을 고릅니다
+  EntryType* best = nullptr;
+  for (EntryType& entry : entries_) {
+    if (entry.in_use_ || entry.desc_.format_ != desc.format_ ||
+        entry.desc_.width_ < desc.width_ || entry.desc_.height_ < desc.height_)
+      continue;
+    if (best == nullptr ||
+        uint64_t{entry.desc_.width_} * entry.desc_.height_ <
+            uint64_t{best->desc_.width_} * best->desc_.height_)
+      best = &entry;
+  }
+
+  if (best == nullptr) {
+    DescType allocated = desc;
+    allocated.width_ = RoundUp(desc.width_);
+    allocated.height_ = RoundUp(desc.height_);
+
+    T* target = create(allocated);
+    if (target == nullptr) return nullptr;
+
+    create_count_++;
+    entries_.push_back({target, allocated, frame_, false});
+    best = &entries_.back();
+  }
+
+  best->in_use_ = true;
+  best->last_used_frame_ = frame_;
+  return best->target_;
+}
+
+template <typename T>
+void RenderTargetPoolClass<T>::Release(T* target) {
+  for (EntryType& entry : entries_) {
+    if (entry.target_ == target) {
+      entry.in_use_ = false;
+      return;
+    }
+  }
+}
+
+template <typename T>
+typename RenderTargetPoolClass<T>::DescType
+RenderTargetPoolClass<T>::GetAllocatedDesc(const T* target) const {
+  for (const EntryType& entry : entries_)
+    if (entry.target_ == target) return entry.desc_;
+  return {};
+}
+
+template <typename T>
+void RenderTargetPoolClass<T>::EndFrame() {
+  frame_++;
+
+  // 빈 타겟 중 오래 쉰 것을 지우고 남은 것을 앞으로 당깁니다
+  size_t count = 0;
+  for (EntryType& entry : entries_) {
+    if (entry.in_use_ == false &&
+        frame_ - entry.last_used_frame_ > max_idle_frames_) {
+      entry.target_->Release();
+      continue;
+    }
+    entries_[count++] = entry;
+  }
+  entries_.resize(count);
+}
@@ -0,0 +1,277 @@
+#include "pch.h"
+#include "resource_manager_class.h"
+
+#include <cstring>
+
+#include "com_throw.h"
+
+namespace {
+// 같은 내용의 리소스를 찾는 키는 64 비트 FNV-1a 입니다
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+const uint64_t FNV_PRIME = 1099511628211ull;
+
+void HashBytes(uint64_t& hash, const void* data, const size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+}
+}  // namespace
+
+void ResourceManagerClass::ContentsType::Append(const void* data,
+                                                const size_t size) {
+  if (key_ == 0) key_ = FNV_OFFSET_BASIS;
+  HashBytes(key_, data, size);
+
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  bytes_.insert(bytes_.end(), bytes, bytes + size);
+}
+
+bool ResourceManagerClass::Initialize(ID3D11Device* device) {
+  device_ = device;
+  device_->AddRef();
+  frame_ = 0;
+
+  return buffers_.Initialize(POOL_CAPACITY) &&
+         vertex_shaders_.Initialize(POOL_CAPACITY) &&
+         pixel_shaders_.Initialize(POOL_CAPACITY) &&
+         input_layouts_.Initialize(POOL_CAPACITY) &&
+         render_target_views_.Initialize(POOL_CAPACITY) &&
+         depth_stencil_views_.Initialize(POOL_CAPACITY) &&
+         shader_resource_views_.Initialize(POOL_CAPACITY);
+}
+
+void ResourceManagerClass::Shutdown() {
+  shader_resource_views_.Shutdown();
+  depth_stencil_views_.Shutdown();
+  render_target_views_.Shutdown();
+  input_layouts_.Shutdown();
+  pixel_shaders_.Shutdown();
+  vertex_shaders_.Shutdown();
+  buffers_.Shutdown();
+
+  if (device_) {
+    device_->Release();
+    device_ = nullptr;
+  }
+}
+
+ID3D11Device* ResourceManagerClass::GetDevice() { return device_; }
+
+void ResourceManagerClass::EndFrame() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // frame_ 에 놓은 리소스는 frame_ + FRAME_LATENCY 프레임을 제출할 때
+  // Present 가 기다려 주므로 그 뒤에는 GPU 가 읽지 않습니다
+  frame_++;
+  if (frame_ <= FRAME_LATENCY) return;
+
+  const uint64_t completed_frame = frame_ - FRAME_LATENCY - 1;
+  buffers_.Collect(completed_frame);
+  vertex_shaders_.Collect(completed_frame);
+  pixel_shaders_.Collect(completed_frame);
+  input_layouts_.Collect(completed_frame);
+  render_target_views_.Collect(completed_frame);
+  depth_stencil_views_.Collect(completed_frame);
+  shader_resource_views_.Collect(completed_frame);
+}
+
+ResourceManagerClass::BufferHandleType ResourceManagerClass::CreateBuffer(
+    const D3D11_BUFFER_DESC& desc, const D3D11_SUBRESOURCE_DATA* initial_data,
+    const uint64_t key) {
+  // 내용이 바뀌지 않는 IMMUTABLE 버퍼만 공유합니다. 큰 버퍼는 내용 대신
+  // 호출자의 key 를 desc 와 함께 비교합니다
+  ContentsType contents;
+  if (initial_data && desc.Usage == D3D11_USAGE_IMMUTABLE) {
+    if (key != 0) {
+      contents.AppendValue(desc);
+      contents.AppendValue(key);
+    } else if (desc.ByteWidth <= MAX_SHARED_BUFFER_SIZE) {
+      contents.AppendValue(desc);
+      contents.Append(initial_data->pSysMem, desc.ByteWidth);
+    }
+
+    const BufferHandleType handle = Find(buffers_, contents);
+    if (handle.IsValid()) return handle;
+  }
+
+  ID3D11Buffer* buffer = nullptr;
+  com::ThrowIfFailed(device_->CreateBuffer(&desc, initial_data, &buffer));
+  return Add(buffers_, buffer, contents);
+}
+
+ResourceManagerClass::VertexShaderHandleType
+ResourceManagerClass::CreateVertexShader(const void* bytecode,
+                                         const size_t size) {
+  ContentsType contents;
+  contents.Append(bytecode, size);
+  const VertexShaderHandleType handle = Find(vertex_shaders_, contents);
+  if (handle.IsValid()) return handle;
+
+  ID3D11VertexShader* shader = nullptr;
+  com::ThrowIfFailed(
+      device_->CreateVertexShader(bytecode, size, nullptr, &shader));
+  return Add(vertex_shaders_, shader, contents);
+}
+
+ResourceManagerClass::PixelShaderHandleType
+ResourceManagerClass::CreatePixelShader(const void* bytecode,
+                                        const size_t size) {
+  ContentsType contents;
+  contents.Append(bytecode, size);
+  const PixelShaderHandleType handle = Find(pixel_shaders_, contents);
+  if (handle.IsValid()) return handle;
+
+  ID3D11PixelShader* shader = nullptr;
+  com::ThrowIfFailed(
+      device_->CreatePixelShader(bytecode, size, nullptr, &shader));
+  return Add(pixel_shaders_, shader, contents);
+}
+
+ResourceManagerClass::InputLayoutHandleType
+ResourceManagerClass::CreateInputLayout(
+    const D3D11_INPUT_ELEMENT_DESC* elements, const uint32_t count,
+    const void* bytecode, const size_t size) {
+  // 시맨틱 이름은 포인터가 아니라 끝의 0 까지 문자열로 비교합니다
+  ContentsType contents;
+  for (uint32_t i = 0; i < count; i++) {
+    const D3D11_INPUT_ELEMENT_DESC& element = elements[i];
+    contents.Append(element.SemanticName,
+                    std::strlen(element.SemanticName) + 1);
+    contents.AppendValue(element.SemanticIndex);
+    contents.AppendValue(element.Format);
+    contents.AppendValue(element.InputSlot);
+    contents.AppendValue(element.AlignedByteOffset);
+    contents.AppendValue(element.InputSlotClass);
+    contents.AppendValue(element.InstanceDataStepRate);
+  }
+  contents.Append(bytecode, size);
+  const InputLayoutHandleType handle = Find(input_layouts_, contents);
+  if (handle.IsValid()) return handle;
+
+  ID3D11InputLayout* layout = nullptr;
+  com::ThrowIfFailed(
+      device_->CreateInputLayout(elements, count, bytecode, size, &layout));
+  return Add(input_layouts_, layout, contents);
+}
+
+ResourceManagerClass::RenderTargetViewHandleType
+ResourceManagerClass::AddRenderTargetView(ID3D11RenderTargetView* view) {
+  return Add(render_target_views_, view, {});
+}
+
+ResourceManagerClass::DepthStencilViewHandleType
+ResourceManagerClass::AddDepthStencilView(ID3D11DepthStencilView* view) {
+  return Add(depth_stencil_views_, view, {});
+}
+
+ResourceManagerClass::ShaderResourceViewHandleType
+ResourceManagerClass::AddShaderResourceView(ID3D11ShaderResourceView* view) {
+  return Add(shader_resource_views_, view, {});
+}
+
+ID3D11Buffer* ResourceManagerClass::Get(const BufferHandleType handle) {
+  return buffers_.Get(handle);
+}
+
+ID3D11VertexShader* ResourceManagerClass::Get(
+    const VertexShaderHandleType handle) {
+  return vertex_shaders_.Get(handle);
+}
+
+ID3D11PixelShader* ResourceManagerClass::Get(
+    const PixelShaderHandleType handle) {
+  return pixel_shaders_.Get(handle);
+}
+
+ID3D11InputLayout* ResourceManagerClass::Get(
+    const InputLayoutHandleType handle) {
+  return input_layouts_.Get(handle);
+}
+
+ID3D11RenderTargetView* ResourceManagerClass::Get(
+    const RenderTargetViewHandleType handle) {
+  return render_target_views_.Get(handle);
+}
+
+ID3D11DepthStencilView* ResourceManagerClass::Get(
+    const DepthStencilViewHandleType handle) {
+  return depth_stencil_views_.Get(handle);
+}
+
+ID3D11ShaderResourceView* ResourceManagerClass::Get(
+    const ShaderResourceViewHandleType handle) {
+  return shader_resource_views_.Get(handle);
+}
+
+void ResourceManagerClass::Release(BufferHandleType& handle) {
+  Release(buffers_, handle);
+}
+
+void ResourceManagerClass::Release(VertexShaderHandleType& handle) {
+  Release(vertex_shaders_, handle);
+}
+
+void ResourceManagerClass::Release(PixelShaderHandleType& handle) {
+  Release(pixel_shaders_, handle);
+}
+
+void ResourceManagerClass::Release(InputLayoutHandleType& handle) {
+  Release(input_layouts_, handle);
+}
+
+void ResourceManagerClass::Release(RenderTargetViewHandleType& handle) {
+  Release(render_target_views_, handle);
+}
+
+void ResourceManagerClass::Release(DepthStencilViewHandleType& handle) {
+  Release(depth_stencil_views_, handle);
+}
+
+void ResourceManagerClass::Release(ShaderResourceViewHandleType& handle) {
+  Release(shader_resource_views_, handle);
+}
+
+template <typename T>
+typename ResourcePoolClass<T>::HandleType ResourceManagerClass::Find(
+    ResourcePoolClass<T>& pool, const ContentsType& contents) {
+  if (contents.key_ == 0) return {};
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pool.Find(contents.key_, contents.bytes_.data(),
+                   contents.bytes_.size());
+}
+
+template <typename T>
+typename ResourcePoolClass<T>::HandleType ResourceManagerClass::Add(
+    ResourcePoolClass<T>& pool, T* resource, const ContentsType& contents) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // 잠그지 않고 만드는 동안 다른 스레드가 같은 리소스를 먼저 넣었으면
+  // 그것을 공유하고 방금 만든 것은 버립니다
+  if (contents.key_ != 0) {
+    const typename ResourcePoolClass<T>::HandleType handle = pool.Find(
+        contents.key_, contents.bytes_.data(), contents.bytes_.size());
+    if (handle.IsValid()) {
+      resource->Release();
+      return handle;
+    }
+  }
+
+  const typename ResourcePoolClass<T>::HandleType handle = pool.Add(
+      resource, contents.key_, contents.bytes_.data(), contents.bytes_.size());
+  if (handle.IsValid() == false) com::ThrowIfFailed(E_OUTOFMEMORY);
+  return handle;
+}
+
+template <typename T>
+void ResourceManagerClass::Release(
+    ResourcePoolClass<T>& pool,
+    typename ResourcePoolClass<T>::HandleType& handle) {
+  if (handle.IsValid() == false) return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  pool.Release(handle, frame_);
+  handle = {};
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <d3d11.h>
+
+#include "resource_pool_class.h"
+
+// 버퍼, 셰이더, input layout, 뷰를 종류마다 ResourcePoolClass 에 두고 32 bit
+// 핸들로 나눠 줍니다. 같은 내용으로 다시 만들면 기존 리소스를 공유하고,
+// 놓은 리소스는 GPU 가 그 프레임을 끝낼 때까지 해제를 미룹니다.
+// 만들기와 놓기는 여러 스레드에서 불러도 되고, Get 은 잠그지 않습니다.
+class ResourceManagerClass {
+ public:
+  // 종류마다 담을 수 있는 최대 리소스 수입니다
+  static const uint32_t POOL_CAPACITY = 4096;
+  // 놓은 리소스를 해제하기 전에 기다리는 프레임 수입니다. DXGI 가 CPU 를
+  // 앞서 보낼 수 있는 기본 최대 프레임 수와 같습니다
+  static const uint32_t FRAME_LATENCY = 3;
+  // 내용으로 찾는 버퍼의 최대 크기입니다. 내용을 해시하고 복사해 두는
+  // 비용이 이보다 큰 버퍼에서는 공유로 아끼는 것보다 큽니다
+  static const uint32_t MAX_SHARED_BUFFER_SIZE = 64 * 1024;
+
+  using BufferHandleType = ResourcePoolClass<ID3D11Buffer>::HandleType;
+  using VertexShaderHandleType =
+      ResourcePoolClass<ID3D11VertexShader>::HandleType;
+  using PixelShaderHandleType =
+      ResourcePoolClass<ID3D11PixelShader>::HandleType;
+  using InputLayoutHandleType =
+      ResourcePoolClass<ID3D11InputLayout>::HandleType;
+  using RenderTargetViewHandleType =
+      ResourcePoolClass<ID3D11RenderTargetView>::HandleType;
+  using DepthStencilViewHandleType =
+      ResourcePoolClass<ID3D11DepthStencilView>::HandleType;
+  using ShaderResourceViewHandleType =
+      ResourcePoolClass<ID3D11ShaderResourceView>::HandleType;
+
+  bool Initialize(ID3D11Device* device);
+  // GPU 가 모든 작업을 마친 뒤에 부릅니다
+  void Shutdown();
+
+  ID3D11Device* GetDevice();
+  // 프레임을 제출할 때마다 부릅니다. FRAME_LATENCY 프레임보다 전에 놓은
+  // 리소스를 해제합니다
+  void EndFrame();
+
+  // 초기 데이터가 있고 CPU 가 쓰지 않는 버퍼는 desc 와 내용이 같으면 기존
+  // 버퍼를 공유합니다. MAX_SHARED_BUFFER_SIZE 보다 큰 버퍼는 내용 대신
+  // 호출자가 준 key(0 이 아닌 값)와 desc 가 같을 때만 공유하므로, 같은
+  // key 는 같은 내용을 가리켜야 합니다. 동적 버퍼는 항상 새로 만듭니다
+  BufferHandleType CreateBuffer(const D3D11_BUFFER_DESC& desc,
+                                const D3D11_SUBRESOURCE_DATA* initial_data,
+                                const uint64_t key = 0);
+  // 셰이더와 input layout 은 bytecode(와 요소 선언)가 같으면 공유합니다
+  VertexShaderHandleType CreateVertexShader(const void* bytecode,
+                                            const size_t size);
+  PixelShaderHandleType CreatePixelShader(const void* bytecode,
+                                          const size_t size);
+  InputLayoutHandleType CreateInputLayout(
+      const D3D11_INPUT_ELEMENT_DESC* elements, const uint32_t count,
+      const void* bytecode, const size_t size);
+  // 이미 만든 뷰의 참조 하나를 넘겨받아 등록합니다
+  RenderTargetViewHandleType AddRenderTargetView(ID3D11RenderTargetView* view);
+  DepthStencilViewHandleType AddDepthStencilView(ID3D11DepthStencilView* view);
+  ShaderResourceViewHandleType AddShaderResourceView(
+      ID3D11ShaderResourceView* view);
+
+  // 해제됐거나 빈 핸들이면 nullptr 입니다
+  ID3D11Buffer* Get(const BufferHandleType handle);
+  ID3D11VertexShader* Get(const VertexShaderHandleType handle);
+  ID3D11PixelShader* Get(const PixelShaderHandleType handle);
+  ID3D11InputLayout* Get(const InputLayoutHandleType handle);
+  ID3D11RenderTargetView* Get(const RenderTargetViewHandleType handle);
+  ID3D11DepthStencilView* Get(const DepthStencilViewHandleType handle);
+  ID3D11ShaderResourceView* Get(const ShaderResourceViewHandleType handle);
+
+  // 참조를 놓고 handle 을 비웁니다
+  void Release(BufferHandleType& handle);
+  void Release(VertexShaderHandleType& handle);
+  void Release(PixelShaderHandleType& handle);
+  void Release(InputLayoutHandleType& handle);
+  void Release(RenderTargetViewHandleType& handle);
+  void Release(DepthStencilViewHandleType& handle);
+  void Release(ShaderResourceViewHandleType& handle);
+
+ private:
+  // 해시 키와 그 키를 계산한 바이트입니다. 키가 맞으면 바이트도 비교합니다
+  struct ContentsType {
+    uint64_t key_ = 0;
+    std::vector<uint8_t> bytes_;
+
+    void Append(const void* data, const size_t size);
+    template <typename V>
+    void AppendValue(const V& value) {
+      Append(&value, sizeof(value));
+    }
+  };
+
+  template <typename T>
+  typename ResourcePoolClass<T>::HandleType Find(ResourcePoolClass<T>& pool,
+                                                 const ContentsType& contents);
+  template <typename T>
+  typename ResourcePoolClass<T>::HandleType Add(ResourcePoolClass<T>& pool,
+                                                T* resource,
+                                                const ContentsType& contents);
+  template <typename T>
+  void Release(ResourcePoolClass<T>& pool,
+               typename ResourcePoolClass<T>::HandleType& handle);
+
+  ID3D11Device* device_ = nullptr;
+  std::mutex mutex_;
+  uint64_t frame_ = 0;
+
+  ResourcePoolClass<ID3D11Buffer> buffers_;
+  ResourcePoolClass<ID3D11VertexShader> vertex_shaders_;
+  ResourcePoolClass<ID3D11PixelShader> pixel_shaders_;
+  ResourcePoolClass<ID3D11InputLayout> input_layouts_;
+  ResourcePoolClass<ID3D11RenderTargetView> render_target_views_;
+  ResourcePoolClass<ID3D11DepthStencilView> depth_stencil_views_;
+  ResourcePoolClass<ID3D11ShaderResourceView> shader_resource_views_;
+};
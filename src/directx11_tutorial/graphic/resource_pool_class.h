@@ -0,0 +1,236 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+// GPU 리소스를 촘촘한 슬롯 배열에 두고 32 bit 세대 핸들로 가리키는
+// 풀입니다. 핸들은 아래 INDEX_BITS 가 슬롯 번호, 위가 슬롯의 세대이므로
+// 해제된 슬롯을 다시 써도 예전 핸들은 Get 에서 nullptr 이 됩니다.
+// key 를 주고 만든 리소스는 Find 로 다시 찾아 참조 수를 늘려 공유하고,
+// 마지막 참조를 놓으면 핸들은 바로 무효가 되지만 리소스는 Collect 가 그
+// 프레임을 지날 때까지 남겨 둡니다. key 가 내용의 해시라면 내용도 함께
+// 넘겨, 해시가 같아도 내용이 다르면 공유하지 않게 합니다.
+// T 는 Release() 를 가진 참조 계수 객체(COM 인터페이스)이면 되므로 D3D
+// 없이도 동작합니다. 슬롯 배열은 Initialize 에서 한 번에 잡고 Get 이 읽는
+// 리소스와 세대는 atomic 이므로, Get 은 다른 스레드가 Add 나 Release 를
+// 하는 동안에도 잠그지 않고 불러도 됩니다. 그 밖의 함수는 호출하는 쪽이
+// 잠급니다.
+template <typename T>
+class ResourcePoolClass {
+ public:
+  static const uint32_t INDEX_BITS = 20;
+  static const uint32_t MAX_CAPACITY = 1u << INDEX_BITS;
+
+  // value_ 가 0 이면 아무것도 가리키지 않습니다
+  struct HandleType {
+    uint32_t value_ = 0;
+
+    bool IsValid() const { return value_ != 0; }
+    bool operator==(const HandleType& other) const = default;
+  };
+
+  bool Initialize(const uint32_t capacity);
+  // 남은 리소스와 해제를 기다리는 리소스를 모두 해제합니다. GPU 가 모든
+  // 작업을 마친 뒤에 부릅니다
+  void Shutdown();
+
+  // resource 의 참조 하나를 넘겨받아 슬롯에 넣습니다. key 가 0 이 아니면
+  // Find 로 다시 찾을 수 있고, contents 의 size 바이트를 복사해 두었다가
+  // Find 에서 비교합니다. 같은 key 의 리소스가 이미 살아 있으면(해시
+  // 충돌) Find 로 찾을 수 없게 넣습니다. 슬롯이 모자라면 resource 를
+  // 해제하고 빈 핸들을 반환합니다
+  HandleType Add(T* resource, const uint64_t key = 0,
+                 const void* contents = nullptr, const size_t size = 0);
+  // key 로 넣은 리소스가 살아 있고 넣을 때의 내용이 contents 와 같으면
+  // 참조 수를 늘리고 그 핸들을, 아니면 빈 핸들을 반환합니다
+  HandleType Find(const uint64_t key, const void* contents = nullptr,
+                  const size_t size = 0);
+  // 핸들이 가리키는 리소스입니다. 해제됐거나 빈 핸들이면 nullptr 입니다
+  T* Get(const HandleType handle) const;
+  // 참조 수를 줄이고, 0 이 되면 리소스를 frame 에 놓은 것으로 미뤄 둡니다
+  void Release(const HandleType handle, const uint64_t frame);
+  // completed_frame 까지 놓은 리소스를 실제로 해제합니다
+  void Collect(const uint64_t completed_frame);
+
+  uint32_t GetLiveCount() const { return live_count_; }
+  uint32_t GetPendingCount() const {
+    return static_cast<uint32_t>(retired_.size());
+  }
+
+ private:
+  static const uint32_t INDEX_MASK = MAX_CAPACITY - 1;
+  static const uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+  static const uint32_t NO_SLOT = 0xffffffff;
+
+  // Get 이 잠그지 않고 읽는 리소스와 세대만 atomic 입니다
+  struct SlotType {
+    std::atomic<T*> resource_{nullptr};
+    // 0 은 빈 핸들과 구분하기 위해 쓰지 않습니다
+    std::atomic<uint32_t> generation_{1};
+    // keys_ 에 이 슬롯으로 등록한 key 입니다. 등록하지 않았으면 0 입니다
+    uint64_t key_ = 0;
+    std::vector<uint8_t> contents_;
+    uint32_t reference_count_ = 0;
+    uint32_t next_free_ = NO_SLOT;
+  };
+
+  struct RetiredType {
+    T* resource_;
+    uint64_t frame_;
+  };
+
+  // 핸들이 살아 있는 슬롯을 가리키면 그 슬롯 번호를, 아니면 NO_SLOT 을
+  // 반환합니다
+  uint32_t FindSlot(const HandleType handle) const;
+
+  std::vector<SlotType> slots_;
+  // 한 번도 쓰지 않은 첫 슬롯과 해제된 슬롯 목록의 머리입니다
+  uint32_t used_count_ = 0;
+  uint32_t free_head_ = NO_SLOT;
+  uint32_t live_count_ = 0;
+  std::unordered_map<uint64_t, uint32_t> keys_;
+  std::vector<RetiredType> retired_;
+};
+
+template <typename T>
+bool ResourcePoolClass<T>::Initialize(const uint32_t capacity) {
+  if (capacity == 0 || capacity > MAX_CAPACITY) return false;
+
+  slots_ = std::vector<SlotType>(capacity);
+  used_count_ = 0;
+  free_head_ = NO_SLOT;
+  live_count_ = 0;
+  return true;
+}
+
+template <typename T>
+void ResourcePoolClass<T>::Shutdown() {
+  for (uint32_t index = 0; index < used_count_; index++) {
+    T* resource = slots_[index].resource_.load(std::memory_order_relaxed);
+    if (resource) resource->Release();
+  }
+  slots_.clear();
+  used_count_ = 0;
+  free_head_ = NO_SLOT;
+  live_count_ = 0;
+  keys_.clear();
+
+  Collect(UINT64_MAX);
+}
+
+template <typename T>
+typename ResourcePoolClass<T>::HandleType ResourcePoolClass<T>::Add(
+    T* resource, const uint64_t key, const void* contents, const size_t size) {
+  if (resource == nullptr) return {};
+
+  // 해제된 슬롯을 먼저 다시 쓰고, 없으면 새 슬롯을 씁니다
+  uint32_t index = free_head_;
+  if (index != NO_SLOT) {
+    free_head_ = slots_[index].next_free_;
+  } else if (used_count_ < slots_.size()) {
+    index = used_count_++;
+  } else {
+    resource->Release();
+    return {};
+  }
+
+  SlotType& slot = slots_[index];
+  slot.key_ = 0;
+  if (key != 0 && keys_.try_emplace(key, index).second) {
+    slot.key_ = key;
+    const uint8_t* bytes = static_cast<const uint8_t*>(contents);
+    slot.contents_.assign(bytes, bytes + size);
+  }
+  slot.reference_count_ = 1;
+  slot.next_free_ = NO_SLOT;
+  slot.resource_.store(resource, std::memory_order_release);
+  live_count_++;
+
+  return {slot.generation_.load(std::memory_order_relaxed) << INDEX_BITS |
+          index};
+}
+
+template <typename T>
+typename ResourcePoolClass<T>::HandleType ResourcePoolClass<T>::Find(
+    const uint64_t key, const void* contents, const size_t size) {
+  const auto found = keys_.find(key);
+  if (key == 0 || found == keys_.end()) return {};
+
+  // key 가 같아도 내용이 다르면 다른 리소스입니다
+  SlotType& slot = slots_[found->second];
+  if (slot.contents_.size() != size ||
+      (size > 0 && std::memcmp(slot.contents_.data(), contents, size) != 0))
+    return {};
+
+  slot.reference_count_++;
+  return {slot.generation_.load(std::memory_order_relaxed) << INDEX_BITS |
+          found->second};
+}
+
+template <typename T>
+T* ResourcePoolClass<T>::Get(const HandleType handle) const {
+  const uint32_t index = FindSlot(handle);
+  if (index == NO_SLOT) return nullptr;
+
+  // 읽는 사이에 슬롯이 놓이고 다시 쓰였다면 세대가 바뀌어 있습니다.
+  // 다시 쓴 Add 의 리소스를 읽었다면 그 전에 올린 세대도 보입니다
+  const SlotType& slot = slots_[index];
+  T* resource = slot.resource_.load(std::memory_order_acquire);
+  if (slot.generation_.load(std::memory_order_relaxed) !=
+      handle.value_ >> INDEX_BITS)
+    return nullptr;
+  return resource;
+}
+
+template <typename T>
+void ResourcePoolClass<T>::Release(const HandleType handle,
+                                   const uint64_t frame) {
+  const uint32_t index = FindSlot(handle);
+  if (index == NO_SLOT) return;
+
+  SlotType& slot = slots_[index];
+  if (--slot.reference_count_ > 0) return;
+
+  // GPU 가 아직 읽고 있을 수 있으므로 리소스는 미뤄 두고, 슬롯은 세대를
+  // 올려 바로 다시 씁니다
+  retired_.push_back({slot.resource_.load(std::memory_order_relaxed), frame});
+  if (slot.key_ != 0) keys_.erase(slot.key_);
+  slot.key_ = 0;
+  std::vector<uint8_t>().swap(slot.contents_);
+
+  uint32_t generation =
+      (slot.generation_.load(std::memory_order_relaxed) & GENERATION_MASK) + 1;
+  if (generation > GENERATION_MASK) generation = 1;
+  slot.generation_.store(generation, std::memory_order_release);
+  slot.resource_.store(nullptr, std::memory_order_release);
+  slot.next_free_ = free_head_;
+  free_head_ = index;
+  live_count_--;
+}
+
+template <typename T>
+void ResourcePoolClass<T>::Collect(const uint64_t completed_frame) {
+  // 놓은 순서대로 쌓이므로 앞에서부터 completed_frame 을 넘지 않는 것만
+  // 해제합니다
+  size_t count = 0;
+  while (count < retired_.size() && retired_[count].frame_ <= completed_frame)
+    retired_[count++].resource_->Release();
+  retired_.erase(retired_.begin(), retired_.begin() + count);
+}
+
+template <typename T>
+uint32_t ResourcePoolClass<T>::FindSlot(const HandleType handle) const {
+  const uint32_t index = handle.value_ & INDEX_MASK;
+  // used_count_ 대신 고정된 배열 크기와 비교해야 Add 와 동시에 불러도
+  // 됩니다. 한 번도 쓰지 않은 슬롯은 리소스가 없습니다
+  if (handle.IsValid() == false || index >= slots_.size()) return NO_SLOT;
+
+  const SlotType& slot = slots_[index];
+  if (slot.generation_.load(std::memory_order_acquire) !=
+          handle.value_ >> INDEX_BITS ||
+      slot.resource_.load(std::memory_order_relaxed) == nullptr)
+    return NO_SLOT;
+  return index;
+}
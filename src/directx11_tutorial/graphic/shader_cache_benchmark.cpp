@@ -0,0 +1,78 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "framework/benchmark_class.h"
+#include "framework/job_system_class.h"
+#include "graphic/shader_cache_class.h"
+
+void RegisterShaderCacheBenchmarks(BenchmarkClass& benchmark) {
+  // 64 개 셰이더를 캐시 없이 모두 컴파일하거나(cold) 캐시에서 매핑하기(warm).
+  // 어디서나 돌도록 1ms 걸리는 가짜 컴파일러를 씁니다
+  for (const bool warm : {false, true}) {
+    const uint32_t shader_count = 64;
+    const std::string name = "ShaderCacheClass::Load/" +
+                             std::to_string(shader_count) +
+                             (warm ? "/warm" : "/cold");
+
+    benchmark.AddFixture(name, shader_count, [warm, shader_count] {
+      struct DataType {
+        std::filesystem::path directory_;
+        std::vector<ShaderCacheClass::ShaderDescType> shaders_;
+        JobSystemClass job_system_;
+        ~DataType() { job_system_.Shutdown(); }
+      };
+      auto data = std::make_shared<DataType>();
+      data->job_system_.Initialize();
+      data->directory_ =
+          std::filesystem::temp_directory_path() / "benchmark_shader";
+      std::filesystem::create_directories(data->directory_);
+
+      std::ofstream(data->directory_ / "common.hlsli", std::ios::trunc)
+          << "cbuffer MatrixBuffer { matrix world; };\n";
+      for (uint32_t i = 0; i < shader_count; i++) {
+        ShaderCacheClass::ShaderDescType shader{};
+        shader.path_ =
+            data->directory_ / ("shader" + std::to_string(i) + ".hlsl");
+        shader.entry_point_ = "main";
+        shader.profile_ = "vs_5_0";
+        std::ofstream(shader.path_, std::ios::trunc)
+            << "#include \"common.hlsli\"\nfloat4 main() : SV_POSITION "
+            << "{ return world[" << i % 4 << "]; }\n";
+        data->shaders_.push_back(shader);
+      }
+
+      return BenchmarkClass::BodyType([data, warm](uint64_t iterations) {
+        const auto compiler = [](const ShaderCacheClass::ShaderDescType& desc,
+                                 std::vector<uint8_t>& bytecode,
+                                 std::string& /*error*/) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          const std::string path = desc.path_.string();
+          bytecode.assign(path.begin(), path.end());
+          return true;
+        };
+
+        const std::filesystem::path cache_directory =
+            data->directory_ / "cache";
+        for (uint64_t i = 0; i < iterations; i++) {
+          if (warm == false) std::filesystem::remove_all(cache_directory);
+
+          ShaderCacheClass cache{};
+          cache.Initialize(cache_directory, compiler);
+          BenchmarkClass::DoNotOptimize(
+              cache.Load(data->shaders_.data(),
+                         static_cast<uint32_t>(data->shaders_.size()),
+                         &data->job_system_));
+          cache.Shutdown();
+        }
+      });
+    });
+  }
+}
@@ -0,0 +1,297 @@
+#include "pch.h"
+#include "shader_cache_class.h"
+
+#if defined(_WIN32)
+#include <d3dcompiler.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <thread>
+
+#include "framework/profiler.h"
+#include "framework/job_system_class.h"
+
+static_assert(sizeof(ShaderCacheClass::HeaderType) == 24,
+              "shader cache header layout changed");
+
+namespace {
+// 64 비트 FNV-1a 입니다
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+const uint64_t FNV_PRIME = 1099511628211ull;
+
+void HashBytes(uint64_t& hash, const void* data, const size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+}
+
+// 길이를 먼저 섞어 "ab" + "c" 와 "a" + "bc" 가 다른 키가 되게 합니다
+void HashString(uint64_t& hash, const std::string& value) {
+  const uint64_t size = value.size();
+  HashBytes(hash, &size, sizeof(size));
+  HashBytes(hash, value.data(), value.size());
+}
+
+bool ReadFile(const std::filesystem::path& path, std::string& contents) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) return false;
+
+  contents.assign(std::istreambuf_iterator<char>(file),
+                  std::istreambuf_iterator<char>());
+  return true;
+}
+
+// source 의 #include 를 따라가며 include 된 파일의 이름과 내용을 섞습니다.
+// 찾지 못한 파일은 컴파일러가 오류를 내도록 이름만 섞습니다
+void HashIncludes(uint64_t& hash, const std::filesystem::path& directory,
+                  const std::string& source,
+                  std::vector<std::filesystem::path>& visited) {
+  size_t position = 0;
+  while ((position = source.find("#include", position)) !=
+         std::string::npos) {
+    position += sizeof("#include") - 1;
+
+    const size_t open = source.find_first_of("\"<\n", position);
+    if (open == std::string::npos || source[open] == '\n') continue;
+    const size_t end =
+        source.find_first_of(source[open] == '"' ? "\"\n" : ">\n", open + 1);
+    if (end == std::string::npos || source[end] == '\n') continue;
+    position = end + 1;
+
+    const std::string name = source.substr(open + 1, end - open - 1);
+    HashString(hash, name);
+
+    const std::filesystem::path path = (directory / name).lexically_normal();
+    if (std::find(visited.begin(), visited.end(), path) != visited.end())
+      continue;
+    visited.push_back(path);
+
+    std::string contents;
+    if (ReadFile(path, contents) == false) continue;
+    HashString(hash, contents);
+    HashIncludes(hash, path.parent_path(), contents, visited);
+  }
+}
+}  // namespace
+
+#if defined(_WIN32)
+bool ShaderCacheClass::CompileD3D(const ShaderDescType& desc,
+                                  std::vector<uint8_t>& bytecode,
+                                  std::string& error) {
+  std::vector<D3D_SHADER_MACRO> macros;
+  for (const DefineType& define : desc.defines_)
+    macros.push_back({define.name_.c_str(), define.value_.c_str()});
+  macros.push_back({nullptr, nullptr});
+
+  ID3DBlob* code = nullptr;
+  ID3DBlob* error_message = nullptr;
+  const HRESULT result = D3DCompileFromFile(
+      desc.path_.c_str(), macros.data(), D3D_COMPILE_STANDARD_FILE_INCLUDE,
+      desc.entry_point_.c_str(), desc.profile_.c_str(), desc.flags_, 0, &code,
+      &error_message);
+
+  // 컴파일러 메시지는 ANSI 문자열입니다
+  if (error_message) {
+    error.assign(static_cast<const char*>(error_message->GetBufferPointer()),
+                 error_message->GetBufferSize());
+    error_message->Release();
+  }
+
+  if (FAILED(result)) {
+    if (error.empty()) error = "Missing shader file " + desc.path_.string();
+    if (code) code->Release();
+    return false;
+  }
+
+  const uint8_t* data = static_cast<const uint8_t*>(code->GetBufferPointer());
+  bytecode.assign(data, data + code->GetBufferSize());
+  code->Release();
+  return true;
+}
+#endif
+
+bool ShaderCacheClass::Initialize(const std::filesystem::path& directory,
+                                  const CompilerType& compiler,
+                                  const uint64_t compiler_version) {
+  directory_ = directory;
+  compiler_ = compiler;
+  compiler_version_ = compiler_version;
+
+  // 디렉터리를 만들지 못해도 컴파일은 되므로 캐시 없이 동작합니다
+  std::error_code error;
+  std::filesystem::create_directories(directory_, error);
+  return true;
+}
+
+void ShaderCacheClass::Shutdown() {
+  entries_.clear();
+  hit_count_ = 0;
+  miss_count_ = 0;
+}
+
+bool ShaderCacheClass::Load(const ShaderDescType* descs, const uint32_t count,
+                            JobSystemClass* job_system) {
+  PROFILE_FUNCTION();
+
+  entries_.clear();
+  hit_count_ = 0;
+
+  // 키를 계산해 캐시 파일을 먼저 매핑하고, 없는 셰이더만 모읍니다
+  std::vector<uint32_t> misses;
+  for (uint32_t i = 0; i < count; i++) {
+    entries_.push_back(std::make_unique<EntryType>());
+    EntryType& entry = *entries_.back();
+
+    if (ComputeKey(descs[i], entry.key_) == false) {
+      entry.error_ = "Missing shader file " + descs[i].path_.string();
+    } else if (OpenCacheFile(entry)) {
+      hit_count_++;
+    } else {
+      misses.push_back(i);
+    }
+  }
+  miss_count_ = static_cast<uint32_t>(misses.size());
+
+  // 캐시에 없는 셰이더는 모두 함께 컴파일합니다
+  auto compile = [this, descs, &misses](uint32_t miss) {
+    EntryType& entry = *entries_[misses[miss]];
+    if (!compiler_) {
+      entry.error_ = "No shader compiler";
+      return;
+    }
+    if (compiler_(descs[misses[miss]], entry.bytecode_, entry.error_) == false)
+      return;
+
+    entry.data_ = entry.bytecode_.data();
+    entry.size_ = entry.bytecode_.size();
+
+    // 캐시를 쓰지 못해도 이번 실행은 메모리의 bytecode 로 계속합니다
+    WriteCacheFile(entry);
+  };
+
+  if (job_system) {
+    job_system->ParallelFor(miss_count_, compile);
+  } else {
+    for (uint32_t miss = 0; miss < miss_count_; miss++) compile(miss);
+  }
+
+  for (const std::unique_ptr<EntryType>& entry : entries_)
+    if (entry->data_ == nullptr) return false;
+  return true;
+}
+
+const void* ShaderCacheClass::GetBytecode(const uint32_t index) {
+  return entries_[index]->data_;
+}
+
+size_t ShaderCacheClass::GetBytecodeSize(const uint32_t index) {
+  return entries_[index]->size_;
+}
+
+const std::string& ShaderCacheClass::GetError(const uint32_t index) {
+  return entries_[index]->error_;
+}
+
+uint32_t ShaderCacheClass::GetHitCount() { return hit_count_; }
+
+uint32_t ShaderCacheClass::GetMissCount() { return miss_count_; }
+
+bool ShaderCacheClass::ComputeKey(const ShaderDescType& desc, uint64_t& key) {
+  std::string source;
+  if (ReadFile(desc.path_, source) == false) return false;
+
+  uint64_t hash = FNV_OFFSET_BASIS;
+  const uint32_t version = VERSION;
+  HashBytes(hash, &version, sizeof(version));
+  HashBytes(hash, &compiler_version_, sizeof(compiler_version_));
+
+  HashString(hash, desc.path_.generic_string());
+  HashString(hash, source);
+  std::vector<std::filesystem::path> visited{desc.path_.lexically_normal()};
+  HashIncludes(hash, desc.path_.parent_path(), source, visited);
+
+  for (const DefineType& define : desc.defines_) {
+    HashString(hash, define.name_);
+    HashString(hash, define.value_);
+  }
+  HashString(hash, desc.entry_point_);
+  HashString(hash, desc.profile_);
+  HashBytes(hash, &desc.flags_, sizeof(desc.flags_));
+
+  key = hash;
+  return true;
+}
+
+std::filesystem::path ShaderCacheClass::GetCachePath(const uint64_t key) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.cso",
+                static_cast<unsigned long long>(key));
+  return directory_ / name;
+}
+
+bool ShaderCacheClass::OpenCacheFile(EntryType& entry) {
+  if (entry.file_.Open(GetCachePath(entry.key_)) == false) return false;
+
+  // 크기, 키가 맞지 않는 파일은 없는 것으로 보고 다시 컴파일합니다
+  HeaderType header{};
+  if (entry.file_.GetSize() < sizeof(HeaderType)) {
+    entry.file_.Close();
+    return false;
+  }
+  std::memcpy(&header, entry.file_.GetData(), sizeof(HeaderType));
+
+  if (header.magic_ != MAGIC || header.version_ != VERSION ||
+      header.key_ != entry.key_ || header.size_ == 0 ||
+      header.size_ != entry.file_.GetSize() - sizeof(HeaderType)) {
+    entry.file_.Close();
+    return false;
+  }
+
+  entry.data_ = entry.file_.GetData() + sizeof(HeaderType);
+  entry.size_ = static_cast<size_t>(header.size_);
+  return true;
+}
+
+bool ShaderCacheClass::WriteCacheFile(const EntryType& entry) {
+  const std::filesystem::path path = GetCachePath(entry.key_);
+  std::filesystem::path temporary_path = path;
+  temporary_path += "." +
+                    std::to_string(std::hash<std::thread::id>{}(
+                        std::this_thread::get_id())) +
+                    ".tmp";
+
+  HeaderType header{};
+  header.magic_ = MAGIC;
+  header.version_ = VERSION;
+  header.key_ = entry.key_;
+  header.size_ = entry.size_;
+
+  {
+    std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entry.data_),
+               static_cast<std::streamsize>(entry.size_));
+    if (!file.good()) {
+      file.close();
+      std::error_code error;
+      std::filesystem::remove(temporary_path, error);
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporary_path, path, error);
+  if (error) {
+    std::filesystem::remove(temporary_path, error);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "framework/mapped_file_class.h"
+
+class JobSystemClass;
+
+// 컴파일한 셰이더 bytecode 를 디스크에 보관합니다. 키는 소스와 소스가
+// include 하는 모든 파일의 내용, define, 진입점, 프로파일, 플래그, 컴파일러
+// 버전의 64 비트 해시이며 "<키>.cso" 파일 하나에 bytecode 하나를 담습니다.
+// 캐시에 있으면 파일을 매핑해 복사 없이 넘겨주고, 없는 셰이더만 작업
+// 시스템에서 함께 컴파일합니다. 컴파일러는 함수로 받으므로 D3DCompiler 가
+// 없는 곳에서는 다른 컴파일러로 바꿔 쓸 수 있습니다.
+class ShaderCacheClass {
+ public:
+  static const uint32_t MAGIC = 0x48534353;  // "SCSH"
+  static const uint32_t VERSION = 1;
+
+  struct DefineType {
+    std::string name_;
+    std::string value_;
+  };
+
+  struct ShaderDescType {
+    std::filesystem::path path_;
+    std::string entry_point_;
+    std::string profile_;
+    std::vector<DefineType> defines_;
+    uint32_t flags_ = 0;
+  };
+
+  // 성공하면 bytecode 를 채우고 true, 실패하면 error 에 메시지를 남깁니다.
+  // 여러 스레드에서 동시에 불릴 수 있습니다
+  using CompilerType = std::function<bool(const ShaderDescType& desc,
+                                          std::vector<uint8_t>& bytecode,
+                                          std::string& error)>;
+
+  // 캐시 파일의 헤더입니다. 바로 뒤에 bytecode 가 이어집니다
+  struct HeaderType {
+    uint32_t magic_;
+    uint32_t version_;
+    uint64_t key_;
+    uint64_t size_;
+  };
+
+#if defined(_WIN32)
+  // D3DCompileFromFile 로 컴파일하는 기본 컴파일러입니다
+  static bool CompileD3D(const ShaderDescType& desc,
+                         std::vector<uint8_t>& bytecode, std::string& error);
+#endif
+
+  // compiler_version 은 키에 섞어 컴파일러가 바뀌면 캐시를 무효로 만듭니다
+  bool Initialize(const std::filesystem::path& directory,
+                  const CompilerType& compiler,
+                  const uint64_t compiler_version = 0);
+  void Shutdown();
+
+  // descs 의 셰이더를 모두 준비합니다. 캐시에 없는 셰이더는 job_system 으로
+  // 함께 컴파일해 캐시에 씁니다. 하나라도 실패하면 false 를 반환합니다.
+  // 결과는 descs 순서대로 이전 Load 결과를 대신합니다
+  bool Load(const ShaderDescType* descs, const uint32_t count,
+            JobSystemClass* job_system = nullptr);
+
+  // Load 한 index 번째 셰이더입니다. 다음 Load 나 Shutdown 전까지 유효합니다
+  const void* GetBytecode(const uint32_t index);
+  size_t GetBytecodeSize(const uint32_t index);
+  const std::string& GetError(const uint32_t index);
+
+  // 마지막 Load 에서 캐시를 읽은 수와 새로 컴파일한 수입니다
+  uint32_t GetHitCount();
+  uint32_t GetMissCount();
+
+  // 소스와 include 파일을 읽어 키를 계산합니다. 소스를 읽지 못하면 false
+  bool ComputeKey(const ShaderDescType& desc, uint64_t& key);
+  std::filesystem::path GetCachePath(const uint64_t key);
+
+ private:
+  struct EntryType {
+    MappedFileClass file_;
+    std::vector<uint8_t> bytecode_;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    uint64_t key_ = 0;
+    std::string error_;
+  };
+
+  // 매핑한 캐시 파일의 헤더를 검증하고 bytecode 를 가리킵니다
+  bool OpenCacheFile(EntryType& entry);
+  // 임시 파일에 쓴 뒤 이름을 바꿔 다른 프로세스가 반쯤 쓴 파일을 읽지
+  // 않게 합니다
+  bool WriteCacheFile(const EntryType& entry);
+
+  std::filesystem::path directory_;
+  CompilerType compiler_;
+  uint64_t compiler_version_ = 0;
+  std::vector<std::unique_ptr<EntryType>> entries_;
+  uint32_t hit_count_ = 0;
+  uint32_t miss_count_ = 0;
+};
@@ -0,0 +1,20 @@
+#include "pch.h"
+#include "shader_constants.h"
+
+namespace shader_constants {
+void FillMatrixBuffer(MatrixBufferType* data, const DirectX::XMMATRIX& world,
+                      const DirectX::XMMATRIX& view,
+                      const DirectX::XMMATRIX& projection) {
+  // 행렬을 transpose 하여 셰이더에서 사용할 수 있게 합니다
+  data->world_ = DirectX::XMMatrixTranspose(world);
+  data->view_ = DirectX::XMMatrixTranspose(view);
+  data->projection_ = DirectX::XMMatrixTranspose(projection);
+}
+
+void FillWvpBuffer(WvpBufferType* data, const DirectX::XMMATRIX& world,
+                   const DirectX::XMMATRIX& view_projection) {
+  // 월드 행렬에 프레임당 한 번 계산한 뷰-투영 행렬을 곱하고 transpose 합니다
+  data->world_view_projection_ = DirectX::XMMatrixTranspose(
+      DirectX::XMMatrixMultiply(world, view_projection));
+}
+}  // namespace shader_constants
@@ -0,0 +1,27 @@
+#pragma once
+#include <DirectXMath.h>
+
+// 색상 셰이더의 상수 버퍼 배치와 그것을 채우는 함수입니다. DirectXMath 만
+// 쓰므로 D3D 없는 빌드에서도 벤치마크할 수 있습니다
+namespace shader_constants {
+// vertex.hlsl 의 상수 버퍼입니다
+struct MatrixBufferType {
+  DirectX::XMMATRIX world_;
+  DirectX::XMMATRIX view_;
+  DirectX::XMMATRIX projection_;
+};
+
+// vertex_wvp.hlsl 의 상수 버퍼입니다. 미리 곱한 행렬 하나만 올립니다
+struct WvpBufferType {
+  DirectX::XMMATRIX world_view_projection_;
+};
+
+// 행렬을 transpose 하여 상수 버퍼 메모리에 채웁니다
+void FillMatrixBuffer(MatrixBufferType* data, const DirectX::XMMATRIX& world,
+                      const DirectX::XMMATRIX& view,
+                      const DirectX::XMMATRIX& projection);
+
+// world * view_projection 을 transpose 하여 상수 버퍼 메모리에 채웁니다
+void FillWvpBuffer(WvpBufferType* data, const DirectX::XMMATRIX& world,
+                   const DirectX::XMMATRIX& view_projection);
+}  // namespace shader_constants
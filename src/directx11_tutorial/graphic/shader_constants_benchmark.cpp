@@ -0,0 +1,42 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <DirectXMath.h>
+
+#include "framework/benchmark_class.h"
+#include "graphic/shader_constants.h"
+
+void RegisterShaderConstantsBenchmarks(BenchmarkClass& benchmark) {
+  // ColorShaderClass::SetShaderParameters 의 transpose 3번과 상수 버퍼 채우기
+  benchmark.Add("shader_constants::FillMatrixBuffer", 1,
+                [](uint64_t iterations) {
+                  shader_constants::MatrixBufferType buffer{};
+                  DirectX::XMMATRIX world = DirectX::XMMatrixIdentity();
+                  DirectX::XMMATRIX view =
+                      DirectX::XMMatrixTranslation(0.0f, 0.0f, 5.0f);
+                  DirectX::XMMATRIX projection =
+                      DirectX::XMMatrixPerspectiveFovLH(
+                          DirectX::XM_PI / 4.0f, 4.0f / 3.0f, 0.1f, 1000.0f);
+
+                  for (uint64_t i = 0; i < iterations; i++) {
+                    shader_constants::FillMatrixBuffer(&buffer, world, view,
+                                                       projection);
+                    BenchmarkClass::DoNotOptimize(buffer);
+                  }
+                });
+
+  // 미리 곱한 월드-뷰-투영 행렬 하나만 채우기
+  benchmark.Add("shader_constants::FillWvpBuffer", 1, [](uint64_t iterations) {
+    shader_constants::WvpBufferType buffer{};
+    DirectX::XMMATRIX world = DirectX::XMMatrixIdentity();
+    DirectX::XMMATRIX view_projection = DirectX::XMMatrixMultiply(
+        DirectX::XMMatrixTranslation(0.0f, 0.0f, 5.0f),
+        DirectX::XMMatrixPerspectiveFovLH(DirectX::XM_PI / 4.0f, 4.0f / 3.0f,
+                                          0.1f, 1000.0f));
+
+    for (uint64_t i = 0; i < iterations; i++) {
+      shader_constants::FillWvpBuffer(&buffer, world, view_projection);
+      BenchmarkClass::DoNotOptimize(buffer);
+    }
+  });
+}
@@ -0,0 +1,596 @@
+#include "pch.h"
+#include "soft_rasterizer_class.h"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "framework/profiler.h"
+#include "framework/job_system_class.h"
+
+namespace {
+uint32_t PackColor(float red, float green, float blue, float alpha) {
+  auto to_byte = [](float value) {
+    value = (std::min)((std::max)(value, 0.0f), 1.0f);
+    return static_cast<uint32_t>(value * 255.0f + 0.5f);
+  };
+
+  return to_byte(red) | (to_byte(green) << 8) | (to_byte(blue) << 16) |
+         (to_byte(alpha) << 24);
+}
+
+__m128i PackColor(__m128 red, __m128 green, __m128 blue, __m128 alpha) {
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 scale = _mm_set1_ps(255.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+
+  auto to_byte = [&](__m128 value) {
+    value = _mm_min_ps(_mm_max_ps(value, zero), one);
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale), half));
+  };
+
+  __m128i packed = to_byte(red);
+  packed = _mm_or_si128(packed, _mm_slli_epi32(to_byte(green), 8));
+  packed = _mm_or_si128(packed, _mm_slli_epi32(to_byte(blue), 16));
+  packed = _mm_or_si128(packed, _mm_slli_epi32(to_byte(alpha), 24));
+  return packed;
+}
+}  // namespace
+
+bool SoftRasterizerClass::Initialize(const int32_t width, const int32_t height,
+                                     float screen_depth, float screen_near,
+                                     JobSystemClass* job_system) {
+  // 버퍼를 잡기 전에 인자를 확인합니다. 작업 시스템은 타일과 정점을 모든
+  // 코어에서 나눠 처리합니다
+  if (job_system == nullptr || width <= 0 || height <= 0) return false;
+  job_system_ = job_system;
+
+  width_ = width;
+  height_ = height;
+
+  // SIMD 로 4픽셀씩 처리하므로 한 줄의 크기를 4의 배수로 맞춥니다
+  pitch_ = (width + 3) & ~3;
+
+  color_buffer_.assign(static_cast<size_t>(pitch_) * height_, 0);
+  depth_buffer_.assign(static_cast<size_t>(pitch_) * height_, 1.0f);
+
+  // 화면을 타일로 나누고 타일마다 삼각형 목록(bin)을 만듭니다
+  tile_count_x_ = (width_ + TILE_SIZE - 1) / TILE_SIZE;
+  tile_count_y_ = (height_ + TILE_SIZE - 1) / TILE_SIZE;
+  bins_.resize(static_cast<size_t>(tile_count_x_) * tile_count_y_);
+
+  // D3DClass 와 같은 투영 행렬을 설정합니다
+  float field_of_view = DirectX::XM_PI / 4.0f;
+  float screen_aspect = static_cast<float>(width) / static_cast<float>(height);
+
+  projection_matrix_ = DirectX::XMMatrixPerspectiveFovLH(
+      field_of_view, screen_aspect, screen_near, screen_depth);
+
+  world_matrix_ = DirectX::XMMatrixIdentity();
+
+  ortho_matrix_ = DirectX::XMMatrixOrthographicLH(static_cast<float>(width),
+                                                  static_cast<float>(height),
+                                                  screen_near, screen_depth);
+
+  return true;
+}
+
+void SoftRasterizerClass::Shutdown() {
+  // 작업 시스템은 빌려 쓰므로 해제하지 않습니다
+  job_system_ = nullptr;
+
+  color_buffer_.clear();
+  depth_buffer_.clear();
+  triangles_.clear();
+  bins_.clear();
+  used_vertices_.clear();
+  local_indices_.clear();
+  vertex_slots_.clear();
+  instance_matrices_.clear();
+}
+
+void SoftRasterizerClass::BeginScene(float red, float green, float blue,
+                                     float alpha) {
+  // 실제 지우기는 EndScene 에서 타일별로 래스터화 직전에 수행합니다
+  clear_color_ = PackColor(red, green, blue, alpha);
+
+  triangles_.clear();
+  for (std::vector<uint32_t>& bin : bins_) bin.clear();
+}
+
+void SoftRasterizerClass::EndScene() {
+  PROFILE_FUNCTION();
+
+  // 모든 타일을 병렬로 지우고 래스터화합니다. 이것이 Present 에 해당합니다
+  job_system_->ParallelFor(
+      static_cast<uint32_t>(bins_.size()),
+      [this](uint32_t tile_index) { RasterizeTile(tile_index); });
+}
+
+void SoftRasterizerClass::DrawIndexed(const ModelClass::VertexType* vertices,
+                                      const int32_t vertex_count,
+                                      const uint32_t* indices,
+                                      const int32_t index_count,
+                                      DirectX::XMMATRIX world,
+                                      DirectX::XMMATRIX view,
+                                      DirectX::XMMATRIX projection) {
+  PROFILE_FUNCTION();
+
+  MatrixBufferType matrices{world, view, projection};
+
+  // 모든 정점에 정점 커널을 한 번씩 실행합니다
+  RunVertexKernel(vertex_count, [&](int32_t i) {
+    transformed_[i] = ColorVertexKernel(vertices[i], matrices);
+  });
+
+  AssembleTriangles(transformed_.data(), vertex_count, indices, index_count);
+}
+
+void SoftRasterizerClass::DrawIndexed(
+    const ModelClass::VertexType* vertices, const int32_t vertex_count,
+    const uint32_t* indices, const int32_t index_count,
+    const DirectX::XMMATRIX& world_view_projection) {
+  PROFILE_FUNCTION();
+
+  // 모든 정점에 월드-뷰-투영 정점 커널을 한 번씩 실행합니다
+  RunVertexKernel(vertex_count, [&](int32_t i) {
+    transformed_[i] = ColorVertexWvpKernel(vertices[i], world_view_projection);
+  });
+
+  AssembleTriangles(transformed_.data(), vertex_count, indices, index_count);
+}
+
+void SoftRasterizerClass::DrawIndexedInstanced(
+    const ModelClass::VertexType* vertices, const int32_t vertex_count,
+    const uint32_t* indices, const int32_t index_count,
+    const ModelClass::InstanceType* instances, const int32_t instance_count,
+    const DirectX::XMMATRIX& view_projection) {
+  PROFILE_FUNCTION();
+
+  if (instance_count <= 0 || index_count <= 0 || vertex_count <= 0) return;
+
+  // 인덱스가 가리키는 정점만 모으고 인덱스를 그 목록 안의 위치로 바꿉니다.
+  // LOD 는 정점 버퍼의 일부만 쓰므로 버퍼 전체를 변환하지 않습니다. 범위를
+  // 벗어난 인덱스가 있는 삼각형은 버립니다
+  if (vertex_slots_.size() < static_cast<size_t>(vertex_count))
+    vertex_slots_.resize(vertex_count, NO_SLOT);
+  used_vertices_.clear();
+  local_indices_.clear();
+  const uint32_t vertex_limit = static_cast<uint32_t>(vertex_count);
+  for (int32_t i = 0; i + 2 < index_count; i += 3) {
+    if (indices[i] >= vertex_limit || indices[i + 1] >= vertex_limit ||
+        indices[i + 2] >= vertex_limit)
+      continue;
+
+    for (int32_t corner = i; corner < i + 3; corner++) {
+      uint32_t& slot = vertex_slots_[indices[corner]];
+      if (slot == NO_SLOT) {
+        slot = static_cast<uint32_t>(used_vertices_.size());
+        used_vertices_.push_back(indices[corner]);
+      }
+      local_indices_.push_back(slot);
+    }
+  }
+  for (const uint32_t vertex : used_vertices_) vertex_slots_[vertex] = NO_SLOT;
+  if (used_vertices_.empty()) return;
+
+  // 여러 인스턴스의 정점을 한 번에 나눠 변환한 뒤 제출 순서대로 조립합니다
+  const int32_t used_count = static_cast<int32_t>(used_vertices_.size());
+  const int32_t batch_size =
+      (std::max)(1, INSTANCE_BATCH_VERTICES / used_count);
+  for (int32_t first = 0; first < instance_count; first += batch_size) {
+    const int32_t count = (std::min)(batch_size, instance_count - first);
+
+    instance_matrices_.resize(count);
+    for (int32_t i = 0; i < count; i++)
+      instance_matrices_[i] = DirectX::XMMatrixMultiply(
+          DirectX::XMLoadFloat4x4(&instances[first + i].world_),
+          view_projection);
+
+    RunVertexKernel(count * used_count, [&](int32_t i) {
+      const int32_t instance = i / used_count;
+      transformed_[i] = ColorVertexInstancedKernel(
+          vertices[used_vertices_[i % used_count]],
+          instance_matrices_[instance], instances[first + instance].color_);
+    });
+
+    for (int32_t i = 0; i < count; i++)
+      AssembleTriangles(&transformed_[static_cast<size_t>(i) * used_count],
+                        static_cast<uint32_t>(used_count),
+                        local_indices_.data(),
+                        static_cast<int32_t>(local_indices_.size()));
+  }
+}
+
+template <typename Kernel>
+void SoftRasterizerClass::RunVertexKernel(const int32_t vertex_count,
+                                          const Kernel& kernel) {
+  transformed_.resize(vertex_count);
+
+  // 정점 커널은 서로 독립이므로 VERTEX_CHUNK_SIZE 단위로 나눠 실행합니다
+  if (vertex_count <= VERTEX_CHUNK_SIZE) {
+    for (int32_t i = 0; i < vertex_count; i++) kernel(i);
+    return;
+  }
+
+  const uint32_t chunk_count =
+      (vertex_count + VERTEX_CHUNK_SIZE - 1) / VERTEX_CHUNK_SIZE;
+  job_system_->ParallelFor(chunk_count, [&](uint32_t chunk) {
+    const int32_t begin = static_cast<int32_t>(chunk) * VERTEX_CHUNK_SIZE;
+    const int32_t end = (std::min)(begin + VERTEX_CHUNK_SIZE, vertex_count);
+    for (int32_t i = begin; i < end; i++) kernel(i);
+  });
+}
+
+void SoftRasterizerClass::GetProjectionMatrix(
+    DirectX::XMMATRIX& projection_matrix) {
+  projection_matrix = projection_matrix_;
+}
+
+void SoftRasterizerClass::GetWorldMatrix(DirectX::XMMATRIX& world_matrix) {
+  world_matrix = world_matrix_;
+}
+
+void SoftRasterizerClass::GetOrthoMatrix(DirectX::XMMATRIX& ortho_matrix) {
+  ortho_matrix = ortho_matrix_;
+}
+
+int32_t SoftRasterizerClass::GetWidth() { return width_; }
+
+int32_t SoftRasterizerClass::GetHeight() { return height_; }
+
+const uint32_t* SoftRasterizerClass::GetColorBuffer() {
+  return color_buffer_.data();
+}
+
+int32_t SoftRasterizerClass::GetPitch() { return pitch_; }
+
+bool SoftRasterizerClass::SaveToFile(const std::filesystem::path& path) {
+  std::ofstream file(path, std::ios::binary);
+  if (!file) return false;
+
+  file << "P6\n" << width_ << " " << height_ << "\n255\n";
+
+  std::vector<char> row(static_cast<size_t>(width_) * 3);
+  for (int32_t y = 0; y < height_; y++) {
+    const uint32_t* pixels = &color_buffer_[static_cast<size_t>(y) * pitch_];
+    for (int32_t x = 0; x < width_; x++) {
+      row[x * 3 + 0] = static_cast<char>(pixels[x] & 0xFF);
+      row[x * 3 + 1] = static_cast<char>((pixels[x] >> 8) & 0xFF);
+      row[x * 3 + 2] = static_cast<char>((pixels[x] >> 16) & 0xFF);
+    }
+    file.write(row.data(), row.size());
+  }
+
+  return file.good();
+}
+
+SoftRasterizerClass::PixelInputType SoftRasterizerClass::ColorVertexKernel(
+    const ModelClass::VertexType& input, const MatrixBufferType& matrices) {
+  // 적절한 행렬 계산을 위해 벡터를 4 단위로 변경합니다
+  DirectX::XMVECTOR position = DirectX::XMVectorSet(
+      input.position_.x, input.position_.y, input.position_.z, 1.0f);
+
+  // 월드, 뷰 및 투영 행렬에 대한 정점의 위치를 계산합니다
+  position = DirectX::XMVector4Transform(position, matrices.world_);
+  position = DirectX::XMVector4Transform(position, matrices.view_);
+  position = DirectX::XMVector4Transform(position, matrices.projection_);
+
+  // 픽셀 커널이 사용할 입력 색상을 저장합니다
+  PixelInputType output{};
+  DirectX::XMStoreFloat4(&output.position_, position);
+  output.color_ = input.color_;
+
+  return output;
+}
+
+SoftRasterizerClass::PixelInputType SoftRasterizerClass::ColorVertexWvpKernel(
+    const ModelClass::VertexType& input,
+    const DirectX::XMMATRIX& world_view_projection) {
+  // 미리 곱한 행렬 하나로 정점의 위치를 계산합니다
+  const DirectX::XMVECTOR position = DirectX::XMVector4Transform(
+      DirectX::XMVectorSet(input.position_.x, input.position_.y,
+                           input.position_.z, 1.0f),
+      world_view_projection);
+
+  PixelInputType output{};
+  DirectX::XMStoreFloat4(&output.position_, position);
+  output.color_ = input.color_;
+
+  return output;
+}
+
+SoftRasterizerClass::PixelInputType
+SoftRasterizerClass::ColorVertexInstancedKernel(
+    const ModelClass::VertexType& input,
+    const DirectX::XMMATRIX& world_view_projection,
+    const DirectX::XMFLOAT4& instance_color) {
+  PixelInputType output = ColorVertexWvpKernel(input, world_view_projection);
+
+  // 정점 색상에 인스턴스 색상을 곱합니다
+  output.color_.x *= instance_color.x;
+  output.color_.y *= instance_color.y;
+  output.color_.z *= instance_color.z;
+  output.color_.w *= instance_color.w;
+
+  return output;
+}
+
+void SoftRasterizerClass::AssembleTriangles(
+    const PixelInputType* transformed, const uint32_t vertex_count,
+    const uint32_t* indices, const int32_t index_count) {
+  // 삼각형을 클리핑, 셋업하고 겹치는 타일에 배치합니다
+  for (int32_t i = 0; i + 2 < index_count; i += 3) {
+    if (indices[i] >= vertex_count || indices[i + 1] >= vertex_count ||
+        indices[i + 2] >= vertex_count)
+      continue;
+    ClipTriangle(transformed[indices[i]], transformed[indices[i + 1]],
+                 transformed[indices[i + 2]]);
+  }
+}
+
+void SoftRasterizerClass::ClipTriangle(const PixelInputType& v0,
+                                       const PixelInputType& v1,
+                                       const PixelInputType& v2) {
+  const PixelInputType* input[3] = {&v0, &v1, &v2};
+
+  // x, y 가 모두 한쪽 평면 밖에 있는 삼각형은 바로 버립니다
+  auto all_outside = [&](auto distance) {
+    return distance(*input[0]) < 0.0f && distance(*input[1]) < 0.0f &&
+           distance(*input[2]) < 0.0f;
+  };
+  if (all_outside([](const PixelInputType& v) {
+        return v.position_.w + v.position_.x;
+      }) ||
+      all_outside([](const PixelInputType& v) {
+        return v.position_.w - v.position_.x;
+      }) ||
+      all_outside([](const PixelInputType& v) {
+        return v.position_.w + v.position_.y;
+      }) ||
+      all_outside([](const PixelInputType& v) {
+        return v.position_.w - v.position_.y;
+      }) ||
+      all_outside([](const PixelInputType& v) { return v.position_.z; }))
+    return;
+
+  // 근평면(z >= 0) 안쪽에 모두 있으면 클리핑 없이 셋업합니다
+  if (v0.position_.z >= 0.0f && v1.position_.z >= 0.0f &&
+      v2.position_.z >= 0.0f) {
+    SetupTriangle(v0, v1, v2);
+    return;
+  }
+
+  // 근평면에 대해 Sutherland-Hodgman 클리핑을 수행합니다
+  auto lerp = [](const PixelInputType& a, const PixelInputType& b, float t) {
+    auto mix = [t](const DirectX::XMFLOAT4& p, const DirectX::XMFLOAT4& q) {
+      return DirectX::XMFLOAT4(p.x + (q.x - p.x) * t, p.y + (q.y - p.y) * t,
+                               p.z + (q.z - p.z) * t, p.w + (q.w - p.w) * t);
+    };
+    return PixelInputType{mix(a.position_, b.position_),
+                          mix(a.color_, b.color_)};
+  };
+
+  PixelInputType clipped[4]{};
+  int32_t count = 0;
+  for (int32_t i = 0; i < 3; i++) {
+    const PixelInputType& a = *input[i];
+    const PixelInputType& b = *input[(i + 1) % 3];
+    const bool a_inside = a.position_.z >= 0.0f;
+    const bool b_inside = b.position_.z >= 0.0f;
+
+    if (a_inside) clipped[count++] = a;
+    if (a_inside != b_inside) {
+      const float t = a.position_.z / (a.position_.z - b.position_.z);
+      clipped[count++] = lerp(a, b, t);
+    }
+  }
+
+  for (int32_t i = 1; i + 1 < count; i++)
+    SetupTriangle(clipped[0], clipped[i], clipped[i + 1]);
+}
+
+void SoftRasterizerClass::SetupTriangle(const PixelInputType& v0,
+                                        const PixelInputType& v1,
+                                        const PixelInputType& v2) {
+  const PixelInputType* input[3] = {&v0, &v1, &v2};
+
+  // 원근 나눗셈과 뷰포트 변환으로 화면 좌표를 구합니다
+  float x[3], y[3];
+  TriangleType triangle{};
+  for (int32_t i = 0; i < 3; i++) {
+    const DirectX::XMFLOAT4& position = input[i]->position_;
+    const float inv_w = 1.0f / position.w;
+
+    x[i] = (position.x * inv_w * 0.5f + 0.5f) * width_;
+    y[i] = (0.5f - position.y * inv_w * 0.5f) * height_;
+    triangle.z_[i] = position.z * inv_w;
+    triangle.inv_w_[i] = inv_w;
+
+    // 원근 보정 보간을 위해 색상을 w 로 나눠 둡니다
+    const DirectX::XMFLOAT4& color = input[i]->color_;
+    triangle.color_over_w_[i] = DirectX::XMFLOAT4(
+        color.x * inv_w, color.y * inv_w, color.z * inv_w, color.w * inv_w);
+  }
+
+  // 화면(y 아래 방향)에서 시계 방향이 앞면입니다. 뒷면은 컬링합니다
+  const float area =
+      (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+  if (!(area > 0.0f)) return;
+
+  // 화면 영역으로 잘린 바운딩 박스를 구합니다
+  const float min_x = (std::min)({x[0], x[1], x[2]});
+  const float max_x = (std::max)({x[0], x[1], x[2]});
+  const float min_y = (std::min)({y[0], y[1], y[2]});
+  const float max_y = (std::max)({y[0], y[1], y[2]});
+
+  // 범위를 벗어난 float 를 int32_t 로 바꾸면 정의되지 않은 동작이므로
+  // float 에서 먼저 화면으로 자릅니다. 비교가 거짓인 NaN 도 여기서 버립니다
+  if (!(min_x < width_ && min_y < height_ && max_x > -1.0f && max_y > -1.0f))
+    return;
+
+  triangle.min_x_ = static_cast<int32_t>(std::floor((std::max)(min_x, 0.0f)));
+  triangle.min_y_ = static_cast<int32_t>(std::floor((std::max)(min_y, 0.0f)));
+  triangle.max_x_ = static_cast<int32_t>(
+      std::ceil((std::min)(max_x, static_cast<float>(width_ - 1))));
+  triangle.max_y_ = static_cast<int32_t>(
+      std::ceil((std::min)(max_y, static_cast<float>(height_ - 1))));
+  if (triangle.min_x_ > triangle.max_x_ || triangle.min_y_ > triangle.max_y_)
+    return;
+
+  // 각 정점의 맞은편 에지에 대한 에지 함수를 만듭니다
+  for (int32_t i = 0; i < 3; i++) {
+    const int32_t a = (i + 1) % 3;
+    const int32_t b = (i + 2) % 3;
+
+    const float edge_a = y[a] - y[b];
+    const float edge_b = x[b] - x[a];
+    triangle.edge_a_[i] = edge_a;
+    triangle.edge_b_[i] = edge_b;
+    triangle.edge_c_[i] = -(edge_a * x[a] + edge_b * y[a]);
+
+    // top-left 규칙: 위쪽 에지와 왼쪽 에지 위의 픽셀만 포함합니다
+    triangle.top_left_[i] = edge_a > 0.0f || (edge_a == 0.0f && edge_b > 0.0f);
+  }
+  triangle.inv_area_ = 1.0f / area;
+
+  // 삼각형이 겹치는 모든 타일의 bin 에 삼각형을 추가합니다
+  const uint32_t triangle_index = static_cast<uint32_t>(triangles_.size());
+  triangles_.push_back(triangle);
+
+  for (int32_t ty = triangle.min_y_ / TILE_SIZE;
+       ty <= triangle.max_y_ / TILE_SIZE; ty++) {
+    for (int32_t tx = triangle.min_x_ / TILE_SIZE;
+         tx <= triangle.max_x_ / TILE_SIZE; tx++) {
+      bins_[static_cast<size_t>(ty) * tile_count_x_ + tx].push_back(
+          triangle_index);
+    }
+  }
+}
+
+void SoftRasterizerClass::RasterizeTile(const int32_t tile_index) {
+  PROFILE_FUNCTION();
+
+  const int32_t tile_x0 = (tile_index % tile_count_x_) * TILE_SIZE;
+  const int32_t tile_y0 = (tile_index / tile_count_x_) * TILE_SIZE;
+  const int32_t tile_x1 = (std::min)(tile_x0 + TILE_SIZE, width_);
+  const int32_t tile_y1 = (std::min)(tile_y0 + TILE_SIZE, height_);
+
+  // 타일 영역의 색상 버퍼와 깊이 버퍼를 지웁니다
+  for (int32_t y = tile_y0; y < tile_y1; y++) {
+    const size_t row = static_cast<size_t>(y) * pitch_;
+    std::fill(color_buffer_.begin() + row + tile_x0,
+              color_buffer_.begin() + row + tile_x1, clear_color_);
+    std::fill(depth_buffer_.begin() + row + tile_x0,
+              depth_buffer_.begin() + row + tile_x1, 1.0f);
+  }
+
+  // 제출된 순서대로 삼각형을 래스터화합니다
+  for (const uint32_t triangle_index : bins_[tile_index])
+    RasterizeTriangle(triangles_[triangle_index], tile_x0, tile_y0, tile_x1,
+                      tile_y1);
+}
+
+void SoftRasterizerClass::RasterizeTriangle(const TriangleType& triangle,
+                                            const int32_t tile_x0,
+                                            const int32_t tile_y0,
+                                            const int32_t tile_x1,
+                                            const int32_t tile_y1) {
+  const int32_t min_x = (std::max)(triangle.min_x_, tile_x0);
+  const int32_t min_y = (std::max)(triangle.min_y_, tile_y0);
+  const int32_t max_x = (std::min)(triangle.max_x_, tile_x1 - 1);
+  const int32_t max_y = (std::min)(triangle.max_y_, tile_y1 - 1);
+  if (min_x > max_x || min_y > max_y) return;
+
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 lane_offset = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+  const __m128i lane_index = _mm_setr_epi32(0, 1, 2, 3);
+  const __m128i first_x = _mm_set1_epi32(min_x - 1);
+  const __m128i last_x = _mm_set1_epi32(max_x + 1);
+  const __m128 inv_area = _mm_set1_ps(triangle.inv_area_);
+
+  __m128 edge_a[3], top_left[3];
+  for (int32_t i = 0; i < 3; i++) {
+    edge_a[i] = _mm_set1_ps(triangle.edge_a_[i]);
+    top_left[i] = _mm_castsi128_ps(
+        _mm_set1_epi32(triangle.top_left_[i] ? -1 : 0));
+  }
+
+  // 4픽셀 단위로 처리합니다. 타일 시작이 4의 배수이므로 타일 경계를 넘지 않습니다
+  const int32_t start_x = min_x & ~3;
+  for (int32_t y = min_y; y <= max_y; y++) {
+    const float py = static_cast<float>(y) + 0.5f;
+    const size_t row = static_cast<size_t>(y) * pitch_;
+
+    __m128 edge_row[3];
+    for (int32_t i = 0; i < 3; i++)
+      edge_row[i] = _mm_set1_ps(triangle.edge_b_[i] * py + triangle.edge_c_[i]);
+
+    for (int32_t x = start_x; x <= max_x; x += 4) {
+      const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)),
+                                   lane_offset);
+
+      // 세 에지 함수를 4픽셀에 대해 동시에 계산합니다
+      __m128 w[3];
+      __m128 mask = _mm_castsi128_ps(_mm_and_si128(
+          _mm_cmpgt_epi32(_mm_add_epi32(_mm_set1_epi32(x), lane_index),
+                          first_x),
+          _mm_cmplt_epi32(_mm_add_epi32(_mm_set1_epi32(x), lane_index),
+                          last_x)));
+      for (int32_t i = 0; i < 3; i++) {
+        w[i] = _mm_add_ps(_mm_mul_ps(edge_a[i], px), edge_row[i]);
+        const __m128 inside =
+            _mm_or_ps(_mm_and_ps(top_left[i], _mm_cmpge_ps(w[i], zero)),
+                      _mm_andnot_ps(top_left[i], _mm_cmpgt_ps(w[i], zero)));
+        mask = _mm_and_ps(mask, inside);
+      }
+      if (_mm_movemask_ps(mask) == 0) continue;
+
+      // 무게중심 좌표로 깊이를 보간하고 깊이 테스트(LESS)를 합니다
+      const __m128 b0 = _mm_mul_ps(w[0], inv_area);
+      const __m128 b1 = _mm_mul_ps(w[1], inv_area);
+      const __m128 b2 = _mm_mul_ps(w[2], inv_area);
+
+      auto interpolate = [&](float a0, float a1, float a2) {
+        return _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(b0, _mm_set1_ps(a0)),
+                       _mm_mul_ps(b1, _mm_set1_ps(a1))),
+            _mm_mul_ps(b2, _mm_set1_ps(a2)));
+      };
+
+      const __m128 z =
+          interpolate(triangle.z_[0], triangle.z_[1], triangle.z_[2]);
+      float* depth = &depth_buffer_[row + x];
+      const __m128 old_depth = _mm_loadu_ps(depth);
+      mask = _mm_and_ps(mask, _mm_cmplt_ps(z, old_depth));
+      if (_mm_movemask_ps(mask) == 0) continue;
+
+      _mm_storeu_ps(depth, _mm_or_ps(_mm_and_ps(mask, z),
+                                     _mm_andnot_ps(mask, old_depth)));
+
+      // pixel.hlsl 의 ColorPixelShader 는 보간된 색상을 그대로 출력하므로
+      // 원근 보정된 색상을 바로 렌더 타깃 형식으로 바꿉니다
+      const __m128 w_value = _mm_div_ps(
+          one, interpolate(triangle.inv_w_[0], triangle.inv_w_[1],
+                           triangle.inv_w_[2]));
+      const DirectX::XMFLOAT4* c = triangle.color_over_w_;
+      __m128 red = _mm_mul_ps(interpolate(c[0].x, c[1].x, c[2].x), w_value);
+      __m128 green = _mm_mul_ps(interpolate(c[0].y, c[1].y, c[2].y), w_value);
+      __m128 blue = _mm_mul_ps(interpolate(c[0].z, c[1].z, c[2].z), w_value);
+      __m128 alpha = _mm_mul_ps(interpolate(c[0].w, c[1].w, c[2].w), w_value);
+
+      __m128i* color = reinterpret_cast<__m128i*>(&color_buffer_[row + x]);
+      const __m128i old_color = _mm_loadu_si128(color);
+      const __m128i pixel_mask = _mm_castps_si128(mask);
+      _mm_storeu_si128(
+          color, _mm_or_si128(
+                     _mm_and_si128(pixel_mask,
+                                   PackColor(red, green, blue, alpha)),
+                     _mm_andnot_si128(pixel_mask, old_color)));
+    }
+  }
+}
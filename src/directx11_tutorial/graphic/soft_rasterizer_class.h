@@ -0,0 +1,146 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "model_class.h"
+
+class JobSystemClass;
+
+// GPU 없이 D3DClass 와 같은 역할을 하는 타일 기반 소프트웨어 렌더러입니다.
+// vertex.hlsl / pixel.hlsl 의 색상 파이프라인을 C++ 커널로 실행합니다.
+class SoftRasterizerClass {
+ public:
+  // 타일 래스터화와 정점 커널을 job_system 으로 나눠 실행합니다. 작업
+  // 시스템은 Shutdown 까지 살아 있어야 합니다
+  bool Initialize(const int32_t width, const int32_t height,
+                  float screen_depth, float screen_near,
+                  JobSystemClass* job_system);
+  void Shutdown();
+
+  void BeginScene(float red, float green, float blue, float alpha);
+  void EndScene();
+
+  // 그리기 함수는 vertex_count 이상을 가리키는 인덱스가 있는 삼각형을
+  // 그리지 않고 건너뜁니다
+
+  void DrawIndexed(const ModelClass::VertexType* vertices,
+                   const int32_t vertex_count, const uint32_t* indices,
+                   const int32_t index_count, DirectX::XMMATRIX world,
+                   DirectX::XMMATRIX view, DirectX::XMMATRIX projection);
+  // vertex_wvp.hlsl 과 같이 미리 곱한 월드-뷰-투영 행렬 하나로 그립니다
+  void DrawIndexed(const ModelClass::VertexType* vertices,
+                   const int32_t vertex_count, const uint32_t* indices,
+                   const int32_t index_count,
+                   const DirectX::XMMATRIX& world_view_projection);
+  // vertex_instanced.hlsl 과 같이 인스턴스마다 월드 행렬과 인스턴스 색상으로
+  // 그립니다. 인덱스가 가리키는 정점만 인스턴스마다 한 번씩 변환합니다
+  void DrawIndexedInstanced(const ModelClass::VertexType* vertices,
+                            const int32_t vertex_count,
+                            const uint32_t* indices, const int32_t index_count,
+                            const ModelClass::InstanceType* instances,
+                            const int32_t instance_count,
+                            const DirectX::XMMATRIX& view_projection);
+
+  void GetProjectionMatrix(DirectX::XMMATRIX& projection_matrix);
+  void GetWorldMatrix(DirectX::XMMATRIX& world_matrix);
+  void GetOrthoMatrix(DirectX::XMMATRIX& ortho_matrix);
+
+  int32_t GetWidth();
+  int32_t GetHeight();
+
+  // R8G8B8A8 형식의 색상 버퍼입니다. 한 줄은 GetPitch() 개의 픽셀입니다
+  const uint32_t* GetColorBuffer();
+  int32_t GetPitch();
+
+  // 마지막으로 그려진 프레임을 PPM 파일로 저장합니다
+  bool SaveToFile(const std::filesystem::path& path);
+
+ private:
+  static const int32_t TILE_SIZE = 64;
+  // 정점 커널을 작업 하나로 묶어 실행하는 정점 수입니다
+  static const int32_t VERTEX_CHUNK_SIZE = 4096;
+  // 인스턴스 그리기에서 한 번에 변환해 두는 정점 수의 상한입니다
+  static const int32_t INSTANCE_BATCH_VERTICES = 1 << 16;
+  static constexpr uint32_t NO_SLOT = 0xffffffff;
+
+  // vertex.hlsl 의 MatrixBuffer 와 같은 구조입니다
+  struct MatrixBufferType {
+    DirectX::XMMATRIX world_;
+    DirectX::XMMATRIX view_;
+    DirectX::XMMATRIX projection_;
+  };
+
+  // vertex.hlsl 의 PixelInputType 과 같은 구조입니다 (클립 공간)
+  struct PixelInputType {
+    DirectX::XMFLOAT4 position_;
+    DirectX::XMFLOAT4 color_;
+  };
+
+  // 화면 공간으로 셋업된 삼각형입니다. 에지 함수는 a * x + b * y + c 입니다
+  struct TriangleType {
+    float edge_a_[3];
+    float edge_b_[3];
+    float edge_c_[3];
+    bool top_left_[3];
+    float inv_area_;
+    float z_[3];
+    float inv_w_[3];
+    DirectX::XMFLOAT4 color_over_w_[3];
+    int32_t min_x_, min_y_, max_x_, max_y_;
+  };
+
+  static PixelInputType ColorVertexKernel(const ModelClass::VertexType& input,
+                                          const MatrixBufferType& matrices);
+  static PixelInputType ColorVertexWvpKernel(
+      const ModelClass::VertexType& input,
+      const DirectX::XMMATRIX& world_view_projection);
+  static PixelInputType ColorVertexInstancedKernel(
+      const ModelClass::VertexType& input,
+      const DirectX::XMMATRIX& world_view_projection,
+      const DirectX::XMFLOAT4& instance_color);
+
+  // kernel(i) 를 [0, vertex_count) 의 모든 정점에 실행합니다
+  template <typename Kernel>
+  void RunVertexKernel(const int32_t vertex_count, const Kernel& kernel);
+  // transformed 의 vertex_count 개 정점으로 삼각형을 조립합니다
+  void AssembleTriangles(const PixelInputType* transformed,
+                         const uint32_t vertex_count, const uint32_t* indices,
+                         const int32_t index_count);
+
+  void ClipTriangle(const PixelInputType& v0, const PixelInputType& v1,
+                    const PixelInputType& v2);
+  void SetupTriangle(const PixelInputType& v0, const PixelInputType& v1,
+                     const PixelInputType& v2);
+  void RasterizeTile(const int32_t tile_index);
+  void RasterizeTriangle(const TriangleType& triangle, const int32_t tile_x0,
+                         const int32_t tile_y0, const int32_t tile_x1,
+                         const int32_t tile_y1);
+
+  int32_t width_ = 0;
+  int32_t height_ = 0;
+  int32_t pitch_ = 0;
+  int32_t tile_count_x_ = 0;
+  int32_t tile_count_y_ = 0;
+  uint32_t clear_color_ = 0;
+
+  std::vector<uint32_t> color_buffer_;
+  std::vector<float> depth_buffer_;
+  std::vector<PixelInputType> transformed_;
+  std::vector<TriangleType> triangles_;
+  std::vector<std::vector<uint32_t>> bins_;
+
+  // 인스턴스 그리기에서 인덱스가 가리키는 정점들과, 그 목록 안의 위치로
+  // 바꾼 인덱스입니다. vertex_slots_ 는 그리기 사이에 NO_SLOT 으로 남습니다
+  std::vector<uint32_t> used_vertices_;
+  std::vector<uint32_t> local_indices_;
+  std::vector<uint32_t> vertex_slots_;
+  std::vector<DirectX::XMMATRIX> instance_matrices_;
+
+  JobSystemClass* job_system_ = nullptr;
+
+  DirectX::XMMATRIX projection_matrix_;
+  DirectX::XMMATRIX world_matrix_;
+  DirectX::XMMATRIX ortho_matrix_;
+};
@@ -0,0 +1,81 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "framework/benchmark_class.h"
+#include "graphic/state_filter_class.h"
+
+void RegisterStateFilterBenchmarks(BenchmarkClass& benchmark) {
+  // 정렬된 렌더 큐처럼 드로우마다 파이프라인 상태를 모두 다시 설정하는
+  // 10 만 드로우를, 통과한 호출을 기록하는 가짜 컨텍스트로 보내기.
+  // 셰이더는 1000 드로우, 메시는 16 드로우마다 바뀌고 상수 조각은 매번
+  // 바뀝니다
+  for (const bool filtered : {false, true}) {
+    const uint32_t draw_count = 100000;
+    const std::string name = "StateFilterClass/" +
+                             std::to_string(draw_count) +
+                             (filtered ? "/filtered" : "/unfiltered");
+
+    benchmark.AddFixture(name, draw_count, [filtered, draw_count] {
+      struct DataType {
+        StateFilterClass state_filter_;
+        std::vector<StateFilterClass::CallType> calls_;
+      };
+      auto data = std::make_shared<DataType>();
+      data->state_filter_.SetEnabled(filtered);
+      data->calls_.reserve(size_t{draw_count} * 8);
+
+      return BenchmarkClass::BodyType([data, draw_count](uint64_t iterations) {
+        using CallType = StateFilterClass::CallType;
+        StateFilterClass& filter = data->state_filter_;
+        std::vector<CallType>& calls = data->calls_;
+
+        // 주소로만 비교하므로 정수로 가짜 핸들을 만듭니다
+        const auto handle = [](const uintptr_t value) {
+          return reinterpret_cast<const void*>(value << 4);
+        };
+
+        uint32_t start = 0, count = 0;
+        for (uint64_t i = 0; i < iterations; i++) {
+          calls.clear();
+          filter.Invalidate();
+          filter.ResetCounters();
+
+          for (uint32_t draw = 0; draw < draw_count; draw++) {
+            const uintptr_t program = 1 + draw / 1000 % 2;
+            const uintptr_t mesh = 100 + draw / 16 % 64;
+            const void* buffers[2] = {handle(mesh), handle(200)};
+            const uint32_t strides[2] = {16, 80};
+            const uint32_t offsets[2] = {0, 0};
+            const void* constant_buffer = handle(300);
+            const uint32_t first_constant = draw % 4096 * 16;
+            const uint32_t constant_count = 16;
+
+            if (filter.SetInputLayout(handle(program)))
+              calls.push_back(CallType::INPUT_LAYOUT);
+            if (filter.SetVertexShader(handle(10 + program)))
+              calls.push_back(CallType::VERTEX_SHADER);
+            if (filter.SetPixelShader(handle(20)))
+              calls.push_back(CallType::PIXEL_SHADER);
+            if (filter.SetVertexBuffers(0, 2, buffers, strides, offsets,
+                                        start, count))
+              calls.push_back(CallType::VERTEX_BUFFERS);
+            if (filter.SetIndexBuffer(handle(mesh + 1000), 57, 0))
+              calls.push_back(CallType::INDEX_BUFFER);
+            if (filter.SetPrimitiveTopology(4))
+              calls.push_back(CallType::PRIMITIVE_TOPOLOGY);
+            if (filter.SetVertexConstantBuffers(0, 1, &constant_buffer,
+                                                &first_constant,
+                                                &constant_count, start,
+                                                count))
+              calls.push_back(CallType::VERTEX_CONSTANT_BUFFERS);
+          }
+          BenchmarkClass::DoNotOptimize(calls);
+        }
+      });
+    });
+  }
+}
@@ -0,0 +1,278 @@
+#include "pch.h"
+#include "state_filter_class.h"
+
+#include <cmath>
+
+namespace {
+// 아직 모르는 상태를 나타내는 값입니다. 어떤 실제 값과도 같지 않습니다
+const void* const UNKNOWN_HANDLE = reinterpret_cast<const void*>(~uintptr_t{0});
+const uint32_t UNKNOWN_VALUE = ~0u;
+const float UNKNOWN_FLOAT = NAN;
+
+bool IsSameViewport(const StateFilterClass::ViewportType& a,
+                    const StateFilterClass::ViewportType& b) {
+  return a.top_left_x_ == b.top_left_x_ && a.top_left_y_ == b.top_left_y_ &&
+         a.width_ == b.width_ && a.height_ == b.height_ &&
+         a.min_depth_ == b.min_depth_ && a.max_depth_ == b.max_depth_;
+}
+
+// 바뀐 슬롯이 모두 들어가도록 [first, last] 구간을 넓힙니다
+void ExtendRange(const uint32_t slot, uint32_t& first, uint32_t& last) {
+  if (first == UNKNOWN_VALUE) first = slot;
+  last = slot;
+}
+}  // namespace
+
+StateFilterClass::StateFilterClass() {
+  Invalidate();
+  ResetCounters();
+}
+
+void StateFilterClass::SetEnabled(const bool enabled) { enabled_ = enabled; }
+
+bool StateFilterClass::IsEnabled() { return enabled_; }
+
+void StateFilterClass::Invalidate() {
+  input_layout_ = UNKNOWN_HANDLE;
+  for (uint32_t i = 0; i < MAX_VERTEX_BUFFERS; i++) {
+    vertex_buffers_[i] = UNKNOWN_HANDLE;
+    vertex_strides_[i] = UNKNOWN_VALUE;
+    vertex_offsets_[i] = UNKNOWN_VALUE;
+  }
+  index_buffer_ = UNKNOWN_HANDLE;
+  index_format_ = UNKNOWN_VALUE;
+  index_offset_ = UNKNOWN_VALUE;
+  primitive_topology_ = UNKNOWN_VALUE;
+
+  StageType* stages[] = {&vertex_stage_, &pixel_stage_};
+  for (StageType* stage : stages) {
+    stage->shader_ = UNKNOWN_HANDLE;
+    for (ConstantBufferType& constant_buffer : stage->constant_buffers_)
+      constant_buffer = {UNKNOWN_HANDLE, UNKNOWN_VALUE, UNKNOWN_VALUE};
+  }
+
+  render_target_count_ = UNKNOWN_VALUE;
+  for (const void*& render_target : render_targets_)
+    render_target = UNKNOWN_HANDLE;
+  depth_stencil_view_ = UNKNOWN_HANDLE;
+  depth_stencil_state_ = UNKNOWN_HANDLE;
+  stencil_ref_ = UNKNOWN_VALUE;
+  blend_state_ = UNKNOWN_HANDLE;
+  for (float& factor : blend_factor_) factor = UNKNOWN_FLOAT;
+  sample_mask_ = UNKNOWN_VALUE;
+
+  rasterizer_state_ = UNKNOWN_HANDLE;
+  viewport_count_ = UNKNOWN_VALUE;
+}
+
+void StateFilterClass::ResetCounters() {
+  for (uint32_t& count : issued_counts_) count = 0;
+  for (uint32_t& count : filtered_counts_) count = 0;
+}
+
+uint32_t StateFilterClass::GetIssuedCount() {
+  uint32_t total = 0;
+  for (const uint32_t count : issued_counts_) total += count;
+  return total;
+}
+
+uint32_t StateFilterClass::GetFilteredCount() {
+  uint32_t total = 0;
+  for (const uint32_t count : filtered_counts_) total += count;
+  return total;
+}
+
+uint32_t StateFilterClass::GetIssuedCount(const CallType type) {
+  return issued_counts_[static_cast<uint32_t>(type)];
+}
+
+uint32_t StateFilterClass::GetFilteredCount(const CallType type) {
+  return filtered_counts_[static_cast<uint32_t>(type)];
+}
+
+bool StateFilterClass::SetInputLayout(const void* layout) {
+  const bool changed = input_layout_ != layout;
+  input_layout_ = layout;
+  return Count(CallType::INPUT_LAYOUT, changed);
+}
+
+bool StateFilterClass::SetVertexBuffers(
+    const uint32_t start, const uint32_t count, const void* const* buffers,
+    const uint32_t* strides, const uint32_t* offsets, uint32_t& changed_start,
+    uint32_t& changed_count) {
+  changed_start = start;
+  changed_count = count;
+
+  // 범위를 벗어난 호출은 검사하지 않고 API 에 맡깁니다
+  if (start + count > MAX_VERTEX_BUFFERS)
+    return Count(CallType::VERTEX_BUFFERS, true);
+
+  uint32_t first = UNKNOWN_VALUE, last = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    const uint32_t slot = start + i;
+    const uint32_t stride = strides ? strides[i] : 0;
+    const uint32_t offset = offsets ? offsets[i] : 0;
+    if (vertex_buffers_[slot] != buffers[i] ||
+        vertex_strides_[slot] != stride || vertex_offsets_[slot] != offset) {
+      vertex_buffers_[slot] = buffers[i];
+      vertex_strides_[slot] = stride;
+      vertex_offsets_[slot] = offset;
+      ExtendRange(slot, first, last);
+    }
+  }
+
+  if (first != UNKNOWN_VALUE && enabled_) {
+    changed_start = first;
+    changed_count = last - first + 1;
+  }
+  return Count(CallType::VERTEX_BUFFERS, first != UNKNOWN_VALUE);
+}
+
+bool StateFilterClass::SetIndexBuffer(const void* buffer,
+                                      const uint32_t format,
+                                      const uint32_t offset) {
+  const bool changed = index_buffer_ != buffer || index_format_ != format ||
+                       index_offset_ != offset;
+  index_buffer_ = buffer;
+  index_format_ = format;
+  index_offset_ = offset;
+  return Count(CallType::INDEX_BUFFER, changed);
+}
+
+bool StateFilterClass::SetPrimitiveTopology(const uint32_t topology) {
+  const bool changed = primitive_topology_ != topology;
+  primitive_topology_ = topology;
+  return Count(CallType::PRIMITIVE_TOPOLOGY, changed);
+}
+
+bool StateFilterClass::SetVertexShader(const void* shader) {
+  const bool changed = vertex_stage_.shader_ != shader;
+  vertex_stage_.shader_ = shader;
+  return Count(CallType::VERTEX_SHADER, changed);
+}
+
+bool StateFilterClass::SetPixelShader(const void* shader) {
+  const bool changed = pixel_stage_.shader_ != shader;
+  pixel_stage_.shader_ = shader;
+  return Count(CallType::PIXEL_SHADER, changed);
+}
+
+bool StateFilterClass::SetVertexConstantBuffers(
+    const uint32_t start, const uint32_t count, const void* const* buffers,
+    const uint32_t* first_constants, const uint32_t* constant_counts,
+    uint32_t& changed_start, uint32_t& changed_count) {
+  return SetConstantBuffers(vertex_stage_, CallType::VERTEX_CONSTANT_BUFFERS,
+                            start, count, buffers, first_constants,
+                            constant_counts, changed_start, changed_count);
+}
+
+bool StateFilterClass::SetPixelConstantBuffers(
+    const uint32_t start, const uint32_t count, const void* const* buffers,
+    const uint32_t* first_constants, const uint32_t* constant_counts,
+    uint32_t& changed_start, uint32_t& changed_count) {
+  return SetConstantBuffers(pixel_stage_, CallType::PIXEL_CONSTANT_BUFFERS,
+                            start, count, buffers, first_constants,
+                            constant_counts, changed_start, changed_count);
+}
+
+bool StateFilterClass::SetRenderTargets(const uint32_t count,
+                                        const void* const* views,
+                                        const void* depth_stencil_view) {
+  if (count > MAX_RENDER_TARGETS)
+    return Count(CallType::RENDER_TARGETS, true);
+
+  // count 뒤의 슬롯은 API 가 비우므로 nullptr 과 비교합니다
+  bool changed = render_target_count_ != count ||
+                 depth_stencil_view_ != depth_stencil_view;
+  for (uint32_t i = 0; i < MAX_RENDER_TARGETS; i++) {
+    const void* view = i < count ? views[i] : nullptr;
+    changed = changed || render_targets_[i] != view;
+    render_targets_[i] = view;
+  }
+  render_target_count_ = count;
+  depth_stencil_view_ = depth_stencil_view;
+  return Count(CallType::RENDER_TARGETS, changed);
+}
+
+bool StateFilterClass::SetDepthStencilState(const void* state,
+                                            const uint32_t stencil_ref) {
+  const bool changed =
+      depth_stencil_state_ != state || stencil_ref_ != stencil_ref;
+  depth_stencil_state_ = state;
+  stencil_ref_ = stencil_ref;
+  return Count(CallType::DEPTH_STENCIL_STATE, changed);
+}
+
+bool StateFilterClass::SetBlendState(const void* state,
+                                     const float* blend_factor,
+                                     const uint32_t sample_mask) {
+  bool changed = blend_state_ != state || sample_mask_ != sample_mask;
+  for (uint32_t i = 0; i < 4; i++) {
+    const float factor = blend_factor ? blend_factor[i] : 1.0f;
+    changed = changed || blend_factor_[i] != factor;
+    blend_factor_[i] = factor;
+  }
+  blend_state_ = state;
+  sample_mask_ = sample_mask;
+  return Count(CallType::BLEND_STATE, changed);
+}
+
+bool StateFilterClass::SetRasterizerState(const void* state) {
+  const bool changed = rasterizer_state_ != state;
+  rasterizer_state_ = state;
+  return Count(CallType::RASTERIZER_STATE, changed);
+}
+
+bool StateFilterClass::SetViewports(const uint32_t count,
+                                    const ViewportType* viewports) {
+  if (count > MAX_VIEWPORTS) return Count(CallType::VIEWPORTS, true);
+
+  bool changed = viewport_count_ != count;
+  for (uint32_t i = 0; i < count; i++) {
+    changed = changed || IsSameViewport(viewports_[i], viewports[i]) == false;
+    viewports_[i] = viewports[i];
+  }
+  viewport_count_ = count;
+  return Count(CallType::VIEWPORTS, changed);
+}
+
+bool StateFilterClass::Count(const CallType type, const bool issue) {
+  // 꺼져 있으면 같은 값이어도 호출합니다. 그림자 사본은 계속 맞춰 둡니다
+  const bool issued = issue || enabled_ == false;
+  if (issued)
+    issued_counts_[static_cast<uint32_t>(type)]++;
+  else
+    filtered_counts_[static_cast<uint32_t>(type)]++;
+  return issued;
+}
+
+bool StateFilterClass::SetConstantBuffers(
+    StageType& stage, const CallType type, const uint32_t start,
+    const uint32_t count, const void* const* buffers,
+    const uint32_t* first_constants, const uint32_t* constant_counts,
+    uint32_t& changed_start, uint32_t& changed_count) {
+  changed_start = start;
+  changed_count = count;
+
+  if (start + count > MAX_CONSTANT_BUFFERS) return Count(type, true);
+
+  uint32_t first = UNKNOWN_VALUE, last = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    const ConstantBufferType constant_buffer{
+        buffers[i], first_constants ? first_constants[i] : 0,
+        constant_counts ? constant_counts[i] : 0};
+    ConstantBufferType& slot = stage.constant_buffers_[start + i];
+    if (slot.buffer_ != constant_buffer.buffer_ ||
+        slot.first_constant_ != constant_buffer.first_constant_ ||
+        slot.constant_count_ != constant_buffer.constant_count_) {
+      slot = constant_buffer;
+      ExtendRange(start + i, first, last);
+    }
+  }
+
+  if (first != UNKNOWN_VALUE && enabled_) {
+    changed_start = first;
+    changed_count = last - first + 1;
+  }
+  return Count(type, first != UNKNOWN_VALUE);
+}
@@ -0,0 +1,158 @@
+#pragma once
+#include <cstdint>
+
+// 바인딩된 IA, VS, PS, OM, RS 상태의 그림자 사본을 두고, 새로 설정하려는
+// 값이 이미 바인딩된 값과 같은지 알려 줍니다. 리소스와 상태 객체는 주소로만
+// 비교하므로 그래픽스 API 와 무관하며, 실제 호출은 DeviceContextClass 처럼
+// 이 클래스를 쓰는 쪽이 합니다.
+// Set 함수는 호출해야 하면 true 를 반환하고 그림자 사본을 갱신합니다.
+// 슬롯 배열을 받는 함수는 실제로 바뀐 슬롯 구간만 돌려줍니다.
+class StateFilterClass {
+ public:
+  // D3D11 의 슬롯 수와 같습니다
+  static const uint32_t MAX_VERTEX_BUFFERS = 32;
+  static const uint32_t MAX_CONSTANT_BUFFERS = 14;
+  static const uint32_t MAX_RENDER_TARGETS = 8;
+  static const uint32_t MAX_VIEWPORTS = 16;
+
+  // 카운터를 나누는 호출 종류입니다
+  enum class CallType : uint32_t {
+    INPUT_LAYOUT = 0,
+    VERTEX_BUFFERS,
+    INDEX_BUFFER,
+    PRIMITIVE_TOPOLOGY,
+    VERTEX_SHADER,
+    VERTEX_CONSTANT_BUFFERS,
+    PIXEL_SHADER,
+    PIXEL_CONSTANT_BUFFERS,
+    RENDER_TARGETS,
+    DEPTH_STENCIL_STATE,
+    BLEND_STATE,
+    RASTERIZER_STATE,
+    VIEWPORTS,
+    CALL_TYPE_COUNT,
+  };
+
+  // D3D11_VIEWPORT 와 같은 배치입니다
+  struct ViewportType {
+    float top_left_x_;
+    float top_left_y_;
+    float width_;
+    float height_;
+    float min_depth_;
+    float max_depth_;
+  };
+
+  // 모든 상태를 알 수 없음으로 두고 카운터를 비웁니다
+  StateFilterClass();
+
+  // enabled 가 false 이면 모든 호출을 그대로 통과시킵니다. 카운터는 계속
+  // 셉니다
+  void SetEnabled(const bool enabled);
+  bool IsEnabled();
+
+  // 실제 상태를 알 수 없게 되었을 때 부릅니다 (ClearState, 명령 목록 실행,
+  // 이 클래스를 거치지 않은 호출). 다음 Set 은 모두 통과합니다
+  void Invalidate();
+
+  // 프레임마다 카운터를 비웁니다
+  void ResetCounters();
+  uint32_t GetIssuedCount();
+  uint32_t GetFilteredCount();
+  uint32_t GetIssuedCount(const CallType type);
+  uint32_t GetFilteredCount(const CallType type);
+
+  bool SetInputLayout(const void* layout);
+  // strides, offsets 가 nullptr 이면 0 으로 봅니다
+  bool SetVertexBuffers(const uint32_t start, const uint32_t count,
+                        const void* const* buffers, const uint32_t* strides,
+                        const uint32_t* offsets, uint32_t& changed_start,
+                        uint32_t& changed_count);
+  bool SetIndexBuffer(const void* buffer, const uint32_t format,
+                      const uint32_t offset);
+  bool SetPrimitiveTopology(const uint32_t topology);
+
+  bool SetVertexShader(const void* shader);
+  bool SetPixelShader(const void* shader);
+  // first_constants, constant_counts 가 nullptr 이면 버퍼 전체를
+  // 바인딩합니다 (VSSetConstantBuffers)
+  bool SetVertexConstantBuffers(const uint32_t start, const uint32_t count,
+                                const void* const* buffers,
+                                const uint32_t* first_constants,
+                                const uint32_t* constant_counts,
+                                uint32_t& changed_start,
+                                uint32_t& changed_count);
+  bool SetPixelConstantBuffers(const uint32_t start, const uint32_t count,
+                               const void* const* buffers,
+                               const uint32_t* first_constants,
+                               const uint32_t* constant_counts,
+                               uint32_t& changed_start,
+                               uint32_t& changed_count);
+
+  // count 뒤의 렌더 타겟 슬롯은 비어 있는 것으로 봅니다
+  bool SetRenderTargets(const uint32_t count, const void* const* views,
+                        const void* depth_stencil_view);
+  bool SetDepthStencilState(const void* state, const uint32_t stencil_ref);
+  // blend_factor 가 nullptr 이면 1, 1, 1, 1 로 봅니다
+  bool SetBlendState(const void* state, const float* blend_factor,
+                     const uint32_t sample_mask);
+  bool SetRasterizerState(const void* state);
+  bool SetViewports(const uint32_t count, const ViewportType* viewports);
+
+ private:
+  // 상수 버퍼 슬롯 하나입니다. constant_count_ 가 0 이면 버퍼 전체입니다
+  struct ConstantBufferType {
+    const void* buffer_;
+    uint32_t first_constant_;
+    uint32_t constant_count_;
+  };
+
+  // 셰이더 단계 하나의 셰이더와 상수 버퍼입니다
+  struct StageType {
+    const void* shader_;
+    ConstantBufferType constant_buffers_[MAX_CONSTANT_BUFFERS];
+  };
+
+  // 호출 결과를 세고 그대로 반환합니다
+  bool Count(const CallType type, const bool issue);
+  bool SetConstantBuffers(StageType& stage, const CallType type,
+                          const uint32_t start, const uint32_t count,
+                          const void* const* buffers,
+                          const uint32_t* first_constants,
+                          const uint32_t* constant_counts,
+                          uint32_t& changed_start, uint32_t& changed_count);
+
+  bool enabled_ = true;
+
+  uint32_t issued_counts_[static_cast<uint32_t>(CallType::CALL_TYPE_COUNT)];
+  uint32_t filtered_counts_[static_cast<uint32_t>(CallType::CALL_TYPE_COUNT)];
+
+  // IA
+  const void* input_layout_;
+  const void* vertex_buffers_[MAX_VERTEX_BUFFERS];
+  uint32_t vertex_strides_[MAX_VERTEX_BUFFERS];
+  uint32_t vertex_offsets_[MAX_VERTEX_BUFFERS];
+  const void* index_buffer_;
+  uint32_t index_format_;
+  uint32_t index_offset_;
+  uint32_t primitive_topology_;
+
+  // VS, PS
+  StageType vertex_stage_;
+  StageType pixel_stage_;
+
+  // OM
+  uint32_t render_target_count_;
+  const void* render_targets_[MAX_RENDER_TARGETS];
+  const void* depth_stencil_view_;
+  const void* depth_stencil_state_;
+  uint32_t stencil_ref_;
+  const void* blend_state_;
+  float blend_factor_[4];
+  uint32_t sample_mask_;
+
+  // RS
+  const void* rasterizer_state_;
+  uint32_t viewport_count_;
+  ViewportType viewports_[MAX_VIEWPORTS];
+};
@@ -0,0 +1,129 @@
+#include "pch.h"
+#include "framework/engine_benchmarks.h"
+
+#include <DirectXMath.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "framework/benchmark_class.h"
+#include "framework/job_system_class.h"
+#include "graphic/transform_class.h"
+
+void RegisterTransformBenchmarks(BenchmarkClass& benchmark) {
+  // 위치, 회전, 크기로부터 월드 행렬을 대량으로 만들기
+  for (const uint32_t count : {1000u, 100000u, 1000000u}) {
+    const std::string name =
+        "WorldMatrixGeneration/" + std::to_string(count);
+
+    benchmark.AddFixture(name, count, [count] {
+      struct DataType {
+        std::vector<DirectX::XMFLOAT3> positions_, rotations_;
+        std::vector<float> scales_;
+        std::vector<DirectX::XMFLOAT4X4> worlds_;
+      };
+      auto data = std::make_shared<DataType>();
+
+      std::mt19937 random(1234);
+      std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+      data->positions_.resize(count);
+      data->rotations_.resize(count);
+      data->scales_.resize(count);
+      data->worlds_.resize(count);
+      for (uint32_t i = 0; i < count; i++) {
+        data->positions_[i] = {distribution(random), distribution(random),
+                               distribution(random)};
+        data->rotations_[i] = {distribution(random), distribution(random),
+                               distribution(random)};
+        data->scales_[i] = 1.0f + distribution(random) * 0.001f;
+      }
+
+      return BenchmarkClass::BodyType([data, count](uint64_t iterations) {
+        for (uint64_t n = 0; n < iterations; n++) {
+          for (uint32_t i = 0; i < count; i++) {
+            const DirectX::XMFLOAT3& position = data->positions_[i];
+            const DirectX::XMFLOAT3& rotation = data->rotations_[i];
+            const float scale = data->scales_[i];
+
+            const DirectX::XMMATRIX world =
+                DirectX::XMMatrixScaling(scale, scale, scale) *
+                DirectX::XMMatrixRotationRollPitchYaw(rotation.x, rotation.y,
+                                                      rotation.z) *
+                DirectX::XMMatrixTranslation(position.x, position.y,
+                                             position.z);
+            DirectX::XMStoreFloat4x4(&data->worlds_[i], world);
+          }
+          BenchmarkClass::DoNotOptimize(data->worlds_);
+        }
+      });
+    });
+  }
+
+  // SoA 변환 저장소의 월드 행렬 갱신. 매 반복마다 dirty_percent 만큼의
+  // 변환을 바꾸고 Update 합니다
+  struct TransformCaseType {
+    uint32_t count_;
+    uint32_t dirty_percent_;
+    bool threaded_;
+  };
+  for (const TransformCaseType& transform_case :
+       {TransformCaseType{1000, 100, false},
+        TransformCaseType{100000, 100, false},
+        TransformCaseType{1000000, 100, false},
+        TransformCaseType{1000000, 100, true},
+        TransformCaseType{1000000, 1, false},
+        TransformCaseType{1000000, 1, true}}) {
+    const std::string name =
+        "TransformClass::Update/" + std::to_string(transform_case.count_) +
+        "/dirty" + std::to_string(transform_case.dirty_percent_) + "%" +
+        (transform_case.threaded_ ? "/threaded" : "");
+
+    benchmark.AddFixture(name, transform_case.count_, [transform_case] {
+      struct DataType {
+        TransformClass transforms_;
+        JobSystemClass job_system_;
+        ~DataType() {
+          transforms_.Shutdown();
+          job_system_.Shutdown();
+        }
+      };
+      auto data = std::make_shared<DataType>();
+      if (transform_case.threaded_) data->job_system_.Initialize();
+
+      std::mt19937 random(1234);
+      std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+      const uint32_t count = transform_case.count_;
+      data->transforms_.Initialize(count);
+      for (uint32_t i = 0; i < count; i++) {
+        const int32_t index = data->transforms_.Create();
+        data->transforms_.SetPosition(index, distribution(random),
+                                      distribution(random),
+                                      distribution(random));
+        DirectX::XMFLOAT4 rotation{};
+        DirectX::XMStoreFloat4(
+            &rotation, DirectX::XMQuaternionRotationRollPitchYaw(
+                           distribution(random), distribution(random),
+                           distribution(random)));
+        data->transforms_.SetRotation(index, rotation);
+      }
+      data->transforms_.Update();
+
+      const uint32_t stride = 100 / transform_case.dirty_percent_;
+      const bool threaded = transform_case.threaded_;
+      return BenchmarkClass::BodyType(
+          [data, count, stride, threaded](uint64_t iterations) {
+            TransformClass& transforms = data->transforms_;
+            for (uint64_t n = 0; n < iterations; n++) {
+              const float offset = static_cast<float>(n & 0xFF);
+              for (uint32_t i = 0; i < count; i += stride)
+                transforms.SetScale(i, 1.0f, 1.0f, 1.0f + offset);
+
+              transforms.Update(threaded ? &data->job_system_ : nullptr);
+              BenchmarkClass::DoNotOptimize(transforms.GetWorldMatrices()[0]);
+            }
+          });
+    });
+  }
+}
@@ -0,0 +1,325 @@
+#include "pch.h"
+#include "transform_class.h"
+
+#if !defined(_XM_NO_INTRINSICS_)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "framework/profiler.h"
+#include "framework/job_system_class.h"
+
+namespace {
+
+#if !defined(_XM_NO_INTRINSICS_)
+// 4개 변환의 성분 벡터(행마다 x, y, z, w)를 transpose 해서
+// 변환마다 한 행씩 저장합니다. dirty 가 아닌 변환은 건드리지 않습니다
+void StoreRows(DirectX::XMFLOAT4X4* world, const uint8_t* dirty,
+               const uint32_t row, __m128 x, __m128 y, __m128 z, __m128 w) {
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+  if (dirty[0]) _mm_storeu_ps(world[0].m[row], x);
+  if (dirty[1]) _mm_storeu_ps(world[1].m[row], y);
+  if (dirty[2]) _mm_storeu_ps(world[2].m[row], z);
+  if (dirty[3]) _mm_storeu_ps(world[3].m[row], w);
+}
+#endif
+
+}  // namespace
+
+bool TransformClass::Initialize(const uint32_t capacity) {
+  for (std::vector<float>* component :
+       {&position_x_, &position_y_, &position_z_, &rotation_x_, &rotation_y_,
+        &rotation_z_, &rotation_w_, &scale_x_, &scale_y_, &scale_z_})
+    component->reserve(capacity);
+
+  parent_.reserve(capacity);
+  dirty_.reserve(capacity);
+  world_.reserve(capacity);
+  return true;
+}
+
+void TransformClass::Shutdown() {
+  Clear();
+
+  for (std::vector<float>* component :
+       {&position_x_, &position_y_, &position_z_, &rotation_x_, &rotation_y_,
+        &rotation_z_, &rotation_w_, &scale_x_, &scale_y_, &scale_z_})
+    component->shrink_to_fit();
+
+  parent_.shrink_to_fit();
+  children_.shrink_to_fit();
+  dirty_.shrink_to_fit();
+  world_.shrink_to_fit();
+}
+
+int32_t TransformClass::Create(const int32_t parent) {
+  const int32_t index = static_cast<int32_t>(parent_.size());
+
+  // 한 번의 순차 패스로 부모를 먼저 계산하려면 부모가 앞에 있어야 합니다
+  if (parent >= index) return INVALID_INDEX;
+
+  position_x_.push_back(0.0f);
+  position_y_.push_back(0.0f);
+  position_z_.push_back(0.0f);
+  rotation_x_.push_back(0.0f);
+  rotation_y_.push_back(0.0f);
+  rotation_z_.push_back(0.0f);
+  rotation_w_.push_back(1.0f);
+  scale_x_.push_back(1.0f);
+  scale_y_.push_back(1.0f);
+  scale_z_.push_back(1.0f);
+
+  parent_.push_back(parent);
+  if (parent != INVALID_INDEX) children_.push_back(index);
+
+  dirty_.push_back(1);
+  DirectX::XMFLOAT4X4 identity{};
+  DirectX::XMStoreFloat4x4(&identity, DirectX::XMMatrixIdentity());
+  world_.push_back(identity);
+
+  return index;
+}
+
+void TransformClass::Clear() {
+  for (std::vector<float>* component :
+       {&position_x_, &position_y_, &position_z_, &rotation_x_, &rotation_y_,
+        &rotation_z_, &rotation_w_, &scale_x_, &scale_y_, &scale_z_})
+    component->clear();
+
+  parent_.clear();
+  children_.clear();
+  dirty_.clear();
+  world_.clear();
+  updated_count_ = 0;
+}
+
+void TransformClass::SetPosition(const int32_t index, float x, float y,
+                                 float z) {
+  position_x_[index] = x;
+  position_y_[index] = y;
+  position_z_[index] = z;
+  dirty_[index] = 1;
+}
+
+void TransformClass::SetRotation(const int32_t index,
+                                 const DirectX::XMFLOAT4& quaternion) {
+  rotation_x_[index] = quaternion.x;
+  rotation_y_[index] = quaternion.y;
+  rotation_z_[index] = quaternion.z;
+  rotation_w_[index] = quaternion.w;
+  dirty_[index] = 1;
+}
+
+void TransformClass::SetScale(const int32_t index, float x, float y,
+                              float z) {
+  scale_x_[index] = x;
+  scale_y_[index] = y;
+  scale_z_[index] = z;
+  dirty_[index] = 1;
+}
+
+void TransformClass::Update(JobSystemClass* job_system) {
+  PROFILE_FUNCTION();
+
+  const uint32_t count = GetCount();
+
+  // 부모가 바뀌면 자식도 다시 계산해야 합니다. 부모가 항상 앞에 있으므로
+  // 한 번의 순차 패스로 손자까지 전파됩니다
+  for (const uint32_t child : children_)
+    dirty_[child] |= dirty_[parent_[child]];
+
+  // 로컬 행렬(S * R * T)을 월드 행렬 자리에 계산합니다
+  if (job_system && count > CHUNK_SIZE) {
+    const uint32_t chunk_count = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::atomic<uint32_t> updated{0};
+
+    job_system->ParallelFor(chunk_count, [&](uint32_t chunk) {
+      const uint32_t begin = chunk * CHUNK_SIZE;
+      const uint32_t end = (std::min)(begin + CHUNK_SIZE, count);
+      updated.fetch_add(ComposeLocal(begin, end), std::memory_order_relaxed);
+    });
+    updated_count_ = updated.load(std::memory_order_relaxed);
+  } else {
+    updated_count_ = ComposeLocal(0, count);
+  }
+
+  // 부모의 월드 행렬을 곱하고 dirty 를 지웁니다
+  ApplyParents();
+  if (count > 0) std::memset(dirty_.data(), 0, count);
+}
+
+uint32_t TransformClass::GetCount() {
+  return static_cast<uint32_t>(parent_.size());
+}
+
+int32_t TransformClass::GetParent(const int32_t index) {
+  return parent_[index];
+}
+
+const DirectX::XMFLOAT4X4* TransformClass::GetWorldMatrices() {
+  return world_.data();
+}
+
+uint32_t TransformClass::GetUpdatedCount() { return updated_count_; }
+
+uint32_t TransformClass::ComposeLocal(const uint32_t begin,
+                                      const uint32_t end) {
+  PROFILE_FUNCTION();
+
+  uint32_t updated = 0;
+  uint32_t index = begin;
+
+#if defined(__AVX__)
+  // 8개씩 묶어서 계산합니다. 하나도 바뀌지 않은 묶음은 건너뜁니다
+  for (; index + 8 <= end; index += 8) {
+    uint64_t mask = 0;
+    std::memcpy(&mask, &dirty_[index], sizeof(mask));
+    if (mask == 0) continue;
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 x = _mm256_loadu_ps(&rotation_x_[index]);
+    const __m256 y = _mm256_loadu_ps(&rotation_y_[index]);
+    const __m256 z = _mm256_loadu_ps(&rotation_z_[index]);
+    const __m256 w = _mm256_loadu_ps(&rotation_w_[index]);
+
+    const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y);
+    const __m256 zz = _mm256_mul_ps(z, z), xy = _mm256_mul_ps(x, y);
+    const __m256 xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+    const __m256 xw = _mm256_mul_ps(x, w), yw = _mm256_mul_ps(y, w);
+    const __m256 zw = _mm256_mul_ps(z, w);
+
+    // XMMatrixRotationQuaternion 과 같은 행 우선 회전 행렬에 크기를 곱합니다
+    const __m256 sx = _mm256_loadu_ps(&scale_x_[index]);
+    const __m256 sy = _mm256_loadu_ps(&scale_y_[index]);
+    const __m256 sz = _mm256_loadu_ps(&scale_z_[index]);
+    const __m256 m[12] = {
+        _mm256_mul_ps(sx, _mm256_sub_ps(
+                              one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz)))),
+        _mm256_mul_ps(sx, _mm256_mul_ps(two, _mm256_add_ps(xy, zw))),
+        _mm256_mul_ps(sx, _mm256_mul_ps(two, _mm256_sub_ps(xz, yw))),
+        _mm256_mul_ps(sy, _mm256_mul_ps(two, _mm256_sub_ps(xy, zw))),
+        _mm256_mul_ps(sy, _mm256_sub_ps(
+                              one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz)))),
+        _mm256_mul_ps(sy, _mm256_mul_ps(two, _mm256_add_ps(yz, xw))),
+        _mm256_mul_ps(sz, _mm256_mul_ps(two, _mm256_add_ps(xz, yw))),
+        _mm256_mul_ps(sz, _mm256_mul_ps(two, _mm256_sub_ps(yz, xw))),
+        _mm256_mul_ps(sz, _mm256_sub_ps(
+                              one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy)))),
+        _mm256_loadu_ps(&position_x_[index]),
+        _mm256_loadu_ps(&position_y_[index]),
+        _mm256_loadu_ps(&position_z_[index])};
+
+    // 앞, 뒤 4개씩 나눠 transpose 하여 저장합니다
+    for (uint32_t half = 0; half < 2; half++) {
+      __m128 part[12];
+      for (uint32_t i = 0; i < 12; i++)
+        part[i] = half == 0 ? _mm256_castps256_ps128(m[i])
+                            : _mm256_extractf128_ps(m[i], 1);
+
+      const uint32_t base = index + half * 4;
+      const __m128 zero = _mm_setzero_ps();
+      StoreRows(&world_[base], &dirty_[base], 0, part[0], part[1], part[2],
+                zero);
+      StoreRows(&world_[base], &dirty_[base], 1, part[3], part[4], part[5],
+                zero);
+      StoreRows(&world_[base], &dirty_[base], 2, part[6], part[7], part[8],
+                zero);
+      StoreRows(&world_[base], &dirty_[base], 3, part[9], part[10], part[11],
+                _mm_set1_ps(1.0f));
+    }
+
+    for (uint32_t i = 0; i < 8; i++) updated += dirty_[index + i];
+  }
+#endif
+
+#if !defined(_XM_NO_INTRINSICS_)
+  // 4개씩 묶어서 계산합니다. 하나도 바뀌지 않은 묶음은 건너뜁니다
+  for (; index + 4 <= end; index += 4) {
+    uint32_t mask = 0;
+    std::memcpy(&mask, &dirty_[index], sizeof(mask));
+    if (mask == 0) continue;
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 x = _mm_loadu_ps(&rotation_x_[index]);
+    const __m128 y = _mm_loadu_ps(&rotation_y_[index]);
+    const __m128 z = _mm_loadu_ps(&rotation_z_[index]);
+    const __m128 w = _mm_loadu_ps(&rotation_w_[index]);
+
+    const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y);
+    const __m128 zz = _mm_mul_ps(z, z), xy = _mm_mul_ps(x, y);
+    const __m128 xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+    const __m128 xw = _mm_mul_ps(x, w), yw = _mm_mul_ps(y, w);
+    const __m128 zw = _mm_mul_ps(z, w);
+
+    // XMMatrixRotationQuaternion 과 같은 행 우선 회전 행렬에 크기를 곱합니다
+    const __m128 sx = _mm_loadu_ps(&scale_x_[index]);
+    const __m128 sy = _mm_loadu_ps(&scale_y_[index]);
+    const __m128 sz = _mm_loadu_ps(&scale_z_[index]);
+    const __m128 zero = _mm_setzero_ps();
+
+    StoreRows(
+        &world_[index], &dirty_[index], 0,
+        _mm_mul_ps(sx, _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)))),
+        _mm_mul_ps(sx, _mm_mul_ps(two, _mm_add_ps(xy, zw))),
+        _mm_mul_ps(sx, _mm_mul_ps(two, _mm_sub_ps(xz, yw))), zero);
+    StoreRows(
+        &world_[index], &dirty_[index], 1,
+        _mm_mul_ps(sy, _mm_mul_ps(two, _mm_sub_ps(xy, zw))),
+        _mm_mul_ps(sy, _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)))),
+        _mm_mul_ps(sy, _mm_mul_ps(two, _mm_add_ps(yz, xw))), zero);
+    StoreRows(
+        &world_[index], &dirty_[index], 2,
+        _mm_mul_ps(sz, _mm_mul_ps(two, _mm_add_ps(xz, yw))),
+        _mm_mul_ps(sz, _mm_mul_ps(two, _mm_sub_ps(yz, xw))),
+        _mm_mul_ps(sz, _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)))),
+        zero);
+    StoreRows(&world_[index], &dirty_[index], 3,
+              _mm_loadu_ps(&position_x_[index]),
+              _mm_loadu_ps(&position_y_[index]),
+              _mm_loadu_ps(&position_z_[index]), one);
+
+    for (uint32_t i = 0; i < 4; i++) updated += dirty_[index + i];
+  }
+#endif
+
+  // 남은 변환은 DirectXMath 로 하나씩 계산합니다
+  for (; index < end; index++) {
+    if (dirty_[index] == 0) continue;
+    ComposeLocalScalar(index);
+    updated++;
+  }
+
+  return updated;
+}
+
+void TransformClass::ComposeLocalScalar(const uint32_t index) {
+  const DirectX::XMMATRIX local =
+      DirectX::XMMatrixScaling(scale_x_[index], scale_y_[index],
+                               scale_z_[index]) *
+      DirectX::XMMatrixRotationQuaternion(
+          DirectX::XMVectorSet(rotation_x_[index], rotation_y_[index],
+                               rotation_z_[index], rotation_w_[index])) *
+      DirectX::XMMatrixTranslation(position_x_[index], position_y_[index],
+                                   position_z_[index]);
+  DirectX::XMStoreFloat4x4(&world_[index], local);
+}
+
+void TransformClass::ApplyParents() {
+  PROFILE_FUNCTION();
+
+  // 부모가 앞에 있으므로 오름차순으로 돌면 부모는 이미 월드 행렬입니다
+  for (const uint32_t child : children_) {
+    if (dirty_[child] == 0) continue;
+
+    const DirectX::XMMATRIX local = DirectX::XMLoadFloat4x4(&world_[child]);
+    const DirectX::XMMATRIX parent =
+        DirectX::XMLoadFloat4x4(&world_[parent_[child]]);
+    DirectX::XMStoreFloat4x4(&world_[child],
+                             DirectX::XMMatrixMultiply(local, parent));
+  }
+}
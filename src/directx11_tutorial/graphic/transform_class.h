@@ -0,0 +1,55 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+class JobSystemClass;
+
+// 많은 물체의 위치, 회전(쿼터니언), 크기를 성분별 배열(SoA)로 저장하고
+// 변경된 것만 SIMD 로 묶어 월드 행렬을 다시 계산합니다.
+// 월드 행렬은 transpose 하지 않은 행 우선 행렬로 연속해서 저장되므로
+// ModelClass::InstanceType 으로 그대로 복사할 수 있습니다.
+class TransformClass {
+ public:
+  static const int32_t INVALID_INDEX = -1;
+  // 한 스레드 작업이 맡는 변환 수입니다. SIMD 폭(8)의 배수여야 합니다
+  static const uint32_t CHUNK_SIZE = 16384;
+
+  bool Initialize(const uint32_t capacity);
+  void Shutdown();
+
+  // 단위 변환을 하나 추가하고 인덱스를 반환합니다. 부모는 자식보다 먼저
+  // 만들어져야 합니다
+  int32_t Create(const int32_t parent = INVALID_INDEX);
+  void Clear();
+
+  void SetPosition(const int32_t index, float x, float y, float z);
+  void SetRotation(const int32_t index, const DirectX::XMFLOAT4& quaternion);
+  void SetScale(const int32_t index, float x, float y, float z);
+
+  // 변경된 변환과 그 자손의 월드 행렬을 다시 계산합니다. job_system 이
+  // 있으면 CHUNK_SIZE 단위로 나눠 병렬로 계산합니다
+  void Update(JobSystemClass* job_system = nullptr);
+
+  uint32_t GetCount();
+  int32_t GetParent(const int32_t index);
+  const DirectX::XMFLOAT4X4* GetWorldMatrices();
+  // 마지막 Update 에서 다시 계산한 변환 수입니다
+  uint32_t GetUpdatedCount();
+
+ private:
+  uint32_t ComposeLocal(const uint32_t begin, const uint32_t end);
+  void ComposeLocalScalar(const uint32_t index);
+  void ApplyParents();
+
+ private:
+  std::vector<float> position_x_, position_y_, position_z_;
+  std::vector<float> rotation_x_, rotation_y_, rotation_z_, rotation_w_;
+  std::vector<float> scale_x_, scale_y_, scale_z_;
+  std::vector<int32_t> parent_;
+  // 부모가 있는 변환의 인덱스입니다. 만든 순서대로라 오름차순입니다
+  std::vector<uint32_t> children_;
+  std::vector<uint8_t> dirty_;
+  std::vector<DirectX::XMFLOAT4X4> world_;
+  uint32_t updated_count_ = 0;
+};
@@ -0,0 +1,159 @@
+#include "pch.h"
+#include "upscale_shader_class.h"
+
+#include <d3dcompiler.h>
+
+#include <format>
+
+#include "com_throw.h"
+#include "device_context_class.h"
+#include "shader_cache_class.h"
+#include "framework/profiler.h"
+
+namespace {
+// 컴파일한 셰이더 bytecode 를 보관하는 디렉터리입니다
+const wchar_t* SHADER_CACHE_DIRECTORY = L"shader/cache";
+
+// ShaderCacheClass::Load 에 넘기는 셰이더 순서입니다
+enum ShaderIndex : uint32_t {
+  FULLSCREEN_VERTEX_SHADER = 0,
+  UPSCALE_PIXEL_SHADER,
+  SHADER_COUNT,
+};
+}  // namespace
+
+bool UpscaleShaderClass::Initialize(ResourceManagerClass* resources,
+                                    JobSystemClass* job_system) {
+  resources_ = resources;
+  error_.clear();
+
+  // 두 셰이더를 캐시에서 매핑하고, 캐시에 없는 셰이더만 함께 컴파일합니다
+  const ShaderCacheClass::ShaderDescType shaders[SHADER_COUNT] = {
+      {L"shader/vertex_fullscreen.hlsl", "FullscreenVertexShader", "vs_5_0",
+       {}, D3D10_SHADER_ENABLE_STRICTNESS},
+      {L"shader/pixel_upscale.hlsl", "UpscalePixelShader", "ps_5_0", {},
+       D3D10_SHADER_ENABLE_STRICTNESS},
+  };
+
+  ShaderCacheClass shader_cache{};
+  shader_cache.Initialize(SHADER_CACHE_DIRECTORY, ShaderCacheClass::CompileD3D,
+                          D3D_COMPILER_VERSION);
+  const bool loaded = shader_cache.Load(shaders, SHADER_COUNT, job_system);
+
+  OutputDebugStringA(std::format("Upscale shader cache: {} hit, {} compiled\n",
+                                 shader_cache.GetHitCount(),
+                                 shader_cache.GetMissCount())
+                         .c_str());
+
+  if (loaded == false) {
+    for (uint32_t i = 0; i < SHADER_COUNT; i++)
+      if (shader_cache.GetBytecode(i) == nullptr)
+        AppendShaderError(shader_cache.GetError(i), shaders[i].path_);
+    return false;
+  }
+
+  // bytecode 로부터 정점 및 픽셀 셰이더를 생성합니다
+  vertex_shader_ = resources_->CreateVertexShader(
+      shader_cache.GetBytecode(FULLSCREEN_VERTEX_SHADER),
+      shader_cache.GetBytecodeSize(FULLSCREEN_VERTEX_SHADER));
+  pixel_shader_ = resources_->CreatePixelShader(
+      shader_cache.GetBytecode(UPSCALE_PIXEL_SHADER),
+      shader_cache.GetBytecodeSize(UPSCALE_PIXEL_SHADER));
+
+  // 매핑한 캐시 파일은 셰이더 객체를 만든 뒤에는 필요 없습니다
+  shader_cache.Shutdown();
+
+  // 두 셰이더가 함께 쓰는 텍스처 좌표 상수 버퍼를 만듭니다
+  D3D11_BUFFER_DESC upscale_buffer_desc{};
+  upscale_buffer_desc.Usage = D3D11_USAGE_DYNAMIC;
+  upscale_buffer_desc.ByteWidth = sizeof(UpscaleBufferType);
+  upscale_buffer_desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+  upscale_buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+  upscale_buffer_desc.MiscFlags = 0;
+  upscale_buffer_desc.StructureByteStride = 0;
+
+  upscale_buffer_ = resources_->CreateBuffer(upscale_buffer_desc, nullptr);
+
+  // 텍셀 사이를 선형으로 보간하는 샘플러 상태를 만듭니다
+  D3D11_SAMPLER_DESC sampler_desc{};
+  sampler_desc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+  sampler_desc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+  sampler_desc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+  sampler_desc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+  sampler_desc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+  sampler_desc.MaxLOD = D3D11_FLOAT32_MAX;
+
+  com::ThrowIfFailed(resources_->GetDevice()->CreateSamplerState(
+      &sampler_desc, &sampler_state_));
+
+  constants_ = {};
+  return true;
+}
+
+void UpscaleShaderClass::Shutdown() {
+  if (sampler_state_) {
+    sampler_state_->Release();
+    sampler_state_ = nullptr;
+  }
+
+  if (resources_ == nullptr) return;
+
+  resources_->Release(upscale_buffer_);
+  resources_->Release(pixel_shader_);
+  resources_->Release(vertex_shader_);
+}
+
+void UpscaleShaderClass::Render(DeviceContextClass* device_context,
+                                ID3D11ShaderResourceView* source,
+                                const uint32_t width, const uint32_t height,
+                                const uint32_t source_width,
+                                const uint32_t source_height) {
+  PROFILE_FUNCTION();
+
+  // 쓰인 영역의 배율과, 가장자리에서 바깥 텍셀이 섞이지 않도록 마지막 텍셀
+  // 중심까지의 좌표를 계산합니다
+  const UpscaleBufferType constants = {
+      {static_cast<float>(width) / source_width,
+       static_cast<float>(height) / source_height},
+      {(width - 0.5f) / source_width, (height - 0.5f) / source_height}};
+
+  ID3D11Buffer* upscale_buffer = resources_->Get(upscale_buffer_);
+  if (constants.uv_scale_.x != constants_.uv_scale_.x ||
+      constants.uv_scale_.y != constants_.uv_scale_.y ||
+      constants.uv_max_.x != constants_.uv_max_.x ||
+      constants.uv_max_.y != constants_.uv_max_.y) {
+    D3D11_MAPPED_SUBRESOURCE mapped_resource{};
+    com::ThrowIfFailed(device_context->GetContext()->Map(
+        upscale_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource));
+    *reinterpret_cast<UpscaleBufferType*>(mapped_resource.pData) = constants;
+    device_context->GetContext()->Unmap(upscale_buffer, 0);
+    constants_ = constants;
+  }
+
+  // 정점은 셰이더가 정점 번호로 만드므로 input layout 이 없습니다
+  device_context->IASetInputLayout(nullptr);
+  device_context->IASetPrimitiveTopology(
+      D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+  device_context->VSSetShader(resources_->Get(vertex_shader_));
+  device_context->VSSetConstantBuffers(0, 1, &upscale_buffer);
+  device_context->PSSetShader(resources_->Get(pixel_shader_));
+  device_context->PSSetConstantBuffers(0, 1, &upscale_buffer);
+
+  // 텍스처와 샘플러, 인덱스 없는 드로우는 상태 필터가 다루지 않으므로
+  // 컨텍스트로 직접 호출합니다
+  ID3D11DeviceContext* context = device_context->GetContext();
+  context->PSSetShaderResources(0, 1, &source);
+  context->PSSetSamplers(0, 1, &sampler_state_);
+  context->Draw(3, 0);
+
+  ID3D11ShaderResourceView* null_view = nullptr;
+  context->PSSetShaderResources(0, 1, &null_view);
+}
+
+const std::string& UpscaleShaderClass::GetError() { return error_; }
+
+void UpscaleShaderClass::AppendShaderError(const std::string& error_message,
+                                           const std::filesystem::path& path) {
+  error_ += "Error compiling shader " + path.string() + "\n" + error_message;
+  if (error_.back() != '\n') error_ += '\n';
+}
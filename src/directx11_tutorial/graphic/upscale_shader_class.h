@@ -0,0 +1,53 @@
+#pragma once
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <filesystem>
+#include <string>
+
+#include "resource_manager_class.h"
+
+class DeviceContextClass;
+class JobSystemClass;
+
+// 낮은 해상도로 그린 장면 텍스처를 화면을 덮는 삼각형 하나로 렌더 타겟에
+// bilinear 로 늘려 그립니다. 정점 버퍼와 input layout 은 쓰지 않습니다
+class UpscaleShaderClass {
+ public:
+  // vertex_fullscreen.hlsl 과 pixel_upscale.hlsl 의 상수 버퍼입니다
+  struct UpscaleBufferType {
+    DirectX::XMFLOAT2 uv_scale_;
+    DirectX::XMFLOAT2 uv_max_;
+  };
+
+  // job_system 이 있으면 캐시에 없는 셰이더를 병렬로 컴파일합니다.
+  // 셰이더와 상수 버퍼는 resources 에서 만들고 핸들로 들고 있습니다.
+  // 작업 스레드에서 불릴 수 있으므로 창을 띄우지 않습니다. 실패하면
+  // GetError 로 이유를 읽어 호출한 쪽에서 알립니다
+  bool Initialize(ResourceManagerClass* resources,
+                  JobSystemClass* job_system = nullptr);
+  void Shutdown();
+  // 마지막 Initialize 가 실패한 이유입니다
+  const std::string& GetError();
+
+  // source_width x source_height 크기인 source 의 왼쪽 위 width x height
+  // 영역을 지금 바인딩한 렌더 타겟의 뷰포트 전체로 늘려 그립니다. 그린 뒤
+  // source 를 풀어 다음 프레임에 렌더 타겟으로 쓸 수 있게 합니다
+  void Render(DeviceContextClass* device_context,
+              ID3D11ShaderResourceView* source, const uint32_t width,
+              const uint32_t height, const uint32_t source_width,
+              const uint32_t source_height);
+
+ private:
+  // 컴파일 오류를 error_ 에 덧붙입니다
+  void AppendShaderError(const std::string& error_message,
+                         const std::filesystem::path& path);
+
+  std::string error_;
+  ResourceManagerClass* resources_ = nullptr;
+  ResourceManagerClass::VertexShaderHandleType vertex_shader_{};
+  ResourceManagerClass::PixelShaderHandleType pixel_shader_{};
+  ResourceManagerClass::BufferHandleType upscale_buffer_{};
+  ID3D11SamplerState* sampler_state_ = nullptr;
+  // 상수 버퍼에 마지막으로 올린 값입니다. 배율이 바뀔 때만 다시 올립니다
+  UpscaleBufferType constants_{};
+};
@@ -0,0 +1,222 @@
+#pragma once
+#if defined(_WIN32)
+#include <d3d11.h>
+#endif
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "mesh_file_class.h"
+
+// 정점 구조체가 속성을 한 번만 선언하면 input layout, stride, 메시 파일
+// 속성을 컴파일 타임에 만들어 주는 반영(reflection) 계층입니다.
+//
+//   template <>
+//   struct VertexAttributes<MyVertex> {
+//     static constexpr VertexAttributeType ATTRIBUTES[] = {
+//         VERTEX_ATTRIBUTE(MyVertex, position_, "POSITION", 0),
+//         VERTEX_ATTRIBUTE(MyVertex, color_, "COLOR", 0)};
+//   };
+//
+// 포맷은 멤버 타입에서 정해지고, 속성이 선언 순서대로 빈틈 없이 구조체를
+// 덮지 않으면 static_assert 로 빌드가 실패합니다.
+// D3D11 이 없는 빌드에서는 input layout 없이 stride 와 메시 파일 속성만
+// 만듭니다.
+
+struct VertexAttributeType {
+  const char* semantic_;
+  uint32_t semantic_index_;
+  MeshFileClass::FormatType file_format_;
+  uint32_t offset_;
+  uint32_t rows_;  // 행렬은 행마다 요소 하나로 펼칩니다
+  uint32_t row_size_;
+#if defined(_WIN32)
+  DXGI_FORMAT format_;
+#endif
+};
+
+#if defined(_WIN32)
+namespace vertex_layout {
+constexpr uint32_t GetFormatSize(const DXGI_FORMAT format) {
+  switch (format) {
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+      return 16;
+    case DXGI_FORMAT_R32G32B32_FLOAT:
+      return 12;
+    case DXGI_FORMAT_R32G32_FLOAT:
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R16G16B16A16_SNORM:
+      return 8;
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R32_FLOAT:
+      return 4;
+    default:
+      return 0;
+  }
+}
+}  // namespace vertex_layout
+
+#define VERTEX_GPU_FORMAT(format, row_size)                         \
+  static constexpr DXGI_FORMAT FORMAT = format;                     \
+  static_assert(vertex_layout::GetFormatSize(format) == row_size,   \
+                "member size does not match its DXGI format");
+#define VERTEX_ATTRIBUTE_GPU_FORMAT(member_type) \
+  , VertexFormatTraits<member_type>::FORMAT
+#else
+#define VERTEX_GPU_FORMAT(format, row_size)
+#define VERTEX_ATTRIBUTE_GPU_FORMAT(member_type)
+#endif
+
+// 멤버 타입별 GPU 포맷과 메시 파일 포맷입니다
+template <typename Member>
+struct VertexFormatTraits;
+
+#define VERTEX_FORMAT_TRAITS(type, format, file_format, rows)          \
+  template <>                                                          \
+  struct VertexFormatTraits<type> {                                    \
+    static constexpr MeshFileClass::FormatType FILE_FORMAT =           \
+        MeshFileClass::FormatType::file_format;                        \
+    static constexpr uint32_t ROWS = rows;                             \
+    static constexpr uint32_t ROW_SIZE = sizeof(type) / rows;          \
+    VERTEX_GPU_FORMAT(format, ROW_SIZE)                                \
+  };
+
+VERTEX_FORMAT_TRAITS(DirectX::XMFLOAT2, DXGI_FORMAT_R32G32_FLOAT, FLOAT2, 1)
+VERTEX_FORMAT_TRAITS(DirectX::XMFLOAT3, DXGI_FORMAT_R32G32B32_FLOAT, FLOAT3, 1)
+VERTEX_FORMAT_TRAITS(DirectX::XMFLOAT4, DXGI_FORMAT_R32G32B32A32_FLOAT, FLOAT4,
+                     1)
+VERTEX_FORMAT_TRAITS(DirectX::XMFLOAT4X4, DXGI_FORMAT_R32G32B32A32_FLOAT,
+                     UNKNOWN, 4)
+VERTEX_FORMAT_TRAITS(DirectX::PackedVector::XMSHORTN4,
+                     DXGI_FORMAT_R16G16B16A16_SNORM, SNORM16X4, 1)
+VERTEX_FORMAT_TRAITS(DirectX::PackedVector::XMHALF4,
+                     DXGI_FORMAT_R16G16B16A16_FLOAT, HALF4, 1)
+VERTEX_FORMAT_TRAITS(DirectX::PackedVector::XMUBYTEN4,
+                     DXGI_FORMAT_R8G8B8A8_UNORM, UNORM8X4, 1)
+
+#undef VERTEX_FORMAT_TRAITS
+#undef VERTEX_GPU_FORMAT
+
+// 정점 구조체마다 특수화해서 ATTRIBUTES 배열을 선언합니다
+template <typename Vertex>
+struct VertexAttributes;
+
+#define VERTEX_ATTRIBUTE(vertex, member, semantic, semantic_index)         \
+  VertexAttributeType {                                                    \
+    semantic, semantic_index,                                              \
+        VertexFormatTraits<decltype(vertex::member)>::FILE_FORMAT,         \
+        static_cast<uint32_t>(offsetof(vertex, member)),                   \
+        VertexFormatTraits<decltype(vertex::member)>::ROWS,                \
+        VertexFormatTraits<decltype(vertex::member)>::ROW_SIZE             \
+            VERTEX_ATTRIBUTE_GPU_FORMAT(decltype(vertex::member))          \
+  }
+
+namespace vertex_layout {
+template <typename Vertex>
+constexpr uint32_t CountElements() {
+  uint32_t count = 0;
+  for (const VertexAttributeType& attribute :
+       VertexAttributes<Vertex>::ATTRIBUTES)
+    count += attribute.rows_;
+  return count;
+}
+
+// 속성이 선언 순서대로 겹치거나 빈틈 없이 구조체 전체를 덮는지 확인합니다
+template <typename Vertex>
+constexpr bool CoversStruct() {
+  uint32_t end = 0;
+  for (const VertexAttributeType& attribute :
+       VertexAttributes<Vertex>::ATTRIBUTES) {
+    if (attribute.offset_ != end) return false;
+    end += attribute.rows_ * attribute.row_size_;
+  }
+  return end == sizeof(Vertex);
+}
+
+template <typename Vertex>
+constexpr auto MakeFileAttributes() {
+  constexpr size_t COUNT = std::size(VertexAttributes<Vertex>::ATTRIBUTES);
+  std::array<MeshFileClass::AttributeType, COUNT> attributes{};
+  for (size_t i = 0; i < COUNT; i++) {
+    const VertexAttributeType& source = VertexAttributes<Vertex>::ATTRIBUTES[i];
+    MeshFileClass::AttributeType& attribute = attributes[i];
+    for (size_t c = 0;
+         source.semantic_[c] != '\0' && c + 1 < sizeof(attribute.semantic_);
+         c++)
+      attribute.semantic_[c] = source.semantic_[c];
+    attribute.semantic_index_ = source.semantic_index_;
+    attribute.format_ = source.file_format_;
+    attribute.offset_ = source.offset_;
+  }
+  return attributes;
+}
+
+#if defined(_WIN32)
+template <typename Vertex, uint32_t SLOT,
+          D3D11_INPUT_CLASSIFICATION CLASSIFICATION>
+constexpr auto MakeInputElements() {
+  std::array<D3D11_INPUT_ELEMENT_DESC, CountElements<Vertex>()> elements{};
+  uint32_t index = 0;
+  for (const VertexAttributeType& attribute :
+       VertexAttributes<Vertex>::ATTRIBUTES) {
+    for (uint32_t row = 0; row < attribute.rows_; row++) {
+      D3D11_INPUT_ELEMENT_DESC& element = elements[index++];
+      element.SemanticName = attribute.semantic_;
+      element.SemanticIndex = attribute.semantic_index_ + row;
+      element.Format = attribute.format_;
+      element.InputSlot = SLOT;
+      element.AlignedByteOffset = attribute.offset_ + row * attribute.row_size_;
+      element.InputSlotClass = CLASSIFICATION;
+      element.InstanceDataStepRate =
+          CLASSIFICATION == D3D11_INPUT_PER_INSTANCE_DATA ? 1 : 0;
+    }
+  }
+  return elements;
+}
+
+// 여러 정점 스트림의 요소 배열을 하나의 input layout 으로 잇습니다
+template <size_t FIRST, size_t SECOND>
+constexpr std::array<D3D11_INPUT_ELEMENT_DESC, FIRST + SECOND> Concat(
+    const std::array<D3D11_INPUT_ELEMENT_DESC, FIRST>& first,
+    const std::array<D3D11_INPUT_ELEMENT_DESC, SECOND>& second) {
+  std::array<D3D11_INPUT_ELEMENT_DESC, FIRST + SECOND> elements{};
+  for (size_t i = 0; i < FIRST; i++) elements[i] = first[i];
+  for (size_t i = 0; i < SECOND; i++) elements[FIRST + i] = second[i];
+  return elements;
+}
+#endif
+}  // namespace vertex_layout
+
+// Vertex 의 input layout 과 메시 파일 속성입니다. 모두 constexpr 이라
+// 실행 중에 배치를 만들지 않습니다
+#if defined(_WIN32)
+template <typename Vertex, uint32_t SLOT = 0,
+          D3D11_INPUT_CLASSIFICATION CLASSIFICATION =
+              D3D11_INPUT_PER_VERTEX_DATA>
+#else
+template <typename Vertex>
+#endif
+class VertexLayoutClass {
+  static_assert(vertex_layout::CoversStruct<Vertex>(),
+                "vertex attributes must cover the struct in declaration "
+                "order without padding");
+
+ public:
+  static constexpr uint32_t STRIDE = sizeof(Vertex);
+  static constexpr uint32_t ELEMENT_COUNT =
+      vertex_layout::CountElements<Vertex>();
+  static constexpr uint32_t ATTRIBUTE_COUNT =
+      static_cast<uint32_t>(std::size(VertexAttributes<Vertex>::ATTRIBUTES));
+
+#if defined(_WIN32)
+  static constexpr std::array<D3D11_INPUT_ELEMENT_DESC, ELEMENT_COUNT>
+      INPUT_ELEMENTS =
+          vertex_layout::MakeInputElements<Vertex, SLOT, CLASSIFICATION>();
+#endif
+  static constexpr std::array<MeshFileClass::AttributeType, ATTRIBUTE_COUNT>
+      FILE_ATTRIBUTES = vertex_layout::MakeFileAttributes<Vertex>();
+};
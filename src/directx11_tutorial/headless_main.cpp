@@ -0,0 +1,27 @@
+#include "pch.h"
+#include "framework/command_line.h"
+#include "framework/headless_class.h"
+
+// 윈도우 없이 프레임 루프만 돌리는 콘솔 프로그램입니다. 통계는 표준 출력으로
+// 나가고, 실패하면 0 이 아닌 값으로 끝나므로 CI 에서 그대로 쓸 수 있습니다
+int main(int argc, char** argv) {
+  HeadlessClass::Options options{};
+  if (HeadlessClass::ParseOptions(command_line::GetArguments(argc, argv),
+                                  options) == false) {
+    HeadlessClass::PrintUsage();
+    return 2;
+  }
+
+  HeadlessClass* headless = new HeadlessClass{};
+  if (headless == nullptr) return 1;
+
+  int32_t exit_code = 0;
+  if (headless->Initialize(options) == false || headless->Run() == false)
+    exit_code = 1;
+
+  headless->Shutdown();
+  delete headless;
+  headless = nullptr;
+
+  return exit_code;
+}
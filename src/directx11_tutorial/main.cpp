@@ -4,6 +4,8 @@
 int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
                       _In_opt_ HINSTANCE hPrevInstance, _In_ LPWSTR lpCmdLine,
                       _In_ int nCmdShow) {
+  // 윈도우 없이 프레임 루프만 돌리려면 directx11_tutorial_headless 를,
+  // 마이크로벤치마크는 directx11_tutorial_benchmark 를 실행합니다
   SystemClass* system = new SystemClass{};
   if (system == nullptr) return -1;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#if defined(_WIN32)
 #include <SDKDDKVer.h>
 #define WIN32_LEAN_AND_MEAN  // Exclude rarely-used stuff from Windows headers
 // Windows Header Files
@@ -11,3 +12,9 @@
 #include <tchar.h>
 
 #include "dx.h"
+#else
+// GPU 없는 빌드는 소프트웨어 렌더러와 이식 가능한 코어만 컴파일합니다
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#endif
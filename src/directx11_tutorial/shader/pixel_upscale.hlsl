@@ -0,0 +1,20 @@
+cbuffer UpscaleBuffer
+{
+    float2 uvScale;
+    float2 uvMax;
+};
+
+struct PixelInputType
+{
+    float4 position : SV_POSITION;
+    float2 uv : TEXCOORD0;
+};
+
+Texture2D sceneTexture;
+SamplerState linearSampler;
+
+float4 UpscalePixelShader(PixelInputType input) : SV_TARGET
+{
+    // 쓰이지 않은 영역이 가장자리에 섞이지 않도록 마지막 텍셀 중심까지만 읽습니다
+    return sceneTexture.Sample(linearSampler, min(input.uv, uvMax));
+}
@@ -0,0 +1,26 @@
+cbuffer UpscaleBuffer
+{
+    // 장면 타겟에서 쓰인 영역의 텍스처 좌표 배율과 샘플링할 최대 좌표입니다
+    float2 uvScale;
+    float2 uvMax;
+};
+
+struct PixelInputType
+{
+    float4 position : SV_POSITION;
+    float2 uv : TEXCOORD0;
+};
+
+PixelInputType FullscreenVertexShader(uint vertexId : SV_VertexID)
+{
+    PixelInputType output;
+
+    // 정점 버퍼 없이 정점 번호로 화면을 덮는 삼각형 하나를 만듭니다
+    float2 uv = float2((vertexId << 1) & 2, vertexId & 2);
+    output.position = float4(uv * float2(2.0f, -2.0f) + float2(-1.0f, 1.0f), 0.0f, 1.0f);
+
+    // 장면 타겟은 쓰인 영역보다 클 수 있으므로 그 영역으로 좁힙니다
+    output.uv = uv * uvScale;
+
+    return output;
+}
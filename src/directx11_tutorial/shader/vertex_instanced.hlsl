@@ -0,0 +1,40 @@
+cbuffer FrameBuffer
+{
+    matrix viewProjectionMatrix;
+};
+
+struct VertexInputType
+{
+    float4 position : POSITION;
+    float4 color : COLOR;
+    float4 world0 : WORLD0;
+    float4 world1 : WORLD1;
+    float4 world2 : WORLD2;
+    float4 world3 : WORLD3;
+    float4 instanceColor : INSTANCECOLOR;
+};
+
+struct PixelInputType
+{
+    float4 position : SV_POSITION;
+    float4 color : COLOR;
+};
+
+PixelInputType ColorVertexShader(VertexInputType input)
+{
+    PixelInputType output;
+
+    // 적절한 행렬 계산을 위해 벡터를 4 단위로 변경합니다
+    input.position.w = 1.0f;
+
+    // 인스턴스 스트림으로 들어온 월드 행렬과 프레임당 한 번 올린 뷰-투영 행렬로
+    // 정점의 위치를 계산합니다
+    float4x4 worldMatrix = float4x4(input.world0, input.world1, input.world2, input.world3);
+    output.position = mul(input.position, worldMatrix);
+    output.position = mul(output.position, viewProjectionMatrix);
+
+    // 정점 색상에 인스턴스 색상을 곱해 픽셀 쉐이더로 넘깁니다
+    output.color = input.color * input.instanceColor;
+
+    return output;
+}
@@ -0,0 +1,32 @@
+cbuffer MatrixBuffer
+{
+    matrix worldViewProjectionMatrix;
+};
+
+struct VertexInputType
+{
+    float4 position : POSITION;
+    float4 color : COLOR;
+};
+
+struct PixelInputType
+{
+    float4 position : SV_POSITION;
+    float4 color : COLOR;
+};
+
+PixelInputType ColorVertexShader(VertexInputType input)
+{
+    PixelInputType output;
+
+    // 적절한 행렬 계산을 위해 벡터를 4 단위로 변경합니다
+    input.position.w = 1.0f;
+
+    // CPU 에서 미리 곱해 둔 월드-뷰-투영 행렬로 정점의 위치를 한 번에 계산합니다
+    output.position = mul(input.position, worldViewProjectionMatrix);
+
+    // 픽셀 쉐이더가 사용할 입력 색상을 저장합니다
+    output.color = input.color;
+
+    return output;
+}
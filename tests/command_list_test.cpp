@@ -0,0 +1,219 @@
+#include "pch.h"
+#include "graphic/command_list_class.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "framework/job_system_class.h"
+#include "test.h"
+
+namespace {
+const uint32_t CHUNK_COUNT = 16;
+const uint32_t DRAWS_PER_CHUNK = 500;
+
+// 받은 호출을 인자와 함께 한 줄씩 남기는 가짜 대상입니다. 명령 목록을
+// 재생한 결과와 같은 호출을 바로 한 결과를 비교합니다
+class LogTargetClass {
+ public:
+  std::vector<std::string> lines_;
+
+  void SetInputLayout(const void* layout) { Log("IL %p", layout); }
+  void SetVertexBuffers(const uint32_t start, const uint32_t count,
+                        const void* const* buffers, const uint32_t* strides,
+                        const uint32_t* offsets) {
+    Log("VB %u %u", start, count);
+    for (uint32_t i = 0; i < count; i++)
+      Log(" %p %u %u", buffers[i], strides ? strides[i] : 0,
+          offsets ? offsets[i] : 0);
+  }
+  void SetIndexBuffer(const void* buffer, const uint32_t format,
+                      const uint32_t offset) {
+    Log("IB %p %u %u", buffer, format, offset);
+  }
+  void SetPrimitiveTopology(const uint32_t topology) {
+    Log("PT %u", topology);
+  }
+  void SetVertexShader(const void* shader) { Log("VS %p", shader); }
+  void SetPixelShader(const void* shader) { Log("PS %p", shader); }
+  void SetVertexConstantBuffers(const uint32_t start, const uint32_t count,
+                                const void* const* buffers,
+                                const uint32_t* first_constants,
+                                const uint32_t* constant_counts) {
+    LogConstantBuffers("VC", start, count, buffers, first_constants,
+                       constant_counts);
+  }
+  void SetPixelConstantBuffers(const uint32_t start, const uint32_t count,
+                               const void* const* buffers,
+                               const uint32_t* first_constants,
+                               const uint32_t* constant_counts) {
+    LogConstantBuffers("PC", start, count, buffers, first_constants,
+                       constant_counts);
+  }
+  void SetRenderTargets(const uint32_t count, const void* const* views,
+                        const void* depth_stencil_view) {
+    Log("RT %u %p", count, depth_stencil_view);
+    for (uint32_t i = 0; i < count; i++) Log(" %p", views[i]);
+  }
+  void SetDepthStencilState(const void* state, const uint32_t stencil_ref) {
+    Log("DS %p %u", state, stencil_ref);
+  }
+  void SetBlendState(const void* state, const float* blend_factor,
+                     const uint32_t sample_mask) {
+    const float ones[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    const float* factor = blend_factor ? blend_factor : ones;
+    Log("BS %p %g %g %g %g %x", state, factor[0], factor[1], factor[2],
+        factor[3], sample_mask);
+  }
+  void SetRasterizerState(const void* state) { Log("RS %p", state); }
+  void SetViewports(const uint32_t count,
+                    const StateFilterClass::ViewportType* viewports) {
+    Log("VP %u", count);
+    for (uint32_t i = 0; i < count; i++)
+      Log(" %g %g %g %g %g %g", viewports[i].top_left_x_,
+          viewports[i].top_left_y_, viewports[i].width_,
+          viewports[i].height_, viewports[i].min_depth_,
+          viewports[i].max_depth_);
+  }
+  void DrawIndexed(const uint32_t index_count, const uint32_t start_index,
+                   const int32_t base_vertex) {
+    Log("DI %u %u %d", index_count, start_index, base_vertex);
+  }
+  void DrawIndexedInstanced(const uint32_t index_count,
+                            const uint32_t instance_count,
+                            const uint32_t start_index,
+                            const int32_t base_vertex,
+                            const uint32_t start_instance) {
+    Log("DII %u %u %u %d %u", index_count, instance_count, start_index,
+        base_vertex, start_instance);
+  }
+
+ private:
+  template <typename... Arguments>
+  void Log(const char* format, Arguments... arguments) {
+    char line[128];
+    std::snprintf(line, sizeof(line), format, arguments...);
+    if (format[0] == ' ')
+      lines_.back() += line;
+    else
+      lines_.push_back(line);
+  }
+
+  void LogConstantBuffers(const char* name, const uint32_t start,
+                          const uint32_t count, const void* const* buffers,
+                          const uint32_t* first_constants,
+                          const uint32_t* constant_counts) {
+    Log("%s %u %u %d", name, start, count, first_constants != nullptr);
+    for (uint32_t i = 0; i < count; i++)
+      Log(" %p %u %u", buffers[i], first_constants ? first_constants[i] : 0,
+          constant_counts ? constant_counts[i] : 0);
+  }
+};
+
+const void* Handle(const uintptr_t value) {
+  return reinterpret_cast<const void*>(value * 16);
+}
+
+// 묶음 번호만으로 정해지는 명령들을 기록합니다. 묶음마다 프레임 상태를
+// 먼저 다시 바인딩하므로 묶음은 서로 독립입니다
+template <typename Target>
+void RecordChunk(Target& target, const uint32_t chunk) {
+  const void* render_target = Handle(90);
+  target.SetRenderTargets(1, &render_target, Handle(91));
+  target.SetDepthStencilState(Handle(92), 1);
+  target.SetRasterizerState(Handle(50));
+  const float blend_factor[4] = {0.25f, 0.5f, 0.75f, 1.0f};
+  target.SetBlendState(Handle(93), chunk % 2 ? blend_factor : nullptr,
+                       0xffffffff);
+  const StateFilterClass::ViewportType viewport = {0.0f, 0.0f, 640.0f,
+                                                   480.0f, 0.0f, 1.0f};
+  target.SetViewports(1, &viewport);
+  target.SetPrimitiveTopology(4);
+
+  std::mt19937 random(chunk * 7 + 1);
+  for (uint32_t draw = 0; draw < DRAWS_PER_CHUNK; draw++) {
+    target.SetInputLayout(Handle(1 + random() % 2));
+    target.SetVertexShader(Handle(1 + random() % 2));
+    target.SetPixelShader(Handle(1));
+
+    const void* buffers[2] = {Handle(10 + random() % 3),
+                              Handle(20 + random() % 2)};
+    const uint32_t strides[2] = {16, 80};
+    const uint32_t offsets[2] = {0, 64};
+    if (random() % 2)
+      target.SetVertexBuffers(0, 2, buffers, strides, offsets);
+    else
+      target.SetVertexBuffers(0, 1, buffers, strides, nullptr);
+    target.SetIndexBuffer(Handle(30 + random() % 2), 57, 0);
+
+    // 링 버퍼 조각과 버퍼 전체 바인딩을 섞습니다
+    const void* constant_buffer = Handle(40);
+    const uint32_t first_constant = chunk * DRAWS_PER_CHUNK + draw;
+    const uint32_t constant_count = 16;
+    if (draw % 3)
+      target.SetVertexConstantBuffers(0, 1, &constant_buffer,
+                                      &first_constant, &constant_count);
+    else
+      target.SetPixelConstantBuffers(1, 1, &constant_buffer, nullptr,
+                                     nullptr);
+
+    if (draw % 5)
+      target.DrawIndexed(3 * (1 + random() % 100), random() % 1000,
+                         -static_cast<int32_t>(draw));
+    else
+      target.DrawIndexedInstanced(36, 1 + random() % 64, 0, 0, draw);
+  }
+}
+
+// 묶음들을 작업 시스템에서 따로 기록하고, 묶음 순서대로 재생합니다
+std::vector<std::string> RecordAndExecute(
+    JobSystemClass& job_system, std::vector<CommandListClass>& lists) {
+  job_system.ParallelFor(CHUNK_COUNT, [&](uint32_t chunk) {
+    lists[chunk].Reset();
+    RecordChunk(lists[chunk], chunk);
+  });
+
+  LogTargetClass target;
+  for (const CommandListClass& list : lists) list.Execute(target);
+  return target.lines_;
+}
+}  // namespace
+
+int main() {
+  // 같은 호출을 바로 한 결과가 기준입니다
+  LogTargetClass expected;
+  for (uint32_t chunk = 0; chunk < CHUNK_COUNT; chunk++)
+    RecordChunk(expected, chunk);
+
+  JobSystemClass job_system;
+  CHECK(job_system.Initialize(3));
+
+  // 병렬 기록과 재생이 바로 호출한 것과 같은 순서, 같은 인자이고, 몇 번을
+  // 되풀이해도 같아야 합니다. 목록은 Reset 해서 다시 씁니다
+  std::vector<CommandListClass> lists(CHUNK_COUNT);
+  for (uint32_t run = 0; run < 5; run++) {
+    const std::vector<std::string> lines = RecordAndExecute(job_system, lists);
+    CHECK(lines.size() == expected.lines_.size());
+    CHECK(lines == expected.lines_);
+  }
+
+  // 묶음 하나는 프레임 상태 6 개와 드로우마다 명령 7 개입니다
+  CHECK(lists[0].GetCommandCount() == 6 + 7 * DRAWS_PER_CHUNK);
+  const size_t size = lists[0].GetSize();
+  lists[0].Reset();
+  CHECK(lists[0].GetCommandCount() == 0 && lists[0].GetSize() == 0);
+  RecordChunk(lists[0], 0);
+  CHECK(lists[0].GetSize() == size);
+
+  // 목록은 다른 목록으로도 재생할 수 있습니다
+  CommandListClass copy;
+  lists[3].Execute(copy);
+  LogTargetClass original, copied;
+  lists[3].Execute(original);
+  copy.Execute(copied);
+  CHECK(original.lines_ == copied.lines_);
+
+  job_system.Shutdown();
+  return test::Finish();
+}
@@ -0,0 +1,72 @@
+#include "pch.h"
+#include "graphic/constant_ring_allocator_class.h"
+
+#include "test.h"
+
+namespace {
+void TestReserveNoOverwrite() {
+  ConstantRingAllocatorClass ring;
+  CHECK(ring.Initialize(1024, true));
+
+  uint32_t offset = 0;
+  bool discard = false;
+
+  // 첫 예약은 항상 discard 이고, 이후에는 정렬된 오프셋으로 이어 씁니다
+  CHECK(ring.Reserve(10, offset, discard) && offset == 0 && discard);
+  CHECK(ring.Reserve(256, offset, discard) && offset == 256 && !discard);
+  CHECK(ring.Reserve(512, offset, discard) && offset == 512 && !discard);
+
+  // 남은 공간이 없으면 처음으로 돌아갑니다
+  CHECK(ring.Reserve(1, offset, discard) && offset == 0 && discard);
+  CHECK(ring.GetUsedBytes() == 256);
+  CHECK(ring.GetDiscardCount() == 2);
+
+  // 용량보다 큰 예약은 실패합니다
+  CHECK(ring.Reserve(2000, offset, discard) == false);
+  CHECK(ring.Reserve(0, offset, discard) == false);
+}
+
+void TestReserveDiscard() {
+  ConstantRingAllocatorClass ring;
+  CHECK(ring.Initialize(1024, false));
+
+  uint32_t offset = 0;
+  bool discard = false;
+
+  // 덮어쓰기를 못 하면 매 예약이 처음부터입니다
+  CHECK(ring.Reserve(1, offset, discard) && offset == 0 && discard);
+  CHECK(ring.Reserve(1, offset, discard) && offset == 0 && discard);
+}
+
+void TestGrowCapacity() {
+  const uint32_t MAX = ConstantRingAllocatorClass::MAX_CAPACITY;
+  uint32_t grown = 0;
+
+  CHECK(ConstantRingAllocatorClass::GrowCapacity(1024, 3000, grown));
+  CHECK(grown == 4096);
+
+  // 0 에서 시작해도 멈춥니다
+  CHECK(ConstantRingAllocatorClass::GrowCapacity(0, 1000, grown));
+  CHECK(grown == 1024);
+
+  // 두 배가 최대 크기를 넘으면 최대 크기에서 멈춥니다
+  CHECK(ConstantRingAllocatorClass::GrowCapacity(96u << 20, 100u << 20,
+                                                 grown));
+  CHECK(grown == MAX);
+  CHECK(ConstantRingAllocatorClass::GrowCapacity(MAX, MAX, grown));
+  CHECK(grown == MAX);
+
+  // count * stride 가 uint32 를 넘는 배치는 실패합니다
+  const uint64_t huge = static_cast<uint64_t>(20000000) * 256;
+  CHECK(ConstantRingAllocatorClass::GrowCapacity(MAX, huge, grown) == false);
+  CHECK(ConstantRingAllocatorClass::GrowCapacity(1024, uint64_t{MAX} + 1,
+                                                 grown) == false);
+}
+}  // namespace
+
+int main() {
+  TestReserveNoOverwrite();
+  TestReserveDiscard();
+  TestGrowCapacity();
+  return test::Finish();
+}
@@ -0,0 +1,265 @@
+#include "pch.h"
+#include "graphic/dynamic_resolution_class.h"
+
+#include <algorithm>
+#include <random>
+
+#include "graphic/presenter_class.h"
+#include "graphic/render_target_pool_class.h"
+#include "test.h"
+
+namespace {
+const int64_t MILLISECOND = 1000000;
+const uint32_t WIDTH = 1280;
+const uint32_t HEIGHT = 720;
+
+// 해제되면 살아 있는 수를 줄이는 가짜 렌더 타겟입니다
+struct FakeTargetType {
+  uint32_t* live_count_;
+
+  void Release() {
+    (*live_count_)--;
+    delete this;
+  }
+};
+
+using TargetPoolType = RenderTargetPoolClass<FakeTargetType>;
+
+// 장면의 비용은 그리는 픽셀 수, 즉 배율의 제곱에 비례합니다
+double SceneMilliseconds(const double full_milliseconds, const float scale) {
+  return full_milliseconds * scale * scale;
+}
+
+void TestSettings() {
+  DynamicResolutionClass resolution;
+  DynamicResolutionClass::SettingsType settings;
+  CHECK(resolution.Initialize(settings));
+  CHECK(resolution.GetScale() == settings.max_scale_);
+
+  DynamicResolutionClass::SettingsType invalid = settings;
+  invalid.budget_milliseconds_ = 0.0;
+  CHECK(resolution.Initialize(invalid) == false);
+  invalid = settings;
+  invalid.min_scale_ = 0.0f;
+  CHECK(resolution.Initialize(invalid) == false);
+  invalid = settings;
+  invalid.min_scale_ = invalid.max_scale_ + 0.1f;
+  CHECK(resolution.Initialize(invalid) == false);
+  invalid = settings;
+  invalid.scale_step_ = 0.0f;
+  CHECK(resolution.Initialize(invalid) == false);
+
+  // 재지 못한 프레임은 배율을 바꾸지 않습니다
+  CHECK(resolution.Update(0.0) == settings.max_scale_);
+  CHECK(resolution.Update(-5.0) == settings.max_scale_);
+
+  CHECK(resolution.GetScaledSize(WIDTH) == WIDTH);
+  CHECK(resolution.GetScaledSize(0) == 1);
+  for (uint32_t i = 0; i < 200; i++) resolution.Update(100.0);
+  CHECK(resolution.GetScale() == settings.min_scale_);
+  CHECK(resolution.GetScaledSize(WIDTH) == WIDTH / 2);
+  CHECK(resolution.GetScaledSize(1) == 1);
+
+  resolution.Reset();
+  CHECK(resolution.GetScale() == settings.max_scale_);
+}
+
+// 예산 근처에서 흔들리는 프레임 시간에는 배율을 바꾸지 않습니다
+void TestNoiseIsIgnored() {
+  DynamicResolutionClass resolution;
+  CHECK(resolution.Initialize({}));
+
+  std::mt19937 random(7);
+  std::uniform_real_distribution<double> noise(-0.6, 0.6);
+  for (uint32_t frame = 0; frame < 1000; frame++)
+    CHECK(resolution.Update(15.6 + noise(random)) == 1.0f);
+}
+
+// 무거운 장면에서 배율을 낮추고 가벼워지면 되돌리는 동안, 배율대로 빌린
+// 장면 타겟은 단위로 올린 크기 덕분에 몇 개만 만들어 돌려 씁니다
+void TestClosedLoopWithTargetPool() {
+  DynamicResolutionClass resolution;
+  DynamicResolutionClass::SettingsType settings;
+  CHECK(resolution.Initialize(settings));
+
+  uint32_t live_count = 0;
+  TargetPoolType pool;
+  CHECK(pool.Initialize(64, 3));
+  const auto create = [&live_count](const TargetPoolType::DescType&) {
+    live_count++;
+    return new FakeTargetType{&live_count};
+  };
+
+  std::mt19937 random(1);
+  std::normal_distribution<double> noise(0.0, 0.8);
+  float scale = resolution.GetScale();
+  uint32_t change_count = 0;
+  for (uint32_t frame = 0; frame < 600; frame++) {
+    const double full_milliseconds = frame < 300 ? 30.0 : 12.0;
+    const double milliseconds =
+        SceneMilliseconds(full_milliseconds, scale) + 1.0 + noise(random);
+    const float updated = resolution.Update(milliseconds);
+    if (updated != scale) change_count++;
+    scale = updated;
+
+    // 무거운 구간 끝에는 예산 근처에 머뭅니다
+    if (frame == 299) {
+      CHECK(scale < settings.max_scale_);
+      CHECK(SceneMilliseconds(full_milliseconds, scale) + 1.0 <
+            settings.budget_milliseconds_ * 1.15);
+    }
+
+    // 배율이 1 보다 작으면 D3DClass 처럼 장면 타겟을 빌립니다
+    if (scale < 1.0f) {
+      const TargetPoolType::DescType desc{resolution.GetScaledSize(WIDTH),
+                                          resolution.GetScaledSize(HEIGHT), 1};
+      FakeTargetType* target = pool.Acquire(desc, create);
+      CHECK(target != nullptr);
+      const TargetPoolType::DescType allocated = pool.GetAllocatedDesc(target);
+      CHECK(allocated.width_ >= desc.width_ && allocated.width_ % 64 == 0);
+      CHECK(allocated.height_ >= desc.height_ && allocated.height_ % 64 == 0);
+      pool.Release(target);
+    }
+    pool.EndFrame();
+  }
+
+  CHECK(scale == settings.max_scale_);
+  CHECK(change_count < 30);
+  CHECK(pool.GetCreateCount() <= change_count);
+  // 배율이 1 로 돌아와 빌리지 않으므로 쉬던 타겟은 모두 해제됐습니다
+  CHECK(pool.GetTargetCount() == 0);
+  CHECK(live_count == 0);
+  pool.Shutdown();
+}
+
+void TestTargetPoolReuse() {
+  uint32_t live_count = 0;
+  TargetPoolType pool;
+  CHECK(pool.Initialize(0, 3) == false);
+  CHECK(pool.Initialize(64, 3));
+  const auto create = [&live_count](const TargetPoolType::DescType&) {
+    live_count++;
+    return new FakeTargetType{&live_count};
+  };
+
+  FakeTargetType* first = pool.Acquire({700, 500, 1}, create);
+  CHECK(pool.GetAllocatedDesc(first).width_ == 704);
+  CHECK(pool.GetAllocatedDesc(first).height_ == 512);
+  pool.Release(first);
+
+  // 조금 작아진 요청은 같은 타겟을, 커진 요청과 다른 형식은 새 타겟을 씁니다
+  CHECK(pool.Acquire({650, 480, 1}, create) == first);
+  pool.Release(first);
+  FakeTargetType* larger = pool.Acquire({800, 600, 1}, create);
+  CHECK(larger != first);
+  pool.Release(larger);
+  FakeTargetType* other_format = pool.Acquire({640, 480, 2}, create);
+  CHECK(other_format != first && other_format != larger);
+  CHECK(live_count == 3);
+
+  // 빌려 준 타겟은 쉬지 않은 것이므로 해제하지 않습니다
+  for (uint32_t frame = 0; frame < 5; frame++) {
+    pool.EndFrame();
+    FakeTargetType* target = pool.Acquire({800, 600, 1}, create);
+    CHECK(target == larger);
+    pool.Release(target);
+  }
+  CHECK(live_count == 2);
+  CHECK(pool.GetTargetCount() == 2);
+  CHECK(pool.GetCreateCount() == 3);
+  CHECK(pool.Acquire({640, 480, 3}, [](const TargetPoolType::DescType&) {
+          return static_cast<FakeTargetType*>(nullptr);
+        }) == nullptr);
+
+  pool.Shutdown();
+  CHECK(live_count == 0);
+}
+
+// 시간이 호출자가 넘길 때만 흐르는 시계입니다
+struct MockClockType {
+  int64_t now_ = 0;
+
+  int64_t Now() { return now_; }
+  void SleepUntil(const int64_t time) { now_ = (std::max)(now_, time); }
+};
+
+// 수직 동기로 표시하는 지연 1 프레임 스왑 체인입니다. GPU 가 끝낸 프레임은
+// 다음 vblank 에 표시되고, 그때까지 다음 프레임은 대기열에 들어가지 못합니다
+struct VsyncSwapChainType {
+  MockClockType* clock_;
+  int64_t refresh_period_;
+  int64_t gpu_end_ = 0;
+  int64_t flip_time_ = 0;
+  // 마지막으로 잰 GPU 프레임 시간입니다
+  int64_t gpu_time_ = 0;
+
+  void WaitForFrameLatency() {
+    clock_->now_ = (std::max)(clock_->now_, flip_time_);
+  }
+
+  void Present(const int64_t gpu_time) {
+    gpu_time_ = gpu_time;
+    gpu_end_ = (std::max)(clock_->now_, gpu_end_) + gpu_time;
+    flip_time_ =
+        (gpu_end_ + refresh_period_ - 1) / refresh_period_ * refresh_period_;
+  }
+};
+
+// 수직 동기에서는 프레임 간격이 화면 주기 밑으로 내려가지 않으므로, 대기열을
+// 기다린 시간까지 해상도 조절에 넣으면 장면이 가벼워져도 배율을 되돌리지
+// 못합니다
+void TestVsyncRecovers() {
+  PresenterClass::SettingsType present;
+  present.mode_ = PresenterClass::ModeType::VSYNC;
+  PresenterClass presenter;
+  CHECK(presenter.Initialize(present, false));
+
+  DynamicResolutionClass resolution;
+  DynamicResolutionClass::SettingsType settings;
+  CHECK(resolution.Initialize(settings));
+
+  MockClockType clock;
+  VsyncSwapChainType swap_chain{&clock, 16666667};
+  const int64_t cpu_time = 2 * MILLISECOND;
+  float scale = resolution.GetScale();
+  for (uint32_t frame = 0; frame < 800; frame++) {
+    presenter.WaitForNextFrame(clock, swap_chain);
+    scale = resolution.Update(
+        static_cast<double>(presenter.GetBusyTime(swap_chain.gpu_time_)) /
+        1e6);
+
+    if (frame > 2) {
+      CHECK(presenter.GetFrameInterval() >= swap_chain.refresh_period_);
+      CHECK(presenter.GetWorkTime() == cpu_time);
+      // GPU 시간을 모르면 CPU 가 일한 시간만 봅니다
+      CHECK(presenter.GetBusyTime(0) == cpu_time);
+    }
+    if (frame == 399) CHECK(scale < settings.max_scale_);
+
+    const double full_milliseconds = frame < 400 ? 30.0 : 8.0;
+    clock.now_ += cpu_time;
+    swap_chain.Present(static_cast<int64_t>(
+        SceneMilliseconds(full_milliseconds, scale) * MILLISECOND));
+  }
+  CHECK(scale == settings.max_scale_);
+
+  // 수직 동기를 끄면 대기열을 기다린 시간은 GPU 가 밀린 시간이므로 넣습니다
+  presenter.SetMode(PresenterClass::ModeType::UNCAPPED, 0.0);
+  presenter.WaitForNextFrame(clock, swap_chain);
+  clock.now_ += cpu_time;
+  swap_chain.Present(20 * MILLISECOND);
+  presenter.WaitForNextFrame(clock, swap_chain);
+  CHECK(presenter.GetLatencyWaitTime() > 0);
+  CHECK(presenter.GetBusyTime(0) ==
+        presenter.GetWorkTime() + presenter.GetLatencyWaitTime());
+}
+}  // namespace
+
+int main() {
+  TestSettings();
+  TestNoiseIsIgnored();
+  TestClosedLoopWithTargetPool();
+  TestTargetPoolReuse();
+  TestVsyncRecovers();
+  return test::Finish();
+}
@@ -0,0 +1,141 @@
+#include "pch.h"
+#include "framework/allocation_counter.h"
+#include "framework/frame_arena_class.h"
+#include "framework/job_system_class.h"
+#include "framework/pool_allocator_class.h"
+#include "graphic/graphics_class.h"
+
+#include <cstring>
+#include <vector>
+
+#include "test.h"
+
+namespace {
+const uint32_t WARMUP_FRAMES = 10;
+const uint32_t MEASURED_FRAMES = 200;
+
+// 작업 스레드 여럿이 함께 할당해도 정렬과 내용이 맞고, 영역이 넉넉하면
+// 프레임 동안 힙을 쓰지 않는지 봅니다
+void TestFrameArena(JobSystemClass& job_system) {
+  const uint32_t ALLOCATION_COUNT = 1000;
+
+  FrameArenaClass arena;
+  CHECK(arena.Initialize(64 * 1024, 2));
+  std::vector<unsigned char*> pointers(ALLOCATION_COUNT);
+
+  for (uint32_t frame = 0; frame < 6; frame++) {
+    arena.BeginFrame();
+    const uint64_t allocation_start = allocation_counter::GetAllocationCount();
+
+    job_system.ParallelFor(ALLOCATION_COUNT, [&](uint32_t i) {
+      const size_t size = 7 + i % 5;
+      pointers[i] = static_cast<unsigned char*>(
+          arena.Allocate(size, size_t{8} << (i % 3)));
+      std::memset(pointers[i], static_cast<int>(i & 0xff), size);
+    });
+
+    uint32_t wrong = 0;
+    for (uint32_t i = 0; i < ALLOCATION_COUNT; i++) {
+      const size_t alignment = size_t{8} << (i % 3);
+      wrong += reinterpret_cast<uintptr_t>(pointers[i]) % alignment != 0;
+      for (size_t k = 0; k < 7 + i % 5; k++)
+        wrong += pointers[i][k] != static_cast<unsigned char>(i & 0xff);
+    }
+    CHECK(wrong == 0);
+    CHECK(allocation_counter::GetAllocationCount() == allocation_start);
+  }
+
+  CHECK(arena.GetOverflowCount() == 0);
+  arena.Shutdown();
+}
+
+// 영역이 모자라면 힙으로 넘기고, 다음에 그 영역을 쓸 때는 키워서 다시
+// 넘치지 않습니다
+void TestFrameArenaOverflow() {
+  FrameArenaClass arena;
+  CHECK(arena.Initialize(1024, 1));
+
+  arena.BeginFrame();
+  CHECK(arena.Allocate(4096) != nullptr);
+  CHECK(arena.GetOverflowCount() == 1);
+
+  arena.BeginFrame();
+  const uint64_t allocation_start = allocation_counter::GetAllocationCount();
+  CHECK(arena.Allocate(4096) != nullptr);
+  CHECK(arena.GetOverflowCount() == 1);
+  CHECK(allocation_counter::GetAllocationCount() == allocation_start);
+  arena.Shutdown();
+}
+
+// 받아 둔 슬롯 안에서는 Create/Destroy 가 힙을 쓰지 않습니다
+void TestPoolAllocator() {
+  struct ItemType {
+    uint64_t value_;
+    double weight_;
+  };
+
+  PoolAllocatorClass<ItemType, 16> pool;
+  CHECK(pool.Initialize(40));
+  CHECK(pool.GetCapacity() == 48);
+
+  std::vector<ItemType*> items;
+  items.reserve(48);
+
+  const uint64_t allocation_start = allocation_counter::GetAllocationCount();
+  for (uint32_t round = 0; round < 100; round++) {
+    for (uint64_t i = 0; i < 48; i++)
+      items.push_back(pool.Create(ItemType{i, 0.5}));
+    for (ItemType* item : items) pool.Destroy(item);
+    items.clear();
+  }
+  CHECK(allocation_counter::GetAllocationCount() == allocation_start);
+  CHECK(pool.GetLiveCount() == 0 && pool.GetCapacity() == 48);
+
+  // 넘치면 묶음을 더 받고, 살아 있는 객체의 주소는 그대로입니다
+  for (uint64_t i = 0; i < 49; i++)
+    items.push_back(pool.Create(ItemType{i, 0.5}));
+  CHECK(pool.GetCapacity() == 64);
+  CHECK(items[3]->value_ == 3 && items[48]->value_ == 48);
+  for (ItemType* item : items) pool.Destroy(item);
+  pool.Shutdown();
+}
+
+// 소프트웨어 렌더러로 프레임 루프를 돌려, 워밍업 뒤 N 프레임 동안 힙
+// 할당이 한 번도 없는지 봅니다. directx11_tutorial_headless 의
+// --require-zero-alloc 과 같은 검사입니다
+void TestFrameLoop() {
+  GraphicsClass graphics;
+  CHECK(graphics.InitializeSoftware(320, 240));
+
+  bool rendered = true;
+  for (uint32_t i = 0; i < WARMUP_FRAMES; i++)
+    rendered = graphics.Frame() && rendered;
+
+  const uint64_t allocation_start = allocation_counter::GetAllocationCount();
+  const uint64_t bytes_start = allocation_counter::GetAllocatedBytes();
+  for (uint32_t i = 0; i < MEASURED_FRAMES; i++)
+    rendered = graphics.Frame() && rendered;
+  const uint64_t allocation_count =
+      allocation_counter::GetAllocationCount() - allocation_start;
+  const uint64_t allocated_bytes =
+      allocation_counter::GetAllocatedBytes() - bytes_start;
+
+  CHECK(rendered);
+  CHECK(allocation_count == 0);
+  CHECK(allocated_bytes == 0);
+  graphics.Shutdown();
+}
+}  // namespace
+
+int main() {
+  JobSystemClass job_system;
+  CHECK(job_system.Initialize(3));
+
+  TestFrameArena(job_system);
+  job_system.Shutdown();
+
+  TestFrameArenaOverflow();
+  TestPoolAllocator();
+  TestFrameLoop();
+  return test::Finish();
+}
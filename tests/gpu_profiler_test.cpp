@@ -0,0 +1,247 @@
+#include "pch.h"
+#include "graphic/gpu_profiler_class.h"
+
+#include <cstring>
+#include <vector>
+
+#include "test.h"
+
+namespace {
+// 쿼리를 넣은 순서대로 끝내는 가짜 GPU 입니다. 타임스탬프는 End 할 때마다
+// tick_step_ 씩 흐르고, completed_frame_ 보다 앞선 프레임의 쿼리만 결과가
+// 있습니다
+struct FakeGpuType {
+  struct QueryStateType {
+    uint64_t ticks_ = 0;
+    uint64_t frame_ = 0;
+    bool disjoint_ = false;
+    bool live_ = false;
+  };
+
+  std::vector<QueryStateType> queries_;
+  uint64_t clock_ = 1000;
+  uint64_t tick_step_ = 500;
+  uint64_t frequency_ = 1000000000;
+  uint64_t frame_ = 0;
+  uint64_t completed_frame_ = 0;
+  bool disjoint_ = false;
+  // 0 이 아니면 이 번호의 쿼리가 닫는 시각을 앞당겨 돌려줍니다
+  uint32_t early_query_ = 0;
+  uint32_t end_count_ = 0;
+
+  uint32_t GetLiveCount() const {
+    uint32_t count = 0;
+    for (const QueryStateType& query : queries_)
+      if (query.live_) count++;
+    return count;
+  }
+};
+
+struct FakeBackendType {
+  using QueryType = uint32_t;
+
+  FakeGpuType* gpu_ = nullptr;
+
+  QueryType CreateTimestamp() { return Create(); }
+  QueryType CreateDisjoint() { return Create(); }
+  void Release(const QueryType query) { gpu_->queries_[query].live_ = false; }
+  void Begin(const QueryType) {}
+  void End(const QueryType query) {
+    FakeGpuType::QueryStateType& state = gpu_->queries_[query];
+    gpu_->clock_ += gpu_->tick_step_;
+    state.ticks_ = query == gpu_->early_query_ ? 0 : gpu_->clock_;
+    state.frame_ = gpu_->frame_;
+    state.disjoint_ = gpu_->disjoint_;
+    gpu_->end_count_++;
+  }
+  bool GetTimestamp(const QueryType query, uint64_t& ticks) {
+    const FakeGpuType::QueryStateType& state = gpu_->queries_[query];
+    if (state.frame_ >= gpu_->completed_frame_) return false;
+    ticks = state.ticks_;
+    return true;
+  }
+  bool GetDisjoint(const QueryType query, uint64_t& frequency,
+                   bool& disjoint) {
+    const FakeGpuType::QueryStateType& state = gpu_->queries_[query];
+    if (state.frame_ >= gpu_->completed_frame_) return false;
+    frequency = gpu_->frequency_;
+    disjoint = state.disjoint_;
+    return true;
+  }
+
+ private:
+  QueryType Create() {
+    gpu_->queries_.push_back({});
+    gpu_->queries_.back().live_ = true;
+    return static_cast<QueryType>(gpu_->queries_.size() - 1);
+  }
+};
+
+using ProfilerType = GpuProfilerClass<FakeBackendType>;
+
+const uint32_t FRAME_COUNT = 3;
+const uint32_t MAX_SCOPES = 4;
+const int64_t CPU_FRAME_TIME = 1000000;
+
+// 프레임 구간 안에 A(B), C(D(E)) 를 엽니다. 프레임 구간을 포함해 넷까지만
+// 재므로 D 와 E 는 재지 않습니다
+void RecordFrame(ProfilerType& profiler, FakeGpuType& gpu,
+                 const uint64_t frame) {
+  gpu.frame_ = frame;
+  profiler.BeginFrame(CPU_FRAME_TIME * static_cast<int64_t>(frame));
+  {
+    ScopedGpuZone a(&profiler, "A");
+    ScopedGpuZone b(&profiler, "B");
+  }
+  {
+    ScopedGpuZone c(&profiler, "C");
+    ScopedGpuZone d(&profiler, "D");
+    ScopedGpuZone e(&profiler, "E");
+  }
+  ScopedGpuZone<ProfilerType> none(nullptr, "none");
+  profiler.EndFrame();
+}
+
+void TestInitialize() {
+  FakeGpuType gpu;
+  ProfilerType profiler;
+  CHECK(profiler.Initialize({&gpu}, 0, MAX_SCOPES) == false);
+  CHECK(profiler.Initialize({&gpu}, FRAME_COUNT, 0) == false);
+  CHECK(gpu.GetLiveCount() == 0);
+
+  // 쿼리는 모두 처음에 만들고 Shutdown 에서 모두 해제합니다
+  CHECK(profiler.Initialize({&gpu}, FRAME_COUNT, MAX_SCOPES));
+  CHECK(gpu.GetLiveCount() == FRAME_COUNT * (1 + 2 * MAX_SCOPES));
+  const size_t query_count = gpu.queries_.size();
+  for (uint64_t frame = 0; frame < 8; frame++) {
+    gpu.completed_frame_ = frame;
+    RecordFrame(profiler, gpu, frame);
+  }
+  CHECK(gpu.queries_.size() == query_count);
+  profiler.Shutdown();
+  CHECK(gpu.GetLiveCount() == 0);
+}
+
+void TestZones() {
+  FakeGpuType gpu;
+  ProfilerType profiler;
+  CHECK(profiler.Initialize({&gpu}, FRAME_COUNT, MAX_SCOPES));
+
+  // GPU 가 두 프레임 늦게 끝내도 기다리지 않고 끝난 프레임만 읽습니다
+  for (uint64_t frame = 0; frame < 10; frame++) {
+    gpu.completed_frame_ = frame >= 2 ? frame - 1 : 0;
+    RecordFrame(profiler, gpu, frame);
+  }
+  CHECK(profiler.GetResolvedFrameCount() == 8);
+  CHECK(profiler.GetDroppedFrameCount() == 0);
+
+  // 재는 구간마다 End 두 번, 프레임마다 disjoint 쿼리 End 한 번입니다
+  CHECK(gpu.end_count_ == 10 * (2 * MAX_SCOPES + 1));
+
+  const std::vector<ProfilerType::ZoneType>& zones = profiler.GetZones();
+  CHECK(zones.size() == MAX_SCOPES);
+  if (zones.size() != MAX_SCOPES) return;
+  CHECK(std::strcmp(zones[0].name_, "GPU frame") == 0 && zones[0].depth_ == 0);
+  CHECK(std::strcmp(zones[1].name_, "A") == 0 && zones[1].depth_ == 1);
+  CHECK(std::strcmp(zones[2].name_, "B") == 0 && zones[2].depth_ == 2);
+  CHECK(std::strcmp(zones[3].name_, "C") == 0 && zones[3].depth_ == 1);
+
+  // 가장 최근에 읽은 프레임 7 의 첫 타임스탬프를 그 프레임의 CPU 시각에
+  // 맞추고, 나머지는 틱을 나노초로 바꾼 만큼 뒤입니다. 열고 닫는 순서는
+  // frame A B /B /A C /C /frame 입니다
+  const int64_t origin = 7 * CPU_FRAME_TIME;
+  CHECK(zones[0].begin_ == origin);
+  CHECK(zones[0].end_ == origin + 7 * 500);
+  CHECK(zones[1].begin_ == origin + 1 * 500);
+  CHECK(zones[1].end_ == origin + 4 * 500);
+  CHECK(zones[2].begin_ == origin + 2 * 500);
+  CHECK(zones[2].end_ == origin + 3 * 500);
+  CHECK(zones[3].begin_ == origin + 5 * 500);
+  CHECK(zones[3].end_ == origin + 6 * 500);
+  CHECK(profiler.GetFrameTime() == 7 * 500);
+
+  profiler.Shutdown();
+}
+
+void TestStallAndDisjoint() {
+  FakeGpuType gpu;
+  ProfilerType profiler;
+  CHECK(profiler.Initialize({&gpu}, FRAME_COUNT, MAX_SCOPES));
+  for (uint64_t frame = 0; frame < 10; frame++) {
+    gpu.completed_frame_ = frame >= 2 ? frame - 1 : 0;
+    RecordFrame(profiler, gpu, frame);
+  }
+
+  // GPU 가 프레임 8 에서 멈추면 읽은 묶음 하나만 더 쓰고, 그 뒤의
+  // 프레임은 기다리지 않고 건너뜁니다
+  const uint64_t resolved = profiler.GetResolvedFrameCount();
+  const uint32_t end_count = gpu.end_count_;
+  for (uint64_t frame = 10; frame < 15; frame++)
+    RecordFrame(profiler, gpu, frame);
+  CHECK(profiler.GetDroppedFrameCount() == 4);
+  CHECK(profiler.GetResolvedFrameCount() == resolved);
+  CHECK(gpu.end_count_ == end_count + 2 * MAX_SCOPES + 1);
+
+  // 시계가 흔들린 프레임은 버리고, 지난 결과를 그대로 둡니다
+  gpu.completed_frame_ = 1000;
+  gpu.disjoint_ = true;
+  RecordFrame(profiler, gpu, 20);
+  const int64_t frame_time = profiler.GetFrameTime();
+  const uint64_t dropped = profiler.GetDroppedFrameCount();
+  gpu.disjoint_ = false;
+  RecordFrame(profiler, gpu, 21);
+  CHECK(profiler.GetDroppedFrameCount() == dropped + 1);
+  CHECK(profiler.GetFrameTime() == frame_time);
+
+  // 다음 프레임부터 다시 읽습니다
+  RecordFrame(profiler, gpu, 22);
+  CHECK(profiler.GetResolvedFrameCount() > resolved);
+  CHECK(profiler.GetZones().size() == MAX_SCOPES);
+  CHECK(profiler.GetZones()[0].begin_ == 21 * CPU_FRAME_TIME);
+
+  profiler.Shutdown();
+  CHECK(gpu.GetLiveCount() == 0);
+}
+
+void TestTimeConversion() {
+  FakeGpuType gpu;
+  ProfilerType profiler;
+  CHECK(profiler.Initialize({&gpu}, FRAME_COUNT, MAX_SCOPES));
+
+  // 1 MHz 시계의 틱 하나는 1 us 입니다. 프레임 구간이 CPU 프레임보다 길면
+  // 다음 프레임은 지난 프레임의 GPU 끝 시각부터 놓습니다
+  gpu.frequency_ = 1000000;
+  gpu.tick_step_ = 400;
+  gpu.completed_frame_ = 1000;
+  RecordFrame(profiler, gpu, 0);
+  RecordFrame(profiler, gpu, 1);
+  RecordFrame(profiler, gpu, 2);
+  const std::vector<ProfilerType::ZoneType>& zones = profiler.GetZones();
+  CHECK(profiler.GetFrameTime() == 7 * 400 * 1000);
+  CHECK(zones[0].begin_ == 7 * 400 * 1000);
+
+  // 닫는 시각을 여는 시각보다 앞서 돌려줘도 구간 길이는 음수가 되지
+  // 않습니다. 프레임 3 은 묶음 0 을 쓰므로, disjoint 쿼리 0 번 뒤의
+  // 타임스탬프 중 A 를 닫는 3 번째가 쿼리 1 + 3 번입니다
+  gpu.early_query_ = 1 + 3;
+  RecordFrame(profiler, gpu, 3);
+  RecordFrame(profiler, gpu, 4);
+  CHECK(zones.size() == MAX_SCOPES);
+  CHECK(std::strcmp(zones[1].name_, "A") == 0);
+  CHECK(zones[1].end_ == zones[1].begin_);
+  for (const ProfilerType::ZoneType& zone : zones) {
+    CHECK(zone.end_ >= zone.begin_);
+    CHECK(zone.begin_ >= zones[0].begin_);
+  }
+
+  profiler.Shutdown();
+}
+}  // namespace
+
+int main() {
+  TestInitialize();
+  TestZones();
+  TestStallAndDisjoint();
+  TestTimeConversion();
+  return test::Finish();
+}
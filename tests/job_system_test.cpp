@@ -0,0 +1,113 @@
+#include "pch.h"
+#include "framework/job_system_class.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+
+namespace {
+const uint32_t ROUNDS = 100;
+
+// 모든 인덱스가 정확히 한 번씩 실행되는지 봅니다
+void TestParallelForCoverage(JobSystemClass& job_system) {
+  for (uint32_t round = 0; round < ROUNDS; round++) {
+    const uint32_t count = 1 + round * 7919 % 100000;
+    std::vector<std::atomic<uint32_t>> hits(count);
+    job_system.ParallelFor(count, [&](uint32_t index) {
+      hits[index].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    uint32_t wrong = 0;
+    for (uint32_t i = 0; i < count; i++) wrong += hits[i] != 1;
+    CHECK(wrong == 0);
+  }
+}
+
+// 작업 안에서 다시 ParallelFor 를 불러도 교착되지 않아야 합니다
+void TestNestedParallelFor(JobSystemClass& job_system) {
+  uint64_t expected = 0;
+  for (uint64_t i = 0; i < 64 * 64 * 16; i++) expected += i;
+
+  for (uint32_t round = 0; round < ROUNDS / 4; round++) {
+    std::atomic<uint64_t> sum{0};
+    job_system.ParallelFor(64, [&](uint32_t i) {
+      job_system.ParallelFor(64, [&](uint32_t j) {
+        job_system.ParallelFor(16, [&](uint32_t k) {
+          sum.fetch_add(i * 1024 + j * 16 + k, std::memory_order_relaxed);
+        });
+      });
+    });
+    CHECK(sum == expected);
+  }
+}
+
+// 작업 시스템 밖의 스레드 여럿이 deque 크기보다 많은 작업을 함께 넣습니다
+void TestExternalThreads(JobSystemClass& job_system) {
+  const uint32_t JOB_COUNT = 2 * JobSystemClass::DEQUE_CAPACITY + 1;
+  const uint32_t THREAD_COUNT = 3;
+  const uint32_t EXTERNAL_ROUNDS = ROUNDS / 10;
+
+  std::atomic<uint64_t> total{0};
+  std::atomic<uint32_t> unfinished{0};
+  const auto submit = [&] {
+    std::vector<JobSystemClass::JobType> jobs(JOB_COUNT);
+    for (uint32_t round = 0; round < EXTERNAL_ROUNDS; round++) {
+      for (uint32_t i = 0; i < JOB_COUNT; i++) {
+        jobs[i] = {};
+        jobs[i].function_ = [](void* data, uint32_t) {
+          static_cast<std::atomic<uint64_t>*>(data)->fetch_add(
+              1, std::memory_order_relaxed);
+        };
+        jobs[i].data_ = &total;
+        jobs[i].index_ = i;
+      }
+
+      JobSystemClass::CounterType counter;
+      job_system.Run(jobs.data(), JOB_COUNT, &counter);
+      job_system.Wait(&counter);
+      if (counter.value_ != 0) unfinished++;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < THREAD_COUNT; i++) threads.emplace_back(submit);
+  submit();
+  for (std::thread& thread : threads) thread.join();
+
+  CHECK(unfinished == 0);
+  CHECK(total == uint64_t{THREAD_COUNT} * EXTERNAL_ROUNDS * JOB_COUNT);
+}
+
+// 잠든 작업 스레드가 작은 작업에도 깨어나야 합니다
+void TestWakeAfterIdle(JobSystemClass& job_system) {
+  for (uint32_t round = 0; round < 20; round++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+    std::atomic<uint32_t> count{0};
+    job_system.ParallelFor(8, [&](uint32_t) { count++; });
+    CHECK(count == 8);
+  }
+}
+}  // namespace
+
+int main() {
+  JobSystemClass job_system;
+  CHECK(job_system.Initialize(7));
+  CHECK(job_system.GetThreadCount() == 8);
+
+  TestParallelForCoverage(job_system);
+  TestNestedParallelFor(job_system);
+  TestExternalThreads(job_system);
+  TestWakeAfterIdle(job_system);
+  job_system.Shutdown();
+
+  // 일이 없는 채로 바로 끝내도 멈추지 않아야 합니다
+  JobSystemClass idle_job_system;
+  CHECK(idle_job_system.Initialize(3));
+  idle_job_system.Shutdown();
+
+  return test::Finish();
+}
@@ -0,0 +1,153 @@
+#include "pch.h"
+#include "graphic/mesh_file_class.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "test.h"
+
+namespace {
+struct VertexType {
+  float position_[3];
+  float color_[4];
+};
+
+const uint32_t VERTEX_COUNT = 1000;
+const uint32_t INDEX_COUNT = 3000;
+
+// 정점 1000 개, 인덱스 3000 개, LOD 두 단계인 메시를 씁니다
+bool WriteMesh(const std::filesystem::path& path) {
+  std::vector<VertexType> vertices(VERTEX_COUNT);
+  for (uint32_t i = 0; i < VERTEX_COUNT; i++)
+    vertices[i] = {{static_cast<float>(i), 1.0f, 2.0f},
+                   {1.0f, 0.0f, 0.0f, 1.0f}};
+  std::vector<uint16_t> indices(INDEX_COUNT);
+  for (uint32_t i = 0; i < INDEX_COUNT; i++)
+    indices[i] = static_cast<uint16_t>(i % VERTEX_COUNT);
+
+  const MeshFileClass::AttributeType attributes[] = {
+      {"POSITION", 0, MeshFileClass::FormatType::FLOAT3, 0, 0},
+      {"COLOR", 0, MeshFileClass::FormatType::FLOAT4, 12, 0}};
+  const MeshFileClass::LodType lods[] = {{0, INDEX_COUNT, 0.0f, 0},
+                                         {0, 300, 0.5f, 0}};
+  const float bounds_min[3] = {0.0f, 1.0f, 2.0f};
+  const float bounds_max[3] = {999.0f, 1.0f, 2.0f};
+
+  return MeshFileClass::Write(path, attributes, 2, lods, 2, vertices.data(),
+                              VERTEX_COUNT, sizeof(VertexType),
+                              indices.data(), INDEX_COUNT, 2, bounds_min,
+                              bounds_max);
+}
+
+// 파일의 offset 위치에 value 를 덮어씁니다
+void Patch(const std::filesystem::path& path, const uint64_t offset,
+           const uint32_t value) {
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.seekp(static_cast<std::streamoff>(offset));
+  file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void TestRoundTrip(const std::filesystem::path& path) {
+  CHECK(WriteMesh(path));
+
+  MeshFileClass mesh;
+  CHECK(mesh.Open(path));
+
+  const MeshFileClass::HeaderType& header = mesh.GetHeader();
+  CHECK(header.vertex_count_ == VERTEX_COUNT);
+  CHECK(header.index_count_ == INDEX_COUNT);
+  CHECK(header.vertex_stride_ == sizeof(VertexType));
+  CHECK(header.lod_count_ == 2);
+  CHECK(header.vertex_offset_ % MeshFileClass::ALIGNMENT == 0);
+  CHECK(header.index_offset_ % MeshFileClass::ALIGNMENT == 0);
+  CHECK(header.bounds_max_[0] == 999.0f);
+
+  // 매핑된 덩어리를 복사 없이 그대로 읽습니다
+  const VertexType* vertices =
+      static_cast<const VertexType*>(mesh.GetVertexData());
+  const uint16_t* indices = static_cast<const uint16_t*>(mesh.GetIndexData());
+  CHECK(vertices[999].position_[0] == 999.0f);
+  CHECK(vertices[0].color_[3] == 1.0f);
+  CHECK(indices[2999] == 999);
+
+  CHECK(mesh.GetLods()[1].index_count_ == 300);
+  CHECK(mesh.GetLods()[1].error_ == 0.5f);
+
+  const MeshFileClass::AttributeType* color = mesh.FindAttribute("COLOR", 0);
+  CHECK(color != nullptr && color->offset_ == 12);
+  CHECK(mesh.FindAttribute("COLOR", 1) == nullptr);
+  CHECK(mesh.FindAttribute("NORMAL", 0) == nullptr);
+
+  mesh.Close();
+}
+
+void TestRejectsCorruptFiles(const std::filesystem::path& path) {
+  MeshFileClass mesh;
+
+  // 인덱스 수가 파일보다 크면 덩어리가 파일 밖으로 나갑니다
+  CHECK(WriteMesh(path));
+  Patch(path, offsetof(MeshFileClass::HeaderType, index_count_), 100000000);
+  CHECK(mesh.Open(path) == false);
+
+  CHECK(WriteMesh(path));
+  Patch(path, offsetof(MeshFileClass::HeaderType, magic_), 0);
+  CHECK(mesh.Open(path) == false);
+
+  CHECK(WriteMesh(path));
+  Patch(path, offsetof(MeshFileClass::HeaderType, version_),
+        MeshFileClass::VERSION + 1);
+  CHECK(mesh.Open(path) == false);
+
+  CHECK(WriteMesh(path));
+  Patch(path, offsetof(MeshFileClass::HeaderType, index_size_), 3);
+  CHECK(mesh.Open(path) == false);
+
+  // LOD 구간이 삼각형 단위가 아니면 거부합니다
+  CHECK(WriteMesh(path));
+  Patch(path,
+        sizeof(MeshFileClass::HeaderType) +
+            2 * sizeof(MeshFileClass::AttributeType) +
+            offsetof(MeshFileClass::LodType, index_count_),
+        301);
+  CHECK(mesh.Open(path) == false);
+
+  // 정점 수를 넘는 인덱스는 거부합니다. Patch 는 마지막 인덱스 두 개를
+  // 덮어씁니다
+  CHECK(WriteMesh(path));
+  CHECK(mesh.Open(path));
+  const uint64_t last_indices =
+      mesh.GetHeader().index_offset_ + sizeof(uint16_t) * (INDEX_COUNT - 2);
+  mesh.Close();
+  Patch(path, last_indices, 0xffff);
+  CHECK(mesh.Open(path) == false);
+  Patch(path, last_indices, (VERTEX_COUNT << 16) | 998);
+  CHECK(mesh.Open(path) == false);
+  Patch(path, last_indices, ((VERTEX_COUNT - 1) << 16) | 998);
+  CHECK(mesh.Open(path));
+  mesh.Close();
+
+  // 잘린 파일
+  CHECK(WriteMesh(path));
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  CHECK(mesh.Open(path) == false);
+  std::filesystem::resize_file(path, sizeof(MeshFileClass::HeaderType) - 1);
+  CHECK(mesh.Open(path) == false);
+
+  std::filesystem::remove(path);
+  CHECK(mesh.Open(path) == false);
+}
+}  // namespace
+
+int main() {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "mesh_file_test.mesh";
+
+  TestRoundTrip(path);
+  TestRejectsCorruptFiles(path);
+
+  std::error_code error;
+  std::filesystem::remove(path, error);
+  return test::Finish();
+}
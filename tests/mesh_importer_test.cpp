@@ -0,0 +1,249 @@
+#include "pch.h"
+#include "graphic/mesh_importer_class.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "framework/job_system_class.h"
+#include "test.h"
+
+namespace {
+struct MeshType {
+  std::vector<ModelClass::VertexType> vertices_;
+  std::vector<uint32_t> indices_;
+};
+
+void WriteFile(const std::filesystem::path& path, const std::string& text) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+bool Import(const std::filesystem::path& path, const std::string& text,
+            MeshType& mesh, JobSystemClass* job_system = nullptr) {
+  WriteFile(path, text);
+
+  MeshImporterClass importer;
+  if (importer.Import(path, job_system) == false) return false;
+  importer.ReleaseGeometry(mesh.vertices_, mesh.indices_);
+  return true;
+}
+
+bool SameMesh(const MeshType& a, const MeshType& b) {
+  return a.vertices_.size() == b.vertices_.size() &&
+         a.indices_ == b.indices_ &&
+         std::memcmp(a.vertices_.data(), b.vertices_.data(),
+                     a.vertices_.size() * sizeof(ModelClass::VertexType)) ==
+             0;
+}
+
+// 사각형 면은 부채꼴 삼각형 두 개가 되고, vt 와 vn 은 정점이 아닙니다
+void TestObjQuad(const std::filesystem::path& path) {
+  const std::string text =
+      "# quad\n"
+      "v 0 0 0\n"
+      "vt 0 0\n"
+      "v 1 0 0 1 0 0\n"
+      "vn 0 0 1\n"
+      "v 1 1 0\r\n"
+      "v 0 1 0\n"
+      "v 0 0 0\n"
+      "f 1/1/1 2/1/1 3//1 4\n"
+      "f 5 3 4\n";
+
+  MeshType mesh;
+  CHECK(Import(path, text, mesh));
+  CHECK(mesh.vertices_.size() == 4);
+  CHECK((mesh.indices_ == std::vector<uint32_t>{0, 1, 2, 0, 2, 3, 0, 2, 3}));
+
+  if (mesh.vertices_.size() == 4) {
+    CHECK(mesh.vertices_[1].position_.x == 1.0f);
+    CHECK(mesh.vertices_[1].color_.y == 0.0f);
+    CHECK(mesh.vertices_[2].position_.y == 1.0f);
+    CHECK(mesh.vertices_[2].color_.y == 1.0f);
+  }
+}
+
+void TestObjRejectsBadIndices(const std::filesystem::path& path) {
+  const std::string vertices = "v 0 0 0\nv 1 0 0\nv 1 1 0\n";
+
+  MeshType mesh;
+  CHECK(Import(path, vertices + "f 1 2 3\n", mesh));
+  CHECK(Import(path, vertices + "f -3 -2 -1\n", mesh));
+  CHECK(Import(path, vertices + "f 0 1 2\n", mesh) == false);
+  CHECK(Import(path, vertices + "f 1 2 4\n", mesh) == false);
+  CHECK(Import(path, vertices + "f -4 -2 -1\n", mesh) == false);
+  CHECK(Import(path, vertices + "f 1 2 99999999999\n", mesh) == false);
+  CHECK(Import(path, "v 0 0\nf 1 1 1\n", mesh) == false);
+}
+
+// 정점을 앞에 모두 쓰고 면은 뒤에서 음수 인덱스로 가리킵니다. 파일이
+// 여러 청크로 나뉘므로 면과 정점이 서로 다른 청크에 놓입니다
+void TestObjRelativeAcrossChunks(const std::filesystem::path& path) {
+  const uint32_t VERTEX_COUNT = 300000;
+
+  std::string text;
+  for (uint32_t i = 0; i < VERTEX_COUNT; i++)
+    text += "v " + std::to_string(i) + " 0 0\n";
+  for (uint32_t i = 0; i < VERTEX_COUNT; i += 3)
+    text += "f -" + std::to_string(VERTEX_COUNT - i) + " -" +
+            std::to_string(VERTEX_COUNT - i - 1) + " -" +
+            std::to_string(VERTEX_COUNT - i - 2) + "\n";
+  CHECK(text.size() > 4 * MeshImporterClass::MIN_CHUNK_SIZE);
+
+  JobSystemClass job_system;
+  CHECK(job_system.Initialize(4));
+
+  MeshType mesh;
+  CHECK(Import(path, text, mesh, &job_system));
+  CHECK(mesh.vertices_.size() == VERTEX_COUNT);
+  CHECK(mesh.indices_.size() == VERTEX_COUNT);
+
+  uint32_t wrong = 0;
+  for (uint32_t i = 0; i < mesh.indices_.size(); i++)
+    wrong += mesh.indices_[i] != i ||
+             mesh.vertices_[i].position_.x != static_cast<float>(i);
+  CHECK(wrong == 0);
+
+  job_system.Shutdown();
+}
+
+// 같은 사각형을 ASCII, 리틀/빅 엔디언 이진 PLY 로 씁니다
+const char* const PLY_HEADER =
+    "element vertex 4\n"
+    "property float x\n"
+    "property float y\n"
+    "property float z\n"
+    "property uchar red\n"
+    "property uchar green\n"
+    "property uchar blue\n"
+    "element face 1\n"
+    "property list uchar int vertex_indices\n"
+    "end_header\n";
+
+std::string MakeAsciiPly() {
+  return std::string("ply\nformat ascii 1.0\ncomment quad\n") + PLY_HEADER +
+         "0 0 0 255 0 0\n"
+         "1 0 0 0 255 0\n"
+         "1 1 0 0 0 255\n"
+         "0 1 0 255 255 255\n"
+         "4 0 1 2 3\n";
+}
+
+template <typename T>
+void AppendScalar(std::string& text, const T value, const bool big_endian) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  if (big_endian) std::reverse(bytes, bytes + sizeof(T));
+  text.append(bytes, sizeof(T));
+}
+
+std::string MakeBinaryPly(const bool big_endian) {
+  std::string text = big_endian ? "ply\nformat binary_big_endian 1.0\n"
+                                : "ply\nformat binary_little_endian 1.0\n";
+  text += PLY_HEADER;
+
+  const float positions[4][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+  const uint8_t colors[4][3] = {
+      {255, 0, 0}, {0, 255, 0}, {0, 0, 255}, {255, 255, 255}};
+  for (uint32_t i = 0; i < 4; i++) {
+    for (const float value : positions[i])
+      AppendScalar(text, value, big_endian);
+    for (const uint8_t value : colors[i]) AppendScalar(text, value, big_endian);
+  }
+
+  AppendScalar(text, uint8_t{4}, big_endian);
+  for (int32_t i = 0; i < 4; i++) AppendScalar(text, i, big_endian);
+  return text;
+}
+
+void TestPly(const std::filesystem::path& path) {
+  MeshType ascii;
+  CHECK(Import(path, MakeAsciiPly(), ascii));
+  CHECK(ascii.vertices_.size() == 4);
+  CHECK((ascii.indices_ == std::vector<uint32_t>{0, 1, 2, 0, 2, 3}));
+  if (ascii.vertices_.size() == 4) {
+    CHECK(ascii.vertices_[2].position_.y == 1.0f);
+    CHECK(ascii.vertices_[2].color_.z == 1.0f);
+    CHECK(ascii.vertices_[2].color_.x == 0.0f);
+  }
+
+  MeshType little_endian, big_endian;
+  CHECK(Import(path, MakeBinaryPly(false), little_endian));
+  CHECK(Import(path, MakeBinaryPly(true), big_endian));
+  CHECK(SameMesh(ascii, little_endian));
+  CHECK(SameMesh(ascii, big_endian));
+}
+
+// 본문이 잘리면 요소 수만큼 읽지 못하므로 거부합니다
+void TestPlyRejectsTruncatedBody(const std::filesystem::path& path) {
+  MeshType mesh;
+
+  const std::string ascii = MakeAsciiPly();
+  CHECK(Import(path, ascii.substr(0, ascii.size() - 10), mesh) == false);
+  CHECK(Import(path, ascii.substr(0, ascii.find("1 1 0 0 0 255") + 5),
+               mesh) == false);
+  CHECK(Import(path, ascii.substr(0, ascii.find("end_header")), mesh) ==
+        false);
+
+  for (const bool big_endian : {false, true}) {
+    const std::string binary = MakeBinaryPly(big_endian);
+    CHECK(Import(path, binary.substr(0, binary.size() - 1), mesh) == false);
+    CHECK(Import(path, binary.substr(0, binary.size() - 17), mesh) == false);
+    CHECK(Import(path, binary.substr(0, binary.size() - 40), mesh) == false);
+  }
+}
+
+// 중복 제거 결과는 작업 스레드 수와 상관없이 같아야 합니다
+void TestDedupIndependentOfThreadCount(const std::filesystem::path& path) {
+  const uint32_t VERTEX_COUNT = 200000;
+  const uint32_t DISTINCT = 5000;
+
+  std::string text;
+  for (uint32_t i = 0; i < VERTEX_COUNT; i++) {
+    const uint32_t value = i * 7919 % DISTINCT;
+    text += "v " + std::to_string(value % 71) + " " +
+            std::to_string(value / 71) + " 0.5\n";
+  }
+  for (uint32_t i = 0; i + 2 < VERTEX_COUNT; i += 2)
+    text += "f " + std::to_string(VERTEX_COUNT - i) + " " +
+            std::to_string(i + 1) + " " + std::to_string(i + 3) + "\n";
+
+  MeshType expected;
+  CHECK(Import(path, text, expected));
+  CHECK(expected.vertices_.size() == DISTINCT);
+
+  for (const uint32_t thread_count : {1u, 2u, 3u, 8u}) {
+    JobSystemClass job_system;
+    CHECK(job_system.Initialize(thread_count));
+
+    MeshType mesh;
+    CHECK(Import(path, text, mesh, &job_system));
+    CHECK(SameMesh(expected, mesh));
+
+    job_system.Shutdown();
+  }
+}
+}  // namespace
+
+int main() {
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path();
+  const std::filesystem::path obj = directory / "mesh_importer_test.obj";
+  const std::filesystem::path ply = directory / "mesh_importer_test.ply";
+
+  TestObjQuad(obj);
+  TestObjRejectsBadIndices(obj);
+  TestObjRelativeAcrossChunks(obj);
+  TestPly(ply);
+  TestPlyRejectsTruncatedBody(ply);
+  TestDedupIndependentOfThreadCount(obj);
+
+  std::error_code error;
+  std::filesystem::remove(obj, error);
+  std::filesystem::remove(ply, error);
+  return test::Finish();
+}
@@ -0,0 +1,79 @@
+#include "pch.h"
+#include "graphic/model_class.h"
+
+#include <filesystem>
+#include <vector>
+
+#include "graphic/mesh_file_class.h"
+#include "test.h"
+
+namespace {
+// 삼각형 하나짜리 LOD 를 lod_count 단계 쌓은 FLOAT32 메시를 씁니다
+bool WriteMesh(const std::filesystem::path& path, const uint32_t lod_count) {
+  const ModelClass::VertexType vertices[] = {
+      {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f, 1.0f}},
+      {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 1.0f}},
+      {{0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 1.0f}}};
+
+  std::vector<uint16_t> indices;
+  std::vector<MeshFileClass::LodType> lods;
+  for (uint32_t i = 0; i < lod_count; i++) {
+    lods.push_back({i * 3, 3, 0.1f * static_cast<float>(i), 0});
+    indices.insert(indices.end(), {0, 1, 2});
+  }
+
+  const MeshFileClass::AttributeType attributes[] = {
+      {"POSITION", 0, MeshFileClass::FormatType::FLOAT3, 0, 0},
+      {"COLOR", 0, MeshFileClass::FormatType::FLOAT4, 12, 0}};
+  const float bounds_min[3] = {0.0f, 0.0f, 0.0f};
+  const float bounds_max[3] = {1.0f, 1.0f, 0.0f};
+
+  return MeshFileClass::Write(
+      path, attributes, 2, lods.data(), lod_count, vertices, 3,
+      sizeof(ModelClass::VertexType), indices.data(),
+      static_cast<uint32_t>(indices.size()), sizeof(uint16_t), bounds_min,
+      bounds_max);
+}
+
+void TestLoadsMeshLods(const std::filesystem::path& path) {
+  CHECK(WriteMesh(path, 2));
+
+  ModelClass model;
+  CHECK(model.Initialize(nullptr, path));
+  CHECK(model.GetVertexCount() == 3);
+  CHECK(model.GetIndexCount() == 3);
+  CHECK(model.GetLodCount() == 2);
+  CHECK(model.GetLods()[1].first_index_ == 3);
+  CHECK(model.GetIndices()[5] == 2);
+  model.Shutdown();
+}
+
+// 렌더러가 다루는 것보다 많은 LOD 는 원본부터 MAX_LODS 개만 남깁니다
+void TestClampsExtraLods(const std::filesystem::path& path) {
+  CHECK(WriteMesh(path, MeshFileClass::MAX_LODS));
+
+  ModelClass model;
+  CHECK(model.Initialize(nullptr, path));
+  CHECK(model.GetLodCount() == static_cast<int>(ModelClass::MAX_LODS));
+  CHECK(model.GetIndexCount() == 3);
+
+  const ModelClass::LodType* lods = model.GetLods();
+  for (uint32_t i = 0; i < ModelClass::MAX_LODS; i++) {
+    CHECK(lods[i].first_index_ == i * 3);
+    CHECK(lods[i].index_count_ == 3);
+  }
+  model.Shutdown();
+}
+}  // namespace
+
+int main() {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "model_test.mesh";
+
+  TestLoadsMeshLods(path);
+  TestClampsExtraLods(path);
+
+  std::error_code error;
+  std::filesystem::remove(path, error);
+  return test::Finish();
+}
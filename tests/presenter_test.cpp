@@ -0,0 +1,180 @@
+#include "pch.h"
+#include "graphic/presenter_class.h"
+
+#include <algorithm>
+#include <deque>
+
+#include "test.h"
+
+namespace {
+const int64_t MILLISECOND = 1000000;
+
+// 시간이 호출자가 넘길 때만 흐르는 시계입니다
+struct MockClockType {
+  int64_t now_ = 1000;
+  uint32_t sleep_count_ = 0;
+
+  int64_t Now() { return now_; }
+  void SleepUntil(const int64_t time) {
+    CHECK(time >= now_);
+    now_ = time;
+    sleep_count_++;
+  }
+};
+
+// GPU 가 프레임 하나를 gpu_time_ 동안 그리는 스왑 체인 대기열입니다.
+// done_ 은 표시했지만 GPU 가 아직 끝내지 않은 프레임들이 끝나는 시각입니다
+struct MockSwapChainType {
+  MockClockType* clock_;
+  int64_t gpu_time_;
+  uint32_t max_frame_latency_;
+  std::deque<int64_t> done_{};
+
+  // 프레임 지연 대기 객체처럼 대기열에 자리가 날 때까지 시간을 보냅니다
+  void WaitForFrameLatency() {
+    Retire();
+    if (done_.size() < max_frame_latency_) return;
+
+    clock_->now_ = done_[done_.size() - max_frame_latency_];
+    Retire();
+  }
+
+  void Present() {
+    const int64_t start =
+        done_.empty() ? clock_->now_ : (std::max)(clock_->now_, done_.back());
+    done_.push_back(start + gpu_time_);
+  }
+
+  void Retire() {
+    while (done_.empty() == false && done_.front() <= clock_->now_)
+      done_.pop_front();
+  }
+};
+
+PresenterClass::SettingsType MakeSettings(const PresenterClass::ModeType mode,
+                                          const double frame_rate_limit) {
+  PresenterClass::SettingsType settings;
+  settings.mode_ = mode;
+  settings.frame_rate_limit_ = frame_rate_limit;
+  settings.buffer_count_ = 3;
+  settings.max_frame_latency_ = 1;
+  return settings;
+}
+
+// 프레임 하나를 돌립니다. CPU 는 work_time 동안 일하고 표시합니다
+void RunFrame(PresenterClass& presenter, MockClockType& clock,
+              MockSwapChainType& swap_chain, const int64_t work_time) {
+  presenter.WaitForNextFrame(clock, swap_chain);
+  clock.now_ += work_time;
+  swap_chain.Present();
+}
+
+void TestSettings() {
+  PresenterClass presenter;
+  PresenterClass::SettingsType settings =
+      MakeSettings(PresenterClass::ModeType::VSYNC, 60.0);
+  CHECK(presenter.Initialize(settings, true));
+  CHECK(presenter.GetSyncInterval() == 1);
+  CHECK(presenter.IsTearingAllowed() == false);
+
+  // 수직 동기를 끈 표시에서만, 스왑 체인이 허용할 때만 티어링합니다
+  presenter.SetMode(PresenterClass::ModeType::UNCAPPED, 0.0);
+  CHECK(presenter.GetSyncInterval() == 0);
+  CHECK(presenter.IsTearingAllowed());
+  presenter.SetMode(PresenterClass::ModeType::CAPPED, 144.0);
+  CHECK(presenter.GetSyncInterval() == 0);
+  CHECK(presenter.GetSettings().frame_rate_limit_ == 144.0);
+  CHECK(presenter.Initialize(settings, false));
+  presenter.SetMode(PresenterClass::ModeType::UNCAPPED, 0.0);
+  CHECK(presenter.IsTearingAllowed() == false);
+
+  settings.buffer_count_ = PresenterClass::MIN_BUFFER_COUNT - 1;
+  CHECK(presenter.Initialize(settings, false) == false);
+  settings.buffer_count_ = PresenterClass::MAX_BUFFER_COUNT + 1;
+  CHECK(presenter.Initialize(settings, false) == false);
+  settings.buffer_count_ = 2;
+  settings.max_frame_latency_ = 0;
+  CHECK(presenter.Initialize(settings, false) == false);
+  settings.max_frame_latency_ = PresenterClass::MAX_FRAME_LATENCY + 1;
+  CHECK(presenter.Initialize(settings, false) == false);
+}
+
+void TestCappedPacing() {
+  PresenterClass presenter;
+  CHECK(presenter.Initialize(
+      MakeSettings(PresenterClass::ModeType::CAPPED, 100.0), true));
+
+  // 3 ms 일하고 GPU 가 1 ms 그리면, 대기열을 1 ms 기다리고 나머지 6 ms 를
+  // 자서 10 ms 마다 프레임을 시작합니다
+  MockClockType clock;
+  MockSwapChainType swap_chain{&clock, 1 * MILLISECOND, 1};
+  for (uint32_t i = 0; i < 50; i++) {
+    RunFrame(presenter, clock, swap_chain, 3 * MILLISECOND);
+    if (i > 0) CHECK(presenter.GetFrameInterval() == 10 * MILLISECOND);
+    if (i > 1) {
+      CHECK(presenter.GetSleepTime() == 6 * MILLISECOND);
+      CHECK(presenter.GetLatencyWaitTime() == 1 * MILLISECOND);
+      CHECK(presenter.GetWorkTime() == 3 * MILLISECOND);
+    }
+  }
+  CHECK(presenter.GetFrameCount() == 50);
+
+  // 주기보다 느린 프레임 뒤에 밀린 프레임을 몰아서 시작하지 않습니다
+  for (uint32_t i = 0; i < 10; i++)
+    RunFrame(presenter, clock, swap_chain, 25 * MILLISECOND);
+  for (uint32_t i = 0; i < 5; i++) {
+    RunFrame(presenter, clock, swap_chain, 1 * MILLISECOND);
+    CHECK(presenter.GetFrameInterval() >= 10 * MILLISECOND);
+  }
+
+  // 모드를 바꾸면 다음 CAPPED 프레임은 그 시각부터 셉니다
+  presenter.SetMode(PresenterClass::ModeType::CAPPED, 50.0);
+  const uint32_t sleep_count = clock.sleep_count_;
+  RunFrame(presenter, clock, swap_chain, 1 * MILLISECOND);
+  CHECK(clock.sleep_count_ == sleep_count);
+  RunFrame(presenter, clock, swap_chain, 1 * MILLISECOND);
+  CHECK(presenter.GetFrameInterval() == 20 * MILLISECOND);
+}
+
+void TestUncappedGpuBound() {
+  PresenterClass presenter;
+  CHECK(presenter.Initialize(
+      MakeSettings(PresenterClass::ModeType::UNCAPPED, 0.0), true));
+
+  // CPU 가 GPU 보다 빠르면 대기 객체가 GPU 속도에 맞춰 주고, 대기열은
+  // max_frame_latency_ 를 넘지 않습니다. 지연이 1 프레임이면 CPU 는 GPU 가
+  // 끝나야 다음 프레임을 시작하므로 간격은 두 시간의 합입니다
+  MockClockType clock;
+  MockSwapChainType swap_chain{&clock, 16 * MILLISECOND, 1};
+  for (uint32_t i = 0; i < 20; i++) {
+    RunFrame(presenter, clock, swap_chain, 1 * MILLISECOND);
+    CHECK(swap_chain.done_.size() <= 1);
+    CHECK(presenter.GetSleepTime() == 0);
+    if (i > 1) CHECK(presenter.GetFrameInterval() == 17 * MILLISECOND);
+  }
+  CHECK(clock.sleep_count_ == 0);
+
+  // 2 프레임까지 쌓으면 CPU 와 GPU 가 겹쳐 GPU 시간마다 시작합니다
+  MockSwapChainType pipelined{&clock, 16 * MILLISECOND, 2};
+  for (uint32_t i = 0; i < 20; i++) {
+    RunFrame(presenter, clock, pipelined, 1 * MILLISECOND);
+    CHECK(pipelined.done_.size() <= 2);
+    if (i > 2) CHECK(presenter.GetFrameInterval() == 16 * MILLISECOND);
+  }
+}
+
+void TestSystemClock() {
+  PresenterClass::SystemClockType clock;
+  const int64_t begin = clock.Now();
+  clock.SleepUntil(begin + 5 * MILLISECOND);
+  CHECK(clock.Now() - begin >= 5 * MILLISECOND);
+}
+}  // namespace
+
+int main() {
+  TestSettings();
+  TestCappedPacing();
+  TestUncappedGpuBound();
+  TestSystemClock();
+  return test::Finish();
+}
@@ -0,0 +1,224 @@
+#include "pch.h"
+#include "graphic/resource_pool_class.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+
+namespace {
+// Release() 만 가진 가짜 리소스입니다. 풀이 해제한 횟수와, 풀에 넣을 때
+// 받은 핸들을 기록합니다
+struct FakeResourceType {
+  std::atomic<uint32_t> release_count_{0};
+  std::atomic<uint32_t> handle_{0};
+
+  void Release() { release_count_++; }
+};
+
+using PoolType = ResourcePoolClass<FakeResourceType>;
+
+void TestHandles() {
+  PoolType pool;
+  CHECK(pool.Initialize(4));
+
+  FakeResourceType first;
+  const PoolType::HandleType handle = pool.Add(&first);
+  CHECK(handle.IsValid());
+  CHECK(pool.Get(handle) == &first);
+  CHECK(pool.Get({}) == nullptr);
+
+  // 놓은 핸들은 바로 무효가 되지만 리소스는 그 프레임이 끝날 때까지 남습니다
+  pool.Release(handle, 5);
+  CHECK(pool.Get(handle) == nullptr);
+  CHECK(pool.GetLiveCount() == 0);
+  CHECK(pool.GetPendingCount() == 1);
+  pool.Collect(4);
+  CHECK(first.release_count_ == 0);
+  pool.Collect(5);
+  CHECK(first.release_count_ == 1);
+  CHECK(pool.GetPendingCount() == 0);
+
+  // 같은 슬롯을 다시 써도 예전 핸들은 새 리소스를 가리키지 않습니다
+  FakeResourceType second;
+  const PoolType::HandleType reused = pool.Add(&second);
+  CHECK(reused.IsValid());
+  CHECK(reused != handle);
+  CHECK(pool.Get(handle) == nullptr);
+  CHECK(pool.Get(reused) == &second);
+
+  // 이미 놓은 핸들을 다시 놓아도 새 리소스의 참조는 줄지 않습니다
+  pool.Release(handle, 6);
+  CHECK(pool.Get(reused) == &second);
+
+  pool.Shutdown();
+  CHECK(second.release_count_ == 1);
+}
+
+void TestSharing() {
+  PoolType pool;
+  CHECK(pool.Initialize(8));
+
+  const char contents[] = "vertices";
+  const char other[] = "indices!";
+  const uint64_t key = 42;
+
+  FakeResourceType shared;
+  const PoolType::HandleType handle =
+      pool.Add(&shared, key, contents, sizeof(contents));
+  CHECK(pool.Find(key, contents, sizeof(contents)) == handle);
+  CHECK(pool.Find(key + 1, contents, sizeof(contents)).IsValid() == false);
+
+  // 해시가 같아도 내용이 다르면 공유하지 않고, 따로 넣은 리소스는 먼저 넣은
+  // 리소스의 key 를 빼앗지 않습니다
+  CHECK(pool.Find(key, other, sizeof(other)).IsValid() == false);
+  CHECK(pool.Find(key, contents, sizeof(contents) - 1).IsValid() == false);
+  FakeResourceType collided;
+  const PoolType::HandleType collided_handle =
+      pool.Add(&collided, key, other, sizeof(other));
+  CHECK(collided_handle.IsValid());
+  CHECK(collided_handle != handle);
+  CHECK(pool.Find(key, contents, sizeof(contents)) == handle);
+  CHECK(pool.Find(key, other, sizeof(other)).IsValid() == false);
+
+  // Add 와 Find 두 번으로 참조가 셋이므로 세 번 놓아야 해제됩니다
+  pool.Release(handle, 0);
+  pool.Release(handle, 0);
+  CHECK(pool.Get(handle) == &shared);
+  pool.Release(handle, 0);
+  CHECK(pool.Get(handle) == nullptr);
+  CHECK(pool.Find(key, contents, sizeof(contents)).IsValid() == false);
+
+  // 충돌한 리소스를 놓아도 새로 넣은 key 는 남습니다
+  FakeResourceType again;
+  const PoolType::HandleType again_handle =
+      pool.Add(&again, key, contents, sizeof(contents));
+  pool.Release(collided_handle, 0);
+  CHECK(pool.Find(key, contents, sizeof(contents)) == again_handle);
+  pool.Release(again_handle, 0);
+  pool.Release(again_handle, 0);
+
+  // 호출자 key 는 내용 없이 넣고, 내용으로 찾는 쪽과 섞이지 않습니다
+  FakeResourceType keyed;
+  const PoolType::HandleType keyed_handle = pool.Add(&keyed, key);
+  CHECK(pool.Find(key) == keyed_handle);
+  CHECK(pool.Find(key, contents, sizeof(contents)).IsValid() == false);
+  pool.Release(keyed_handle, 0);
+  pool.Release(keyed_handle, 0);
+
+  pool.Collect(0);
+  CHECK(shared.release_count_ == 1);
+  CHECK(collided.release_count_ == 1);
+  CHECK(again.release_count_ == 1);
+  CHECK(keyed.release_count_ == 1);
+  CHECK(pool.GetLiveCount() == 0);
+  pool.Shutdown();
+}
+
+void TestCapacity() {
+  PoolType pool;
+  CHECK(pool.Initialize(PoolType::MAX_CAPACITY + 1) == false);
+  CHECK(pool.Initialize(2));
+
+  // 슬롯이 모자라면 넘겨받은 참조를 해제하고 빈 핸들을 반환합니다
+  FakeResourceType resources[3];
+  CHECK(pool.Add(&resources[0]).IsValid());
+  CHECK(pool.Add(&resources[1]).IsValid());
+  CHECK(pool.Add(&resources[2]).IsValid() == false);
+  CHECK(resources[2].release_count_ == 1);
+
+  pool.Shutdown();
+  CHECK(resources[0].release_count_ == 1);
+  CHECK(resources[1].release_count_ == 1);
+}
+
+void TestShutdownReleasesPending() {
+  PoolType pool;
+  CHECK(pool.Initialize(2));
+
+  FakeResourceType live;
+  FakeResourceType retired;
+  pool.Add(&live);
+  pool.Release(pool.Add(&retired), 100);
+  pool.Shutdown();
+  CHECK(live.release_count_ == 1);
+  CHECK(retired.release_count_ == 1);
+}
+
+// 한 스레드가 잠근 채 슬롯을 빠르게 돌려 쓰는 동안 다른 스레드들이 잠그지
+// 않고 Get 합니다. Get 이 돌려준 리소스는 항상 그 핸들로 넣은 것이어야
+// 합니다
+void TestConcurrentGet() {
+  // 슬롯 하나가 세대를 한 바퀴 돌지 않을 만큼만 넣습니다
+  const uint32_t CAPACITY = 64;
+  const uint32_t LIVE = 32;
+  const uint32_t ADD_COUNT = 200000;
+  const uint64_t MIN_HIT_COUNT = 10000;
+  const uint32_t PUBLISHED = 256;
+  const uint32_t READERS = 3;
+
+  PoolType pool;
+  CHECK(pool.Initialize(CAPACITY));
+
+  std::vector<FakeResourceType> resources(ADD_COUNT);
+  std::vector<std::atomic<uint32_t>> published(PUBLISHED);
+  std::atomic<bool> done{false};
+  std::atomic<uint32_t> mismatch_count{0};
+  std::atomic<uint64_t> hit_count{0};
+  std::mutex mutex;
+
+  std::vector<std::thread> readers;
+  for (uint32_t reader = 0; reader < READERS; reader++) {
+    readers.emplace_back([&, reader] {
+      uint32_t index = reader;
+      while (done == false) {
+        const PoolType::HandleType handle{published[index % PUBLISHED]};
+        index += 7;
+        FakeResourceType* resource = pool.Get(handle);
+        if (resource == nullptr) continue;
+
+        // 넣은 스레드가 아직 핸들을 적지 못했을 수는 있습니다
+        const uint32_t value = resource->handle_;
+        if (value != 0 && value != handle.value_) mismatch_count++;
+        hit_count++;
+      }
+    });
+  }
+
+  std::vector<PoolType::HandleType> live;
+  uint32_t add_count = 0;
+  for (uint32_t i = 0; i < ADD_COUNT && hit_count < MIN_HIT_COUNT; i++) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const PoolType::HandleType handle = pool.Add(&resources[i]);
+    resources[i].handle_ = handle.value_;
+    published[i % PUBLISHED] = handle.value_;
+    live.push_back(handle);
+    if (live.size() > LIVE) {
+      pool.Release(live.front(), i);
+      live.erase(live.begin());
+    }
+    pool.Collect(i);
+    add_count++;
+  }
+
+  done = true;
+  for (std::thread& reader : readers) reader.join();
+  CHECK(mismatch_count == 0);
+  CHECK(hit_count >= MIN_HIT_COUNT);
+
+  pool.Shutdown();
+  for (uint32_t i = 0; i < add_count; i++)
+    CHECK(resources[i].release_count_ == 1);
+}
+}  // namespace
+
+int main() {
+  TestHandles();
+  TestSharing();
+  TestCapacity();
+  TestShutdownReleasesPending();
+  TestConcurrentGet();
+  return test::Finish();
+}
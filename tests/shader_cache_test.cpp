@@ -0,0 +1,129 @@
+#include "pch.h"
+#include "graphic/shader_cache_class.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "framework/job_system_class.h"
+#include "test.h"
+
+namespace {
+const uint32_t SHADER_COUNT = 8;
+
+std::atomic<uint32_t> compile_count{0};
+std::atomic<uint32_t> running_count{0};
+std::atomic<uint32_t> peak_running_count{0};
+
+// D3DCompiler 대신 쓰는 컴파일러입니다. 경로와 진입점을 bytecode 로
+// 돌려주고, 진입점이 "bad" 이면 실패합니다. 잠깐 멈춰 여러 컴파일이 함께
+// 도는지 볼 수 있게 합니다
+bool StubCompile(const ShaderCacheClass::ShaderDescType& desc,
+                 std::vector<uint8_t>& bytecode, std::string& error) {
+  const uint32_t running = ++running_count;
+  uint32_t peak = peak_running_count;
+  while (running > peak &&
+         !peak_running_count.compare_exchange_weak(peak, running)) {
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  running_count--;
+  compile_count++;
+
+  if (desc.entry_point_ == "bad") {
+    error = "error X3000: syntax error";
+    return false;
+  }
+
+  const std::string text = desc.path_.generic_string() + desc.entry_point_;
+  bytecode.assign(text.begin(), text.end());
+  return true;
+}
+
+void WriteText(const std::filesystem::path& path, const char* text) {
+  std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+}
+}  // namespace
+
+int main() {
+  namespace fs = std::filesystem;
+
+  const fs::path directory = fs::temp_directory_path() / "shader_cache_test";
+  fs::remove_all(directory);
+  fs::create_directories(directory / "src");
+
+  WriteText(directory / "src" / "common.hlsli", "float x;\n");
+  std::vector<ShaderCacheClass::ShaderDescType> descs;
+  for (uint32_t i = 0; i < SHADER_COUNT; i++) {
+    const fs::path path =
+        directory / "src" / ("s" + std::to_string(i) + ".hlsl");
+    WriteText(path, "#include \"common.hlsli\"\nvoid main() {}\n");
+    descs.push_back({path, "main", "vs_5_0", {{"A", "1"}}, 0});
+  }
+
+  JobSystemClass job_system;
+  CHECK(job_system.Initialize(3));
+
+  ShaderCacheClass cache;
+  CHECK(cache.Initialize(directory / "cache", StubCompile, 1));
+
+  // 처음에는 모두 컴파일하며, 작업 시스템에서 함께 돕니다
+  CHECK(cache.Load(descs.data(), SHADER_COUNT, &job_system));
+  CHECK(cache.GetMissCount() == SHADER_COUNT && cache.GetHitCount() == 0);
+  CHECK(compile_count == SHADER_COUNT);
+  CHECK(peak_running_count > 1);
+
+  // 두 번째에는 컴파일 없이 캐시 파일을 읽습니다
+  CHECK(cache.Load(descs.data(), SHADER_COUNT, &job_system));
+  CHECK(cache.GetHitCount() == SHADER_COUNT && cache.GetMissCount() == 0);
+  CHECK(compile_count == SHADER_COUNT);
+  const std::string expected = descs[3].path_.generic_string() + "main";
+  CHECK(cache.GetBytecodeSize(3) == expected.size());
+  CHECK(std::string(static_cast<const char*>(cache.GetBytecode(3)),
+                    cache.GetBytecodeSize(3)) == expected);
+
+  // include 한 파일이 바뀌면 모두 다시 컴파일합니다
+  WriteText(directory / "src" / "common.hlsli", "float y;\n");
+  CHECK(cache.Load(descs.data(), SHADER_COUNT, &job_system));
+  CHECK(cache.GetMissCount() == SHADER_COUNT);
+
+  // define, 플래그, 프로파일도 키에 들어갑니다
+  descs[0].defines_[0].value_ = "2";
+  descs[1].flags_ = 4;
+  descs[2].profile_ = "vs_4_0";
+  CHECK(cache.Load(descs.data(), SHADER_COUNT, &job_system));
+  CHECK(cache.GetMissCount() == 3 && cache.GetHitCount() == SHADER_COUNT - 3);
+
+  // 컴파일 실패는 Load 의 실패와 셰이더별 오류로 알립니다
+  descs[4].entry_point_ = "bad";
+  CHECK(cache.Load(descs.data(), SHADER_COUNT, nullptr) == false);
+  CHECK(cache.GetError(4).find("X3000") != std::string::npos);
+  descs[4].entry_point_ = "main";
+
+  // 손상된 캐시 파일은 버리고 다시 컴파일합니다
+  uint64_t key = 0;
+  CHECK(cache.ComputeKey(descs[5], key));
+  fs::resize_file(cache.GetCachePath(key), 4);
+  CHECK(cache.Load(descs.data(), SHADER_COUNT, &job_system));
+  CHECK(cache.GetMissCount() == 1);
+  cache.Shutdown();
+
+  // 컴파일러 버전이 바뀌면 캐시를 쓰지 않습니다
+  ShaderCacheClass other_cache;
+  CHECK(other_cache.Initialize(directory / "cache", StubCompile, 2));
+  CHECK(other_cache.Load(descs.data(), SHADER_COUNT, &job_system));
+  CHECK(other_cache.GetMissCount() == SHADER_COUNT);
+  other_cache.Shutdown();
+
+  // 임시 파일이 남지 않습니다
+  for (const fs::directory_entry& entry :
+       fs::directory_iterator(directory / "cache"))
+    CHECK(entry.path().extension() == ".cso");
+
+  job_system.Shutdown();
+  fs::remove_all(directory);
+  return test::Finish();
+}
@@ -0,0 +1,94 @@
+#include "pch.h"
+#include "graphic/soft_rasterizer_class.h"
+
+#include <vector>
+
+#include "framework/job_system_class.h"
+#include "test.h"
+
+namespace {
+const int32_t SIZE = 64;
+const uint32_t CLEAR_COLOR = 0xff000000;
+
+// 화면을 덮는 사각형 정점과 그 두 삼각형입니다
+const ModelClass::VertexType VERTICES[] = {
+    {{-1.0f, -1.0f, 0.5f}, {1.0f, 1.0f, 1.0f, 1.0f}},
+    {{-1.0f, 1.0f, 0.5f}, {1.0f, 1.0f, 1.0f, 1.0f}},
+    {{1.0f, 1.0f, 0.5f}, {1.0f, 1.0f, 1.0f, 1.0f}},
+    {{1.0f, -1.0f, 0.5f}, {1.0f, 1.0f, 1.0f, 1.0f}},
+};
+const int32_t VERTEX_COUNT = 4;
+
+uint32_t CountDrawnPixels(SoftRasterizerClass& rasterizer) {
+  uint32_t count = 0;
+  const uint32_t* colors = rasterizer.GetColorBuffer();
+  for (int32_t y = 0; y < SIZE; y++)
+    for (int32_t x = 0; x < SIZE; x++)
+      if (colors[y * rasterizer.GetPitch() + x] != CLEAR_COLOR) count++;
+  return count;
+}
+
+// 범위를 벗어난 인덱스가 있는 삼각형만 버리고 나머지는 그립니다
+void TestOutOfRangeIndices() {
+  JobSystemClass job_system;
+  CHECK(job_system.Initialize(2));
+  SoftRasterizerClass rasterizer;
+  CHECK(rasterizer.Initialize(SIZE, SIZE, 100.0f, 0.1f, &job_system));
+
+  const std::vector<uint32_t> valid = {0, 1, 2, 0, 2, 3};
+  const std::vector<uint32_t> corrupt = {0, 1, 2, 0, 2, 0x7fffffff,
+                                         4, 2, 3};
+
+  rasterizer.BeginScene(0.0f, 0.0f, 0.0f, 1.0f);
+  rasterizer.DrawIndexed(VERTICES, VERTEX_COUNT, valid.data(), 6,
+                         DirectX::XMMatrixIdentity());
+  rasterizer.EndScene();
+  const uint32_t full = CountDrawnPixels(rasterizer);
+  CHECK(full == SIZE * SIZE);
+
+  rasterizer.BeginScene(0.0f, 0.0f, 0.0f, 1.0f);
+  rasterizer.DrawIndexed(VERTICES, VERTEX_COUNT, corrupt.data(),
+                         static_cast<int32_t>(corrupt.size()),
+                         DirectX::XMMatrixIdentity());
+  rasterizer.EndScene();
+  const uint32_t half = CountDrawnPixels(rasterizer);
+  CHECK(half > 0 && half < full);
+
+  rasterizer.BeginScene(0.0f, 0.0f, 0.0f, 1.0f);
+  rasterizer.DrawIndexed(VERTICES, VERTEX_COUNT, corrupt.data(),
+                         static_cast<int32_t>(corrupt.size()),
+                         DirectX::XMMatrixIdentity(),
+                         DirectX::XMMatrixIdentity(),
+                         DirectX::XMMatrixIdentity());
+  rasterizer.EndScene();
+  CHECK(CountDrawnPixels(rasterizer) == half);
+
+  ModelClass::InstanceType instances[2]{};
+  for (ModelClass::InstanceType& instance : instances) {
+    DirectX::XMStoreFloat4x4(&instance.world_, DirectX::XMMatrixIdentity());
+    instance.color_ = {1.0f, 1.0f, 1.0f, 1.0f};
+  }
+  rasterizer.BeginScene(0.0f, 0.0f, 0.0f, 1.0f);
+  rasterizer.DrawIndexedInstanced(VERTICES, VERTEX_COUNT, corrupt.data(),
+                                  static_cast<int32_t>(corrupt.size()),
+                                  instances, 2, DirectX::XMMatrixIdentity());
+  rasterizer.EndScene();
+  CHECK(CountDrawnPixels(rasterizer) == half);
+
+  // 모든 삼각형이 잘못됐으면 아무것도 그리지 않습니다
+  const uint32_t all_bad[] = {0, 1, 9};
+  rasterizer.BeginScene(0.0f, 0.0f, 0.0f, 1.0f);
+  rasterizer.DrawIndexedInstanced(VERTICES, VERTEX_COUNT, all_bad, 3,
+                                  instances, 2, DirectX::XMMatrixIdentity());
+  rasterizer.EndScene();
+  CHECK(CountDrawnPixels(rasterizer) == 0);
+
+  rasterizer.Shutdown();
+  job_system.Shutdown();
+}
+}  // namespace
+
+int main() {
+  TestOutOfRangeIndices();
+  return test::Finish();
+}
@@ -0,0 +1,257 @@
+#include "pch.h"
+#include "graphic/state_filter_class.h"
+
+#include <cstring>
+#include <random>
+
+#include "test.h"
+
+namespace {
+const uint32_t VERTEX_BUFFER_SLOTS = 2;
+
+// 실제로 바인딩된 상태를 흉내 내는 가짜 디바이스 컨텍스트입니다. 필터가
+// 통과시킨 호출만 받고, 받은 호출 수를 셉니다
+struct MockContextType {
+  const void* input_layout_ = nullptr;
+  const void* vertex_buffers_[StateFilterClass::MAX_VERTEX_BUFFERS] = {};
+  uint32_t vertex_strides_[StateFilterClass::MAX_VERTEX_BUFFERS] = {};
+  const void* index_buffer_ = nullptr;
+  uint32_t primitive_topology_ = 0;
+  const void* vertex_shader_ = nullptr;
+  const void* pixel_shader_ = nullptr;
+  const void* constant_buffer_ = nullptr;
+  uint32_t first_constant_ = 0;
+  const void* render_target_ = nullptr;
+  const void* blend_state_ = nullptr;
+  const void* rasterizer_state_ = nullptr;
+  StateFilterClass::ViewportType viewport_{};
+  uint32_t call_count_ = 0;
+
+  // ID3D11DeviceContext::ClearState 처럼 모든 상태를 비웁니다
+  void ClearState() {
+    const uint32_t call_count = call_count_;
+    *this = MockContextType{};
+    call_count_ = call_count + 1;
+  }
+};
+
+// 한 드로우가 원하는 상태입니다
+struct DrawStateType {
+  const void* input_layout_;
+  const void* vertex_buffers_[VERTEX_BUFFER_SLOTS];
+  uint32_t vertex_strides_[VERTEX_BUFFER_SLOTS];
+  const void* index_buffer_;
+  const void* vertex_shader_;
+  const void* pixel_shader_;
+  const void* constant_buffer_;
+  uint32_t first_constant_;
+  const void* render_target_;
+  const void* blend_state_;
+  const void* rasterizer_state_;
+  StateFilterClass::ViewportType viewport_;
+};
+
+const void* Handle(const uintptr_t value) {
+  return reinterpret_cast<const void*>(value * 16);
+}
+
+// DeviceContextClass 처럼 필터를 거쳐 가짜 컨텍스트에 바인딩합니다
+void Bind(StateFilterClass& filter, MockContextType& context,
+          const DrawStateType& state) {
+  if (filter.SetInputLayout(state.input_layout_)) {
+    context.input_layout_ = state.input_layout_;
+    context.call_count_++;
+  }
+
+  // 필터가 돌려준 바뀐 슬롯 구간만 바인딩합니다
+  uint32_t start = 0, count = 0;
+  if (filter.SetVertexBuffers(0, VERTEX_BUFFER_SLOTS, state.vertex_buffers_,
+                              state.vertex_strides_, nullptr, start, count)) {
+    for (uint32_t slot = start; slot < start + count; slot++) {
+      context.vertex_buffers_[slot] = state.vertex_buffers_[slot];
+      context.vertex_strides_[slot] = state.vertex_strides_[slot];
+    }
+    context.call_count_++;
+  }
+
+  if (filter.SetIndexBuffer(state.index_buffer_, 57, 0)) {
+    context.index_buffer_ = state.index_buffer_;
+    context.call_count_++;
+  }
+  if (filter.SetPrimitiveTopology(4)) {
+    context.primitive_topology_ = 4;
+    context.call_count_++;
+  }
+  if (filter.SetVertexShader(state.vertex_shader_)) {
+    context.vertex_shader_ = state.vertex_shader_;
+    context.call_count_++;
+  }
+  if (filter.SetPixelShader(state.pixel_shader_)) {
+    context.pixel_shader_ = state.pixel_shader_;
+    context.call_count_++;
+  }
+
+  // 링 버퍼의 조각을 오프셋으로 바인딩합니다 (VSSetConstantBuffers1)
+  const uint32_t constant_count = 16;
+  if (filter.SetVertexConstantBuffers(0, 1, &state.constant_buffer_,
+                                      &state.first_constant_, &constant_count,
+                                      start, count)) {
+    context.constant_buffer_ = state.constant_buffer_;
+    context.first_constant_ = state.first_constant_;
+    context.call_count_++;
+  }
+
+  if (filter.SetRenderTargets(1, &state.render_target_, nullptr)) {
+    context.render_target_ = state.render_target_;
+    context.call_count_++;
+  }
+  if (filter.SetBlendState(state.blend_state_, nullptr, 0xffffffff)) {
+    context.blend_state_ = state.blend_state_;
+    context.call_count_++;
+  }
+  if (filter.SetRasterizerState(state.rasterizer_state_)) {
+    context.rasterizer_state_ = state.rasterizer_state_;
+    context.call_count_++;
+  }
+  if (filter.SetViewports(1, &state.viewport_)) {
+    context.viewport_ = state.viewport_;
+    context.call_count_++;
+  }
+}
+
+bool Matches(const MockContextType& context, const DrawStateType& state) {
+  for (uint32_t slot = 0; slot < VERTEX_BUFFER_SLOTS; slot++)
+    if (context.vertex_buffers_[slot] != state.vertex_buffers_[slot] ||
+        context.vertex_strides_[slot] != state.vertex_strides_[slot])
+      return false;
+
+  return context.input_layout_ == state.input_layout_ &&
+         context.index_buffer_ == state.index_buffer_ &&
+         context.primitive_topology_ == 4 &&
+         context.vertex_shader_ == state.vertex_shader_ &&
+         context.pixel_shader_ == state.pixel_shader_ &&
+         context.constant_buffer_ == state.constant_buffer_ &&
+         context.first_constant_ == state.first_constant_ &&
+         context.render_target_ == state.render_target_ &&
+         context.blend_state_ == state.blend_state_ &&
+         context.rasterizer_state_ == state.rasterizer_state_ &&
+         std::memcmp(&context.viewport_, &state.viewport_,
+                     sizeof(state.viewport_)) == 0;
+}
+
+// 몇 가지 값 중에서 고른 상태로 많은 드로우를 바인딩하고, 매 드로우 뒤
+// 가짜 컨텍스트의 상태가 원하는 상태와 같은지 봅니다. 가끔 ClearState 로
+// 실제 상태를 비우고 필터를 Invalidate 합니다
+void TestRandomDraws(const bool enabled) {
+  StateFilterClass filter;
+  filter.SetEnabled(enabled);
+  MockContextType context;
+  std::mt19937 random(1);
+
+  const uint32_t DRAW_COUNT = 20000;
+  uint32_t mismatch_count = 0, clear_count = 0;
+  for (uint32_t draw = 0; draw < DRAW_COUNT; draw++) {
+    if (draw % 5000 == 4999) {
+      context.ClearState();
+      filter.Invalidate();
+      clear_count++;
+    }
+
+    DrawStateType state{};
+    state.input_layout_ = Handle(1 + random() % 2);
+    state.vertex_buffers_[0] = Handle(10 + random() % 3);
+    state.vertex_buffers_[1] = Handle(20 + (random() % 8 == 0));
+    state.vertex_strides_[0] = 16;
+    state.vertex_strides_[1] = 80;
+    state.index_buffer_ = Handle(30 + random() % 2);
+    state.vertex_shader_ = Handle(1 + random() % 2);
+    state.pixel_shader_ = Handle(1);
+    state.constant_buffer_ = Handle(40);
+    state.first_constant_ = random() % 4 * 16;
+    state.render_target_ = Handle(60);
+    state.blend_state_ = random() % 16 == 0 ? nullptr : Handle(70);
+    state.rasterizer_state_ = Handle(50);
+    state.viewport_ = {0.0f, 0.0f, 640.0f, 480.0f, 0.0f, 1.0f};
+
+    Bind(filter, context, state);
+    if (Matches(context, state) == false) mismatch_count++;
+  }
+  CHECK(mismatch_count == 0);
+
+  // 카운터는 꺼져 있어도 셉니다
+  // Bind 는 드로우마다 Set 함수 11 개를 부릅니다
+  const uint32_t call_count = DRAW_COUNT * 11;
+  CHECK(filter.GetIssuedCount() + filter.GetFilteredCount() == call_count);
+  CHECK(filter.GetIssuedCount() == context.call_count_ - clear_count);
+  if (enabled) {
+    // 매 드로우 같은 픽셀 셰이더와 뷰포트는 ClearState 뒤에만 다시
+    // 바인딩합니다
+    CHECK(filter.GetIssuedCount(StateFilterClass::CallType::PIXEL_SHADER) ==
+          1 + clear_count);
+    CHECK(filter.GetIssuedCount(StateFilterClass::CallType::VIEWPORTS) ==
+          1 + clear_count);
+    CHECK(filter.GetFilteredCount() > filter.GetIssuedCount());
+  } else {
+    CHECK(filter.GetFilteredCount() == 0);
+  }
+}
+
+// 바뀐 슬롯만 골라 돌려주는지 봅니다
+void TestChangedSlotRange() {
+  StateFilterClass filter;
+  const void* buffers[4] = {Handle(1), Handle(2), Handle(3), Handle(4)};
+  uint32_t start = 0, count = 0;
+
+  CHECK(filter.SetVertexBuffers(0, 4, buffers, nullptr, nullptr, start,
+                                count));
+  CHECK(start == 0 && count == 4);
+
+  buffers[2] = Handle(5);
+  CHECK(filter.SetVertexBuffers(0, 4, buffers, nullptr, nullptr, start,
+                                count));
+  CHECK(start == 2 && count == 1);
+
+  buffers[1] = Handle(6);
+  buffers[3] = Handle(7);
+  CHECK(filter.SetVertexBuffers(0, 4, buffers, nullptr, nullptr, start,
+                                count));
+  CHECK(start == 1 && count == 3);
+
+  CHECK(filter.SetVertexBuffers(0, 4, buffers, nullptr, nullptr, start,
+                                count) == false);
+
+  // 끈 필터는 요청한 구간을 그대로 돌려줍니다
+  filter.SetEnabled(false);
+  buffers[3] = Handle(8);
+  CHECK(filter.SetVertexBuffers(0, 4, buffers, nullptr, nullptr, start,
+                                count));
+  CHECK(start == 0 && count == 4);
+}
+
+// 같은 값이어도 처음에는 상태를 모르므로 통과시킵니다
+void TestUnknownState() {
+  StateFilterClass filter;
+  CHECK(filter.SetInputLayout(nullptr));
+  CHECK(filter.SetInputLayout(nullptr) == false);
+  CHECK(filter.SetBlendState(nullptr, nullptr, 0xffffffff));
+
+  // blend_factor 가 nullptr 이면 1, 1, 1, 1 과 같습니다
+  const float ones[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+  CHECK(filter.SetBlendState(nullptr, ones, 0xffffffff) == false);
+
+  filter.Invalidate();
+  CHECK(filter.SetInputLayout(nullptr));
+  CHECK(filter.SetBlendState(nullptr, ones, 0xffffffff));
+
+  filter.ResetCounters();
+  CHECK(filter.GetIssuedCount() == 0 && filter.GetFilteredCount() == 0);
+}
+}  // namespace
+
+int main() {
+  TestRandomDraws(true);
+  TestRandomDraws(false);
+  TestChangedSlotRange();
+  TestUnknownState();
+  return test::Finish();
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdio>
+
+// 테스트 실행 파일이 함께 쓰는 검사 매크로입니다. assert 와 달리 NDEBUG
+// 빌드에서도 검사하고, 실패해도 멈추지 않고 다음 검사로 넘어갑니다.
+// main 은 test::Finish() 를 반환합니다
+namespace test {
+inline int failure_count = 0;
+
+inline int Finish() { return failure_count == 0 ? 0 : 1; }
+}  // namespace test
+
+#define CHECK(condition)                                              \
+  do {                                                                \
+    if (!(condition)) {                                               \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__,     \
+                   __LINE__, #condition);                             \
+      ::test::failure_count++;                                        \
+    }                                                                 \
+  } while (false)